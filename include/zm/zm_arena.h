@@ -0,0 +1,136 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ */
+/*! \file zm_arena.h
+ * \brief arena allocator of temporary vectors and matrices.
+ * \author Zhidao
+ */
+
+#ifndef __ZM_ARENA_H__
+#define __ZM_ARENA_H__
+
+#include <zm/zm_mat.h>
+
+__BEGIN_DECLS
+
+/*! \brief alignment of memory chunks carved from an arena in bytes. */
+#define ZM_ARENA_ALIGN 64
+
+/*! \struct zArena
+ * \brief arena allocator of temporary vectors and matrices.
+ *
+ * zArena is a stack allocator over one contiguous memory block. Headers and buffers of vectors, matrices
+ * and indices are carved from the block in order, each of which is aligned to ZM_ARENA_ALIGN bytes.
+ * Nothing carved from an arena is freed individually; the whole block is rewound to a mark taken
+ * beforehand or to the head at once, so that a loop that repeatedly needs the same temporaries does
+ * not call malloc() at all once the block is prepared.
+ *
+ * \a used is the number of bytes currently in use, and \a peak is the maximum of it since the block
+ * is prepared, which helps to size the block after a trial run.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zArena ){
+  char *buf;   /*!< aligned head of the block */
+  size_t size; /*!< size of the block in bytes */
+  size_t used; /*!< number of bytes in use */
+  size_t peak; /*!< peak number of bytes in use */
+  /*! \cond */
+  void *_block; /* memory allocated by the arena itself */
+  /*! \endcond */
+};
+
+/*! \brief mark of an arena to be rewound. */
+typedef size_t zArenaMark;
+
+/*! \brief initialize, allocate and free an arena.
+ *
+ * zArenaInit() initializes an arena \a arena as empty.
+ *
+ * zArenaAlloc() allocates a memory block of \a size bytes for \a arena.
+ *
+ * zArenaAssign() assigns a memory block \a buf of \a size bytes prepared by the caller to \a arena.
+ * \a buf is not freed by zArenaFree(), so that a static array can be used as the block.
+ *
+ * zArenaFree() frees the memory block of \a arena if it was allocated by zArenaAlloc(), and initializes
+ * \a arena.
+ * \return
+ * zArenaInit() returns a pointer \a arena.
+ *
+ * zArenaAlloc() and zArenaAssign() return a pointer \a arena, or the null pointer if they fail to
+ * allocate memory or the given block is too small to be aligned.
+ *
+ * zArenaFree() returns no value.
+ */
+__ZM_EXPORT zArena *zArenaInit(zArena *arena);
+__ZM_EXPORT zArena *zArenaAlloc(zArena *arena, size_t size);
+__ZM_EXPORT zArena *zArenaAssign(zArena *arena, void *buf, size_t size);
+__ZM_EXPORT void zArenaFree(zArena *arena);
+
+/*! \brief mark and rewind an arena.
+ *
+ * zArenaMarkGet() returns the current position of an arena \a arena.
+ *
+ * zArenaRelease() rewinds \a arena to \a mark, which has to be obtained by zArenaMarkGet() beforehand.
+ * Everything carved after \a mark is discarded at once.
+ *
+ * zArenaReset() rewinds \a arena to the head.
+ *
+ * zArenaRemain() returns the number of bytes that remain in \a arena.
+ */
+#define zArenaMarkGet(arena)        ( (arena)->used )
+#define zArenaRelease(arena,mark)   ( (arena)->used = (mark) )
+#define zArenaReset(arena)          zArenaRelease( arena, 0 )
+#define zArenaRemain(arena)         ( (arena)->size - (arena)->used )
+
+/*! \brief number of bytes of an arena consumed by a temporary.
+ *
+ * zArenaSize() returns the number of bytes of an arena to carve a memory chunk of \a size bytes.
+ *
+ * zArenaVecSize(), zArenaMatSize() and zArenaIndexSize() return the numbers of bytes of an arena to
+ * carve a vector of size \a size, a \a row x \a col matrix and an index of size \a size, respectively,
+ * including their headers. The sum of them gives the size of a block to hold all of them.
+ */
+__ZM_EXPORT size_t zArenaSize(size_t size);
+__ZM_EXPORT size_t zArenaVecSize(int size);
+__ZM_EXPORT size_t zArenaMatSize(int row, int col);
+__ZM_EXPORT size_t zArenaIndexSize(int size);
+
+/*! \brief carve a memory chunk from an arena.
+ *
+ * zArenaCarve() carves a memory chunk of \a size bytes aligned to ZM_ARENA_ALIGN bytes from an arena
+ * \a arena. The chunk is not zero-cleared.
+ * \return
+ * zArenaCarve() returns a pointer to the carved chunk, or the null pointer if \a arena does not have
+ * enough room.
+ */
+__ZM_EXPORT void *zArenaCarve(zArena *arena, size_t size);
+
+/*! \brief vectors, matrices and indices on an arena.
+ *
+ * zArenaVecAlloc() creates a vector of size \a size, whose header and buffer are carved from an arena
+ * \a arena. zArenaMatAlloc() creates a \a row x \a col matrix, and zArenaIndexCreate() creates an index
+ * of size \a size ordered as 0, 1, ... in the same way. Vectors and matrices are zero-cleared.
+ *
+ * If the null pointer is given for \a arena, they allocate the vector, the matrix and the index on the
+ * heap by zVecAlloc(), zMatAlloc() and zIndexCreate(), respectively, so that a solver can be written
+ * once for both cases.
+ *
+ * zArenaVecFree(), zArenaMatFree() and zArenaIndexFree() free \a v, \a m and \a idx by zVecFree(),
+ * zMatFree() and zIndexFree() if \a arena is the null pointer, and do nothing otherwise.
+ * \return
+ * zArenaVecAlloc(), zArenaMatAlloc() and zArenaIndexCreate() return a pointer to the created object,
+ * or the null pointer if \a arena does not have enough room or they fail to allocate memory.
+ *
+ * zArenaVecFree(), zArenaMatFree() and zArenaIndexFree() return no value.
+ */
+__ZM_EXPORT zVec zArenaVecAlloc(zArena *arena, int size);
+__ZM_EXPORT zMat zArenaMatAlloc(zArena *arena, int row, int col);
+__ZM_EXPORT zIndex zArenaIndexCreate(zArena *arena, int size);
+__ZM_EXPORT void zArenaVecFree(zArena *arena, zVec v);
+__ZM_EXPORT void zArenaMatFree(zArena *arena, zMat m);
+__ZM_EXPORT void zArenaIndexFree(zArena *arena, zIndex idx);
+
+#define zArenaMatAllocSqr(arena,size) zArenaMatAlloc( arena, size, size )
+
+__END_DECLS
+
+#endif /* __ZM_ARENA_H__ */
@@ -46,6 +46,7 @@
 
 #define ZM_WARN_ODE_GEAR1                  "invalid step number %d, modified to 1"
 #define ZM_WARN_ODE_GEAR2                  "step number %d over 6 may cause instability, modified"
+#define ZM_WARN_ODE_STEPTOOSMALL           "step size %g at t=%g too small to satisfy the tolerance"
 
 #define ZM_WARN_GRAPH_DUPNODE              "duplicate specification of a node"
 #define ZM_WARN_GRAPH_DUPCONNECTION        "duplicate node connection, overwritten"
@@ -57,6 +58,11 @@
 #define ZM_ERR_ZERODIV                     "cannot devide by tiny value"
 #define ZM_ERR_OUTOFRANGE                  "specified index out of range"
 
+#define ZM_ERR_THREAD_CREATE               "cannot create a thread"
+#define ZM_ERR_THREAD_INVALIDGRAIN         "invalid grain size %d of a parallel loop"
+
+#define ZM_ERR_ARENA_SHORTAGE              "arena has no room for %lu bytes (%lu bytes remain)"
+
 #define ZM_ERR_VEC_NULL                    "null vector assigned"
 #define ZM_ERR_VEC_SIZEMISMATCH            "size mismatch of vectors"
 #define ZM_ERR_MAT_SIZEMISMATCH            "size mismatch of matrices"
@@ -66,8 +72,19 @@
 #define ZM_ERR_MAT_NOTSYMMETRIC            "not a symmetric matrix"
 #define ZM_ERR_MAT_SINGULAR                "matrix is singular"
 #define ZM_ERR_MAT_NOTPOSITIVESEMIDEFINITE "matrix is not positive-semidefinite"
+#define ZM_ERR_MAT_NOTPOSITIVEDEFINITE     "matrix is not positive-definite"
 #define ZM_ERR_MAT_CANNOTDECOMPOSEZEROMAT  "cannot decompose zero-matrix to L and Q matrices"
 
+#define ZM_ERR_LE_FACTO_NOTFACTORIZED      "matrix not factorized yet"
+#define ZM_ERR_LE_FACTO_2X2PIVOT           "cannot update LDL^T factorization with 2x2 pivots"
+
+#define ZM_ERR_LE_KRYLOV_NOOP              "linear operator not assigned"
+#define ZM_ERR_LE_KRYLOV_BREAKDOWN         "breakdown of Krylov subspace iteration"
+#define ZM_ERR_LE_PRECOND_ZERODIAG         "zero diagonal component at %d for preconditioning"
+#define ZM_ERR_LE_PRECOND_INVALID_OMEGA    "invalid relaxation factor %g, has to be in (0,2)"
+
+#define ZM_ERR_SPMAT_PATTERNMISMATCH       "sparsity pattern mismatch with the analyzed matrix"
+
 #define ZM_ERR_VEC_SIZENOTFOUND            "vector size not specified"
 #define ZM_ERR_MAT_SIZENOTFOUND            "matrix size not specified"
 
@@ -116,6 +133,11 @@
 
 #define ZM_ERR_INVALID_NUMSAMP             "too many samples %d required out of %d"
 
+#define ZM_ERR_ODE_DENSE_OUTOFRANGE        "time %g out of the last step [%g, %g]"
+#define ZM_ERR_ODE_PARAREAL_SLICENUM       "invalid number of time slices %d"
+#define ZM_ERR_ODE_RIDC_LEVEL              "invalid number of correction sweeps %d"
+#define ZM_ERR_ODE_RIDC_STEP               "not positive step size %g"
+
 #define ZM_ERR_OPT_NOEVALUATOR             "no evaluator assigned"
 #define ZM_ERR_OPT_NOINITIALPOINT          "unable to set the initial point"
 #define ZM_ERR_OPT_CANNOTFINDSTEP          "unable to compute step length"
@@ -123,6 +145,11 @@
 #define ZM_ERR_OPT_INFINITESOLUTION        "infinite solution exists"
 #define ZM_ERR_OPT_NONCONVEX               "cannot solve non-convex QP programs"
 #define ZM_ERR_OPT_NONUNIQUE               "solution not uniquely determined"
+#define ZM_ERR_OPT_LP_INVALIDBASIS         "invalid or duplicate index %d of a basis"
+#define ZM_ERR_OPT_LP_NEGATIVEQUAD         "negative coefficient of quadratic cost"
+#define ZM_ERR_OPT_QP_INVALIDWORKINGSET    "invalid or duplicate index %d of a working set"
+#define ZM_ERR_OPT_QP_INVALIDBOUND         "lower bound %g larger than upper bound %g"
+#define ZM_ERR_OPT_LCP_NEGATIVEFRICTION    "negative coefficient of friction"
 
 #define ZM_ERR_OPT_LP2_INVALID_COSTFUNC    "invalid coefficient of cost function. c2 has to be non-zero"
 #define ZM_ERR_OPT_LP2_INVALID_CONSTRAINT  "invalid constraint, both coefficients are too small"
@@ -8,6 +8,8 @@
 #define __ZM_LE_H__
 
 #include <zm/zm_mat.h>
+#include <zm/zm_spmat.h>
+#include <zm/zm_arena.h>
 
 __BEGIN_DECLS
 
@@ -149,6 +151,9 @@ __END_DECLS
 
 #include <zm/zm_le_pivot.h>     /* pivoting */
 #include <zm/zm_le_lu.h>        /* LU decomposition */
+#include <zm/zm_le_facto.h>     /* reusable factorization of symmetric matrices */
+#include <zm/zm_le_spchol.h>    /* sparse Cholesky factorization */
+#include <zm/zm_le_krylov.h>    /* Krylov subspace methods */
 #include <zm/zm_le_lq.h>        /* LQ/QR decomposition */
 #include <zm/zm_le_mat_inv.h>   /* determinant and inverse matrix */
 #include <zm/zm_le_mat_mpinv.h> /* Moore-Penrose inverse matrix */
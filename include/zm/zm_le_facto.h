@@ -0,0 +1,118 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_le_facto - linear equation: reusable factorization of symmetric matrices.
+ */
+
+#ifndef __ZM_LE_FACTO_H__
+#define __ZM_LE_FACTO_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief type of a factorization. */
+typedef enum{
+  ZM_LE_FACTO_NONE = 0,
+  ZM_LE_FACTO_CHOLESKY,
+  ZM_LE_FACTO_LDL
+} zLEFactoType;
+
+/*! \struct zLEFacto
+ * \brief factorization of a symmetric matrix reusable for repeated solutions.
+ *
+ * A symmetric matrix A is factorized as P A P^T = L L^T (Cholesky factorization) for a positive
+ * definite matrix, or P A P^T = L D L^T for a symmetric indefinite matrix, where P is a permutation
+ * matrix represented by \a idx, L is a lower triangular matrix, and D is a block diagonal matrix with
+ * 1x1 or 2x2 blocks. The diagonal and subdiagonal components of D are stored in \a d and \a e,
+ * respectively.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLEFacto ){
+  zLEFactoType type; /*!< type of the factorization */
+  zMat l;            /*!< lower triangular factor */
+  zVec d;            /*!< diagonal components of D */
+  zVec e;            /*!< subdiagonal components of D */
+  zIndex idx;        /*!< pivot index */
+  /*! \cond */
+  zVec _v; /* workspace */
+  /*! \endcond */
+};
+
+#define zLEFactoSize(f) zMatRowSize( (f)->l )
+
+/*! \brief initialize, allocate and free a factorization.
+ *
+ * zLEFactoInit() initializes a factorization \a f.
+ *
+ * zLEFactoAlloc() allocates internal workspace of \a f for a \a size x \a size matrix.
+ *
+ * zLEFactoFree() frees the internal workspace of \a f.
+ * \return
+ * zLEFactoInit() returns a pointer \a f.
+ *
+ * zLEFactoAlloc() returns a pointer \a f if it succeeds. Otherwise, the null pointer is returned.
+ *
+ * zLEFactoFree() returns no value.
+ */
+__ZM_EXPORT zLEFacto *zLEFactoInit(zLEFacto *f);
+__ZM_EXPORT zLEFacto *zLEFactoAlloc(zLEFacto *f, int size);
+__ZM_EXPORT void zLEFactoFree(zLEFacto *f);
+
+/*! \brief factorize a symmetric matrix.
+ *
+ * zLEFactoCholesky() computes the Cholesky factorization of a positive definite symmetric matrix
+ * \a a with diagonal pivoting by zMatDecompCholeskyBlockDST().
+ *
+ * zLEFactoLDL() computes the LDL^T factorization of a symmetric matrix \a a, which can be indefinite,
+ * with Bunch-Kaufman pivoting by zMatDecompLDLDST().
+ *
+ * For both, only the lower triangular part of \a a is referred. The result is stored in \a f, which
+ * has to be allocated for the size of \a a in advance.
+ * \return
+ * zLEFactoCholesky() and zLEFactoLDL() return the true value if they succeed. If the size of \a a
+ * does not match \a f, or if \a a is not positive definite for zLEFactoCholesky() or singular for
+ * zLEFactoLDL(), the false value is returned.
+ */
+__ZM_EXPORT bool zLEFactoCholesky(zLEFacto *f, const zMat a);
+__ZM_EXPORT bool zLEFactoLDL(zLEFacto *f, const zMat a);
+
+/*! \brief solve linear equations with a factorization.
+ *
+ * zLEFactoSolve() solves a linear equation A \a ans = \a b, where A is the matrix factorized in \a f.
+ *
+ * zLEFactoSolveMat() solves A \a ans = \a b for a matrix \a b with many columns at once, in which the
+ * triangular solutions are blocked and done by zRawGEMM().
+ *
+ * \a ans can be the same with \a b.
+ * \return
+ * zLEFactoSolve() and zLEFactoSolveMat() return a pointer \a ans if they succeed. If \a f is not
+ * factorized yet, or the sizes of \a f, \a b and \a ans mismatch, the null pointer is returned.
+ */
+__ZM_EXPORT zVec zLEFactoSolve(zLEFacto *f, const zVec b, zVec ans);
+__ZM_EXPORT zMat zLEFactoSolveMat(zLEFacto *f, const zMat b, zMat ans);
+
+/*! \brief rank-one update of a factorization.
+ *
+ * zLEFactoUpdate() updates a factorization \a f of a matrix A to that of A + \a sigma \a v \a v ^T in
+ * O(n^2) operations, where n is the size of A. A positive \a sigma means an update and a negative
+ * \a sigma a downdate. The pivot index is kept.
+ *
+ * The Cholesky factorization is updated by a sequence of rotations, and the LDL^T factorization by
+ * Gill-Golub-Murray-Saunders' method, for which D has to be diagonal, namely, no 2x2 pivots are
+ * allowed.
+ * \return
+ * zLEFactoUpdate() returns the true value if it succeeds. If the updated matrix is not positive
+ * definite for the Cholesky factorization or singular for the LDL^T factorization, or if D of the
+ * LDL^T factorization has a 2x2 block, the false value is returned with \a f unchanged.
+ */
+__ZM_EXPORT bool zLEFactoUpdate(zLEFacto *f, const zVec v, double sigma);
+
+/*! \brief determinant of a factorized matrix.
+ *
+ * zLEFactoDet() returns the determinant of the matrix factorized in \a f.
+ */
+__ZM_EXPORT double zLEFactoDet(const zLEFacto *f);
+
+__END_DECLS
+
+#endif /* __ZM_LE_FACTO_H__ */
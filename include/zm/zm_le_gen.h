@@ -28,6 +28,7 @@ typedef struct{
   zMat l_facto;     /* left hand matrix */
   zMat r_facto;     /* right hand matrix */
   zIndex index_lu;  /* an index vector for LU decomposition */
+  zArena *_arena;   /* arena on which the workspace is carved */
   /*! \endcond */
 } zLEWorkspace;
 
@@ -35,6 +36,12 @@ typedef struct{
 __ZM_EXPORT void zLEWorkspaceInit(zLEWorkspace *workspace);
 /*! \brief allocate workspace for generalized linear equation solvers. */
 __ZM_EXPORT bool zLEWorkspaceAlloc(zLEWorkspace *workspace, int num_equation, int num_variable);
+/*! \brief allocate workspace for generalized linear equation solvers on an arena.
+ *
+ * The workspace is carved from \a arena, and zLEWorkspaceFree() leaves it to the arena. If \a arena is
+ * the null pointer, it is the same with zLEWorkspaceAlloc().
+ */
+__ZM_EXPORT bool zLEWorkspaceAllocArena(zLEWorkspace *workspace, int num_equation, int num_variable, zArena *arena);
 /*! \brief clone workspace for generalized linear equation solvers. */
 __ZM_EXPORT bool zLEWorkspaceClone(zLEWorkspace *src, zLEWorkspace *cln);
 /*! \brief free workspace for generalized linear equation solvers. */
@@ -42,6 +49,8 @@ __ZM_EXPORT void zLEWorkspaceFree(zLEWorkspace *workspace);
 
 /*! \brief allocate workspace for LQ/LU decomposition and generalized linear equation solvers based on MP inverse. */
 __ZM_EXPORT bool zLEWorkspaceAllocMP(zLEWorkspace *workspace, int num_equation, int num_variable);
+/*! \brief allocate workspace for LQ/LU decomposition and generalized linear equation solvers based on MP inverse on an arena. */
+__ZM_EXPORT bool zLEWorkspaceAllocMPArena(zLEWorkspace *workspace, int num_equation, int num_variable, zArena *arena);
 /*! \brief free workspace for LQ/LU decomposition and generalized linear equation solvers based on MP inverse. */
 __ZM_EXPORT void zLEWorkspaceFreeMP(zLEWorkspace *workspace);
 /*! \brief resize matrices and a vector for LQ/LU decomposition and generalized linear equation solvers based on MP inverse. */
@@ -0,0 +1,174 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_le_krylov - linear equation: Krylov subspace methods.
+ */
+
+#ifndef __ZM_LE_KRYLOV_H__
+#define __ZM_LE_KRYLOV_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief default relative tolerance of residual for Krylov subspace methods. */
+#define ZM_LE_KRYLOV_TOL     ( 1.0e-10 )
+/*! \brief default number of iterations before restart of GMRES. */
+#define ZM_LE_KRYLOV_RESTART 30
+
+/*! \struct zLEKrylov
+ * \brief matrix-free Krylov subspace solver of linear equations.
+ *
+ * zLEKrylov solves a linear equation A x = b only through a linear operator \a op that computes
+ * y = A x, so that A never has to be formed or factorized. \a op is called as \a op(x, y, \a op_util)
+ * and returns a pointer y.
+ *
+ * An optional preconditioner \a pc computes z = M^-1 r for an approximation M of A, which is called as
+ * \a pc(r, z, \a pc_util). If \a pc is the null pointer, no preconditioning is applied.
+ *
+ * The iteration terminates when the residual norm relative to that of b gets less than \a tol or
+ * the number of iterations reaches \a iter. The number of iterations done and the relative residual
+ * are stored in \a iter_num and \a residual, respectively.
+ *
+ * Workspace for a given size is kept in the solver, and is reused over calls.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLEKrylov ){
+  int size;                           /*!< size of the equation */
+  zVec (* op)(const zVec,zVec,void*); /*!< linear operator */
+  void *op_util;                      /*!< utility for the linear operator */
+  zVec (* pc)(const zVec,zVec,void*); /*!< preconditioner */
+  void *pc_util;                      /*!< utility for the preconditioner */
+  double tol;                         /*!< relative tolerance of residual */
+  int iter;                           /*!< maximum number of iterations */
+  int restart;                        /*!< number of iterations before restart of GMRES */
+  int iter_num;                       /*!< number of iterations done */
+  double residual;                    /*!< relative residual */
+  /*! \cond */
+  zVec _r, _rh, _p, _v, _s, _t, _ph, _sh; /* workspace for PCG and BiCGSTAB */
+  zVec *_basis;                           /* Krylov basis for GMRES */
+  zMat _h;                                /* Hessenberg matrix for GMRES */
+  zVec _c, _sn, _g;                       /* Givens rotations and projected residual for GMRES */
+  /*! \endcond */
+};
+
+/*! \brief initialize, allocate and free a Krylov subspace solver.
+ *
+ * zLEKrylovInit() initializes a Krylov subspace solver \a krylov.
+ *
+ * zLEKrylovAlloc() allocates workspace of \a krylov for an equation of size \a size. \a restart is
+ * the number of iterations before restart of GMRES. If it is not positive, ZM_LE_KRYLOV_RESTART is
+ * used. The tolerance and the maximum number of iterations are set for ZM_LE_KRYLOV_TOL and
+ * Z_MAX_ITER_NUM, respectively.
+ *
+ * zLEKrylovFree() frees workspace of \a krylov.
+ *
+ * zLEKrylovSetOp() sets a linear operator \a op with a utility \a util.
+ *
+ * zLEKrylovSetPrecond() sets a preconditioner \a pc with a utility \a util.
+ *
+ * zLEKrylovSetTol() sets the relative tolerance \a tol and the maximum number of iterations \a iter.
+ * If \a iter is not positive, Z_MAX_ITER_NUM is set.
+ * \return
+ * zLEKrylovInit(), zLEKrylovSetOp(), zLEKrylovSetPrecond() and zLEKrylovSetTol() return a pointer
+ * \a krylov.
+ *
+ * zLEKrylovAlloc() returns a pointer \a krylov, or the null pointer if it fails to allocate memory.
+ *
+ * zLEKrylovFree() returns no value.
+ */
+__ZM_EXPORT zLEKrylov *zLEKrylovInit(zLEKrylov *krylov);
+__ZM_EXPORT zLEKrylov *zLEKrylovAlloc(zLEKrylov *krylov, int size, int restart);
+__ZM_EXPORT void zLEKrylovFree(zLEKrylov *krylov);
+__ZM_EXPORT zLEKrylov *zLEKrylovSetOp(zLEKrylov *krylov, zVec (* op)(const zVec,zVec,void*), void *util);
+__ZM_EXPORT zLEKrylov *zLEKrylovSetPrecond(zLEKrylov *krylov, zVec (* pc)(const zVec,zVec,void*), void *util);
+__ZM_EXPORT zLEKrylov *zLEKrylovSetTol(zLEKrylov *krylov, double tol, int iter);
+
+/*! \brief linear operators of matrices.
+ *
+ * zLEKrylovOpMat() and zLEKrylovOpSpMat() are linear operators that multiply \a x by a dense matrix
+ * and a sparse matrix given as \a util, respectively, and put the result into \a y.
+ * \return
+ * zLEKrylovOpMat() and zLEKrylovOpSpMat() return a pointer \a y.
+ */
+__ZM_EXPORT zVec zLEKrylovOpMat(const zVec x, zVec y, void *util);
+__ZM_EXPORT zVec zLEKrylovOpSpMat(const zVec x, zVec y, void *util);
+
+/*! \brief solve a linear equation by Krylov subspace methods.
+ *
+ * zLEKrylovPCG() solves a linear equation A \a ans = \a b by the preconditioned conjugate gradient
+ * method, where A has to be symmetric and positive definite, and the preconditioner has to be so, too.
+ *
+ * zLEKrylovGMRES() solves the equation by the restarted generalized minimal residual method with
+ * right preconditioning, which is applicable to general nonsingular A.
+ *
+ * zLEKrylovBiCGSTAB() solves the equation by the biconjugate gradient stabilized method with right
+ * preconditioning, which is applicable to general nonsingular A with less memory than GMRES.
+ *
+ * A is given by the linear operator of \a krylov. \a ans is used as the initial guess.
+ * \return
+ * zLEKrylovPCG(), zLEKrylovGMRES() and zLEKrylovBiCGSTAB() return a pointer \a ans. If the iteration
+ * does not converge, a warning is shown and \a ans at the last iteration is returned. If the sizes of
+ * \a krylov, \a b and \a ans mismatch, no linear operator is assigned, or the iteration breaks down,
+ * the null pointer is returned.
+ */
+__ZM_EXPORT zVec zLEKrylovPCG(zLEKrylov *krylov, const zVec b, zVec ans);
+__ZM_EXPORT zVec zLEKrylovGMRES(zLEKrylov *krylov, const zVec b, zVec ans);
+__ZM_EXPORT zVec zLEKrylovBiCGSTAB(zLEKrylov *krylov, const zVec b, zVec ans);
+
+/*! \brief type of a preconditioner. */
+typedef enum{
+  ZM_LE_PRECOND_NONE = 0,
+  ZM_LE_PRECOND_JACOBI,
+  ZM_LE_PRECOND_SSOR,
+  ZM_LE_PRECOND_IC
+} zLEPrecondType;
+
+/*! \struct zLEPrecond
+ * \brief built-in preconditioners of sparse matrices.
+ *
+ * zLEPrecond is a preconditioner for a sparse matrix A, which is applied by zLEPrecondApply() as a
+ * preconditioner of zLEKrylov.
+ * - ZM_LE_PRECOND_JACOBI: M = D, where D is the diagonal part of A.
+ * - ZM_LE_PRECOND_SSOR: M = (D/w+L) (D/w)^-1 (D/w+U) w/(2-w), where L and U are the strictly lower and
+ *   upper triangular parts of A, and w is the relaxation factor.
+ * - ZM_LE_PRECOND_IC: M = L L^T, where L is the incomplete Cholesky factor of A without fill-in.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLEPrecond ){
+  zLEPrecondType type; /*!< type of the preconditioner */
+  zSpMat m;            /*!< copy of A (SSOR) or incomplete Cholesky factor (IC) in the CSR format */
+  zVec d;              /*!< diagonal components of A (Jacobi and SSOR) */
+  double omega;        /*!< relaxation factor (SSOR) */
+};
+
+/*! \brief create and apply a preconditioner.
+ *
+ * zLEPrecondJacobi() creates a Jacobi preconditioner \a pc of a sparse matrix \a a.
+ *
+ * zLEPrecondSSOR() creates a symmetric successive over-relaxation preconditioner \a pc of \a a with a
+ * relaxation factor \a omega, which has to be in (0, 2).
+ *
+ * zLEPrecondIC() creates an incomplete Cholesky preconditioner \a pc of a symmetric positive definite
+ * matrix \a a with no fill-in, where only the lower triangular part of \a a is referred. If the
+ * factorization breaks down, it is retried with the diagonal of \a a increasingly shifted.
+ *
+ * zLEPrecondApply() applies \a pc given as \a util to a residual \a r, and puts the result into \a z.
+ * It is passed to zLEKrylovSetPrecond() as a preconditioner.
+ *
+ * zLEPrecondFree() frees internal workspace of \a pc.
+ * \return
+ * zLEPrecondJacobi(), zLEPrecondSSOR() and zLEPrecondIC() return a pointer \a pc, or the null pointer
+ * if \a a is not square, has a zero diagonal component, or they fail to allocate memory.
+ *
+ * zLEPrecondApply() returns a pointer \a z.
+ *
+ * zLEPrecondFree() returns no value.
+ */
+__ZM_EXPORT zLEPrecond *zLEPrecondJacobi(zLEPrecond *pc, const zSpMat a);
+__ZM_EXPORT zLEPrecond *zLEPrecondSSOR(zLEPrecond *pc, const zSpMat a, double omega);
+__ZM_EXPORT zLEPrecond *zLEPrecondIC(zLEPrecond *pc, const zSpMat a);
+__ZM_EXPORT zVec zLEPrecondApply(const zVec r, zVec z, void *util);
+__ZM_EXPORT void zLEPrecondFree(zLEPrecond *pc);
+
+__END_DECLS
+
+#endif /* __ZM_LE_KRYLOV_H__ */
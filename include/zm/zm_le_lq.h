@@ -73,6 +73,133 @@ __ZM_EXPORT int zMatDecompLQAlloc(const zMat m, zMat *l, zMat *q);
  */
 __ZM_EXPORT int zMatDecompQR(const zMat m, zMat q, zMat r);
 
+/*! \brief QR decomposition of a matrix based on Householder's method.
+ *
+ * zMatDecompQR_Householder() decomposes a matrix \a m into a column-orthonormal matrix \a q and an
+ * upper triangular matrix \a r, namely, \a q \a r = \a m, by the blocked Householder method of
+ * zLQFacto applied to the transpose of \a m.
+ * \return
+ * zMatDecompQR_Householder() returns the rank of \a m, or -1 if it fails to allocate memory.
+ * \notes
+ * When the null pointer is given for \a r, zMatDecompQR_Householder() computes only \a q.
+ */
+__ZM_EXPORT int zMatDecompQR_Householder(const zMat m, zMat q, zMat r);
+
+/*! \brief block size of the blocked Householder LQ decomposition. */
+#define ZM_LQ_FACTO_BLOCK 32
+/*! \brief relative tolerance for rank detection in the Householder LQ decomposition. */
+#define ZM_LQ_FACTO_TOL ( 1.0e-10 )
+
+/*! \struct zLQFacto
+ * \brief Householder LQ decomposition with implicit orthogonal factor.
+ *
+ * A matrix A is decomposed as P A = L Q, where P is a row permutation represented by \a idx, L is a
+ * lower trapezoidal matrix, and Q = H_{k-1} ... H_1 H_0 is an orthogonal matrix given by a product of
+ * Householder reflectors H_i = I - \a tau_i v_i v_i^T. Q is never formed explicitly. L is stored in the
+ * lower triangular part of \a a, and v_i with the implicit unit leading component is stored in the
+ * i-th row of \a a right of the diagonal.
+ * Every ZM_LQ_FACTO_BLOCK reflectors are aggregated into the compact WY representation
+ * I - V T V^T, where the upper triangular matrices T are stored in \a t, so that Q is applied to
+ * matrices by matrix-matrix multiplications.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLQFacto ){
+  zMat a;      /*!< L and Householder vectors */
+  zVec tau;    /*!< scale factors of Householder reflectors */
+  zMat t;      /*!< triangular factors of the compact WY representation */
+  zIndex idx;  /*!< row pivot index */
+  int num;     /*!< number of Householder reflectors */
+  int rank;    /*!< rank of the decomposed matrix */
+  /*! \cond */
+  zMat _v, _y, _z; /* workspace for the compact WY representation */
+  zVec _w;         /* workspace for solution */
+  zLQFacto *_cod;  /* decomposition of L for rank-deficient cases */
+  /*! \endcond */
+};
+
+#define zLQFactoRowSize(f) zMatRowSizeNC( (f)->a )
+#define zLQFactoColSize(f) zMatColSizeNC( (f)->a )
+
+/*! \brief initialize, allocate and free a Householder LQ decomposition.
+ *
+ * zLQFactoInit() initializes a decomposition \a f.
+ *
+ * zLQFactoAlloc() allocates internal workspace of \a f for a \a rowsize x \a colsize matrix.
+ *
+ * zLQFactoFree() frees internal workspace of \a f.
+ * \return
+ * zLQFactoInit() returns a pointer \a f.
+ *
+ * zLQFactoAlloc() returns a pointer \a f, or the null pointer if it fails to allocate memory.
+ *
+ * zLQFactoFree() returns no value.
+ */
+__ZM_EXPORT zLQFacto *zLQFactoInit(zLQFacto *f);
+__ZM_EXPORT zLQFacto *zLQFactoAlloc(zLQFacto *f, int rowsize, int colsize);
+__ZM_EXPORT void zLQFactoFree(zLQFacto *f);
+
+/*! \brief Householder LQ decomposition.
+ *
+ * zLQFactoDecomp() decomposes a matrix \a m into L and Q by Householder reflectors, and stores the
+ * result in \a f, which has to be allocated for the size of \a m in advance.
+ *
+ * If \a pivot is the true value, rows are pivoted in descending order of the norms of their remaining
+ * parts (the transpose of column pivoting of QR decomposition), and the decomposition stops when
+ * the maximum remaining norm gets less than ZM_LQ_FACTO_TOL times the first one, which reveals the
+ * rank of \a m. The reflectors are aggregated into the compact WY representation afterward.
+ *
+ * Otherwise, rows are not pivoted, and every ZM_LQ_FACTO_BLOCK rows are factorized as a panel whose
+ * reflectors are applied to the trailing rows at once by zRawGEMM(). The rank is estimated from the
+ * diagonal components of L.
+ * \return
+ * zLQFactoDecomp() returns the rank of \a m, or -1 if the size of \a m mismatches \a f or it fails to
+ * allocate memory.
+ */
+__ZM_EXPORT int zLQFactoDecomp(zLQFacto *f, const zMat m, bool pivot);
+
+/*! \brief multiply a vector or a matrix by the orthogonal factor of a Householder LQ decomposition.
+ *
+ * zLQFactoMulQ() and zLQFactoMulQT() multiply a vector \a v by Q and Q^T of \a f, respectively, and
+ * put the result into \a qv, which can be the same with \a v.
+ *
+ * zLQFactoMulQMat() and zLQFactoMulQTMat() multiply a matrix \a m by Q and Q^T of \a f from the left,
+ * respectively, where the compact WY representation is applied by zRawGEMM(). The result is put into
+ * \a qm, which can be the same with \a m.
+ * \return
+ * These functions return a pointer to the result, or the null pointer if sizes mismatch or they fail
+ * to allocate memory.
+ */
+__ZM_EXPORT zVec zLQFactoMulQ(const zLQFacto *f, const zVec v, zVec qv);
+__ZM_EXPORT zVec zLQFactoMulQT(const zLQFacto *f, const zVec v, zVec qv);
+__ZM_EXPORT zMat zLQFactoMulQMat(zLQFacto *f, const zMat m, zMat qm);
+__ZM_EXPORT zMat zLQFactoMulQTMat(zLQFacto *f, const zMat m, zMat qm);
+
+/*! \brief explicit factors of a Householder LQ decomposition.
+ *
+ * zLQFactoGetL() copies the lower trapezoidal factor L of \a f to \a l, which has to be a
+ * r x k matrix, where r is the row size of the decomposed matrix and k is the rank.
+ *
+ * zLQFactoGetQ() forms the first k rows of Q of \a f in \a q, which has to be a k x c matrix,
+ * where c is the column size of the decomposed matrix.
+ * \return
+ * zLQFactoGetL() and zLQFactoGetQ() return a pointer to the result, or the null pointer if sizes
+ * mismatch or they fail to allocate memory.
+ */
+__ZM_EXPORT zMat zLQFactoGetL(const zLQFacto *f, zMat l);
+__ZM_EXPORT zMat zLQFactoGetQ(zLQFacto *f, zMat q);
+
+/*! \brief Moore-Penrose inverse solution with a Householder LQ decomposition.
+ *
+ * zLQFactoSolveMP() finds the minimum-norm least square solution \a ans of A \a ans = \a b with the
+ * decomposition \a f of A, namely, the solution with the Moore-Penrose inverse of A.
+ * If A is of full row rank, it solves L y = P \a b and \a ans = Q^T y. Otherwise, the first k columns
+ * of L are decomposed as Q'^T L'^T again to form the complete orthogonal decomposition of A, where k
+ * is the rank of A. Q is applied without being formed explicitly.
+ * \return
+ * zLQFactoSolveMP() returns a pointer \a ans, or the null pointer if sizes mismatch or \a f is not
+ * decomposed yet.
+ */
+__ZM_EXPORT zVec zLQFactoSolveMP(zLQFacto *f, const zVec b, zVec ans);
+
 __END_DECLS
 
 #endif /* __ZM_LE_LQ_H__ */
@@ -19,6 +19,10 @@ __BEGIN_DECLS
  * If \a m is degenerated, the sizes of \a l and \a u are automatically adjusted.
  *
  * zMatDecompLUDST() destroys \a m during the LU decomposition.
+ *
+ * If both the row and column sizes of \a m are not less than ZM_LE_LU_BLOCK_THRESHOLD, the decomposition
+ * is done by zMatDecompLUBlockDST(), unless \a m is found to be rank-deficient, in which case the
+ * element-wise elimination is applied instead.
  * \return
  * zMatDecompLUDST() and zMatDecompLU() return the rank of \a m, which becomes the same with the minimum
  * of the row and column size of \a m when \a m is full rank.
@@ -28,6 +32,53 @@ __ZM_EXPORT int zMatDecompLU(const zMat m, zMat l, zMat u, zIndex idx);
 __ZM_EXPORT int zMatDecompLUAndResize(const zMat m, zMat l, zMat u, zIndex idx);
 __ZM_EXPORT int zMatDecompLUAlloc(const zMat m, zMat *l, zMat *u, zIndex *idx);
 
+/*! \brief block sizes of the blocked LU decomposition.
+ *
+ * ZM_LE_LU_BLOCK_SIZE is the width of a panel factorized at once by zMatDecompLUBlockDST().
+ * ZM_LE_LU_BLOCK_MIN is the size under which the recursion of zMatDecompLURecursiveDST() and
+ * triangular solvers stops.
+ * ZM_LE_LU_BLOCK_THRESHOLD is the minimum size of a matrix for which zMatDecompLUDST(), zMatDet(),
+ * zMatInv() and zLESolveGauss() apply the blocked LU decomposition.
+ */
+#define ZM_LE_LU_BLOCK_SIZE       64
+#define ZM_LE_LU_BLOCK_MIN        16
+#define ZM_LE_LU_BLOCK_THRESHOLD 128
+
+/*! \brief blocked LU decomposition into a packed form.
+ *
+ * zMatDecompLUBlockDST() decomposes a matrix \a m with partial pivoting as P \a m = L U, where L is
+ * a unit lower triangular matrix and U is an upper triangular matrix. Both L and U are packed into
+ * \a m; the strictly lower part of \a m is overwritten by L and the upper part by U.
+ * Rows of \a m are actually swapped, and \a idx is swapped in the same way, so that the i-th row of
+ * the result corresponds to the \a idx[i] th row of the original matrix if \a idx is ordered in
+ * advance.
+ * It factorizes a panel of ZM_LE_LU_BLOCK_SIZE columns at once, and then updates the trailing
+ * submatrix by the packed matrix-matrix multiplication zRawGEMM().
+ *
+ * zMatDecompLURecursiveDST() does the same decomposition by recursively splitting columns into
+ * halves, where all the updates except the smallest panels are done by zRawGEMM().
+ *
+ * zLESolveLUBlock() solves a linear equation \a a \a ans = \a b, where \a lu and \a idx are the
+ * packed LU decomposition of \a a and the pivot index computed by zMatDecompLUBlockDST() or
+ * zMatDecompLURecursiveDST().
+ * zLESolveLUBlockMat() solves a set of linear equations \a a \a ans = \a b for a matrix \a b.
+ * \return
+ * zMatDecompLUBlockDST() and zMatDecompLURecursiveDST() return the number of decomposed columns.
+ * When they find a pivot whose absolute value is less than zTOL, they stop the decomposition and
+ * return the column where the pivot is found, which is less than the minimum of the row and column
+ * sizes of \a m. Then, \a m is left partly decomposed.
+ *
+ * zLESolveLUBlock() and zLESolveLUBlockMat() return a pointer \a ans if they succeed. If the sizes of
+ * \a lu, \a idx, \a b and \a ans mismatch, or they fail to allocate internal workspace, the null
+ * pointer is returned.
+ * \sa
+ * zRawGEMM
+ */
+__ZM_EXPORT int zMatDecompLUBlockDST(zMat m, zIndex idx);
+__ZM_EXPORT int zMatDecompLURecursiveDST(zMat m, zIndex idx);
+__ZM_EXPORT zVec zLESolveLUBlock(const zMat lu, const zIndex idx, const zVec b, zVec ans);
+__ZM_EXPORT zMat zLESolveLUBlockMat(const zMat lu, const zIndex idx, const zMat b, zMat ans);
+
 /* Cholesky decomposition.
  *
  * zMatDecompCholesky() decomposes a positive semi-definite symmetric matrix \a m into \a l \a l ^T.
@@ -42,6 +93,33 @@ __ZM_EXPORT int zMatDecompCholesky(const zMat m, zMat l, zIndex index);
 __ZM_EXPORT int zMatDecompCholeskyAndResize(const zMat m, zMat l, zIndex idx);
 __ZM_EXPORT int zMatDecompCholeskyAlloc(const zMat m, zMat *l, zIndex *idx);
 
+/*! \brief blocked Cholesky decomposition and LDL^T decomposition into packed forms.
+ *
+ * zMatDecompCholeskyBlockDST() decomposes a positive semi-definite symmetric matrix \a m with
+ * diagonal pivoting as P \a m P^T = L L^T, where L is a lower triangular matrix. Only the lower
+ * triangular part of \a m is referred, which is overwritten by L; the strictly upper triangular part
+ * is left meaningless. Rows and columns of \a m are actually swapped, and \a idx is swapped in the
+ * same way. A panel of ZM_LE_LU_BLOCK_SIZE columns is decomposed at once, and the trailing
+ * submatrix is updated by zRawGEMM(). zMatDecompCholeskyDST() applies it if the size of \a m is not
+ * less than ZM_LE_LU_BLOCK_THRESHOLD.
+ *
+ * zMatDecompLDLDST() decomposes a symmetric matrix \a m, which can be indefinite, as
+ * P \a m P^T = L D L^T with Bunch-Kaufman pivoting, where L is a unit lower triangular matrix and
+ * D is a block diagonal matrix with 1x1 or 2x2 blocks. The strictly lower triangular part of \a m is
+ * overwritten by L. The diagonal and subdiagonal components of D are stored in \a d and \a e,
+ * respectively; \a e[k] is not zero only if the k-th and (k+1)-th rows make a 2x2 block.
+ * Only the lower triangular part of \a m is referred. \a idx is swapped in the same way with the
+ * rows of \a m.
+ * \return
+ * zMatDecompCholeskyBlockDST() returns the rank of \a m. If \a m is not positive semi-definite, or
+ * it fails to allocate internal workspace, -1 is returned.
+ *
+ * zMatDecompLDLDST() returns the rank of \a m, which is less than the size of \a m if a zero pivot
+ * is found. If it fails to allocate internal workspace, -1 is returned.
+ */
+__ZM_EXPORT int zMatDecompCholeskyBlockDST(zMat m, zIndex idx);
+__ZM_EXPORT int zMatDecompLDLDST(zMat m, zVec d, zVec e, zIndex idx);
+
 __END_DECLS
 
 #endif /* __ZM_LE_LU_H__ */
@@ -0,0 +1,99 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_le_spchol - linear equation: sparse Cholesky factorization.
+ */
+
+#ifndef __ZM_LE_SPCHOL_H__
+#define __ZM_LE_SPCHOL_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief approximate minimum degree ordering.
+ *
+ * zSpMatOrderAMD() computes a fill-reducing permutation of a square sparse matrix \a a with a symmetric
+ * sparsity pattern by the approximate minimum degree algorithm on the quotient graph. The pattern of
+ * \a a + \a a ^T is used, so that only either of the upper or the lower triangular part of \a a suffices.
+ * The result is put into \a perm, where \a perm[k] is the original index of the k-th eliminated variable.
+ * \return
+ * zSpMatOrderAMD() returns a pointer \a perm, or the null pointer if \a a is not square or it fails
+ * to allocate internal workspace.
+ */
+__ZM_EXPORT int *zSpMatOrderAMD(const zSpMat a, int *perm);
+
+/*! \struct zSpCholesky
+ * \brief sparse Cholesky factorization.
+ *
+ * A sparse positive definite symmetric matrix A is factorized as P A P^T = L L^T, where P is a
+ * fill-reducing permutation given by the approximate minimum degree ordering and L is a sparse lower
+ * triangular matrix stored in the CSC format with the diagonal component at the head of each column.
+ * \a perm[k] is the original index of the k-th row of P A P^T, and \a pinv is its inverse.
+ * \a parent is the elimination tree of P A P^T.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zSpCholesky ){
+  int size;        /*!< size of the matrix */
+  int *perm;       /*!< fill-reducing permutation */
+  int *pinv;       /*!< inverse permutation */
+  int *parent;     /*!< elimination tree */
+  zSpMat l;        /*!< lower triangular factor */
+  bool factorized; /*!< flag if numerically factorized */
+  /*! \cond */
+  zSpMatFormat _format; /* storage format of the analyzed matrix */
+  int _nnz;        /* number of components of the analyzed matrix */
+  int *_ptr;       /* offsets of lines of the analyzed matrix */
+  int *_ind;       /* indices of components of the analyzed matrix */
+  zSpMat _c;       /* upper triangular part of the permuted matrix */
+  int *_map;       /* map from components of the original matrix to _c */
+  int *_s;         /* workspace for row patterns */
+  int *_w;         /* workspace for marks */
+  int *_count;     /* workspace for column counters */
+  double *_x;      /* workspace for values */
+  /*! \endcond */
+};
+
+/*! \brief sparse Cholesky factorization.
+ *
+ * zSpCholeskyInit() initializes a sparse Cholesky factorization \a chol.
+ *
+ * zSpCholeskyAnalyze() symbolically analyzes a sparse positive definite symmetric matrix \a a. It
+ * computes a fill-reducing permutation by zSpMatOrderAMD(), the elimination tree and the sparsity
+ * pattern of L, and allocates internal workspace of \a chol. Only the upper triangular part of \a a,
+ * namely, components on and above the diagonal, is referred.
+ *
+ * zSpCholeskyFactorize() numerically factorizes \a a by the up-looking method. \a a has to have the
+ * same sparsity pattern with the one analyzed by zSpCholeskyAnalyze(), so that the analysis can be
+ * reused for matrices with different values.
+ *
+ * zSpCholeskySolve() solves a linear equation A \a ans = \a b with the factorization. \a ans can be
+ * the same with \a b.
+ *
+ * zSpCholeskyFree() frees internal workspace of \a chol.
+ *
+ * zLESolveSpCholesky() solves a linear equation \a a \a ans = \a b at once by the above functions.
+ * \return
+ * zSpCholeskyInit() returns a pointer \a chol.
+ *
+ * zSpCholeskyAnalyze() returns the false value if \a a is not square or it fails to allocate memory.
+ * Otherwise, the true value is returned.
+ *
+ * zSpCholeskyFactorize() returns the false value if the pattern of \a a mismatches the analyzed one or
+ * \a a is not positive definite. Otherwise, the true value is returned.
+ *
+ * zSpCholeskySolve() and zLESolveSpCholesky() return a pointer \a ans, or the null pointer if sizes
+ * mismatch or the factorization fails.
+ *
+ * zSpCholeskyFree() returns no value.
+ */
+__ZM_EXPORT zSpCholesky *zSpCholeskyInit(zSpCholesky *chol);
+__ZM_EXPORT bool zSpCholeskyAnalyze(zSpCholesky *chol, const zSpMat a);
+__ZM_EXPORT bool zSpCholeskyFactorize(zSpCholesky *chol, const zSpMat a);
+__ZM_EXPORT zVec zSpCholeskySolve(zSpCholesky *chol, const zVec b, zVec ans);
+__ZM_EXPORT void zSpCholeskyFree(zSpCholesky *chol);
+
+__ZM_EXPORT zVec zLESolveSpCholesky(const zSpMat a, const zVec b, zVec ans);
+
+__END_DECLS
+
+#endif /* __ZM_LE_SPCHOL_H__ */
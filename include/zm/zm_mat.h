@@ -504,6 +504,12 @@ __ZM_EXPORT double zMatTrace(const zMat m);
  * result is put into \a m.
  *
  * zMulMatTMatNC() and zMulMatTMat() multiply \a m2 by transpose of \a m1. The result is put into \a m.
+ *
+ * zMulMatMatThreadNC(), zMulMatMatTThreadNC() and zMulMatTMatThreadNC() are multithreaded versions of
+ * zMulMatMatNC(), zMulMatMatTNC() and zMulMatTMatNC(), respectively, which run on at most \a num threads.
+ * If \a num is zero or negative, the default number of threads zThreadNum() is applied, which is also
+ * the case of zMulMatMatNC(), zMulMatMatTNC() and zMulMatTMatNC(). The results do not depend on the
+ * number of threads.
  * \notes
  * zMul...DRC family requires more time for calculation because temporary memory allocation is done inside.
  * \return
@@ -514,6 +520,9 @@ __ZM_EXPORT zVec zMulMatTVecNC(const zMat m, const zVec v1, zVec v);
 __ZM_EXPORT zMat zMulMatMatNC(const zMat m1, const zMat m2, zMat m);
 __ZM_EXPORT zMat zMulMatMatTNC(const zMat m1, const zMat m2, zMat m);
 __ZM_EXPORT zMat zMulMatTMatNC(const zMat m1, const zMat m2, zMat m);
+__ZM_EXPORT zMat zMulMatMatThreadNC(const zMat m1, const zMat m2, zMat m, int num);
+__ZM_EXPORT zMat zMulMatMatTThreadNC(const zMat m1, const zMat m2, zMat m, int num);
+__ZM_EXPORT zMat zMulMatTMatThreadNC(const zMat m1, const zMat m2, zMat m, int num);
 
 __ZM_EXPORT zVec zMulMatVec(const zMat m, const zVec v1, zVec v);
 __ZM_EXPORT zVec zMulMatTVec(const zMat m, const zVec v1, zVec v);
@@ -536,12 +545,17 @@ __ZM_EXPORT zVec zMulMatTVecDRC(const zMat m, zVec v);
  *
  * zMatQuad() and zMatTQuad() check if the sizes of \a a, \a w and \a q are consistent, while neither
  * zMatQuadNC() nor zMatTQuadNC() do.
+ *
+ * zMatQuadThreadNC() is a multithreaded version of zMatQuadNC(), which runs on at most \a num threads.
+ * If \a num is zero or negative, the default number of threads zThreadNum() is applied, which is also
+ * the case of zMatQuadNC().
  * \return
- * zMatQuadNC() and zMatTQuadNC() return a pointer \a q.
+ * zMatQuadNC(), zMatQuadThreadNC() and zMatTQuadNC() return a pointer \a q.
  * zMatQuad() and zMatTQuad() also return a pointer \a q, if they succeed.
  * Otherwise, the null pointer is returned.
  */
 __ZM_EXPORT zMat zMatQuadNC(const zMat a, const zVec w, zMat q);
+__ZM_EXPORT zMat zMatQuadThreadNC(const zMat a, const zVec w, zMat q, int num);
 __ZM_EXPORT zMat zMatQuad(const zMat a, const zVec w, zMat q);
 __ZM_EXPORT zMat zMatTQuadNC(const zMat a, const zVec w, zMat q);
 __ZM_EXPORT zMat zMatTQuad(const zMat a, const zVec w, zMat q);
@@ -556,12 +570,17 @@ __ZM_EXPORT zMat zMatTQuad(const zMat a, const zVec w, zMat q);
  *
  * zMulMatMatMatT() and zMulMatTMatMat() check if the sizes of \a a, \a q and \a m are consistent, while
  * neither zMulMatMatMatTNC() nor zMulMatTMatMatNC() do.
+ *
+ * zMulMatMatMatTThreadNC() is a multithreaded version of zMulMatMatMatTNC(), which runs on at most
+ * \a num threads. If \a num is zero or negative, the default number of threads zThreadNum() is
+ * applied, which is also the case of zMulMatMatMatTNC().
  * \return
- * zMulMatMatMatTNC() and zMulMatTMatMatNC() return a pointer \a m.
+ * zMulMatMatMatTNC(), zMulMatMatMatTThreadNC() and zMulMatTMatMatNC() return a pointer \a m.
  * zMulMatMatMatT() and zMulMatTMatMat() also return a pointer \a m, if they succeed.
  * Otherwise, the null pointer is returned.
  */
 __ZM_EXPORT zMat zMulMatMatMatTNC(const zMat a, const zMat q, zMat m);
+__ZM_EXPORT zMat zMulMatMatMatTThreadNC(const zMat a, const zMat q, zMat m, int num);
 __ZM_EXPORT zMat zMulMatMatMatT(const zMat a, const zMat q, zMat m);
 __ZM_EXPORT zMat zMulMatTMatMatNC(const zMat a, const zMat q, zMat m);
 __ZM_EXPORT zMat zMulMatTMatMat(const zMat a, const zMat q, zMat m);
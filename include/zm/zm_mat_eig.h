@@ -97,6 +97,48 @@ __ZM_EXPORT bool zMatEig(const zMat m, zCVec eigval, zCMat eigbase, int iter);
 __ZM_EXPORT bool zMatSymEigBisec(const zMat m, zVec eigval, zMat eigbase);
 __ZM_EXPORT bool zMatSymEigJacobi(const zMat m, zVec eigval, zMat eigbase);
 
+/*! \brief tridiagonalize a symmetric matrix.
+ *
+ * zMatSymTridiag() transforms a symmetric matrix \a m to a tridiagonal matrix T = \a q ^T \a m \a q
+ * by Householder reflections, where \a q is an orthonormal matrix. The diagonal components of T are
+ * stored in \a d, and the subdiagonal components in \a e, namely, \a e[i] is the (i+1, i) component
+ * of T and the last component of \a e is set for zero. \a q can be the null pointer, in which case the
+ * orthonormal matrix is not formed.
+ * \return
+ * zMatSymTridiag() returns the false value if \a m is not square, sizes of \a m, \a d, \a e and \a q
+ * mismatch, or it fails to allocate internal working memory. Otherwise, the true value is returned.
+ */
+__ZM_EXPORT bool zMatSymTridiag(const zMat m, zVec d, zVec e, zMat q);
+
+/*! \brief diagonalize a symmetric matrix through tridiagonalization.
+ *
+ * zMatSymEigTridiag() diagonalizes a symmetric matrix \a m, namely, finds all eigenvalues and
+ * eigenvectors of it. \a m is tridiagonalized by zMatSymTridiag(), and then diagonalized by the
+ * implicit QL method with Wilkinson's shift, where plane rotations are applied to contiguous rows
+ * of the transpose of the transformation matrix. The eigenvalues are stored in \a eigval in ascending
+ * order, and the corresponding eigenvectors in columns of \a eigbase. Namely, the following equation
+ * holds:
+ *   \a m \a eigbase = \a eigbase diag{ \a eigval }
+ * If the null pointer is given for \a eigbase, only the eigenvalues are computed in O(n^2) operations
+ * after the tridiagonalization.
+ *
+ * zMatSymEigExtreme() finds only k extreme eigenvalues and eigenvectors of \a m, where k is the size
+ * of \a eigval. If \a largest is the true value, k largest eigenvalues are stored in \a eigval in
+ * descending order. Otherwise, k smallest ones are stored in ascending order. The eigenvalues are
+ * found by bisection on the Sturm sequence of the tridiagonal matrix, and the eigenvectors are found
+ * by inverse iteration on the tridiagonal matrix followed by the back transformation with the
+ * Householder reflectors. \a eigbase has to be a n x k matrix, where n is the size of \a m, or can
+ * be the null pointer if the eigenvectors are not needed.
+ * \return
+ * zMatSymEigTridiag() and zMatSymEigExtreme() return the false value if \a m is not square, sizes of
+ * \a m, \a eigval and \a eigbase mismatch, or they fail to allocate internal working memory.
+ * Otherwise, they return the true value.
+ * \notes
+ * When \a m is not symmetric, those functions do not work as expected.
+ */
+__ZM_EXPORT bool zMatSymEigTridiag(const zMat m, zVec eigval, zMat eigbase);
+__ZM_EXPORT bool zMatSymEigExtreme(const zMat m, bool largest, zVec eigval, zMat eigbase);
+
 /* singular value decomposition */
 
 /*! \brief singular value decomposition (SVD).
@@ -105,8 +147,10 @@ __ZM_EXPORT bool zMatSymEigJacobi(const zMat m, zVec eigval, zMat eigbase);
  *   \a m = \a u s \a v.
  * where \a u and \a v are orthonormal matrices and s is a diagonal matrix. Note that, different from
  * the standard SVD from, \a v is defined in non-transposed form.
- * The diagonal components of s are so-called singular values, which are stored in a vector \a sv.
- * The number of non-zero singular values coincides with the rank of \a m.
+ * The diagonal components of s are so-called singular values, which are stored in a vector \a sv in
+ * descending order. The number of non-zero singular values coincides with the rank of \a m.
+ * It is based on the Golub-Kahan-Reinsch method, namely, \a m is bidiagonalized by Householder
+ * reflections and then diagonalized by the implicit QR method.
  *
  * The original sizes of each matrix have to be
  *  \a sv: n x 1
@@ -114,14 +158,49 @@ __ZM_EXPORT bool zMatSymEigJacobi(const zMat m, zVec eigval, zMat eigbase);
  *  \a v: n x m,
  * respectively. However, the row size of \a v possibly changes after the function call, due to the rank
  * regression.
+ * Instead, \a u can be n x k and \a sv can be k x 1, where k is the smaller one of n and m, so that only
+ * the thin SVD is computed.
  * \return
- * zMatSVD() returns the rank of \a m, namely, the number of non-zero singular values of \a m.
+ * zMatSVD() returns the rank of \a m, namely, the number of non-zero singular values of \a m, or -1 if
+ * sizes mismatch or it fails to allocate internal working memory.
  */
 __ZM_EXPORT int zMatSVD(const zMat m, zMat u, zVec sv, zMat v);
 
 /*! \def tolerance to discard too small singular values. */
 #define ZM_MAT_SVD_TOL ( 1.0e-6 )
 
+/*! \brief singular values of a matrix.
+ *
+ * zMatSingularValue() computes only singular values of a matrix \a m without singular vectors, and
+ * stores them into \a sv in descending order. The size of \a sv has to be the smaller one of the row
+ * and column sizes of \a m. If \a m is far from square, it is reduced to the triangular factor of LQ
+ * decomposition by zLQFactoDecomp() in advance.
+ * \return
+ * zMatSingularValue() returns a pointer \a sv, or the null pointer if the size of \a sv is wrong or it
+ * fails to allocate internal working memory.
+ */
+__ZM_EXPORT zVec zMatSingularValue(const zMat m, zVec sv);
+
+/*! \brief default oversampling and number of power iterations of the randomized SVD. */
+#define ZM_MAT_SVD_RAND_OVERSAMPLE 10
+#define ZM_MAT_SVD_RAND_POWER       2
+
+/*! \brief randomized truncated singular value decomposition.
+ *
+ * zMatSVDRand() computes k largest singular values and the corresponding singular vectors of a matrix
+ * \a m, where k is the size of \a sv, in the same form with zMatSVD(), namely, \a m is approximated by
+ * \a u s \a v. \a u and \a v have to be n x k and k x m matrices, respectively, or can be the null
+ * pointer if not needed.
+ * The range of \a m is found by multiplying \a m by k + \a oversample random vectors and \a power
+ * times of power iterations with reorthonormalization, and the SVD of the small matrix projected onto
+ * the range is computed. If \a oversample or \a power is negative, ZM_MAT_SVD_RAND_OVERSAMPLE or
+ * ZM_MAT_SVD_RAND_POWER is used, respectively.
+ * \return
+ * zMatSVDRand() returns the number of non-zero singular values found, or -1 if sizes mismatch or it
+ * fails to allocate internal working memory.
+ */
+__ZM_EXPORT int zMatSVDRand(const zMat m, int oversample, int power, zMat u, zVec sv, zMat v);
+
 /*! \brief maximum singular value of a matrix.
  */
 __ZM_EXPORT double zMatSingularValueMax(const zMat m);
@@ -131,6 +210,9 @@ __ZM_EXPORT double zMatSingularValueMax(const zMat m);
 __ZM_EXPORT double zMatSingularValueMin(const zMat m);
 
 /*! \brief condition number of a matrix.
+ *
+ * zMatSingularValueMax(), zMatSingularValueMin() and zMatCondNum() use zMatSingularValue(), which
+ * does not compute singular vectors.
  */
 __ZM_EXPORT double zMatCondNum(const zMat m);
 
@@ -59,6 +59,13 @@ typedef struct _zNLE{
  */
 __ZM_EXPORT zNLE *zNLECreate(zNLE *nle, int nv, int ne, double scale, zVec (*f)(const zVec,zVec,void*), zMat (*jac)(const zVec,zMat,void*));
 
+/*! \brief create simultaneous nonlinear equations solver on an arena.
+ *
+ * zNLECreateArena() is the same with zNLECreate() except that workspace of \a nle is carved from
+ * \a arena. zNLEDestroy() leaves the workspace to the arena.
+ */
+__ZM_EXPORT zNLE *zNLECreateArena(zNLE *nle, int nv, int ne, double scale, zVec (*f)(const zVec,zVec,void*), zMat (*jac)(const zVec,zMat,void*), zArena *arena);
+
 /*! \brief destroy a simultaneous nonlinear equation solver.
  *
  * zNLEDestroy() destroys a solver instance \a nle.
@@ -7,7 +7,7 @@
 #ifndef __ZM_ODE_H__
 #define __ZM_ODE_H__
 
-#include <zm/zm_vec.h>
+#include <zm/zm_arena.h>
 
 __BEGIN_DECLS
 
@@ -19,8 +19,10 @@ ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODE ){
   zODE *(* create)(zODE*,int,int,zVec (*)(double,zVec,void*,zVec));
   void (* destroy)(zODE*);
   zVec (* update)(zODE*,double,zVec,double,void*);
+  zVec (* dense)(zODE*,double,zVec,void*);
   zVec (* cat)(zVec,double,zVec,zVec,void*);
   zVec (* sub)(zVec,zVec,zVec,void*);
+  zArena *arena; /* arena for workspace */
   void *_ws; /* workspace for utility */
   zVec _x1, _x2; /* workspace for deferred correction */
 };
@@ -31,18 +33,37 @@ ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODE ){
   (ode)->create = NULL; \
   (ode)->destroy = NULL; \
   (ode)->update = NULL; \
+  (ode)->dense = NULL; \
   (ode)->cat = NULL; \
   (ode)->sub = NULL; \
+  (ode)->arena = NULL; \
   (ode)->_ws = NULL; \
   (ode)->_x1 = (ode)->_x2 = NULL; \
 } while(0)
 
+/*! \brief assign an arena to an ODE solver.
+ *
+ * zODESetArena() assigns an arena \a arena to an ODE solver \a ode, from which workspace of the solver
+ * is carved by zODECreate() instead of being allocated on the heap. It has to be called after
+ * zODEAssign(), which resets the arena, and before zODECreate(). Currently, the embedded Runge-Kutta
+ * family and the Rosenbrock-W method support it, and the others ignore it.
+ */
+#define zODESetArena(ode,a) ( (ode)->arena = (a) )
+
 /*! \brief concatenate deviation in finite time step to the current variable vector.
  * no need to call this function in user's codes.
  */
 __ZM_EXPORT zVec _zODECatDefault(zVec x, double dt, zVec dx, zVec xn, void *util);
 __ZM_EXPORT zVec _zODESubDefault(zVec x1, zVec x2, zVec dx, void *util);
 
+/*! \brief fused linear combination of stages.
+ * _zODEStageSum() computes \a xs = \a x + \a dt sum_j \a a[j] \a k_j for j = 0, ..., \a n-1 in one pass,
+ * where k_j is the j-th row of \a k in a contiguous \a n x \a dim buffer. \a xs can be \a x.
+ * It is the fast path of Runge-Kutta methods used instead of \a cat if it is the default one.
+ * no need to call this function in user's codes.
+ */
+__ZM_EXPORT void _zODEStageSum(const double *x, double dt, const double *a, const double *k, int n, int dim, double *xs);
+
 /*! \brief assign concatenation and subtraction functions to an ODE solver. */
 __ZM_EXPORT void zODEAssignFunc(zODE *ode, zVec (* catf)(zVec,double,zVec,zVec,void*), zVec (* subf)(zVec,zVec,zVec,void*));
 
@@ -63,6 +84,7 @@ __ZM_EXPORT void zODEAssignFunc(zODE *ode, zVec (* catf)(zVec,double,zVec,zVec,v
  *  'Gauss' for Gauss method (implicit Runge-Kutta,2:4 method)
  *  'Radau' for Radau method (implicit Runge-Kutta,2:4 method)
  *  'Gear' for Gear's method
+ *  'Ros34' for Rosenbrock-W method (linearly implicit Runge-Kutta,4:3 method) for stiff systems
  * \sa
  * zODECreate, zODEDestroy, zODEUpdate
  */
@@ -70,6 +92,8 @@ __ZM_EXPORT void zODEAssignFunc(zODE *ode, zVec (* catf)(zVec,double,zVec,zVec,v
   (ode)->create = zODECreate##type;\
   (ode)->destroy = zODEDestroy##type;\
   (ode)->update = zODEUpdate##type;\
+  (ode)->dense = zODEDense##type;\
+  (ode)->arena = NULL;\
   zODEAssignFunc( ode, catf, subf );\
 } while(0)
 
@@ -101,6 +125,43 @@ __ZM_EXPORT void zODEAssignFunc(zODE *ode, zVec (* catf)(zVec,double,zVec,zVec,v
 #define zODEDestroy(ode)           do{ if( (ode)->destroy ) (ode)->destroy( ode ); } while(0)
 #define zODEUpdate(ode,t,x,dt,u)   (ode)->update( ode, t, x, dt, u )
 
+/*! \brief dense output of an ordinary differential equation quadrature.
+ *
+ * zODEDense() computes the state at time \a t in the last step of \a ode taken by zODEUpdate(),
+ * and puts it into \a x, so that states at arbitrary sample times are obtained without shortening
+ * the step. \a util is for programmer s utility, which is passed to the differential function.
+ * RK4 uses its third-order continuous extension, and DP45 the fourth-order one by Shampine, both of
+ * which are computed only from the stages. The other methods use the cubic Hermite
+ * interpolation of the states and the derivatives at the head and the tail of the step, which costs
+ * at most two evaluations of the differential function for the first call in a step; the derivative
+ * at the tail of a step is reused at the head of the next step if the state is continued.
+ * For RKF45, CK45 and DP45, whose zODEUpdate() splits a step internally if the error is large,
+ * the last step means the last split one.
+ * \return
+ * zODEDense() returns a pointer \a x, or the null pointer if \a t is out of the last step.
+ */
+#define zODEDense(ode,t,x,u)       (ode)->dense( ode, t, x, u )
+
+/*! \struct zODEHermite
+ * \brief cubic Hermite interpolation in a step for dense output.
+ * no need to use it in user's codes.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEHermite ){
+  double t0, t1;          /* head and tail time of the step */
+  zVec x0, x1;            /* states at the head and the tail of the step */
+  zVec f0, f1;            /* derivatives at the head and the tail of the step */
+  bool f0_valid, f1_valid;
+  zVec _dx;
+};
+
+__ZM_EXPORT zODEHermite *_zODEHermiteAlloc(zODEHermite *h, int dim, zArena *arena);
+__ZM_EXPORT void _zODEHermiteFree(zODEHermite *h, zArena *arena);
+/* set the head of a step. \a f can be the null pointer, which is computed lazily. */
+__ZM_EXPORT void _zODEHermiteSetHead(zODEHermite *h, double t, const zVec x, const zVec f);
+/* set the tail of a step. \a f can be the null pointer, which is computed lazily. */
+__ZM_EXPORT void _zODEHermiteSetTail(zODEHermite *h, double t, const zVec x, const zVec f);
+__ZM_EXPORT zVec _zODEHermiteEval(zODE *ode, zODEHermite *h, double t, zVec x, void *util);
+
 __END_DECLS
 
 #include <zm/zm_ode_dc.h>    /* deferred correction */
@@ -118,7 +179,16 @@ __END_DECLS
 #include <zm/zm_ode_bk4.h>   /* <Gauss>: Gauss method
                                 <Radau>: Radau method */
 #include <zm/zm_ode_gear.h>  /* <Gear>: Gear method */
+#include <zm/zm_ode_ros.h>   /* <Ros34>: Rosenbrock-W method */
+#include <zm/zm_ode_imex.h>  /* implicit-explicit additive Runge-Kutta method */
+#include <zm/zm_ode_mr.h>    /* multirate method */
+
+#include <zm/zm_ode_ens.h>   /* batched integration of an ensemble */
+#include <zm/zm_ode_raw.h>   /* allocation-free solver on raw arrays */
+#include <zm/zm_ode_parareal.h> /* parallel-in-time integration */
 
 #include <zm/zm_ode2.h> /* second-order differential equation solver */
 
+#include <zm/zm_ode_event.h> /* event detection */
+
 #endif /* __ZM_ODE_H__ */
@@ -25,8 +25,12 @@ ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODE2 ){
   zVec (* sub_dis)(zVec,zVec,zVec,void*);
   zVec (* sub_vel)(zVec,zVec,zVec,void*);
   void *util;  /* workspace for utility */
+  int iter;    /* maximum number of fixed-point iterations of velocity-dependent forces */
+  double tol;  /* tolerance of fixed-point iterations */
   zODE _ode;   /* need for regular solution */
-  zVec _x, _v, _a; /* working memory */
+  zVec _x, _v, _a, _a2; /* working memory */
+  double _t;   /* time at which _a is valid for _x */
+  bool _a_valid;
 };
 
 /*! \brief initialize a second-order ODE solver. */
@@ -40,8 +44,12 @@ ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODE2 ){
   (ode)->sub_dis = NULL; \
   (ode)->sub_vel = NULL; \
   (ode)->util = NULL; \
+  (ode)->iter = 0; \
+  (ode)->tol = 0; \
   zODEInit( &(ode)->_ode ); \
-  (ode)->_x = (ode)->_v = (ode)->_a = NULL; \
+  (ode)->_x = (ode)->_v = (ode)->_a = (ode)->_a2 = NULL; \
+  (ode)->_t = 0; \
+  (ode)->_a_valid = false; \
 } while(0)
 
 /*! \brief assign concatenation and subtraction functions to a second-order ODE solver. */
@@ -52,7 +60,7 @@ __ZM_EXPORT void zODE2AssignFunc(zODE2 *ode, zVec (* catf1)(zVec,double,zVec,zVe
  * zODE2Assign() assigns a numerical solver for a second-order ordinary differential equation to \a ode.
  * \a type1 is an identifier of the method. See zODEAssign().
  * \a type2 is an identifier of the particular method for second-order differential equation, where
- *  'Regular', 'Sympl' and 'Leapfrog' are available.
+ *  'Regular', 'Symplectic', 'Leapfrog', 'Verlet', 'Yoshida4', 'Yoshida6' and 'ForestRuth' are available.
  * \sa
  * zODEAssign, zODE2Create, zODE2Destroy, zODE2Update
  */
@@ -110,6 +118,52 @@ __ZM_EXPORT void zODE2InitHistoryLeapfrog(zODE2 *ode, zVec x, zVec v, double dt)
 __ZM_EXPORT void zODE2DestroyLeapfrog(zODE2 *ode);
 __ZM_EXPORT void zODE2UpdateLeapfrog(zODE2* ode, double t, zVec x, zVec v, double dt, void *util);
 
+/*! \brief default maximum number of fixed-point iterations of symplectic splitting methods. */
+#define ZODE2_ITER_NUM 10
+
+/*! \brief symplectic splitting methods.
+ *
+ * 'Verlet' is the Stormer-Verlet method in the velocity (kick-drift-kick) form, which is extended to
+ * velocity-dependent forces by the generalized Stormer-Verlet scheme as
+ *  v_(i+1/2) = v_(i) + 0.5dt * a( t_(i), x_(i), v_(i+1/2) ),
+ *  x_(i+1) = x_(i) + dt * v_(i+1/2),
+ *  v_(i+1) = v_(i+1/2) + 0.5dt * a( t_(i+1), x_(i+1), v_(i+1/2) ).
+ * The first half kick is implicit, and is solved by a fixed-point iteration started from the
+ * acceleration at the tail of the previous step.
+ *
+ * 'Yoshida4' and 'Yoshida6' are the fourth- and sixth-order methods by H. Yoshida (1990) which compose
+ * 'Verlet' of three and seven substeps, respectively. 'ForestRuth' is the fourth-order method by
+ * E. Forest and R. D. Ruth (1990) which composes the Stormer-Verlet method in the position
+ * (drift-kick-drift) form of three substeps, where a kick is solved by the implicit midpoint rule for
+ * velocity-dependent forces.
+ *
+ * All of them are time-symmetric and are symplectic for Hamiltonian systems, so that the energy error
+ * stays bounded over long-duration integration with larger steps than those of 'Regular'.
+ *
+ * \a ode->iter is the maximum number of fixed-point iterations of a kick, which is ZODE2_ITER_NUM by
+ * default, and \a ode->tol is the tolerance of the change of velocity, which is zTOL by default. They are
+ * set by zODE2SetFixedPoint(). If \a iter is zero, kicks are explicitly computed with the acceleration
+ * at the head of each kick, which only suits for velocity-independent forces; it saves one evaluation
+ * of the second-order differential function per substep.
+ */
+__ZM_EXPORT zODE2 *zODE2CreateVerlet(zODE2 *ode, int dim, int step, zVec (* f)(double,zVec,zVec,void*,zVec));
+__ZM_EXPORT void zODE2DestroyVerlet(zODE2 *ode);
+__ZM_EXPORT void zODE2UpdateVerlet(zODE2* ode, double t, zVec x, zVec v, double dt, void *util);
+__ZM_EXPORT void zODE2UpdateYoshida4(zODE2* ode, double t, zVec x, zVec v, double dt, void *util);
+__ZM_EXPORT void zODE2UpdateYoshida6(zODE2* ode, double t, zVec x, zVec v, double dt, void *util);
+__ZM_EXPORT void zODE2UpdateForestRuth(zODE2* ode, double t, zVec x, zVec v, double dt, void *util);
+#define zODE2CreateYoshida4   zODE2CreateVerlet
+#define zODE2DestroyYoshida4  zODE2DestroyVerlet
+#define zODE2CreateYoshida6   zODE2CreateVerlet
+#define zODE2DestroyYoshida6  zODE2DestroyVerlet
+#define zODE2CreateForestRuth  zODE2CreateVerlet
+#define zODE2DestroyForestRuth zODE2DestroyVerlet
+
+#define zODE2SetFixedPoint(ode,n,t) do{ \
+  (ode)->iter = (n); \
+  (ode)->tol = (t); \
+} while(0)
+
 __END_DECLS
 
 #endif /* __ZM_ODE2_H__ */
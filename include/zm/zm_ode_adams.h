@@ -16,6 +16,7 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateAdams(zODE *ode, int dim, int step, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyAdams(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateAdams(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseAdams(zODE *ode, double t, zVec x, void *util);
 
 __END_DECLS
 
@@ -16,11 +16,13 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateBEuler(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyBEuler(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateBEuler(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseBEuler(zODE *ode, double t, zVec x, void *util);
 
 /* trapezoidal formula method - A-stable implicit solutions. */
 #define zODECreateTR zODECreateBEuler
 #define zODEDestroyTR zODEDestroyBEuler
 __ZM_EXPORT zVec zODEUpdateTR(zODE *ode, double t, zVec x, double dt, void *util);
+#define zODEDenseTR zODEDenseBEuler
 
 __END_DECLS
 
@@ -18,6 +18,7 @@ __BEGIN_DECLS
  */
 __ZM_EXPORT zODE *zODECreateBK4(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyBK4(zODE *ode);
+__ZM_EXPORT zVec zODEDenseBK4(zODE *ode, double t, zVec x, void *util);
 
 /* 'BK4' is a dummy keyword, since Butcher-Kuntzmann method is a general framework.
  * As body implementations of solvers, 'Gauss' and 'Radau' are prepared. */
@@ -26,11 +27,13 @@ __ZM_EXPORT void zODEDestroyBK4(zODE *ode);
 #define zODECreateGauss  zODECreateBK4
 #define zODEDestroyGauss zODEDestroyBK4
 __ZM_EXPORT zVec zODEUpdateGauss(zODE *ode, double t, zVec x, double dt, void *util);
+#define zODEDenseGauss   zODEDenseBK4
 
 /* Radau method */
 #define zODECreateRadau  zODECreateBK4
 #define zODEDestroyRadau zODEDestroyBK4
 __ZM_EXPORT zVec zODEUpdateRadau(zODE *ode, double t, zVec x, double dt, void *util);
+#define zODEDenseRadau   zODEDenseBK4
 
 __END_DECLS
 
@@ -2,12 +2,15 @@
  * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
  *
  * zm_ode_dc - ordinary differential equation quadrature:
- * deferred correction with Richardson's extrapolation.
+ * deferred correction with Richardson's extrapolation and
+ * revisionist integral deferred correction.
  */
 
 #ifndef __ZM_ODE_DC_H__
 #define __ZM_ODE_DC_H__
 
+#include <zm/zm_thread.h>
+
 __BEGIN_DECLS
 
 /* Deferred correction with Rechardson's extrapolation */
@@ -15,6 +18,85 @@ __ZM_EXPORT zODE *zODECreateDC(zODE *ode, int dim, int step, zVec (* f)(double,z
 __ZM_EXPORT void zODEDestroyDC(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateDC(zODE *ode, double t, zVec x, double dt, void *util);
 
+/*! \struct zODERIDC
+ * \brief revisionist integral deferred correction (RIDC).
+ *
+ * zODERIDC integrates a \a dim-dimensional differential equation \a f with the forward Euler
+ * method as the predictor, of which the error is removed by \a level correction sweeps, each of
+ * which is also the forward Euler method applied to the error equation. The integral of the
+ * differential function in the error equation is computed by the Lagrange interpolation of the
+ * result of the preceding sweep, the order of which rises by one for each sweep, so that the order
+ * of the method is \a level + 1.
+ *
+ * The k-th sweep at a node depends only on the (k-1)-th one at the nodes up to the next, which
+ * allows the predictor and the sweeps to run on different threads in a pipeline; after a start-up
+ * delay of a few nodes per level, all levels proceed simultaneously. The time span is split into
+ * blocks of at most \a block steps, each of which is pipelined in turn, and the workspace is kept
+ * only for a block. At most \a thread_num threads of the default thread pool are used; if it is zero,
+ * the default number of threads zThreadNum() is applied. The result does not depend on the number
+ * of threads.
+ *
+ * \a cat is a function to concatenate a state and its derivative in the same way with that of
+ * zODE, which is the plain addition by default. \a f and \a cat are called from multiple threads
+ * simultaneously, so that they must not modify data shared through the utility pointer.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODERIDC ){
+  int dim;        /*!< dimension of a state */
+  int level;      /*!< number of correction sweeps */
+  int block;      /*!< maximum number of steps of a block */
+  int thread_num; /*!< maximum number of threads */
+  zVec (* f)(double,zVec,void*,zVec);                  /*!< differential function */
+  zVec (* cat)(zVec,double,zVec,zVec,void*);            /*!< concatenate function */
+  /*! \cond */
+  double *_w;              /* quadrature weights */
+  double *_fbuf;           /* derivatives of all levels at nodes of a block */
+  zVecStruct *_fv;         /* vector views of _fbuf */
+  zVec *_x, *_d;           /* states and increments of levels */
+  zThreadCounter *_count;  /* number of nodes at which derivatives are available for each level */
+  /* current block */
+  double _t, _h;
+  int _n;
+  void *_util;
+  /*! \endcond */
+};
+
+/*! \brief default maximum number of steps of a block of RIDC. */
+#define ZODE_RIDC_BLOCK 100
+
+/*! \brief create and destroy a RIDC solver.
+ *
+ * zODERIDCCreate() creates a RIDC solver \a ridc with \a level correction sweeps for a
+ * \a dim-dimensional differential equation \a f. \a block is the maximum number of steps of a
+ * block, which is reset for twice \a level if it is less than that; if it is zero, ZODE_RIDC_BLOCK
+ * is applied. All workspace is allocated at once, so that no allocation happens during integration.
+ *
+ * zODERIDCDestroy() destroys \a ridc.
+ *
+ * zODERIDCSetThreadNum() sets the maximum number of threads of \a ridc for \a num.
+ * zODERIDCSetCat() sets the concatenate function of \a ridc for \a c.
+ * \return
+ * zODERIDCCreate() returns a pointer \a ridc, or the null pointer if \a level is negative or it
+ * fails to allocate memory.
+ *
+ * zODERIDCDestroy() returns no value.
+ */
+__ZM_EXPORT zODERIDC *zODERIDCCreate(zODERIDC *ridc, int dim, int level, int block, zVec (* f)(double,zVec,void*,zVec));
+__ZM_EXPORT void zODERIDCDestroy(zODERIDC *ridc);
+#define zODERIDCSetThreadNum(ridc,num) ( (ridc)->thread_num = (num) )
+#define zODERIDCSetCat(ridc,c)         ( (ridc)->cat = (c) )
+
+/*! \brief integrate an ordinary differential equation by RIDC.
+ *
+ * zODERIDCIntegrate() integrates a state \a x from time \a t to \a tend by a RIDC solver \a ridc
+ * with equal steps not larger than \a dt. The number of steps is at least the number of correction
+ * sweeps of \a ridc, and each block has at least as many steps.
+ * \a util is a utility pointer passed to the differential function.
+ * \return
+ * zODERIDCIntegrate() returns a pointer \a x, or the null pointer if the size of \a x mismatches or
+ * \a dt is not positive.
+ */
+__ZM_EXPORT zVec zODERIDCIntegrate(zODERIDC *ridc, double t, zVec x, double tend, double dt, void *util);
+
 __END_DECLS
 
 #endif /* __ZM_ODE_DC_H__ */
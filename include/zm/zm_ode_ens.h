@@ -0,0 +1,97 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_ens - ordinary differential equation quadrature:
+ * batched integration of an ensemble of initial states.
+ */
+
+#ifndef __ZM_ODE_ENS_H__
+#define __ZM_ODE_ENS_H__
+
+/* NOTE: never include this header file in user programs. */
+
+#include <zm/zm_thread.h>
+
+__BEGIN_DECLS
+
+/*! \struct zODEEns
+ * \brief ensemble solver of an ordinary differential equation.
+ *
+ * zODEEns integrates \a num states of a \a dim-dimensional differential equation at once. The states
+ * are stored in a \a dim x \a num matrix in the structure-of-arrays layout, namely, the j-th column is
+ * the state of the j-th member, and the i-th row holds the i-th components of all members
+ * contiguously. The differential function is evaluated for a batch of members as
+ * \a f(t, x, from, to, util, dx), which has to compute the columns [ \a from, \a to ) of \a dx from
+ * those of \a x, where the time of the j-th member is the j-th element of \a t. The other columns
+ * must not be touched, since batches are processed on multiple threads simultaneously. The member
+ * index j is available to look up member-wise parameters through \a util.
+ *
+ * The members are split into chunks of \a grain members, each of which is advanced over a whole step
+ * by one thread. At most \a thread_num threads of the default thread pool are used; if it is zero,
+ * the default number of threads zThreadNum() is applied.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEEns ){
+  int dim;        /*!< dimension of a state */
+  int num;        /*!< number of members */
+  zMat (* f)(const zVec,const zMat,int,int,void*,zMat); /*!< batched differential function */
+  int thread_num; /*!< maximum number of threads */
+  int grain;      /*!< number of members of a chunk */
+  /*! \cond */
+  zVec _t, _ts, _h, _dt;    /* member-wise time, time of a stage, step size and trial step size */
+  zVec _err_prev;           /* member-wise error norm of the previous step */
+  zMat _xc, _k[7];          /* intermediate states and stages */
+  int *_step_num, *_reject_num, *_state;
+  /*! \endcond */
+};
+
+/*! \brief default number of members of a chunk. */
+#define ZODE_ENS_GRAIN 64
+
+/*! \brief create and destroy an ensemble ODE solver.
+ *
+ * zODEEnsCreate() creates an ensemble solver \a ens of \a num members of a \a dim-dimensional
+ * differential equation defined by a batched differential function \a f. All workspace is allocated
+ * at once, so that no allocation happens during integration.
+ *
+ * zODEEnsDestroy() destroys \a ens.
+ *
+ * zODEEnsSetThreadNum() sets the maximum number of threads of \a ens for \a num.
+ * \return
+ * zODEEnsCreate() returns a pointer \a ens, or the null pointer if it fails to allocate memory.
+ *
+ * zODEEnsDestroy() returns no value.
+ */
+__ZM_EXPORT zODEEns *zODEEnsCreate(zODEEns *ens, int dim, int num, zMat (* f)(const zVec,const zMat,int,int,void*,zMat));
+__ZM_EXPORT void zODEEnsDestroy(zODEEns *ens);
+#define zODEEnsSetThreadNum(ens,n) ( (ens)->thread_num = (n) )
+
+/*! \brief batched integration of an ensemble.
+ *
+ * zODEEnsUpdateRK4() advances all members of \a x, a \a dim x \a num matrix of the states at time
+ * \a t, by a step \a dt with the classical Runge-Kutta method.
+ *
+ * zODEEnsIntegrateAdaptDP45() integrates all members of \a x from \a t to \a tend with adaptive steps
+ * of Dormand-Prince method. Each member has its own step size, which is controlled by \a ctrl in the
+ * same way with zODEStepAdaptERK(), so that a member in a mild region is not slowed down by those in
+ * a harsh region. The trial step size \a ctrl->dt is applied to all members at the first step; if it is
+ * zero, it is estimated member by member. The numbers of accepted and rejected steps and evaluations
+ * of the differential function of all members are added to \a ctrl->step_num, \a ctrl->reject_num and
+ * \a ctrl->eval_num, respectively, where the evaluations for a finished member are not counted. After
+ * the integration, \a ctrl->dt is the smallest one of the trial step sizes proposed for the members.
+ * A finished member stays at \a tend with a null step until the other members in the same chunk finish.
+ *
+ * \a util is a utility pointer passed to the differential function.
+ * \return
+ * zODEEnsUpdateRK4() returns a pointer \a x, or the null pointer if the size of \a x mismatches.
+ *
+ * zODEEnsIntegrateAdaptDP45() returns a pointer \a x. If the size of \a x mismatches, or if the step
+ * size of any member required by the tolerances gets less than the minimum, it returns the null pointer.
+ * \sa
+ * zODEAdaptCtrl, zODEStepAdaptERK
+ */
+__ZM_EXPORT zMat zODEEnsUpdateRK4(zODEEns *ens, double t, zMat x, double dt, void *util);
+__ZM_EXPORT zMat zODEEnsIntegrateAdaptDP45(zODEEns *ens, zODEAdaptCtrl *ctrl, double t, zMat x, double tend, void *util);
+
+__END_DECLS
+
+#endif /* __ZM_ODE_ENS_H__ */
@@ -19,16 +19,113 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateRKF45(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyRKF45(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateRKF45(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseRKF45(zODE *ode, double t, zVec x, void *util);
 
 /* Cash-Karp method is forth-dimension-embedded six-step fifth-dimension Runge-Kutta method. */
 __ZM_EXPORT zODE *zODECreateCK45(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyCK45(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateCK45(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseCK45(zODE *ode, double t, zVec x, void *util);
 
 /* Dormand-Prince method is forth-dimension-embedded seven-step fifth-dimension Runge-Kutta method. */
 __ZM_EXPORT zODE *zODECreateDP45(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyDP45(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateDP45(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseDP45(zODE *ode, double t, zVec x, void *util);
+
+/*! \brief Butcher tableau of Dormand-Prince method.
+ * _zODE_DP45_a is the lower-triangular stage coefficients packed row by row, _zODE_DP45_b4 and
+ * _zODE_DP45_b5 are the weights of the fourth- and fifth-order estimations, and _zODE_DP45_c is
+ * the abscissae of the second and later stages.
+ * no need to refer these in user's codes.
+ */
+__ZM_EXPORT const double _zODE_DP45_a[];
+__ZM_EXPORT const double _zODE_DP45_b4[];
+__ZM_EXPORT const double _zODE_DP45_b5[];
+__ZM_EXPORT const double _zODE_DP45_c[];
+
+/*! \struct zODEAdaptCtrl
+ * \brief adaptive step size controller of embedded Runge-Kutta methods.
+ *
+ * The local error of a step is estimated by the difference between the lower- and higher-order
+ * estimations, and is measured by the root mean square of its components scaled by
+ * \a atol + \a rtol max( |x_i|, |x'_i| ), where x and x' are the states at the head and the tail of
+ * the step. A step with the error norm more than one is rejected and retried with a smaller step size.
+ * For an accepted step, the next step size is proposed by the proportional-integral controller as
+ *   dt' = dt \a safety err^-\a alpha err_prev^\a beta,
+ * where err_prev is the error norm of the previous accepted step, and the ratio dt'/dt is limited
+ * within [ \a fac_min, \a fac_max ] (not more than one just after rejections).
+ *
+ * \a dt is the trial step size of the next step. If it is zero, it is estimated from the derivative
+ * at the initial state by Hairer's algorithm. \a step_num, \a reject_num and \a eval_num count the
+ * accepted steps, the rejected steps and the evaluations of the differential function, respectively.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEAdaptCtrl ){
+  double atol, rtol;       /*!< absolute and relative tolerances */
+  double dt_min, dt_max;   /*!< minimum and maximum step sizes */
+  double safety;           /*!< safety factor */
+  double fac_min, fac_max; /*!< minimum and maximum ratios of step sizes */
+  double alpha, beta;      /*!< gains of the PI controller */
+  double dt;               /*!< trial step size of the next step */
+  int step_num;            /*!< number of accepted steps */
+  int reject_num;          /*!< number of rejected steps */
+  int eval_num;            /*!< number of evaluations of the differential function */
+  /*! \cond */
+  double _err_prev; /* error norm of the previous accepted step */
+  /*! \endcond */
+};
+
+/*! \brief initialize an adaptive step size controller.
+ *
+ * zODEAdaptCtrlInit() initializes an adaptive step size controller \a ctrl with the default values,
+ * where both tolerances are 1.0e-6, the step sizes are not limited, the safety factor is 0.9,
+ * the ratio of step sizes is within [0.2, 10], and the gains of the PI controller are 0.17 and 0.04.
+ * The trial step size is set for zero to be estimated automatically.
+ *
+ * zODEAdaptCtrlSetTol() sets the absolute and relative tolerances \a atol and \a rtol of \a ctrl.
+ * \return
+ * zODEAdaptCtrlInit() and zODEAdaptCtrlSetTol() return a pointer \a ctrl.
+ */
+__ZM_EXPORT zODEAdaptCtrl *zODEAdaptCtrlInit(zODEAdaptCtrl *ctrl);
+__ZM_EXPORT zODEAdaptCtrl *zODEAdaptCtrlSetTol(zODEAdaptCtrl *ctrl, double atol, double rtol);
+
+/*! \brief adaptive integration by embedded Runge-Kutta methods.
+ *
+ * zODEStepAdaptERK() advances a state \a x at time \a t by one accepted step of an ODE solver \a ode,
+ * to which one of RKF45, CK45 and DP45 has to be assigned, with the step size controlled by \a ctrl.
+ * The step does not go beyond \a tend, which can be smaller than \a t to integrate backward. \a t is
+ * updated to the time at the tail of the step. The higher-order estimation is propagated. If \a x is
+ * the one returned by the last call, the derivative at the tail of the last step is reused for the
+ * first stage, which is free for DP45 owing to the first-same-as-last property.
+ *
+ * zODEIntegrateAdaptERK() integrates \a x from \a t to \a tend by repeating zODEStepAdaptERK().
+ *
+ * zODEDenseAdaptERK() computes the state at time \a t in the last accepted step by the continuous
+ * extension, and puts it into \a x. The fourth-order extension by Shampine is used for DP45, and
+ * the cubic Hermite interpolation for RKF45 and CK45, which evaluates the differential function at
+ * the tail of the step once to be reused by the next step. It also works after zODEUpdate(), which
+ * is equivalent to zODEDense().
+ *
+ * \a util is a utility pointer passed to the differential function.
+ * \return
+ * zODEStepAdaptERK() and zODEIntegrateAdaptERK() return a pointer \a x. If the step size required
+ * by the tolerances gets less than the minimum, a warning is shown and the null pointer is returned.
+ *
+ * zODEDenseAdaptERK() returns a pointer \a x, or the null pointer if \a t is out of the last step.
+ */
+__ZM_EXPORT zVec zODEStepAdaptERK(zODE *ode, zODEAdaptCtrl *ctrl, double *t, zVec x, double tend, void *util);
+__ZM_EXPORT zVec zODEIntegrateAdaptERK(zODE *ode, zODEAdaptCtrl *ctrl, double t, zVec x, double tend, void *util);
+__ZM_EXPORT zVec zODEDenseAdaptERK(zODE *ode, double t, zVec x, void *util);
+
+/*! \brief check if a step of an embedded Runge-Kutta method is split.
+ *
+ * zODEIsSplitERK() checks if the last step of \a ode taken by zODEUpdate() from time \a t was split
+ * internally because of a large error, in which case zODEDense() covers only the last split step.
+ * \return
+ * zODEIsSplitERK() returns the true value if one of RKF45, CK45 and DP45 is assigned to \a ode and
+ * the last step was split. Otherwise, it returns the false value.
+ */
+__ZM_EXPORT bool zODEIsSplitERK(const zODE *ode, double t);
 
 __END_DECLS
 
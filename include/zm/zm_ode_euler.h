@@ -16,6 +16,7 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateEuler(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyEuler(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateEuler(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseEuler(zODE *ode, double t, zVec x, void *util);
 
 __END_DECLS
 
@@ -0,0 +1,116 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_event - ordinary differential equation quadrature:
+ * event detection.
+ */
+
+#ifndef __ZM_ODE_EVENT_H__
+#define __ZM_ODE_EVENT_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \struct zODEEvent
+ * \brief event of an ordinary differential equation.
+ *
+ * An event occurs when an event function \a g(t, x, util) of a zODE solver, or \a g2(t, x, v, util)
+ * of a zODE2 solver, crosses zero during a step. \a direction filters the crossing; a positive value
+ * for rising crossings from negative to positive, a negative value for falling ones, and zero for
+ * both. A terminal event stops the integration at the time of the event, while a non-terminal event
+ * is only recorded. The time of the event is localized by a scalar equation solver \a root, which is
+ * either zNLE_VDB() (default) or zNLE_RF() declared in zm_nle_se.h, with the tolerance \a tol on the
+ * value of the event function.
+ *
+ * \a fired and \a t tell if the event occurred in the last step and the time of it, respectively.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEEvent ){
+  double (* g)(double,zVec,void*);       /*!< event function of zODE */
+  double (* g2)(double,zVec,zVec,void*); /*!< event function of zODE2 */
+  int direction;  /*!< direction of crossing */
+  bool terminal;  /*!< true if the integration stops at the event */
+  double (* root)(double (*)(double,void*),double,double,void*,double,int); /*!< scalar equation solver */
+  double tol;     /*!< tolerance of the event function */
+  bool fired;     /*!< true if the event occurred in the last step */
+  double t;       /*!< time of the event */
+};
+
+/*! \brief assign an event function.
+ *
+ * zODEEventAssign() and zODE2EventAssign() assign an event function \a g of zODE and \a g2 of
+ * zODE2 to an event \a ev, respectively, with a direction filter \a direction and a flag \a terminal.
+ * zNLE_VDB() is set for the root finder, and zTOL for the tolerance.
+ *
+ * zODEEventSetSolver() sets a root finder \a root of \a ev.
+ * \return
+ * zODEEventAssign() and zODE2EventAssign() return a pointer \a ev.
+ */
+__ZM_EXPORT zODEEvent *zODEEventAssign(zODEEvent *ev, double (* g)(double,zVec,void*), int direction, bool terminal);
+__ZM_EXPORT zODEEvent *zODE2EventAssign(zODEEvent *ev, double (* g2)(double,zVec,zVec,void*), int direction, bool terminal);
+#define zODEEventSetSolver(ev,r) ( (ev)->root = (r) )
+
+/*! \struct zODEEventMonitor
+ * \brief a set of events to be monitored during integration.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEEventMonitor ){
+  int num;        /*!< number of events */
+  zODEEvent *ev;  /*!< array of events */
+  /*! \cond */
+  double *_g0, *_g1;    /* values of event functions at the head and the tail of a step */
+  double _t1;           /* tail time of the last step */
+  bool _valid;          /* true if _g1 at _t1 is available */
+  zVec _x0, _v0;        /* states at the tail of the last step */
+  zVec _x, _v;          /* workspace for interpolation */
+  /*! \endcond */
+};
+
+#define zODEEventMonitorEvent(m,i) ( &(m)->ev[i] )
+
+/*! \brief allocate and free an event monitor.
+ *
+ * zODEEventMonitorAlloc() allocates an event monitor \a mon of \a num events for a solver of
+ * \a dim-dimensional state. Each event has to be assigned by zODEEventAssign() or zODE2EventAssign()
+ * before integration.
+ *
+ * zODEEventMonitorFree() frees \a mon.
+ * \return
+ * zODEEventMonitorAlloc() returns a pointer \a mon, or the null pointer if it fails to allocate memory.
+ *
+ * zODEEventMonitorFree() returns no value.
+ */
+__ZM_EXPORT zODEEventMonitor *zODEEventMonitorAlloc(zODEEventMonitor *mon, int num, int dim);
+__ZM_EXPORT void zODEEventMonitorFree(zODEEventMonitor *mon);
+
+/*! \brief update a state with event detection.
+ *
+ * zODEUpdateEvent() advances a state \a x at time \a t by a step \a dt of a solver \a ode, and checks
+ * sign changes of the event functions of \a mon between the head and the tail of the step. The time
+ * of each detected event is localized on the dense output zODEDense() of \a ode. If the step is split
+ * internally by an embedded Runge-Kutta method (see zODEIsSplitERK()), it is retaken by halves, so
+ * that each event is localized in a split step covered by the dense output. If terminal events
+ * are detected, the earliest one is taken, and \a x is set for the state at the time of it, which
+ * is located just beyond the zero-crossing so that the same event is not detected again at the next
+ * step. \a t is updated to the time at the tail of the step or at the terminal event. Non-terminal
+ * events before it are marked as fired.
+ *
+ * zODE2UpdateEvent() is the counterpart of zODEUpdateEvent() for a second-order solver \a ode with a
+ * state \a x and its velocity \a v, where the states in the step are interpolated by the cubic Hermite
+ * interpolation of \a x and \a v at the head and the tail of the step without evaluating the
+ * differential function.
+ *
+ * Only the sign of an event function at the ends of a step is checked, so that an even number of
+ * zero-crossings in a step are overlooked. A multistep method, such as 'Adams' and 'Gear', should be
+ * reinitialized after a terminal event, since the history is not valid for the relocated state.
+ * \return
+ * zODEUpdateEvent() and zODE2UpdateEvent() return the index of the terminal event if it occurs, or -1
+ * otherwise. If the dense output fails, zODEUpdateEvent() returns ZODE_EVENT_FAILED, where \a x and
+ * \a t are those at the tail of the step.
+ */
+#define ZODE_EVENT_FAILED ( -2 )
+__ZM_EXPORT int zODEUpdateEvent(zODE *ode, zODEEventMonitor *mon, double *t, zVec x, double dt, void *util);
+__ZM_EXPORT int zODE2UpdateEvent(zODE2 *ode, zODEEventMonitor *mon, double *t, zVec x, zVec v, double dt, void *util);
+
+__END_DECLS
+
+#endif /* __ZM_ODE_EVENT_H__ */
@@ -21,6 +21,7 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateGear(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyGear(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateGear(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseGear(zODE *ode, double t, zVec x, void *util);
 
 /*! \brief initialize history with a given vector.
  *
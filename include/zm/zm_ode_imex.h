@@ -0,0 +1,101 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_imex - ordinary differential equation quadrature:
+ * implicit-explicit additive Runge-Kutta method.
+ */
+
+#ifndef __ZM_ODE_IMEX_H__
+#define __ZM_ODE_IMEX_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief maximum number of stages of implicit-explicit methods. */
+#define ZODE_IMEX_STAGE 4
+
+/*! \struct zODEIMEX
+ * \brief implicit-explicit solver of a split ordinary differential equation.
+ *
+ * zODEIMEX integrates a differential equation split into two parts as
+ *   dx/dt = \a fe(t, x) + \a fi(t, x),
+ * where \a fe is a non-stiff (possibly expensive) part treated explicitly, and \a fi is a stiff
+ * (preferably cheap) part treated implicitly by an additive Runge-Kutta method, which combines
+ * an explicit method and a singly diagonally implicit method with the same abscissae.
+ *
+ * The implicit stages are solved by the simplified Newton method with the matrix I - h gamma J,
+ * where J is the Jacobian matrix of \a fi evaluated at the head of each step by \a jac, or by the
+ * finite difference if \a jac is the null pointer. The LU decomposition of the matrix is shared by
+ * all stages, and is reused while the Jacobian matrix and the step size are unchanged. If \a linear
+ * is true, \a fi is assumed to be affine in the state with a constant Jacobian matrix, so that the
+ * Jacobian matrix is evaluated only once and each stage is solved by one Newton step. Otherwise,
+ * the Newton iteration continues at most \a iter times until the norm of the correction gets less
+ * than \a tol.
+ *
+ * \a err is the root mean square of the error estimated at the last step by the embedded method,
+ * which is zero for methods without embedded one. \a fe_num, \a fi_num and \a decomp_num count the
+ * evaluations of \a fe and \a fi, and the LU decompositions, respectively.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEIMEX ){
+  int dim;    /*!< dimension of a state */
+  zVec (* fe)(double,zVec,void*,zVec);  /*!< explicit part */
+  zVec (* fi)(double,zVec,void*,zVec);  /*!< implicit part */
+  zMat (* jac)(double,zVec,void*,zMat); /*!< Jacobian matrix of the implicit part */
+  bool linear; /*!< true if the implicit part is affine with a constant Jacobian matrix */
+  int iter;    /*!< maximum number of Newton iterations */
+  double tol;  /*!< tolerance of Newton iterations */
+  double err;  /*!< error estimated at the last step */
+  int fe_num, fi_num, decomp_num; /*!< numbers of evaluations and decompositions */
+  /*! \cond */
+  zVec _ke[ZODE_IMEX_STAGE], _ki[ZODE_IMEX_STAGE]; /* stages of explicit and implicit parts */
+  zVec _z, _r, _dz, _e;   /* stage state, residual, correction and error estimation */
+  zMat _j, _lu;           /* Jacobian matrix and LU decomposition of I - h gamma J */
+  zIndex _idx;            /* pivot index */
+  double _hg;             /* h gamma of the last decomposition */
+  bool _jac_valid, _lu_valid;
+  /*! \endcond */
+};
+
+/*! \brief default maximum number of Newton iterations of implicit-explicit methods. */
+#define ZODE_IMEX_ITER 10
+
+/*! \brief create and destroy an implicit-explicit solver.
+ *
+ * zODEIMEXCreate() creates an implicit-explicit solver \a ode of a \a dim-dimensional differential
+ * equation split into an explicit part \a fe and an implicit part \a fi, with the Jacobian matrix
+ * \a jac of \a fi, which can be the null pointer. \a ode->iter is set for ZODE_IMEX_ITER, \a ode->tol
+ * for zTOL, and \a ode->linear for the false value.
+ *
+ * zODEIMEXDestroy() destroys \a ode.
+ *
+ * zODEIMEXSetLinear() sets the flag \a ode->linear for \a l.
+ * \return
+ * zODEIMEXCreate() returns a pointer \a ode, or the null pointer if it fails to allocate memory.
+ *
+ * zODEIMEXDestroy() returns no value.
+ */
+__ZM_EXPORT zODEIMEX *zODEIMEXCreate(zODEIMEX *ode, int dim, zVec (* fe)(double,zVec,void*,zVec), zVec (* fi)(double,zVec,void*,zVec), zMat (* jac)(double,zVec,void*,zMat));
+__ZM_EXPORT void zODEIMEXDestroy(zODEIMEX *ode);
+#define zODEIMEXSetLinear(ode,l) ( (ode)->linear = (l) )
+
+/*! \brief update a state by an implicit-explicit additive Runge-Kutta method.
+ *
+ * zODEIMEXUpdateARS222() advances a state \a x at time \a t by a step \a dt of the second-order
+ * L-stable method ARS(2,2,2) by U. M. Ascher, S. J. Ruuth and R. J. Spiteri (1997).
+ *
+ * zODEIMEXUpdateARK324() advances \a x by the third-order L-stable method ARK3(2)4L[2]SA by
+ * C. A. Kennedy and M. H. Carpenter (2003) with the embedded second-order method for the error
+ * estimation.
+ *
+ * \a util is a utility pointer passed to \a ode->fe, \a ode->fi and \a ode->jac.
+ * \return
+ * zODEIMEXUpdateARS222() and zODEIMEXUpdateARK324() return a pointer \a x, or the null pointer if
+ * the matrix of Newton iteration is singular.
+ */
+__ZM_EXPORT zVec zODEIMEXUpdateARS222(zODEIMEX *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEIMEXUpdateARK324(zODEIMEX *ode, double t, zVec x, double dt, void *util);
+
+__END_DECLS
+
+#endif /* __ZM_ODE_IMEX_H__ */
@@ -0,0 +1,80 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_mr - ordinary differential equation quadrature:
+ * multirate integration of fast-slow systems.
+ */
+
+#ifndef __ZM_ODE_MR_H__
+#define __ZM_ODE_MR_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief maximum number of stages of multirate methods. */
+#define ZODE_MR_STAGE 3
+
+/*! \struct zODEMR
+ * \brief multirate solver of a fast-slow ordinary differential equation.
+ *
+ * zODEMR integrates a differential equation split into two parts as
+ *   dx/dt = \a ff(t, x) + \a fs(t, x),
+ * where \a ff is a fast part, and \a fs is a slow (possibly expensive) part. It is based on the
+ * multirate infinitesimal general-structure additive Runge-Kutta (MRI-GARK) methods by A. Sandu
+ * (2019). The slow part is evaluated only at the stages of a step, and each stage is computed by
+ * integrating a modified fast system
+ *   dv/dt = \a ff(t, v) + sum_j g_ij \a fs(T_j, X_j)
+ * over a fraction of the step, in which the slow part is a constant forcing given by a linear
+ * combination of the slow stages. The fast system is sub-cycled by an arbitrary solver assigned by
+ * zODEAssign(), for example, an implicit one for a stiff fast part, with \a ratio substeps per step.
+ *
+ * \a fs_num counts the evaluations of \a fs.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEMR ){
+  int dim;   /*!< dimension of a state */
+  zVec (* ff)(double,zVec,void*,zVec); /*!< fast part */
+  zVec (* fs)(double,zVec,void*,zVec); /*!< slow part */
+  int ratio; /*!< number of substeps of the fast part per step */
+  int fs_num; /*!< number of evaluations of the slow part */
+  /*! \cond */
+  zODE _fast;               /* solver of the fast part */
+  zVec _ks[ZODE_MR_STAGE];  /* slow stages */
+  zVec _g;                  /* constant forcing of the fast system */
+  void *_util;              /* utility pointer passed to the fast part */
+  /*! \endcond */
+};
+
+/*! \brief create and destroy a multirate solver.
+ *
+ * zODEMRCreate() creates a multirate solver \a ode of a \a dim-dimensional differential equation
+ * split into a fast part \a ff and a slow part \a fs. \a fast is a solver of the fast part to which
+ * a method is assigned by zODEAssign(); it works as a template and is not created nor modified.
+ * \a step is the step number of differential vector history of the fast solver, which is required
+ * only by multistep methods such as 'Adams' and 'Gear' (see zODECreate()).
+ * \a ratio is the number of substeps of the fast part per step.
+ *
+ * zODEMRDestroy() destroys \a ode.
+ * \return
+ * zODEMRCreate() returns a pointer \a ode, or the null pointer if it fails to allocate memory.
+ *
+ * zODEMRDestroy() returns no value.
+ */
+__ZM_EXPORT zODEMR *zODEMRCreate(zODEMR *ode, zODE *fast, int dim, int step, zVec (* ff)(double,zVec,void*,zVec), zVec (* fs)(double,zVec,void*,zVec), int ratio);
+__ZM_EXPORT void zODEMRDestroy(zODEMR *ode);
+
+/*! \brief update a state by a multirate method.
+ *
+ * zODEMRUpdateERK22a() and zODEMRUpdateERK22b() advance a state \a x at time \a t by a step \a dt
+ * of the second-order MRI-GARK methods, which reduce to the explicit midpoint rule and Heun method
+ * for the slow part, respectively. Both evaluate the slow part twice per step.
+ * \a util is a utility pointer passed to \a ode->ff and \a ode->fs.
+ * \return
+ * zODEMRUpdateERK22a() and zODEMRUpdateERK22b() return a pointer \a x.
+ */
+__ZM_EXPORT zVec zODEMRUpdateERK22a(zODEMR *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEMRUpdateERK22b(zODEMR *ode, double t, zVec x, double dt, void *util);
+
+__END_DECLS
+
+#endif /* __ZM_ODE_MR_H__ */
@@ -0,0 +1,96 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_parareal - ordinary differential equation quadrature:
+ * parallel-in-time integration by Parareal method.
+ */
+
+#ifndef __ZM_ODE_PARAREAL_H__
+#define __ZM_ODE_PARAREAL_H__
+
+/* NOTE: never include this header file in user programs. */
+
+#include <zm/zm_thread.h>
+
+__BEGIN_DECLS
+
+/*! \struct zODEParareal
+ * \brief parallel-in-time solver of an ordinary differential equation by Parareal method.
+ *
+ * Parareal method by J.-L. Lions, Y. Maday and G. Turinici (2001) splits a time span into \a num
+ * slices, and iteratively corrects the states at the boundaries of the slices as
+ *   U^(k+1)_(n+1) = G( U^(k+1)_n ) + F( U^k_n ) - G( U^k_n ),
+ * where G is a cheap coarse propagator applied sequentially, and F is an accurate fine propagator
+ * applied to all slices concurrently. The states after k iterations coincide with those of the
+ * sequential fine integration on the first k slices, so that it finishes at most \a num iterations.
+ *
+ * The coarse and fine propagators are arbitrary solvers assigned by zODEAssign(), for which an
+ * instance of the coarse solver and one instance of the fine solver per slice are created, since
+ * a solver has its own workspace. The concatenation and subtraction functions of the fine solver
+ * are used for the correction, so that non-Euclidean states are also integrated. Multistep methods
+ * are not suitable, since their history is not valid at the head of each slice.
+ *
+ * The iteration stops when the maximum absolute value of components of the changes of the states
+ * at the boundaries of all slices gets less than \a tol, or when the number of iterations reaches
+ * \a iter. \a iter_num is the number of iterations taken. At most \a thread_num threads of the
+ * default thread pool are used for the fine propagation; if it is zero, the default number of threads
+ * zThreadNum() is applied.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODEParareal ){
+  int dim;        /*!< dimension of a state */
+  int num;        /*!< number of time slices */
+  int iter;       /*!< maximum number of iterations */
+  double tol;     /*!< tolerance of the change of states */
+  int iter_num;   /*!< number of iterations taken */
+  int thread_num; /*!< maximum number of threads */
+  /*! \cond */
+  zODE _coarse;   /* coarse propagator */
+  zODE *_fine;    /* fine propagators of slices */
+  zVec *_u;       /* states at the boundaries of slices */
+  zVec *_g;       /* coarse propagation of the previous iterate */
+  zVec *_f;       /* fine propagation of the previous iterate */
+  zVec _d, _w;    /* workspace for correction */
+  /*! \endcond */
+};
+
+/*! \brief default tolerance of Parareal iteration. */
+#define ZODE_PARAREAL_TOL ( 1.0e-8 )
+
+/*! \brief create and destroy a Parareal solver.
+ *
+ * zODEPararealCreate() creates a Parareal solver \a pr of \a num time slices for a \a dim-dimensional
+ * differential equation \a f from two solvers \a coarse and \a fine, to which methods are assigned by
+ * zODEAssign(). \a coarse and \a fine work as templates; they are not created nor modified. \a step
+ * is passed to the creation of solvers. See zODECreate(). \a pr->iter is set for \a num, \a pr->tol for
+ * ZODE_PARAREAL_TOL and \a pr->thread_num for zero.
+ *
+ * zODEPararealDestroy() destroys \a pr.
+ *
+ * zODEPararealSetThreadNum() sets the maximum number of threads of \a pr for \a n.
+ * \return
+ * zODEPararealCreate() returns a pointer \a pr, or the null pointer if \a num is not positive or it
+ * fails to allocate memory.
+ *
+ * zODEPararealDestroy() returns no value.
+ */
+__ZM_EXPORT zODEParareal *zODEPararealCreate(zODEParareal *pr, zODE *coarse, zODE *fine, int dim, int step, int num, zVec (* f)(double,zVec,void*,zVec));
+__ZM_EXPORT void zODEPararealDestroy(zODEParareal *pr);
+#define zODEPararealSetThreadNum(pr,n) ( (pr)->thread_num = (n) )
+
+/*! \brief parallel-in-time integration by Parareal method.
+ *
+ * zODEPararealIntegrate() integrates \a x from time \a t to \a tend by a Parareal solver \a pr. The
+ * span is equally divided into the slices. In each slice, the coarse and the fine solvers advance
+ * states by equal steps not larger than \a dt_coarse and \a dt_fine, respectively.
+ * \a util is a utility pointer passed to the differential function.
+ *
+ * If the iteration does not converge within \a pr->iter iterations less than the number of slices,
+ * a warning is shown and the state of the last iterate is returned.
+ * \return
+ * zODEPararealIntegrate() returns a pointer \a x, or the null pointer if the size of \a x mismatches.
+ */
+__ZM_EXPORT zVec zODEPararealIntegrate(zODEParareal *pr, double t, zVec x, double tend, double dt_coarse, double dt_fine, void *util);
+
+__END_DECLS
+
+#endif /* __ZM_ODE_PARAREAL_H__ */
@@ -0,0 +1,94 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_raw - ordinary differential equation quadrature:
+ * allocation-free solver on raw arrays.
+ */
+
+#ifndef __ZM_ODE_RAW_H__
+#define __ZM_ODE_RAW_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \struct zODERaw
+ * \brief allocation-free solver of an ordinary differential equation on raw arrays.
+ *
+ * zODERaw is a lightweight counterpart of zODE for small systems, in which the overhead of calling
+ * the differential function through vector objects and of dispatching the concatenation function
+ * at every stage is not negligible. The differential function \a f(t, x, util, dx) takes raw arrays
+ * of the fixed dimension \a dim, the stages are stored in a contiguous buffer, and the linear
+ * combination of stages is fused into one pass over the components. All workspace is allocated at
+ * once when the solver is created.
+ *
+ * \a err is the root mean square of the difference between the fourth- and fifth-order estimations
+ * at the last step of zODERawUpdateDP45(), which is available for a step size control by the user.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zODERaw ){
+  int dim;  /*!< dimension of a state */
+  void (* f)(double,const double*,void*,double*); /*!< differential function */
+  double err; /*!< error estimated at the last step */
+  /*! \cond */
+  double *_k;       /* contiguous buffer of stages */
+  double *_xc, *_xf; /* intermediate state and the higher-order estimation */
+  double _t1;       /* tail time of the last step */
+  bool _fsal;       /* true if the last stage is the derivative at the tail of the last step */
+  /*! \endcond */
+};
+
+/*! \brief create and destroy an allocation-free ODE solver.
+ *
+ * zODERawCreate() creates a solver \a ode of a \a dim-dimensional differential equation defined by
+ * \a f on raw arrays.
+ *
+ * zODERawDestroy() destroys \a ode.
+ * \return
+ * zODERawCreate() returns a pointer \a ode, or the null pointer if it fails to allocate memory.
+ *
+ * zODERawDestroy() returns no value.
+ */
+__ZM_EXPORT zODERaw *zODERawCreate(zODERaw *ode, int dim, void (* f)(double,const double*,void*,double*));
+__ZM_EXPORT void zODERawDestroy(zODERaw *ode);
+
+/*! \brief update a state on raw arrays.
+ *
+ * zODERawUpdateRK4() and zODERawUpdateDP45() advance a state \a x at time \a t by a step \a dt of
+ * the classical Runge-Kutta method and Dormand-Prince method, respectively. The latter propagates
+ * the fifth-order estimation with no step subdivision, and stores the error estimation to \a ode->err.
+ * If \a x is the one returned by the last call of zODERawUpdateDP45() and \a t is the tail time of
+ * the last step, the last stage is reused as the first one owing to the first-same-as-last property.
+ * \a util is a utility pointer passed to the differential function.
+ * \return
+ * zODERawUpdateRK4() and zODERawUpdateDP45() return a pointer \a x.
+ */
+__ZM_EXPORT double *zODERawUpdateRK4(zODERaw *ode, double t, double *x, double dt, void *util);
+__ZM_EXPORT double *zODERawUpdateDP45(zODERaw *ode, double t, double *x, double dt, void *util);
+
+/*! \brief define a classical Runge-Kutta solver specialized for a differential function.
+ *
+ * zODERawDefineRK4() defines a static function \a name(t, x, dt, util) which advances a state \a x
+ * of the constant dimension \a dim at time \a t by a step \a dt of the classical Runge-Kutta method,
+ * where the differential function \a f(t, x, util, dx) on raw arrays is directly called. Since both
+ * the dimension and the function are known at the compile time, the stages are put on the stack and
+ * the call of \a f can be inlined.
+ */
+#define zODERawDefineRK4(name,dim,f) \
+static double *name(double t, double *x, double dt, void *util){ \
+  double _zode_k[4][(dim)], _zode_x[(dim)]; \
+  int _zode_i; \
+  f( t, x, util, _zode_k[0] ); \
+  for( _zode_i=0; _zode_i<(dim); _zode_i++ ) _zode_x[_zode_i] = x[_zode_i] + 0.5*dt*_zode_k[0][_zode_i]; \
+  f( t+0.5*dt, _zode_x, util, _zode_k[1] ); \
+  for( _zode_i=0; _zode_i<(dim); _zode_i++ ) _zode_x[_zode_i] = x[_zode_i] + 0.5*dt*_zode_k[1][_zode_i]; \
+  f( t+0.5*dt, _zode_x, util, _zode_k[2] ); \
+  for( _zode_i=0; _zode_i<(dim); _zode_i++ ) _zode_x[_zode_i] = x[_zode_i] + dt*_zode_k[2][_zode_i]; \
+  f( t+dt, _zode_x, util, _zode_k[3] ); \
+  for( _zode_i=0; _zode_i<(dim); _zode_i++ ) \
+    x[_zode_i] += dt * ( _zode_k[0][_zode_i]/6 + _zode_k[1][_zode_i]/3 + _zode_k[2][_zode_i]/3 + _zode_k[3][_zode_i]/6 ); \
+  return x; \
+}
+
+__END_DECLS
+
+#endif /* __ZM_ODE_RAW_H__ */
@@ -20,6 +20,7 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateRK4(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyRK4(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateRK4(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseRK4(zODE *ode, double t, zVec x, void *util);
 
 __END_DECLS
 
@@ -18,6 +18,7 @@ __BEGIN_DECLS
 __ZM_EXPORT zODE *zODECreateRKG(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
 __ZM_EXPORT void zODEDestroyRKG(zODE *ode);
 __ZM_EXPORT zVec zODEUpdateRKG(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseRKG(zODE *ode, double t, zVec x, void *util);
 
 __END_DECLS
 
@@ -0,0 +1,72 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_ros - ordinary differential equation quadrature:
+ * Rosenbrock-W method for stiff systems.
+ */
+
+#ifndef __ZM_ODE_ROS_H__
+#define __ZM_ODE_ROS_H__
+
+/* NOTE: never include this header file in user programs. */
+
+#include <zm/zm_spmat.h>
+
+__BEGIN_DECLS
+
+/* Ros34 is a four-stage third-order Rosenbrock-W method ROS34PW2 by Rang and Angermann, which is
+ * L-stable and stiffly accurate. Each stage solves a linear equation with ( I/(h gamma) - J ) instead
+ * of a nonlinear one, where J is the Jacobian matrix of the differential function. Since the method
+ * keeps its order with an approximate J, the Jacobian matrix and the LU decomposition are reused over
+ * steps; the decomposition is redone only when dt changes, and the Jacobian matrix is re-evaluated
+ * when the error estimated by the embedded second-order method grows ZODE_ROS_DEGRADE times as large
+ * as the one just after the last evaluation, or it gets older than ZODE_ROS_JAC_AGE steps.
+ */
+__ZM_EXPORT zODE *zODECreateRos34(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec));
+__ZM_EXPORT void zODEDestroyRos34(zODE *ode);
+__ZM_EXPORT zVec zODEUpdateRos34(zODE *ode, double t, zVec x, double dt, void *util);
+__ZM_EXPORT zVec zODEDenseRos34(zODE *ode, double t, zVec x, void *util);
+
+/*! \brief ratio of the error estimation to re-evaluate the Jacobian matrix. */
+#define ZODE_ROS_DEGRADE 10.0
+/*! \brief maximum number of steps over which the Jacobian matrix is reused. */
+#define ZODE_ROS_JAC_AGE 100
+
+/*! \brief Jacobian matrix of the Rosenbrock-W method.
+ *
+ * zODESetJacobianRos34() assigns a function \a jac that computes the Jacobian matrix of the differential
+ * function of \a ode as \a jac(t, x, util, j), where j is an n x n matrix, to a solver \a ode created
+ * by zODECreateRos34(). If it is the null pointer, the Jacobian matrix is computed by finite difference.
+ *
+ * zODESetJacobianPatternRos34() assigns the sparsity pattern \a pattern of the Jacobian matrix to
+ * \a ode, whose stored components indicate possibly nonzero components. The columns are colored so
+ * that columns in the same color do not share any row, and the finite-difference Jacobian matrix is
+ * computed by perturbing all columns in a color at once, which needs only as many evaluations of the
+ * differential function as the colors. \a pattern is copied, so that it can be freed after the call.
+ * If \a pattern is the null pointer, the dense finite difference is applied.
+ *
+ * zODERefreshJacobianRos34() marks the Jacobian matrix of \a ode to be re-evaluated at the next step,
+ * which is needed when the differential function changes discontinuously.
+ * \return
+ * zODESetJacobianRos34() and zODERefreshJacobianRos34() return a pointer \a ode.
+ *
+ * zODESetJacobianPatternRos34() returns a pointer \a ode, or the null pointer if the size of
+ * \a pattern mismatches or it fails to allocate memory.
+ */
+__ZM_EXPORT zODE *zODESetJacobianRos34(zODE *ode, zMat (* jac)(double,zVec,void*,zMat));
+__ZM_EXPORT zODE *zODESetJacobianPatternRos34(zODE *ode, const zSpMat pattern);
+__ZM_EXPORT zODE *zODERefreshJacobianRos34(zODE *ode);
+
+/*! \brief statistics of the Rosenbrock-W method.
+ *
+ * zODEJacobianNumRos34() and zODEDecompNumRos34() return the numbers of evaluations of the Jacobian
+ * matrix and LU decompositions done by \a ode so far, respectively. zODEColorNumRos34() returns the
+ * number of colors of columns for the finite-difference Jacobian matrix.
+ */
+__ZM_EXPORT int zODEJacobianNumRos34(zODE *ode);
+__ZM_EXPORT int zODEDecompNumRos34(zODE *ode);
+__ZM_EXPORT int zODEColorNumRos34(zODE *ode);
+
+__END_DECLS
+
+#endif /* __ZM_ODE_ROS_H__ */
@@ -11,6 +11,7 @@
 
 #include <zm/zm_opt_line.h>           /* line search */
 #include <zm/zm_opt_lp.h>             /* linear programming */
+#include <zm/zm_opt_lp_revised.h>     /* linear programming by revised simplex method */
 #include <zm/zm_opt_lp_megiddodyer.h> /* linear programming by Megiddo-Dyer algorithm */
 #include <zm/zm_opt_lcp.h>            /* linear complementary problem */
 #include <zm/zm_opt_qp.h>             /* quadratic programming */
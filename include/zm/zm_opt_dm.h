@@ -43,12 +43,20 @@ typedef struct _zOptDM{
   zVec _p, _q, _r;
   zMat _h;
   zIndex _idx;
+  zArena *_arena; /* arena on which the workspace is carved */
   double _b;  /* for Fletcher-Reeves */
   double _df; /* decrease factor */
   double _cf; /* curvature factor */
 } zOptDM;
 
 __ZM_EXPORT zOptDM *zOptDMCreate(zOptDM *opt, int dim, double scale, double (* eval)(const zVec,void*), zVec (* grad)(const zVec,zVec,void*), zMat (* hess)(const zVec,zMat,void*));
+/*! \brief create a descent method solver on an arena.
+ *
+ * zOptDMCreateArena() is the same with zOptDMCreate() except that workspace of \a opt and temporaries
+ * for numerical Hessian matrices are carved from \a arena, so that zOptDMSolve() does not allocate
+ * memory on the heap. zOptDMDestroy() leaves the workspace to the arena.
+ */
+__ZM_EXPORT zOptDM *zOptDMCreateArena(zOptDM *opt, int dim, double scale, double (* eval)(const zVec,void*), zVec (* grad)(const zVec,zVec,void*), zMat (* hess)(const zVec,zMat,void*), zArena *arena);
 __ZM_EXPORT zOptDM *zOptDMAssignSD(zOptDM *opt, const char *stepmethod);
 __ZM_EXPORT zOptDM *zOptDMAssignLM(zOptDM *opt, const char *stepmethod);
 __ZM_EXPORT zOptDM *zOptDMAssignVM(zOptDM *opt, const char *stepmethod, const char *updatemethod);
@@ -33,6 +33,90 @@ __BEGIN_DECLS
 __ZM_EXPORT bool zLCPSolveLemke(const zMat m, const zVec p, zVec w, zVec z);
 __ZM_EXPORT bool zLCPSolveIP(const zMat m, const zVec p, zVec w, zVec z);
 
+/*! \struct zLCPPGS
+ * \brief projected Gauss-Seidel method for linear complementarity
+ * problems.
+ *
+ * zLCPPGS is a set of parameters of the projected Gauss-Seidel (PGS)
+ * method and the projected successive over-relaxation (PSOR) method,
+ * and the statistics of the last solution.
+ *
+ * \a omega is the relaxation factor, where 1 is for PGS, and PSOR is
+ * for a value between 1 and 2.
+ *
+ * If \a tol is positive, the iteration terminates when the residual
+ * gets smaller than \a tol, or the number of iterations reaches
+ * \a iter_max. If \a tol is zero, the iteration is repeated just
+ * \a iter_max times, which is for real-time applications with a fixed
+ * computation time. Z_MAX_ITER_NUM is applied if \a iter_max is zero.
+ *
+ * \a residual is the natural residual of the last solution, namely, the
+ * maximum absolute value of components of min(\a z, \a w) for an
+ * LCP, so that the accuracy can be traded for the latency.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLCPPGS ){
+  double omega;    /*!< relaxation factor */
+  double tol;      /*!< tolerance of the residual */
+  int iter_max;    /*!< maximum number of iterations */
+  int iter_num;    /*!< number of iterations of the last solution */
+  double residual; /*!< residual of the last solution */
+};
+
+/*! \brief default parameters of zLCPPGS. */
+#define ZLCP_PGS_OMEGA ( 1.0 )
+#define ZLCP_PGS_TOL   ( 1.0e-10 )
+
+/*! \brief initialize parameters of the projected Gauss-Seidel method.
+ *
+ * zLCPPGSInit() initializes the parameters of \a pgs for the default
+ * values ZLCP_PGS_OMEGA and ZLCP_PGS_TOL, and zero for \a iter_max.
+ * \return
+ * zLCPPGSInit() returns a pointer \a pgs.
+ */
+__ZM_EXPORT zLCPPGS *zLCPPGSInit(zLCPPGS *pgs);
+
+/*! \brief linear complementarity problem solver by the projected
+ * Gauss-Seidel method.
+ *
+ * zLCPPGSSolve() solves an LCP that finds \a w and \a z which satisfy
+ *   \a w = \a m \a z + \a p, \a w >= 0, \a z >= 0 and w^T z = 0
+ * by the projected Gauss-Seidel method with the parameters of \a pgs.
+ * Each component of \a z is updated one by one as
+ *   z_i <- max( 0, z_i - omega ( m_i z + p_i ) / m_ii ),
+ * which costs O(n^2) per iteration. \a z is the initial guess, which is
+ * a warm start from the solution of the previous problem. \a m is
+ * supposed to be positive semidefinite with positive diagonal components,
+ * for example, the Delassus matrix of contacts.
+ *
+ * zLCPPGSSolveFriction() solves a cone complementarity problem of
+ * contacts with friction cones, in which \a z consists of n blocks of
+ * the normal and the two tangential components of contact forces, and
+ * \a mu is a vector of n friction coefficients. It finds \a z and \a w
+ * that satisfy
+ *   \a w = \a m \a z + \a p, z_k in K_k, w_k in K_k^* and w_k^T z_k = 0
+ * for each block, where K_k is the friction cone with the coefficient
+ * mu_k and K_k^* is its dual cone. Each block is updated as
+ *   z_k <- Proj_K_k( z_k - omega eta_k ( m_k z + p_k ) ),
+ * where eta_k is three over the trace of the k-th diagonal block of \a m
+ * (2010 M. Anitescu and A. Tasora).
+ *
+ * zLCPSolvePGS() is a counterpart of zLCPSolveLemke() which solves an
+ * LCP from zero with the default parameters.
+ *
+ * \a w can be the null pointer for all of them.
+ * \return
+ * zLCPPGSSolve() and zLCPPGSSolveFriction() return the true value if the
+ * residual gets smaller than the tolerance, or the iteration is done
+ * for the given number of times in the real-time mode. The false value
+ * is returned if the sizes of vectors and matrices mismatch, a diagonal
+ * component of \a m is not positive, a friction coefficient is
+ * negative, or the iteration does not converge.
+ * zLCPSolvePGS() returns the same value with zLCPPGSSolve().
+ */
+__ZM_EXPORT bool zLCPPGSSolve(zLCPPGS *pgs, const zMat m, const zVec p, zVec w, zVec z);
+__ZM_EXPORT bool zLCPPGSSolveFriction(zLCPPGS *pgs, const zMat m, const zVec p, const zVec mu, zVec w, zVec z);
+__ZM_EXPORT bool zLCPSolvePGS(const zMat m, const zVec p, zVec w, zVec z);
+
 __END_DECLS
 
 #endif /* __ZM_OPT_LCP_H__ */
@@ -102,6 +102,124 @@ __ZM_EXPORT bool zLPFeasibleBase(const zMat a, const zVec b, zVec base);
  */
 __ZM_EXPORT bool zLPSolvePDIP_PC(const zMat a, const zVec b, const zVec c, zVec x, double *cost);
 
+/*! \struct zLPPDIP
+ * \brief primal-dual interior-point method with normal equations.
+ *
+ * zLPPDIP solves a linear programming problem in the standard form:
+ *   \a c^T x -> minimum
+ *   subject to \a a x = \a b and x >= 0
+ * where \a a is a sparse m x n matrix, or a separable quadratic programming problem with the cost
+ *   \a c^T x + 1/2 x^T diag(\a q) x
+ * for a non-negative vector \a q. \a q is the null pointer for linear programming.
+ *
+ * It is based on Mehrotra's predictor-corrector method with an infeasible starting point. The Newton
+ * system of each iteration is reduced to the normal equation with the symmetric positive definite
+ * matrix A D A^T, where D = ( Z X^-1 + diag(\a q) )^-1, which is factorized by the sparse Cholesky
+ * factorization zSpCholesky. The sparsity pattern of A D A^T is independent of D, so that the symbolic
+ * analysis is done only once when the solver is created. A tiny diagonal regularization is added for
+ * rank-deficient \a a.
+ *
+ * \a x, \a y and \a z are the primal variables, the Lagrange multipliers of the equality constraints
+ * and the dual slack variables, respectively. The last iterate of them before the duality gap gets
+ * smaller than a fraction of the cost is kept, and the next call starts from it, which is a warm start
+ * for a slightly perturbed problem. Since it is still well inside the positive orthant, it takes only a
+ * few iterations to reach the optimum if the perturbation is small.
+ *
+ * The iteration terminates when the primal and dual residuals relative to \a b and \a c, and the
+ * duality gap per variable, are all smaller than \a tol. \a iter_max is the maximum number of
+ * iterations, where Z_MAX_ITER_NUM is applied if it is zero.
+ *
+ * For linear programming, a crossover to a basic solution is tried from nearly optimal iterates, where
+ * the columns with the largest ratios of the primal variables to the dual slack variables are chosen
+ * for a basis. The basic solution is adopted if it is certified to be optimal, namely, it is primal and
+ * dual feasible, which removes the error of the interior point amplified by an ill-conditioned basis.
+ * Otherwise, the iteration continues until the duality gap per variable itself gets smaller than
+ * \a tol, and the interior point is adopted. If the iteration breaks down numerically after that, the
+ * last nearly optimal iterate is adopted.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLPPDIP ){
+  zSpMat a;     /*!< constraint matrix in the CSC format */
+  zVec b;       /*!< constraint vector */
+  zVec c;       /*!< cost vector */
+  zVec q;       /*!< diagonal of the quadratic cost, or the null pointer */
+  zVec x;       /*!< primal variables */
+  zVec y;       /*!< Lagrange multipliers */
+  zVec z;       /*!< dual slack variables */
+  double tol;   /*!< tolerance of termination */
+  int iter_max; /*!< maximum number of iterations (zero for the default) */
+  int iter_num; /*!< number of iterations of the last solution */
+  /*! \cond */
+  zSpMat _m;    /* upper triangular part of A D A^T in the CSC format */
+  int *_map;    /* positions in _m of products of pairs of components of each column of a */
+  int *_diag;   /* positions of diagonal components in _m */
+  zSpCholesky _chol;
+  zVec _d, _rd, _rc, _dx, _dz, _v; /* workspace on columns */
+  zVec _rp, _dy, _w;               /* workspace on rows */
+  zVec _wx, _wy, _wz; /* point for a warm start */
+  bool _warm;   /* true if the point for a warm start is available */
+  zArena *_arena; /* arena on which the vectors are carved */
+  /*! \endcond */
+};
+
+/*! \brief default tolerance of zLPPDIP. */
+#define ZLP_PDIP_TOL ( 1.0e-8 )
+
+/*! \brief create and destroy a primal-dual interior-point solver.
+ *
+ * zLPPDIPCreate() creates a solver \a lp of a linear programming problem with a sparse constraint
+ * matrix \a a in any format, a constraint vector \a b and a cost vector \a c, which are copied to
+ * \a lp. The sparsity pattern of the normal equation is analyzed here.
+ *
+ * zLPPDIPCreateArena() is the same with zLPPDIPCreate() except that the vectors of \a lp, including
+ * the quadratic cost set by zLPPDIPSetQuad(), are carved from \a arena. The sparse matrices and the
+ * factorization are still allocated on the heap.
+ *
+ * zLPPDIPDestroy() destroys \a lp. The vectors on an arena are left to the arena.
+ * \return
+ * zLPPDIPCreate() and zLPPDIPCreateArena() return a pointer \a lp, or the null pointer if the sizes of
+ * \a a, \a b and \a c mismatch or it fails to allocate memory.
+ *
+ * zLPPDIPDestroy() returns no value.
+ */
+__ZM_EXPORT zLPPDIP *zLPPDIPCreate(zLPPDIP *lp, const zSpMat a, const zVec b, const zVec c);
+__ZM_EXPORT zLPPDIP *zLPPDIPCreateArena(zLPPDIP *lp, const zSpMat a, const zVec b, const zVec c, zArena *arena);
+__ZM_EXPORT void zLPPDIPDestroy(zLPPDIP *lp);
+
+/*! \brief modify the problem of a primal-dual interior-point solver.
+ *
+ * zLPPDIPSetCost() and zLPPDIPSetRHS() replace the cost vector and the constraint vector of \a lp with
+ * \a c and \a b, respectively.
+ *
+ * zLPPDIPSetQuad() sets the diagonal \a q of the quadratic cost of \a lp. If \a q is the null pointer,
+ * the quadratic cost is removed.
+ *
+ * They keep the last point of \a lp for a warm start, while zLPPDIPReset() discards it, so that the
+ * next solution starts from scratch.
+ * \return
+ * zLPPDIPSetCost(), zLPPDIPSetRHS() and zLPPDIPSetQuad() return the true value if they succeed, or
+ * the false value if the size of the given vector mismatches, or if \a q has a negative component or
+ * it fails to allocate memory for zLPPDIPSetQuad().
+ */
+__ZM_EXPORT bool zLPPDIPSetCost(zLPPDIP *lp, const zVec c);
+__ZM_EXPORT bool zLPPDIPSetRHS(zLPPDIP *lp, const zVec b);
+__ZM_EXPORT bool zLPPDIPSetQuad(zLPPDIP *lp, const zVec q);
+#define zLPPDIPReset(lp) ( (lp)->_warm = false )
+
+/*! \brief solve a problem by primal-dual interior-point method with normal equations.
+ *
+ * zLPPDIPSolve() solves the problem of \a lp. The answer is put into \a ans, and the optimum value is
+ * stored where \a cost points, unless \a cost is the null pointer.
+ *
+ * zLPSolvePDIP_Cholesky() is a counterpart of zLPSolvePDIP_PC() with a dense constraint matrix \a a,
+ * which is converted to a sparse matrix and solved by zLPPDIPSolve().
+ * \return
+ * zLPPDIPSolve() and zLPSolvePDIP_Cholesky() return the true value if they succeed to get the optimum.
+ * The false value is returned if the size of \a ans mismatches, the iterates diverge for an infeasible
+ * or unbounded problem, the number of iterations exceeds the limit, or they fail to allocate memory.
+ */
+__ZM_EXPORT bool zLPPDIPSolve(zLPPDIP *lp, zVec ans, double *cost);
+__ZM_EXPORT bool zLPSolvePDIP_Cholesky(const zMat a, const zVec b, const zVec c, zVec x, double *cost);
+
 __END_DECLS
 
 #endif /* __ZM_OPT_LP_H__ */
@@ -0,0 +1,121 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_opt_lp_revised - optimization tools:
+ * linear programming by revised simplex method.
+ */
+
+#ifndef __ZM_OPT_LP_REVISED_H__
+#define __ZM_OPT_LP_REVISED_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \struct zLPRevised
+ * \brief revised simplex method for linear programming.
+ *
+ * zLPRevised solves a linear programming problem in the standard form:
+ *   \a c^T x -> minimum
+ *   subject to \a a x = \a b and x >= 0
+ * where \a a is a sparse m x n matrix. Instead of sweeping out the whole tableau, it keeps a sparse
+ * LU factorization of the basis matrix, which is updated by the product form of the inverse at every
+ * pivot and refactorized after \a refactor updates. Columns of the basis are factorized in ascending
+ * order of the number of nonzero components, with a threshold partial pivoting preferring sparse rows.
+ *
+ * The entering variable is chosen by Devex pricing, and the leaving one by the ratio test preferring
+ * large pivots. Bland's rule is applied after a run of degenerate pivots to avoid cycling.
+ *
+ * The first phase minimizes the sum of artificial variables, one for each row, which are replaced by
+ * column singletons of \a a in the initial basis where possible. Artificial variables remaining in the
+ * basis at zero, namely, for redundant constraints, are kept at zero in the second phase.
+ *
+ * \a iter_max is the maximum number of iterations of each phase. If it is zero, ten times the sum
+ * of the numbers of rows and columns of \a a, or Z_MAX_ITER_NUM if larger, is applied.
+ *
+ * The basis after solving is kept for a warm start; the next call skips the first phase if the basis is
+ * still feasible, for example, after only the cost vector is changed.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zLPRevised ){
+  zSpMat a;     /*!< constraint matrix in the CSC format */
+  zVec b;       /*!< constraint vector */
+  zVec c;       /*!< cost vector */
+  int iter_max; /*!< maximum number of iterations (zero for the default) */
+  int refactor; /*!< number of updates before refactorization */
+  int iter_num; /*!< number of iterations of the last solution */
+  /*! \cond */
+  int *_basis;    /* basic variable of each slot of the basis, where n+i is the artificial of the i-th row */
+  int *_pos;      /* slot of each variable in the basis, or -1 for a non-basic variable */
+  double *_sign;  /* sign of the artificial variable of each row */
+  int *_iota;     /* row indices of artificial columns */
+  double *_xb;    /* values of basic variables */
+  double *_w;     /* Devex weights */
+  double *_y, *_d, *_rho, *_work; /* workspace */
+  bool _warm;     /* true if the basis is available for a warm start */
+  struct _zLPRevisedFactor *_lu;
+  /*! \endcond */
+};
+
+/*! \brief default number of updates of the basis before refactorization. */
+#define ZLP_REVISED_REFACTOR 64
+
+/*! \brief create and destroy a revised simplex solver.
+ *
+ * zLPRevisedCreate() creates a revised simplex solver \a lp of a linear programming problem with a
+ * sparse constraint matrix \a a in any format, a constraint vector \a b and a cost vector \a c, which
+ * are copied to \a lp.
+ *
+ * zLPRevisedDestroy() destroys \a lp.
+ * \return
+ * zLPRevisedCreate() returns a pointer \a lp, or the null pointer if the sizes of \a a, \a b and \a c
+ * mismatch or it fails to allocate memory.
+ *
+ * zLPRevisedDestroy() returns no value.
+ */
+__ZM_EXPORT zLPRevised *zLPRevisedCreate(zLPRevised *lp, const zSpMat a, const zVec b, const zVec c);
+__ZM_EXPORT void zLPRevisedDestroy(zLPRevised *lp);
+
+/*! \brief warm start of a revised simplex solver.
+ *
+ * zLPRevisedSetCost() and zLPRevisedSetRHS() replace the cost vector and the constraint vector of
+ * \a lp with \a c and \a b, respectively, keeping the current basis for a warm start.
+ *
+ * zLPRevisedSetBasis() sets the basis of \a lp for an index vector \a basis of the size equal to the
+ * number of constraints, each component of which is a column index of the constraint matrix. It is
+ * used for a warm start from a basis obtained by zLPRevisedGetBasis() in another run. A singular basis
+ * is repaired by artificial variables.
+ *
+ * zLPRevisedGetBasis() copies the current basis of \a lp to \a basis, where an artificial variable of
+ * the i-th row is represented by n+i for the number of columns n of the constraint matrix.
+ *
+ * zLPRevisedReset() discards the basis of \a lp, so that the next solution starts from scratch.
+ * \return
+ * zLPRevisedSetCost(), zLPRevisedSetRHS(), zLPRevisedSetBasis() and zLPRevisedGetBasis() return the
+ * true value if they succeed, or the false value if the size of the given vector mismatches or
+ * \a basis has an invalid or a duplicate index.
+ */
+__ZM_EXPORT bool zLPRevisedSetCost(zLPRevised *lp, const zVec c);
+__ZM_EXPORT bool zLPRevisedSetRHS(zLPRevised *lp, const zVec b);
+__ZM_EXPORT bool zLPRevisedSetBasis(zLPRevised *lp, const zIndex basis);
+__ZM_EXPORT bool zLPRevisedGetBasis(const zLPRevised *lp, zIndex basis);
+#define zLPRevisedReset(lp) ( (lp)->_warm = false )
+
+/*! \brief solve a linear programming problem by revised simplex method.
+ *
+ * zLPRevisedSolve() solves the linear programming problem of \a lp. The answer is put into \a ans,
+ * and the optimum value is stored where \a cost points, unless \a cost is the null pointer.
+ *
+ * zLPSolveSimplexRevised() is a counterpart of zLPSolveSimplex() with a dense constraint matrix \a a,
+ * which is converted to a sparse matrix and solved by zLPRevisedSolve().
+ * \return
+ * zLPRevisedSolve() and zLPSolveSimplexRevised() return the true value if they succeed to get the
+ * optimum. The false value is returned if the size of \a ans mismatches, no feasible solution or an
+ * unbounded solution is found, the number of iterations exceeds the limit, or they fail to allocate
+ * memory.
+ */
+__ZM_EXPORT bool zLPRevisedSolve(zLPRevised *lp, zVec ans, double *cost);
+__ZM_EXPORT bool zLPSolveSimplexRevised(const zMat a, const zVec b, const zVec c, zVec ans, double *cost);
+
+__END_DECLS
+
+#endif /* __ZM_OPT_LP_REVISED_H__ */
@@ -58,6 +58,237 @@ __ZM_EXPORT bool zQPSolveIP(const zMat q, const zVec c, const zMat a, const zVec
  */
 __ZM_EXPORT bool zQPSolveASM(const zMat q, const zVec c, const zMat a, const zVec b, zVec ans, double *cost);
 
+/*! \struct zQPDualASM
+ * \brief dual active set method for quadratic programming.
+ *
+ * zQPDualASM solves a quadratic programming problem which finds the vector x that minimizes
+ * 0.5 x^T \a q x + c^T x subject to \a a x >= b, where \a q is positive definite, based on the dual
+ * active set method (1983 D. Goldfarb and A. Idnani). It is aimed at a sequence of problems with the
+ * same \a q and \a a and different c and b, for example, in model predictive control.
+ *
+ * The Cholesky factorization \a q = L L^T is computed only once when the solver is created. The
+ * iteration starts from the unconstrained minimum, which needs no feasible initial point, and adds the
+ * most violated constraint to the working set one by one, dropping constraints with negative Lagrange
+ * multipliers. The QR factorization of L^-1 N for the normals N of the active constraints is updated
+ * by Givens rotations in O(n^2) at every addition and deletion of a constraint, instead of solving
+ * the KKT system from scratch.
+ *
+ * The working set and its factorization are kept after solving, and the next call starts from the
+ * minimum on them, dropping constraints with negative Lagrange multipliers. If the problem is only
+ * slightly changed, it takes only a few iterations to reach the optimum.
+ *
+ * \a iter_max is the maximum number of additions and deletions of constraints, where Z_MAX_ITER_NUM
+ * is applied if it is zero. \a time_max is the maximum processor time in seconds measured by clock(),
+ * which is not limited if it is zero. If the iteration is cut off by either of them, \a truncated is
+ * set for the true value.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zQPDualASM ){
+  zMat q;          /*!< quadratic coefficient matrix */
+  zMat a;          /*!< constraint matrix */
+  int iter_max;    /*!< maximum number of iterations (zero for the default) */
+  double time_max; /*!< maximum processor time in seconds (zero for no limit) */
+  int iter_num;    /*!< number of iterations of the last solution */
+  bool truncated;  /*!< true if the last solution is cut off by the budget */
+  /*! \cond */
+  zMat _j0;        /* L^-T for the Cholesky factor L of q */
+  zMat _j;         /* L^-T Q for the QR factorization L^-1 N = Q R */
+  zMat _r;         /* upper triangular factor R */
+  zVec _anorm;     /* norms of rows of a */
+  int *_active;    /* active constraints */
+  int *_slot;      /* slot of each constraint in the working set, or -1 for an inactive one */
+  int _nact;       /* number of active constraints */
+  double *_u;      /* Lagrange multipliers of active constraints */
+  double *_d, *_z, *_s, *_w; /* workspace */
+  bool _warm;      /* true if the working set is available for a warm start */
+  /*! \endcond */
+};
+
+/*! \brief create and destroy a dual active set solver.
+ *
+ * zQPDualASMCreate() creates a solver \a qp of a quadratic programming problem with a quadratic
+ * coefficient matrix \a q and a constraint matrix \a a, which are copied to \a qp.
+ *
+ * zQPDualASMDestroy() destroys \a qp.
+ * \return
+ * zQPDualASMCreate() returns a pointer \a qp, or the null pointer if the sizes of \a q and \a a
+ * mismatch, \a q is not positive definite, or it fails to allocate memory.
+ *
+ * zQPDualASMDestroy() returns no value.
+ */
+__ZM_EXPORT zQPDualASM *zQPDualASMCreate(zQPDualASM *qp, const zMat q, const zMat a);
+__ZM_EXPORT void zQPDualASMDestroy(zQPDualASM *qp);
+
+/*! \brief working set of a dual active set solver.
+ *
+ * zQPDualASMSetWorkingSet() sets the working set of \a qp for an index vector \a ws, each component
+ * of which is a row index of the constraint matrix. It is used for a warm start from a working set
+ * obtained by zQPDualASMGetWorkingSet() in another run. Constraints linearly dependent on the former
+ * ones are skipped.
+ *
+ * zQPDualASMGetWorkingSet() copies the current working set of \a qp to \a ws, which is resized to
+ * the number of active constraints.
+ *
+ * zQPDualASMReset() discards the working set of \a qp, so that the next solution starts from scratch.
+ * \return
+ * zQPDualASMSetWorkingSet() and zQPDualASMGetWorkingSet() return the true value if they succeed, or
+ * the false value if \a ws has an invalid or a duplicate index or is not large enough.
+ */
+__ZM_EXPORT bool zQPDualASMSetWorkingSet(zQPDualASM *qp, const zIndex ws);
+__ZM_EXPORT bool zQPDualASMGetWorkingSet(const zQPDualASM *qp, zIndex ws);
+#define zQPDualASMReset(qp) ( (qp)->_warm = false )
+
+/*! \brief solve a quadratic programming problem by dual active set method.
+ *
+ * zQPDualASMSolve() finds the vector x that minimizes 0.5 x^T q x + \a c^T x subject to a x >= \a b
+ * for the quadratic coefficient matrix q and the constraint matrix a of \a qp. The answer is put into
+ * \a ans, and the optimum value is stored where \a cost points, unless \a cost is the null pointer.
+ * If the iteration is cut off by the budget, the last iterate, which is optimal on the current working
+ * set but may violate other constraints, is put into \a ans.
+ *
+ * zQPSolveDualASM() is a counterpart of zQPSolveASM() based on zQPDualASMSolve().
+ * \return
+ * zQPDualASMSolve() and zQPSolveDualASM() return the true value if they succeed to get the optimum.
+ * The false value is returned if the sizes of vectors mismatch, no feasible solution exists, the
+ * iteration is cut off by the budget, or they fail to allocate memory.
+ */
+__ZM_EXPORT bool zQPDualASMSolve(zQPDualASM *qp, const zVec c, const zVec b, zVec ans, double *cost);
+__ZM_EXPORT bool zQPSolveDualASM(const zMat q, const zVec c, const zMat a, const zVec b, zVec ans, double *cost);
+
+/*! \struct zQPADMM
+ * \brief alternating direction method of multipliers for quadratic programming.
+ *
+ * zQPADMM solves a quadratic programming problem which finds the vector x that minimizes
+ * 0.5 x^T \a p x + \a q^T x subject to \a l <= A x <= \a u, where \a p is a sparse positive
+ * semidefinite symmetric n x n matrix, based on the operator splitting method (2020 B. Stellato et al.),
+ * namely, ADMM with the constraint vector z = A x. A is a sparse matrix that stacks a general m x n
+ * constraint matrix and the n x n identity for box constraints of x, so that \a l and \a u have
+ * m + n components. An equality constraint is given by equal lower and upper bounds, and a bound
+ * larger than ZQP_ADMM_INF in magnitude is regarded as infinite.
+ *
+ * Each iteration solves a linear equation with the positive definite matrix
+ *   \a p + \a sigma I + A^T diag(rho) A
+ * instead of the quasi-definite KKT matrix, where the step size rho of each row is \a rho for an
+ * inequality constraint, ZQP_ADMM_RHO_EQ times \a rho for an equality constraint and ZQP_ADMM_RHO_MIN
+ * for an unbounded row, divided by the squared norm of the row to equilibrate rows. The matrix is factorized by zSpCholesky, whose symbolic analysis is done only
+ * once when the solver is created. \a rho is adapted to balance the primal and dual residuals every
+ * ZQP_ADMM_RHO_INTERVAL iterations, and the matrix is refactorized only if it changes by more than
+ * five times. \a alpha is the relaxation parameter.
+ *
+ * The iteration terminates when the primal residual ||A x - z|| and the dual residual
+ * ||\a p x + \a q + A^T y|| in the infinity norm get smaller than \a tol_abs plus \a tol_rel times
+ * the magnitudes of their terms. \a iter_max is the maximum number of iterations, where
+ * Z_MAX_ITER_NUM is applied if it is zero. The primal infeasibility is detected by the difference of
+ * the dual variables y between iterations.
+ *
+ * \a x, \a z and \a y are kept after solving, and the next call starts from them, which is a warm
+ * start for a slightly perturbed problem.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zQPADMM ){
+  zSpMat p;       /*!< upper triangular part of the quadratic coefficient matrix in the CSC format */
+  zSpMat a;       /*!< constraint matrix including the identity for box constraints in the CSC format */
+  zVec q;         /*!< cost vector */
+  zVec l;         /*!< lower bounds of constraints */
+  zVec u;         /*!< upper bounds of constraints */
+  zVec x;         /*!< primal variables */
+  zVec z;         /*!< constraint variables */
+  zVec y;         /*!< Lagrange multipliers */
+  double rho;     /*!< step size */
+  double sigma;   /*!< regularization of primal variables */
+  double alpha;   /*!< relaxation parameter */
+  double tol_abs; /*!< absolute tolerance of termination */
+  double tol_rel; /*!< relative tolerance of termination */
+  int iter_max;   /*!< maximum number of iterations (zero for the default) */
+  int iter_num;   /*!< number of iterations of the last solution */
+  double res_prim; /*!< primal residual of the last solution */
+  double res_dual; /*!< dual residual of the last solution */
+  /*! \cond */
+  zSpMat _m;      /* upper triangular part of p + sigma I + A^T diag(rho) A in the CSC format */
+  zSpMat _ar;     /* constraint matrix in the CSR format */
+  int *_pmap;     /* positions in _m of components of p */
+  int *_amap;     /* positions in _m of products of pairs of components of each row of a */
+  int *_diag;     /* positions of diagonal components in _m */
+  zSpCholesky _chol;
+  zVec _rho;      /* step size of each row */
+  zVec _w;        /* inverse of the squared norm of each row to equilibrate step sizes */
+  zVec _xt, _px, _aty, _rhs; /* workspace on columns */
+  zVec _zt, _ax, _dy;        /* workspace on rows */
+  bool _factorized; /* true if _m is factorized for the current step sizes */
+  bool _warm;     /* true if the iterate is available for a warm start */
+  /*! \endcond */
+};
+
+/*! \brief default parameters of zQPADMM. */
+#define ZQP_ADMM_RHO          ( 0.1 )
+#define ZQP_ADMM_SIGMA        ( 1.0e-6 )
+#define ZQP_ADMM_ALPHA        ( 1.6 )
+#define ZQP_ADMM_TOL          ( 1.0e-6 )
+/*! \brief bound regarded as infinite. */
+#define ZQP_ADMM_INF          ( 1.0e20 )
+/*! \brief ratio of step sizes for equality constraints. */
+#define ZQP_ADMM_RHO_EQ       ( 1.0e3 )
+/*! \brief range of step sizes. */
+#define ZQP_ADMM_RHO_MIN      ( 1.0e-6 )
+#define ZQP_ADMM_RHO_MAX      ( 1.0e6 )
+/*! \brief interval of iterations to adapt the step size. */
+#define ZQP_ADMM_RHO_INTERVAL 25
+
+/*! \brief create and destroy an ADMM solver.
+ *
+ * zQPADMMCreate() creates a solver \a qp of a quadratic programming problem with a sparse quadratic
+ * coefficient matrix \a p and a sparse m x n constraint matrix \a a in any format, which are copied
+ * to \a qp. Only the upper triangular part of \a p is referred. \a a can be the null pointer for a
+ * problem only with box constraints. The cost vector is initialized for zero, and all the bounds are
+ * initialized for infinity.
+ *
+ * zQPADMMDestroy() destroys \a qp.
+ * \return
+ * zQPADMMCreate() returns a pointer \a qp, or the null pointer if the sizes of \a p and \a a
+ * mismatch, \a p is not positive semidefinite, or it fails to allocate memory.
+ *
+ * zQPADMMDestroy() returns no value.
+ */
+__ZM_EXPORT zQPADMM *zQPADMMCreate(zQPADMM *qp, const zSpMat p, const zSpMat a);
+__ZM_EXPORT void zQPADMMDestroy(zQPADMM *qp);
+
+/*! \brief modify the problem of an ADMM solver.
+ *
+ * zQPADMMSetCost() replaces the cost vector of \a qp with \a q.
+ *
+ * zQPADMMSetBound() sets the lower and upper bounds \a l and \a u of m general constraints of \a qp,
+ * while zQPADMMSetBox() sets those \a xl and \a xu of box constraints of n variables. The null pointer
+ * for either of them means infinity.
+ *
+ * zQPADMMWarmStart() sets the primal variables \a x and the Lagrange multipliers \a y of m + n
+ * constraints of \a qp for a warm start. The null pointer for either of them keeps the current one.
+ *
+ * They keep the current iterate of \a qp for a warm start, while zQPADMMReset() discards it, so that
+ * the next solution starts from zero.
+ * \return
+ * zQPADMMSetCost(), zQPADMMSetBound(), zQPADMMSetBox() and zQPADMMWarmStart() return the true value
+ * if they succeed, or the false value if the size of a given vector mismatches, or a lower bound is
+ * larger than the corresponding upper bound.
+ */
+__ZM_EXPORT bool zQPADMMSetCost(zQPADMM *qp, const zVec q);
+__ZM_EXPORT bool zQPADMMSetBound(zQPADMM *qp, const zVec l, const zVec u);
+__ZM_EXPORT bool zQPADMMSetBox(zQPADMM *qp, const zVec xl, const zVec xu);
+__ZM_EXPORT bool zQPADMMWarmStart(zQPADMM *qp, const zVec x, const zVec y);
+#define zQPADMMReset(qp) ( (qp)->_warm = false )
+
+/*! \brief solve a quadratic programming problem by ADMM.
+ *
+ * zQPADMMSolve() solves the problem of \a qp. The answer is put into \a ans, and the optimum value is
+ * stored where \a cost points, unless \a cost is the null pointer.
+ *
+ * zQPSolveADMM() is a counterpart of zQPSolveASM() with dense matrices \a q and \a a, which are
+ * converted to sparse matrices and solved by zQPADMMSolve().
+ * \return
+ * zQPADMMSolve() and zQPSolveADMM() return the true value if they succeed to get the optimum. The false
+ * value is returned if the size of \a ans mismatches, the problem is infeasible, the number of
+ * iterations exceeds the limit, or they fail to allocate memory.
+ */
+__ZM_EXPORT bool zQPADMMSolve(zQPADMM *qp, zVec ans, double *cost);
+__ZM_EXPORT bool zQPSolveADMM(const zMat q, const zVec c, const zMat a, const zVec b, zVec ans, double *cost);
+
 /*! \brief quadratic programming solver by conjugate gradient method.
  *
  * zCGSolve() is an implementation of quadratic programming without constraint conditions - finds the
@@ -8,6 +8,7 @@
 #define __ZM_RAW_H__
 
 #include <zm/zm_misc.h>
+#include <zm/zm_thread.h>
 
 /* ********************************************************** */
 /* CATEGORY:
@@ -17,5 +18,6 @@
 
 #include <zm/zm_raw_vec.h>
 #include <zm/zm_raw_mat.h>
+#include <zm/zm_raw_gemm.h>
 
 #endif /* __ZM_RAW_H__ */
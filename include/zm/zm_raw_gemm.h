@@ -0,0 +1,90 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_raw_gemm - raw vector and matrix : general matrix-matrix multiplication.
+ */
+
+#ifndef __ZM_RAW_GEMM_H__
+#define __ZM_RAW_GEMM_H__
+
+/* NOTE: never include this header file in user programs. */
+
+__BEGIN_DECLS
+
+/*! \brief block sizes of the packed matrix-matrix multiplication.
+ *
+ * A product is computed on ZM_RAW_GEMM_MR x ZM_RAW_GEMM_NR tiles by a register-tiled micro-kernel.
+ * Operands are packed into panels of ZM_RAW_GEMM_MC x ZM_RAW_GEMM_KC and ZM_RAW_GEMM_KC x ZM_RAW_GEMM_NC
+ * so that the panel of the left operand stays in L2 cache and that of the right operand in L3 cache.
+ */
+#define ZM_RAW_GEMM_MR    4
+#define ZM_RAW_GEMM_NR    8
+#define ZM_RAW_GEMM_MC  128
+#define ZM_RAW_GEMM_KC  256
+#define ZM_RAW_GEMM_NC 2048
+
+/*! \brief minimum number of multiply-add operations to invoke the packed matrix-matrix multiplication.
+ *
+ * zRawMulMatMat(), zRawMulMatMatT() and zRawMulMatTMat() fall back to the plain triple loops for
+ * products smaller than this, since packing does not pay off for small matrices.
+ */
+#define ZM_RAW_GEMM_THRESHOLD ( 64*64*64 )
+
+#define zRawGEMMIsSmall(rowsize,colsize,innersize) ( (double)(rowsize)*(colsize)*(innersize) < ZM_RAW_GEMM_THRESHOLD )
+
+/*! \brief micro-kernels of the packed matrix-matrix multiplication.
+ *
+ * ZM_RAW_GEMM_KERNEL_AUTO lets zRawGEMMSelectKernel() choose the fastest one available on the
+ * running processor.
+ */
+typedef enum{
+  ZM_RAW_GEMM_KERNEL_AUTO = 0,
+  ZM_RAW_GEMM_KERNEL_SCALAR,
+  ZM_RAW_GEMM_KERNEL_SSE2,
+  ZM_RAW_GEMM_KERNEL_AVX2
+} zRawGEMMKernelType;
+
+/*! \brief select a micro-kernel of the packed matrix-matrix multiplication.
+ *
+ * zRawGEMMSelectKernel() selects a micro-kernel \a type to be used in zRawGEMM(). If \a type is
+ * ZM_RAW_GEMM_KERNEL_AUTO or the specified kernel is not supported by the running processor, the
+ * fastest one available is chosen at runtime; AVX2/FMA, SSE2 and a portable scalar kernel are tried
+ * in this order.
+ *
+ * zRawGEMMKernel() returns the type of the currently selected micro-kernel. If no kernel has been
+ * selected yet, it selects one automatically.
+ * \return
+ * zRawGEMMSelectKernel() and zRawGEMMKernel() return the type of the selected micro-kernel.
+ */
+__ZM_EXPORT zRawGEMMKernelType zRawGEMMSelectKernel(zRawGEMMKernelType type);
+__ZM_EXPORT zRawGEMMKernelType zRawGEMMKernel(void);
+
+/*! \brief general matrix-matrix multiplication of raw matrices.
+ *
+ * zRawGEMM() computes \a m = \a alpha op( \a m1 ) op( \a m2 ) + \a beta \a m, where op( \a m1 ) is
+ * the transpose of \a m1 if \a trans1 is the true value, or \a m1 itself otherwise. The same applies
+ * to op( \a m2 ) with \a trans2.
+ * \a rowsize and \a colsize are the row and column sizes of \a m, and \a innersize is the column size
+ * of op( \a m1 ), namely, the row size of op( \a m2 ).
+ * \a colcapacity1, \a colcapacity2 and \a colcapacity3 are the maximum column sizes allocated for
+ * \a m1, \a m2 and \a m, respectively.
+ *
+ * If \a beta is zero, \a m is not referred before being overwritten.
+ * \a m must not overlap \a m1 or \a m2.
+ *
+ * zRawGEMMThread() is a multithreaded version of zRawGEMM(). \a m is split into row or column stripes,
+ * which are computed on at most \a num threads. If \a num is zero or negative, the default number of
+ * threads zThreadNum() is applied. zRawGEMM() is equivalent to zRawGEMMThread() with \a num being zero.
+ * The result does not depend on the number of threads.
+ * \return
+ * zRawGEMM() and zRawGEMMThread() return the false value if they fail to allocate the internal
+ * workspace. Otherwise, they return the true value.
+ * \sa
+ * zThreadSetNum
+ */
+__ZM_EXPORT bool zRawGEMM(bool trans1, bool trans2, int rowsize, int colsize, int innersize, double alpha, const double *m1, int colcapacity1, const double *m2, int colcapacity2, double beta, double *m, int colcapacity3);
+__ZM_EXPORT bool zRawGEMMThread(bool trans1, bool trans2, int rowsize, int colsize, int innersize, double alpha, const double *m1, int colcapacity1, const double *m2, int colcapacity2, double beta, double *m, int colcapacity3, int num);
+
+__END_DECLS
+
+#endif /* __ZM_RAW_GEMM_H__ */
@@ -302,6 +302,8 @@ __ZM_EXPORT double zRawMatTrace(const double *m, int colcapacity, int rowsize, i
  * zRawMulMatTMat() multiplies \a m2 by the transpose of \a m1 from the left side. The sizes of
  * \a m1 and \a m2 are \a r1 x \a c1 and \a r1 x \a c2.
  * For those functions, the result is put into \a m.
+ * If the product is larger than ZM_RAW_GEMM_THRESHOLD, they are computed by the packed matrix-matrix
+ * multiplication zRawGEMM().
  * \return
  * These functions return no values.
  */
@@ -0,0 +1,192 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_spmat - sparse matrix class.
+ */
+
+#ifndef __ZM_SPMAT_H__
+#define __ZM_SPMAT_H__
+
+#include <zm/zm_mat.h>
+
+__BEGIN_DECLS
+
+/*! \brief storage format of a sparse matrix.
+ *
+ * ZM_SPMAT_CSR is the compressed sparse row format, and ZM_SPMAT_CSC the compressed sparse column format.
+ */
+typedef enum{
+  ZM_SPMAT_CSR = 0,
+  ZM_SPMAT_CSC
+} zSpMatFormat;
+
+/*! \struct zSpMat
+ * \brief sparse matrix class.
+ *
+ * A sparse matrix stores only nonzero components in the compressed sparse row (CSR) or the compressed
+ * sparse column (CSC) format.
+ * In the CSR format, column indices and values of components on the i-th row are stored in
+ * \a ind[\a ptr[i]], ..., \a ind[\a ptr[i+1]-1] and \a val[\a ptr[i]], ..., \a val[\a ptr[i+1]-1],
+ * respectively, in ascending order of column indices. The CSC format stores components column by
+ * column with row indices in the same manner.
+ * \a nnz is the number of stored components, and \a capacity is the allocated size of \a ind and \a val.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zSpMatStruct ){
+  zSpMatFormat format; /*!< storage format */
+  int rowsize;         /*!< number of rows */
+  int colsize;         /*!< number of columns */
+  int nnz;             /*!< number of stored components */
+  int capacity;        /*!< allocated size of index and value arrays */
+  int *ptr;            /*!< offsets of rows (CSR) or columns (CSC) */
+  int *ind;            /*!< column (CSR) or row (CSC) indices */
+  double *val;         /*!< values of components */
+};
+typedef zSpMatStruct * zSpMat;
+
+#define zSpMatRowSize(m)  (m)->rowsize
+#define zSpMatColSize(m)  (m)->colsize
+#define zSpMatNNZ(m)      (m)->nnz
+#define zSpMatIsCSR(m)    ( (m)->format == ZM_SPMAT_CSR )
+#define zSpMatIsCSC(m)    ( (m)->format == ZM_SPMAT_CSC )
+/*! \brief number of compressed lines, namely, rows in CSR and columns in CSC. */
+#define zSpMatLineSize(m) ( zSpMatIsCSR(m) ? (m)->rowsize : (m)->colsize )
+
+/*! \brief iterate stored components of a sparse matrix.
+ *
+ * zSpMatForEach() iterates all stored components of a sparse matrix \a m, where \a l is the index of
+ * a compressed line (row in CSR and column in CSC) and \a k is the position of a component in \a ind
+ * and \a val.
+ */
+#define zSpMatForEach(m,l,k) \
+  for( (l)=0; (l)<zSpMatLineSize(m); (l)++ ) \
+    for( (k)=(m)->ptr[l]; (k)<(m)->ptr[(l)+1]; (k)++ )
+/*! \brief row and column of a stored component iterated by zSpMatForEach(). */
+#define zSpMatIterRow(m,l,k) ( zSpMatIsCSR(m) ? (l) : (m)->ind[k] )
+#define zSpMatIterCol(m,l,k) ( zSpMatIsCSR(m) ? (m)->ind[k] : (l) )
+
+/*! \brief allocate, clone and free a sparse matrix.
+ *
+ * zSpMatAlloc() allocates a \a rowsize x \a colsize sparse matrix with no stored components in
+ * the format \a format. \a capacity is the initial size of index and value arrays.
+ *
+ * zSpMatClone() clones a sparse matrix \a src.
+ *
+ * zSpMatFree() frees a sparse matrix \a m.
+ * \return
+ * zSpMatAlloc() and zSpMatClone() return a pointer to the newly allocated matrix, or the null pointer
+ * if they fail to allocate memory.
+ *
+ * zSpMatFree() returns no value.
+ */
+__ZM_EXPORT zSpMat zSpMatAlloc(int rowsize, int colsize, int capacity, zSpMatFormat format);
+__ZM_EXPORT zSpMat zSpMatClone(const zSpMat src);
+__ZM_EXPORT void zSpMatFree(zSpMat m);
+
+/*! \brief component of a sparse matrix.
+ *
+ * zSpMatElem() returns the component of a sparse matrix \a m at the \a row th row and the \a col th
+ * column, which is found by a binary search. If it is not stored, zero is returned.
+ */
+__ZM_EXPORT double zSpMatElem(const zSpMat m, int row, int col);
+
+/*! \struct zSpTriplet
+ * \brief triplet list to assemble a sparse matrix.
+ *
+ * A triplet list stores components of a sparse matrix as triplets of row and column indices and a value
+ * in arbitrary order. Duplicated components are summed up when a sparse matrix is created.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zSpTriplet ){
+  int size;     /*!< number of triplets */
+  int capacity; /*!< allocated size of arrays */
+  int *row;     /*!< row indices */
+  int *col;     /*!< column indices */
+  double *val;  /*!< values */
+};
+
+/*! \brief assemble a sparse matrix from triplets.
+ *
+ * zSpTripletInit() initializes a triplet list \a t.
+ *
+ * zSpTripletAlloc() allocates arrays of \a t for \a capacity triplets.
+ *
+ * zSpTripletAdd() adds a triplet of \a row, \a col and \a val to \a t. If the arrays are full, they are
+ * reallocated with double the size.
+ *
+ * zSpTripletFree() frees arrays of \a t.
+ *
+ * zSpMatFromTriplet() creates a \a rowsize x \a colsize sparse matrix in the format \a format from
+ * \a t. Values of duplicated components are summed up.
+ * \return
+ * zSpTripletInit() returns a pointer \a t.
+ *
+ * zSpTripletAlloc() returns a pointer \a t, or the null pointer if it fails to allocate memory.
+ *
+ * zSpTripletAdd() returns the false value if \a row or \a col is negative or it fails to reallocate
+ * memory. Otherwise, it returns the true value.
+ *
+ * zSpTripletFree() returns no value.
+ *
+ * zSpMatFromTriplet() returns a pointer to the newly allocated sparse matrix. If a triplet is out of
+ * the size or it fails to allocate memory, the null pointer is returned.
+ */
+__ZM_EXPORT zSpTriplet *zSpTripletInit(zSpTriplet *t);
+__ZM_EXPORT zSpTriplet *zSpTripletAlloc(zSpTriplet *t, int capacity);
+__ZM_EXPORT bool zSpTripletAdd(zSpTriplet *t, int row, int col, double val);
+__ZM_EXPORT void zSpTripletFree(zSpTriplet *t);
+__ZM_EXPORT zSpMat zSpMatFromTriplet(const zSpTriplet *t, int rowsize, int colsize, zSpMatFormat format);
+
+/*! \brief conversion between sparse and dense matrices.
+ *
+ * zSpMatFromMat() creates a sparse matrix in the format \a format from a dense matrix \a m, where
+ * components whose absolute values are not larger than \a tol are dropped.
+ *
+ * zSpMatToMat() copies a sparse matrix \a sp to a dense matrix \a m.
+ *
+ * zSpMatConvert() creates a sparse matrix in the format \a format with the same components of \a sp.
+ *
+ * zSpMatT() creates the transpose of \a sp in the same format.
+ * \return
+ * zSpMatFromMat(), zSpMatConvert() and zSpMatT() return a pointer to the newly allocated sparse matrix,
+ * or the null pointer if they fail to allocate memory.
+ *
+ * zSpMatToMat() returns a pointer \a m, or the null pointer if the sizes of \a sp and \a m mismatch.
+ */
+__ZM_EXPORT zSpMat zSpMatFromMat(const zMat m, double tol, zSpMatFormat format);
+__ZM_EXPORT zMat zSpMatToMat(const zSpMat sp, zMat m);
+__ZM_EXPORT zSpMat zSpMatConvert(const zSpMat sp, zSpMatFormat format);
+__ZM_EXPORT zSpMat zSpMatT(const zSpMat sp);
+
+/*! \brief multiply a vector by a sparse matrix.
+ *
+ * zSpMatMulVec() multiplies a vector \a v by a sparse matrix \a m, and puts the result into \a mv.
+ *
+ * zSpMatTMulVec() multiplies \a v by the transpose of \a m, and puts the result into \a mv.
+ *
+ * Inner products along compressed lines, namely, zSpMatMulVec() for the CSR format and zSpMatTMulVec()
+ * for the CSC format, run on multiple threads if the default number of threads zThreadNum() is more
+ * than one, while the others scatter products to \a mv on the calling thread.
+ *
+ * The NC versions do not check the size consistency of \a m, \a v and \a mv.
+ * \return
+ * zSpMatMulVec() and zSpMatTMulVec() return a pointer \a mv, or the null pointer if the sizes of
+ * \a m, \a v and \a mv mismatch.
+ */
+__ZM_EXPORT zVec zSpMatMulVecNC(const zSpMat m, const zVec v, zVec mv);
+__ZM_EXPORT zVec zSpMatMulVec(const zSpMat m, const zVec v, zVec mv);
+__ZM_EXPORT zVec zSpMatTMulVecNC(const zSpMat m, const zVec v, zVec mv);
+__ZM_EXPORT zVec zSpMatTMulVec(const zSpMat m, const zVec v, zVec mv);
+
+/*! \brief print a sparse matrix.
+ *
+ * zSpMatFPrint() prints a sparse matrix \a m to the current position of a file \a fp as a list of
+ * triplets of row and column indices and values.
+ * zSpMatPrint() prints \a m to the standard output.
+ * \return
+ * zSpMatFPrint() and zSpMatPrint() return no values.
+ */
+__ZM_EXPORT void zSpMatFPrint(FILE *fp, const zSpMat m);
+#define zSpMatPrint(m) zSpMatFPrint( stdout, (m) )
+
+__END_DECLS
+
+#endif /* __ZM_SPMAT_H__ */
@@ -0,0 +1,148 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ */
+/*! \file zm_thread.h
+ * \brief thread pool for parallel computation.
+ * \author Zhidao
+ */
+
+#ifndef __ZM_THREAD_H__
+#define __ZM_THREAD_H__
+
+#include <zm/zm_misc.h>
+
+__BEGIN_DECLS
+
+/*! \brief functions to be executed in parallel.
+ *
+ * A zThreadFunc function processes a partial range [ \a from, \a to ) of an index range given to
+ * zThreadPoolFor(). A zThreadReduceFunc function computes a partial value for [ \a from, \a to ),
+ * which is summed up by zThreadPoolReduce(). \a util is a utility pointer shared by all threads.
+ */
+typedef void (* zThreadFunc)(void *util, int from, int to);
+typedef double (* zThreadReduceFunc)(void *util, int from, int to);
+
+/*! \struct zThreadPool
+ * \brief thread pool with work stealing.
+ *
+ * A thread pool keeps \a num - 1 worker threads; the thread calling zThreadPoolFor() works as the
+ * remaining one. An index range is split into chunks, which are distributed to the threads evenly at
+ * first. A thread that has exhausted its own chunks steals a half of the remaining ones of another.
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zThreadPool ){
+  int num; /*!< number of threads including the caller */
+  struct _zThreadPoolInternal *_internal;
+};
+
+/*! \brief create and destroy a thread pool.
+ *
+ * zThreadPoolCreate() creates a thread pool \a pool with \a num threads including the calling thread.
+ * If \a num is less than one, or if the library is built without thread support, \a pool runs any
+ * job only on the calling thread.
+ *
+ * zThreadPoolDestroy() terminates all worker threads of \a pool and frees the internal workspace.
+ * \return
+ * zThreadPoolCreate() returns a pointer \a pool if it succeeds. Otherwise, it returns the null pointer.
+ *
+ * zThreadPoolDestroy() returns no value.
+ */
+__ZM_EXPORT zThreadPool *zThreadPoolCreate(zThreadPool *pool, int num);
+__ZM_EXPORT void zThreadPoolDestroy(zThreadPool *pool);
+
+/*! \brief parallel loop and reduction on a thread pool.
+ *
+ * zThreadPoolFor() executes \a func for an index range [ \a from, \a to ) on a thread pool \a pool.
+ * The range is split into chunks of \a grain indices, each of which is processed by one call of
+ * \a func. At most \a num threads participate in the job; if \a num is zero or negative, all threads
+ * of \a pool do. If \a pool is already running another job, for example, when zThreadPoolFor() is
+ * called from \a func, the job is executed on the calling thread.
+ *
+ * zThreadPoolReduce() computes the sum of values returned by \a func over [ \a from, \a to ). Partial
+ * values of the chunks are summed up in the order of indices, so that the result does not depend on
+ * the number of threads and the scheduling.
+ * \return
+ * zThreadPoolFor() returns the false value if \a grain is not positive. Otherwise, it returns the
+ * true value.
+ *
+ * zThreadPoolReduce() returns the sum.
+ */
+__ZM_EXPORT bool zThreadPoolFor(zThreadPool *pool, int num, int from, int to, int grain, zThreadFunc func, void *util);
+__ZM_EXPORT double zThreadPoolReduce(zThreadPool *pool, int num, int from, int to, int grain, zThreadReduceFunc func, void *util);
+
+/*! \struct zThreadCounter
+ * \brief monotonic counter to synchronize pipelined jobs.
+ *
+ * A job on a thread pool can be pipelined by counters, each of which tells how far a chunk has
+ * proceeded, so that a chunk depending on the partial result of another waits until it is available.
+ * The value of a counter has to be accessed only through zThreadCounterSet() and zThreadCounterWait().
+ */
+ZDEF_STRUCT( __ZM_CLASS_EXPORT, zThreadCounter ){
+  int value; /*!< current value */
+  struct _zThreadCounterInternal *_internal;
+};
+
+/*! \brief initialize, destroy, set and wait a counter.
+ *
+ * zThreadCounterInit() initializes a counter \a counter with zero.
+ *
+ * zThreadCounterDestroy() destroys \a counter.
+ *
+ * zThreadCounterSet() sets the value of \a counter for \a value, and wakes up threads waiting for it.
+ *
+ * zThreadCounterWait() blocks the calling thread until the value of \a counter gets equal to or larger
+ * than \a value. If the library is built without thread support, it returns immediately, since all
+ * chunks are executed in the order of indices on the calling thread; a chunk may depend only on
+ * those with smaller indices, which is also necessary to avoid a deadlock when threads are fewer than
+ * the chunks.
+ * \return
+ * zThreadCounterInit() returns a pointer \a counter, or the null pointer if it fails to allocate memory.
+ *
+ * zThreadCounterDestroy() and zThreadCounterSet() return no value.
+ *
+ * zThreadCounterWait() returns the value of \a counter.
+ */
+__ZM_EXPORT zThreadCounter *zThreadCounterInit(zThreadCounter *counter);
+__ZM_EXPORT void zThreadCounterDestroy(zThreadCounter *counter);
+__ZM_EXPORT void zThreadCounterSet(zThreadCounter *counter, int value);
+__ZM_EXPORT int zThreadCounterWait(zThreadCounter *counter, int value);
+
+/*! \brief the default number of threads.
+ *
+ * zThreadSetNum() sets the default number of threads used by parallelized functions of ZM for \a num.
+ * The default thread pool is created with \a num threads. If \a num is zero or negative, the number is
+ * read from an environment variable ZM_THREAD_NUM; if it is not set, one thread is used, namely,
+ * computation is not parallelized.
+ *
+ * zThreadNum() returns the default number of threads.
+ *
+ * zThreadPoolDefault() returns a pointer to the default thread pool. It has at least \a num threads
+ * if \a num is larger than the default number of threads.
+ *
+ * zThreadFor() and zThreadReduce() are zThreadPoolFor() and zThreadPoolReduce() on the default thread
+ * pool, respectively, for which at most \a num threads participate in the job. If \a num is zero or
+ * negative, the default number of threads is applied.
+ * \return
+ * zThreadSetNum() and zThreadNum() return the default number of threads.
+ *
+ * zThreadPoolDefault() returns a pointer to the default thread pool.
+ */
+__ZM_EXPORT int zThreadSetNum(int num);
+__ZM_EXPORT int zThreadNum(void);
+__ZM_EXPORT zThreadPool *zThreadPoolDefault(int num);
+
+#define zThreadFor(num,from,to,grain,func,util) \
+  zThreadPoolFor( zThreadPoolDefault( num ), (num) > 0 ? (num) : zThreadNum(), from, to, grain, func, util )
+#define zThreadReduce(num,from,to,grain,func,util) \
+  zThreadPoolReduce( zThreadPoolDefault( num ), (num) > 0 ? (num) : zThreadNum(), from, to, grain, func, util )
+
+/*! \brief grain size of a parallel loop.
+ *
+ * zThreadGrain() returns a grain size to split \a size indices into about four chunks per thread
+ * for \a num threads, which is rounded up to a multiple of \a unit.
+ */
+#define zThreadGrain(size,num,unit) \
+  ( ( ( (size) + 4*(num) - 1 ) / ( 4*(num) ) + (unit) - 1 ) / (unit) * (unit) )
+
+__END_DECLS
+
+#endif /* __ZM_THREAD_H__ */
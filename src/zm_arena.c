@@ -0,0 +1,154 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_arena - arena allocator of temporary vectors and matrices.
+ */
+
+#include <zm/zm_arena.h>
+
+/* round up a number of bytes to the alignment. */
+#define _zArenaRoundUp(n) ( ( (n) + ZM_ARENA_ALIGN - 1 ) / ZM_ARENA_ALIGN * ZM_ARENA_ALIGN )
+
+/* initialize an arena. */
+zArena *zArenaInit(zArena *arena)
+{
+  arena->buf = NULL;
+  arena->size = arena->used = arena->peak = 0;
+  arena->_block = NULL;
+  return arena;
+}
+
+/* assign a memory block to an arena with the head aligned. */
+static zArena *_zArenaAssign(zArena *arena, void *buf, size_t size)
+{
+  size_t offset;
+
+  offset = _zArenaRoundUp( (size_t)buf ) - (size_t)buf;
+  if( size < offset ) return NULL;
+  arena->buf = (char *)buf + offset;
+  arena->size = ( size - offset ) / ZM_ARENA_ALIGN * ZM_ARENA_ALIGN;
+  arena->used = arena->peak = 0;
+  return arena;
+}
+
+/* allocate a memory block for an arena. */
+zArena *zArenaAlloc(zArena *arena, size_t size)
+{
+  zArenaInit( arena );
+  size = _zArenaRoundUp( size );
+  if( !( arena->_block = malloc( size + ZM_ARENA_ALIGN - 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  return _zArenaAssign( arena, arena->_block, size + ZM_ARENA_ALIGN - 1 );
+}
+
+/* assign a memory block prepared by the caller to an arena. */
+zArena *zArenaAssign(zArena *arena, void *buf, size_t size)
+{
+  zArenaInit( arena );
+  return _zArenaAssign( arena, buf, size );
+}
+
+/* free an arena. */
+void zArenaFree(zArena *arena)
+{
+  free( arena->_block );
+  zArenaInit( arena );
+}
+
+/* number of bytes of an arena to carve a memory chunk. */
+size_t zArenaSize(size_t size)
+{
+  return _zArenaRoundUp( size );
+}
+
+/* number of bytes of an arena to carve a vector. */
+size_t zArenaVecSize(int size)
+{
+  return zArenaSize( sizeof(zVecStruct) ) + zArenaSize( sizeof(double)*size );
+}
+
+/* number of bytes of an arena to carve a matrix. */
+size_t zArenaMatSize(int row, int col)
+{
+  return zArenaSize( sizeof(zMatStruct) ) + zArenaSize( sizeof(double)*row*col );
+}
+
+/* number of bytes of an arena to carve an index. */
+size_t zArenaIndexSize(int size)
+{
+  return zArenaSize( sizeof(zIntArray) ) + zArenaSize( sizeof(int)*size );
+}
+
+/* carve a memory chunk from an arena. */
+void *zArenaCarve(zArena *arena, size_t size)
+{
+  void *ptr;
+
+  size = _zArenaRoundUp( size );
+  if( size > zArenaRemain(arena) ){
+    ZRUNERROR( ZM_ERR_ARENA_SHORTAGE, (unsigned long)size, (unsigned long)zArenaRemain(arena) );
+    return NULL;
+  }
+  ptr = arena->buf + arena->used;
+  if( ( arena->used += size ) > arena->peak ) arena->peak = arena->used;
+  return ptr;
+}
+
+/* create a vector on an arena. */
+zVec zArenaVecAlloc(zArena *arena, int size)
+{
+  zVec v;
+  char *ptr;
+
+  if( !arena ) return zVecAlloc( size );
+  if( !( ptr = (char *)zArenaCarve( arena, zArenaVecSize( size ) ) ) ) return NULL;
+  v = (zVec)ptr;
+  zVecAssignArray( v, size, (double *)( ptr + zArenaSize( sizeof(zVecStruct) ) ) );
+  return zVecZero( v );
+}
+
+/* create a matrix on an arena. */
+zMat zArenaMatAlloc(zArena *arena, int row, int col)
+{
+  zMat m;
+  char *ptr;
+
+  if( !arena ) return zMatAlloc( row, col );
+  if( !( ptr = (char *)zArenaCarve( arena, zArenaMatSize( row, col ) ) ) ) return NULL;
+  m = (zMat)ptr;
+  zMatAssignArray( m, row, col, (double *)( ptr + zArenaSize( sizeof(zMatStruct) ) ) );
+  return zMatZero( m );
+}
+
+/* create an index on an arena. */
+zIndex zArenaIndexCreate(zArena *arena, int size)
+{
+  zIndex idx;
+  char *ptr;
+
+  if( !arena ) return zIndexCreate( size );
+  if( !( ptr = (char *)zArenaCarve( arena, zArenaIndexSize( size ) ) ) ) return NULL;
+  idx = (zIndex)ptr;
+  zArrayAssign( idx, (int *)( ptr + zArenaSize( sizeof(zIntArray) ) ), size );
+  return zIndexOrder( idx, 0 );
+}
+
+/* free a vector unless it is on an arena. */
+void zArenaVecFree(zArena *arena, zVec v)
+{
+  if( !arena ) zVecFree( v );
+}
+
+/* free a matrix unless it is on an arena. */
+void zArenaMatFree(zArena *arena, zMat m)
+{
+  if( !arena ) zMatFree( m );
+}
+
+/* free an index unless it is on an arena. */
+void zArenaIndexFree(zArena *arena, zIndex idx)
+{
+  if( !arena ) zIndexFree( idx );
+}
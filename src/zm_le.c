@@ -183,10 +183,19 @@ zVec zLESolveGauss(const zMat a, const zVec b, zVec ans)
   bcp = zVecClone( b );
   s = zVecAlloc( zVecSizeNC(b) );
   idx = zIndexCreate( zVecSizeNC(b) );
-  if( acp && bcp && idx && s )
+  if( acp && bcp && idx && s ){
+    if( zVecSizeNC(b) >= ZM_LE_LU_BLOCK_THRESHOLD ){
+      if( zMatDecompLUBlockDST( acp, idx ) == zVecSizeNC(b) ){
+        ans = zLESolveLUBlock( acp, idx, b, ans );
+        goto TERMINATE;
+      }
+      zMatCopyNC( a, acp );
+      zIndexOrder( idx, 0 );
+    }
     ans = zLESolveGaussDST( acp, bcp, ans, idx, s );
-  else
+  } else
     ZALLOCERROR();
+ TERMINATE:
   zMatFree( acp );
   zVecFree( bcp );
   zVecFree( s );
@@ -0,0 +1,352 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_le_facto - linear equation: reusable factorization of symmetric matrices.
+ */
+
+#include <zm/zm_le.h>
+
+/* initialize a factorization. */
+zLEFacto *zLEFactoInit(zLEFacto *f)
+{
+  f->type = ZM_LE_FACTO_NONE;
+  f->l = NULL;
+  f->d = f->e = NULL;
+  f->idx = NULL;
+  f->_v = NULL;
+  return f;
+}
+
+/* allocate internal workspace of a factorization. */
+zLEFacto *zLEFactoAlloc(zLEFacto *f, int size)
+{
+  zLEFactoInit( f );
+  f->l = zMatAllocSqr( size );
+  f->d = zVecAlloc( size );
+  f->e = zVecAlloc( size );
+  f->idx = zIndexCreate( size );
+  f->_v = zVecAlloc( size );
+  if( !f->l || !f->d || !f->e || !f->idx || !f->_v ){
+    zLEFactoFree( f );
+    return NULL;
+  }
+  return f;
+}
+
+/* free internal workspace of a factorization. */
+void zLEFactoFree(zLEFacto *f)
+{
+  zMatFree( f->l );
+  zVecFreeAtOnce( 3, f->d, f->e, f->_v );
+  zIndexFree( f->idx );
+  zLEFactoInit( f );
+}
+
+/* subtract a product of raw matrices 'c -= op(a) b', where op(a) is the transpose of a if trans is true. */
+static void _zLEFactoSub(bool trans, const double *a, int acolcapacity, const double *b, int bcolcapacity, double *c, int ccolcapacity, int rowsize, int colsize, int innersize)
+{
+  int i, k;
+
+  if( rowsize <= 0 || colsize <= 0 || innersize <= 0 ) return;
+  if( !zRawGEMMIsSmall( rowsize, colsize, innersize ) &&
+      zRawGEMM( trans, false, rowsize, colsize, innersize, -1.0, a, acolcapacity, b, bcolcapacity, 1.0, c, ccolcapacity ) )
+    return;
+  for( i=0; i<rowsize; i++ )
+    for( k=0; k<innersize; k++ )
+      zRawVecCatDRC( c+i*ccolcapacity, -( trans ? a[k*acolcapacity+i] : a[i*acolcapacity+k] ), b+k*bcolcapacity, colsize );
+}
+
+/* solve 'l x = b' for a lower triangular raw matrix l, where x is overwritten to b. */
+static void _zLEFactoSolveL(const double *l, int lcolcapacity, double *x, int xcolcapacity, int size, int colsize, bool unit)
+{
+  int i, k, size1;
+
+  if( size <= ZM_LE_LU_BLOCK_MIN ){
+    for( i=0; i<size; i++ ){
+      for( k=0; k<i; k++ )
+        zRawVecCatDRC( x+i*xcolcapacity, -l[i*lcolcapacity+k], x+k*xcolcapacity, colsize );
+      if( !unit ) zRawVecDivDRC( x+i*xcolcapacity, l[i*lcolcapacity+i], colsize );
+    }
+    return;
+  }
+  size1 = size / 2;
+  _zLEFactoSolveL( l, lcolcapacity, x, xcolcapacity, size1, colsize, unit );
+  _zLEFactoSub( false, l+size1*lcolcapacity, lcolcapacity, x, xcolcapacity, x+size1*xcolcapacity, xcolcapacity, size-size1, colsize, size1 );
+  _zLEFactoSolveL( l+size1*(lcolcapacity+1), lcolcapacity, x+size1*xcolcapacity, xcolcapacity, size-size1, colsize, unit );
+}
+
+/* solve 'l^T x = b' for a lower triangular raw matrix l, where x is overwritten to b. */
+static void _zLEFactoSolveLT(const double *l, int lcolcapacity, double *x, int xcolcapacity, int size, int colsize, bool unit)
+{
+  int i, k, size1;
+
+  if( size <= ZM_LE_LU_BLOCK_MIN ){
+    for( i=size-1; i>=0; i-- ){
+      for( k=i+1; k<size; k++ )
+        zRawVecCatDRC( x+i*xcolcapacity, -l[k*lcolcapacity+i], x+k*xcolcapacity, colsize );
+      if( !unit ) zRawVecDivDRC( x+i*xcolcapacity, l[i*lcolcapacity+i], colsize );
+    }
+    return;
+  }
+  size1 = size / 2;
+  _zLEFactoSolveLT( l+size1*(lcolcapacity+1), lcolcapacity, x+size1*xcolcapacity, xcolcapacity, size-size1, colsize, unit );
+  _zLEFactoSub( true, l+size1*lcolcapacity, lcolcapacity, x+size1*xcolcapacity, xcolcapacity, x, xcolcapacity, size1, colsize, size-size1 );
+  _zLEFactoSolveLT( l, lcolcapacity, x, xcolcapacity, size1, colsize, unit );
+}
+
+/* solve 'd x = b' for a block diagonal matrix d, where x is overwritten to b. */
+static void _zLEFactoSolveD(const zLEFacto *f, double *x, int xcolcapacity, int colsize)
+{
+  int j, k;
+  double det, x0, x1, *xk;
+
+  for( k=0; k<zVecSizeNC(f->d); k++ ){
+    xk = x + k*xcolcapacity;
+    if( zVecElemNC(f->e,k) == 0 ){
+      zRawVecDivDRC( xk, zVecElemNC(f->d,k), colsize );
+      continue;
+    }
+    det = zVecElemNC(f->d,k) * zVecElemNC(f->d,k+1) - zSqr( zVecElemNC(f->e,k) );
+    for( j=0; j<colsize; j++ ){
+      x0 = xk[j];
+      x1 = xk[xcolcapacity+j];
+      xk[j] = ( zVecElemNC(f->d,k+1) * x0 - zVecElemNC(f->e,k) * x1 ) / det;
+      xk[xcolcapacity+j] = ( zVecElemNC(f->d,k) * x1 - zVecElemNC(f->e,k) * x0 ) / det;
+    }
+    k++;
+  }
+}
+
+/* solve permuted equations 'P A P^T x = b' with a factorization, where x is overwritten to b. */
+static void _zLEFactoSolveRaw(const zLEFacto *f, double *x, int xcolcapacity, int colsize)
+{
+  bool unit;
+
+  unit = f->type == ZM_LE_FACTO_LDL;
+  _zLEFactoSolveL( zMatBufNC(f->l), zMatColCapacity(f->l), x, xcolcapacity, zMatRowSizeNC(f->l), colsize, unit );
+  if( unit ) _zLEFactoSolveD( f, x, xcolcapacity, colsize );
+  _zLEFactoSolveLT( zMatBufNC(f->l), zMatColCapacity(f->l), x, xcolcapacity, zMatRowSizeNC(f->l), colsize, unit );
+}
+
+/* copy the lower triangular part of a matrix to a factorization. */
+static bool _zLEFactoCopy(zLEFacto *f, const zMat a)
+{
+  int i;
+
+  if( !zMatIsSqr( a ) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return false;
+  }
+  if( !zMatSizeEqual( a, f->l ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return false;
+  }
+  f->type = ZM_LE_FACTO_NONE;
+  zIndexOrder( f->idx, 0 );
+  for( i=0; i<zMatRowSizeNC(a); i++ )
+    zRawVecCopy( zMatRowBufNC(a,i), zMatRowBufNC(f->l,i), i+1 );
+  return true;
+}
+
+/* clean the strictly upper triangular part of a lower triangular factor. */
+static void _zLEFactoClean(zLEFacto *f, bool unit)
+{
+  int i;
+
+  for( i=0; i<zMatRowSizeNC(f->l); i++ ){
+    zRawVecZero( zMatRowBufNC(f->l,i)+i+1, zMatColSizeNC(f->l)-i-1 );
+    if( unit ) zMatSetElemNC( f->l, i, i, 1 );
+  }
+}
+
+/* Cholesky factorization of a positive definite symmetric matrix. */
+bool zLEFactoCholesky(zLEFacto *f, const zMat a)
+{
+  int rank;
+
+  if( !_zLEFactoCopy( f, a ) ) return false;
+  if( ( rank = zMatDecompCholeskyBlockDST( f->l, f->idx ) ) < 0 ) return false;
+  if( rank < zMatRowSizeNC(a) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTPOSITIVEDEFINITE );
+    return false;
+  }
+  _zLEFactoClean( f, false );
+  zVecZero( f->d );
+  zVecZero( f->e );
+  f->type = ZM_LE_FACTO_CHOLESKY;
+  return true;
+}
+
+/* LDL^T factorization of a symmetric matrix. */
+bool zLEFactoLDL(zLEFacto *f, const zMat a)
+{
+  int rank;
+
+  if( !_zLEFactoCopy( f, a ) ) return false;
+  if( ( rank = zMatDecompLDLDST( f->l, f->d, f->e, f->idx ) ) < 0 ) return false;
+  if( rank < zMatRowSizeNC(a) ){
+    ZRUNERROR( ZM_ERR_MAT_SINGULAR );
+    return false;
+  }
+  _zLEFactoClean( f, true );
+  f->type = ZM_LE_FACTO_LDL;
+  return true;
+}
+
+/* solve a linear equation with a factorization. */
+zVec zLEFactoSolve(zLEFacto *f, const zVec b, zVec ans)
+{
+  int i;
+
+  if( f->type == ZM_LE_FACTO_NONE ){
+    ZRUNERROR( ZM_ERR_LE_FACTO_NOTFACTORIZED );
+    return NULL;
+  }
+  if( zMatRowSizeNC(f->l) != zVecSize(b) || !zVecSizeEqual( b, ans ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  for( i=0; i<zVecSizeNC(b); i++ )
+    zVecSetElemNC( f->_v, i, zVecElemNC(b,zIndexElemNC(f->idx,i)) );
+  _zLEFactoSolveRaw( f, zVecBufNC(f->_v), 1, 1 );
+  for( i=0; i<zVecSizeNC(b); i++ )
+    zVecSetElemNC( ans, zIndexElemNC(f->idx,i), zVecElemNC(f->_v,i) );
+  return ans;
+}
+
+/* solve linear equations with a factorization for a matrix. */
+zMat zLEFactoSolveMat(zLEFacto *f, const zMat b, zMat ans)
+{
+  zMat x;
+  int i;
+
+  if( f->type == ZM_LE_FACTO_NONE ){
+    ZRUNERROR( ZM_ERR_LE_FACTO_NOTFACTORIZED );
+    return NULL;
+  }
+  if( zMatRowSizeNC(f->l) != zMatRowSize(b) || !zMatSizeEqual( b, ans ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  if( !( x = zMatAlloc( zMatRowSizeNC(b), zMatColSizeNC(b) ) ) ) return NULL;
+  for( i=0; i<zMatRowSizeNC(b); i++ )
+    zRawVecCopy( zMatRowBufNC(b,zIndexElemNC(f->idx,i)), zMatRowBufNC(x,i), zMatColSizeNC(b) );
+  _zLEFactoSolveRaw( f, zMatBufNC(x), zMatColCapacity(x), zMatColSizeNC(x) );
+  for( i=0; i<zMatRowSizeNC(b); i++ )
+    zRawVecCopy( zMatRowBufNC(x,i), zMatRowBufNC(ans,zIndexElemNC(f->idx,i)), zMatColSizeNC(b) );
+  zMatFree( x );
+  return ans;
+}
+
+/* rank-one update of a Cholesky factorization. */
+static void _zLEFactoUpdateCholesky(zLEFacto *f, double *w, double sigma)
+{
+  int i, k, n;
+  double s, r, c, sn;
+
+  n = zMatRowSizeNC(f->l);
+  s = sigma > 0 ? 1 : -1;
+  zRawVecMulDRC( w, sqrt( fabs( sigma ) ), n );
+  for( k=0; k<n; k++ ){
+    r = sqrt( zSqr( zMatElemNC(f->l,k,k) ) + s * zSqr( w[k] ) );
+    c = r / zMatElemNC(f->l,k,k);
+    sn = w[k] / zMatElemNC(f->l,k,k);
+    zMatSetElemNC( f->l, k, k, r );
+    for( i=k+1; i<n; i++ ){
+      zMatSetElemNC( f->l, i, k, ( zMatElemNC(f->l,i,k) + s * sn * w[i] ) / c );
+      w[i] = c * w[i] - sn * zMatElemNC(f->l,i,k);
+    }
+  }
+}
+
+/* rank-one update of an LDL^T factorization. */
+static void _zLEFactoUpdateLDL(zLEFacto *f, double *w, double sigma)
+{
+  int i, j, n;
+  double p, d, beta;
+
+  n = zMatRowSizeNC(f->l);
+  for( j=0; j<n; j++ ){
+    p = w[j];
+    d = zVecElemNC(f->d,j) + sigma * p * p;
+    beta = p * sigma / d;
+    sigma *= zVecElemNC(f->d,j) / d;
+    zVecSetElemNC( f->d, j, d );
+    for( i=j+1; i<n; i++ ){
+      w[i] -= p * zMatElemNC(f->l,i,j);
+      zMatElemNC(f->l,i,j) += beta * w[i];
+    }
+  }
+}
+
+/* rank-one update of a factorization. */
+bool zLEFactoUpdate(zLEFacto *f, const zVec v, double sigma)
+{
+  int i, n;
+  double *w, gamma = 0;
+
+  if( f->type == ZM_LE_FACTO_NONE ){
+    ZRUNERROR( ZM_ERR_LE_FACTO_NOTFACTORIZED );
+    return false;
+  }
+  if( zMatRowSizeNC(f->l) != zVecSize(v) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  n = zVecSizeNC(v);
+  w = zVecBufNC(f->_v);
+  if( f->type == ZM_LE_FACTO_LDL )
+    for( i=0; i<n; i++ )
+      if( zVecElemNC(f->e,i) != 0 ){
+        ZRUNERROR( ZM_ERR_LE_FACTO_2X2PIVOT );
+        return false;
+      }
+  /* check if the updated matrix is nonsingular; det(A+s v v^T) = ( 1 + s v^T A^-1 v ) det(A) */
+  for( i=0; i<n; i++ )
+    w[i] = zVecElemNC(v,zIndexElemNC(f->idx,i));
+  _zLEFactoSolveL( zMatBufNC(f->l), zMatColCapacity(f->l), w, 1, n, 1, f->type == ZM_LE_FACTO_LDL );
+  if( f->type == ZM_LE_FACTO_CHOLESKY ){
+    gamma = 1 + sigma * zRawVecSqrNorm( w, n );
+    if( gamma < zTOL ){
+      ZRUNERROR( ZM_ERR_MAT_NOTPOSITIVEDEFINITE );
+      return false;
+    }
+  } else{
+    for( i=0; i<n; i++ )
+      gamma += zSqr( w[i] ) / zVecElemNC(f->d,i);
+    if( zIsTiny( ( gamma = 1 + sigma * gamma ) ) ){
+      ZRUNERROR( ZM_ERR_MAT_SINGULAR );
+      return false;
+    }
+  }
+  for( i=0; i<n; i++ )
+    w[i] = zVecElemNC(v,zIndexElemNC(f->idx,i));
+  if( f->type == ZM_LE_FACTO_CHOLESKY )
+    _zLEFactoUpdateCholesky( f, w, sigma );
+  else
+    _zLEFactoUpdateLDL( f, w, sigma );
+  return true;
+}
+
+/* determinant of a factorized matrix. */
+double zLEFactoDet(const zLEFacto *f)
+{
+  int k;
+  double det = 1;
+
+  if( f->type == ZM_LE_FACTO_CHOLESKY ){
+    for( k=0; k<zMatRowSizeNC(f->l); k++ )
+      det *= zMatElemNC(f->l,k,k);
+    return det * det;
+  }
+  if( f->type != ZM_LE_FACTO_LDL ) return 0;
+  for( k=0; k<zVecSizeNC(f->d); k++ ){
+    if( zVecElemNC(f->e,k) == 0 ){
+      det *= zVecElemNC(f->d,k);
+      continue;
+    }
+    det *= zVecElemNC(f->d,k) * zVecElemNC(f->d,k+1) - zSqr( zVecElemNC(f->e,k) );
+    k++;
+  }
+  return det;
+}
@@ -22,17 +22,25 @@ void zLEWorkspaceInit(zLEWorkspace *workspace)
   /* for LU/LQ factorization */
   workspace->l_facto = workspace->r_facto = NULL;
   workspace->index_lu = NULL;
+  workspace->_arena = NULL;
+}
+
+/* allocate workspace for generalized linear equation solvers on an arena. */
+bool zLEWorkspaceAllocArena(zLEWorkspace *workspace, int num_equation, int num_variable, zArena *arena)
+{
+  workspace->_arena = arena;
+  workspace->m_regular = zArenaMatAllocSqr( arena, num_variable );
+  workspace->b_copy = num_equation > 0 ? zArenaVecAlloc( arena, num_equation ) : NULL;
+  workspace->v_ispace = zArenaVecAlloc( arena, num_variable );
+  workspace->v_scale = zArenaVecAlloc( arena, num_variable );
+  workspace->index_le = zArenaIndexCreate( arena, num_variable );
+  return workspace->m_regular && workspace->v_ispace && workspace->v_scale && workspace->index_le && ( num_equation == 0 || workspace->b_copy );
 }
 
 /* allocate workspace for generalized linear equation solvers. */
 bool zLEWorkspaceAlloc(zLEWorkspace *workspace, int num_equation, int num_variable)
 {
-  workspace->m_regular = zMatAllocSqr( num_variable );
-  workspace->b_copy = num_equation > 0 ? zVecAlloc( num_equation ) : NULL;
-  workspace->v_ispace = zVecAlloc( num_variable );
-  workspace->v_scale = zVecAlloc( num_variable );
-  workspace->index_le = zIndexCreate( num_variable );
-  return workspace->m_regular && workspace->v_ispace && workspace->v_scale && workspace->index_le && ( num_equation == 0 || workspace->b_copy );
+  return zLEWorkspaceAllocArena( workspace, num_equation, num_variable, NULL );
 }
 
 /* allocate workspace for generalized linear equation solvers, and copy the right-hand-side vector. */
@@ -48,6 +56,7 @@ bool zLEWorkspaceClone(zLEWorkspace *src, zLEWorkspace *cln)
 {
   bool ret = true;
 
+  cln->_arena = NULL;
   if( src->m_regular && !( cln->m_regular = zMatClone( src->m_regular ) ) ) ret = false;
   if( src->v_scale && !( cln->v_scale = zVecClone( src->v_scale ) ) ) ret = false;
   if( src->index_le && !( cln->index_le = zIndexClone( src->index_le ) ) ) ret = false;
@@ -68,19 +77,20 @@ bool zLEWorkspaceClone(zLEWorkspace *src, zLEWorkspace *cln)
 /* free workspace for generalized linear equation solvers. */
 void zLEWorkspaceFree(zLEWorkspace *workspace)
 {
-  zMatFree( workspace->m_regular );
-  zVecFree( workspace->v_scale );
-  zIndexFree( workspace->index_le );
+  zArenaMatFree( workspace->_arena, workspace->m_regular );
+  zArenaVecFree( workspace->_arena, workspace->v_scale );
+  zArenaIndexFree( workspace->_arena, workspace->index_le );
 
-  zVecFree( workspace->b_copy );
-  zVecFree( workspace->v_ispace );
+  zArenaVecFree( workspace->_arena, workspace->b_copy );
+  zArenaVecFree( workspace->_arena, workspace->v_ispace );
 }
 
 /* allocate workspace for generalized linear equation solvers with reference. */
 static bool _zLEWorkspaceAllocRef(zLEWorkspace *workspace, const zVec b, int num_variable)
 {
-  workspace->v_ref = zVecAlloc( num_variable );
-  return _zLEWorkspaceAllocAndCopyB( workspace, b, num_variable ) && workspace->v_ref;
+  workspace->v_ref = NULL;
+  return _zLEWorkspaceAllocAndCopyB( workspace, b, num_variable ) &&
+    ( workspace->v_ref = zVecAlloc( num_variable ) );
 }
 
 /* free workspace for generalized linear equation solvers with reference. */
@@ -93,37 +103,39 @@ static void _zLEWorkspaceFreeRef(zLEWorkspace *workspace)
 /* allocate workspace for generalized linear equation solvers based on MP inverse. */
 static bool _zLEWorkspaceAllocMP(zLEWorkspace *workspace, int num_equation, int num_variable)
 {
-  workspace->v_mp_ispace = zVecAlloc( num_variable );
-  return zLEWorkspaceAlloc( workspace, num_equation, num_variable ) && workspace->v_mp_ispace;
+  workspace->v_mp_ispace = zArenaVecAlloc( workspace->_arena, num_variable );
+  return zLEWorkspaceAllocArena( workspace, num_equation, num_variable, workspace->_arena ) && workspace->v_mp_ispace;
 }
 
 /* free workspace for generalized linear equation solvers based on MP inverse. */
 static void _zLEWorkspaceFreeMP(zLEWorkspace *workspace)
 {
   zLEWorkspaceFree( workspace );
-  zVecFree( workspace->v_mp_ispace );
+  zArenaVecFree( workspace->_arena, workspace->v_mp_ispace );
 }
 
 /* allocate workspace for a linear equation solver with matrix decomposition. */
 static bool _zLEWorkspaceAllocLR(zLEWorkspace *workspace, int num_equation, int num_variable)
 {
-  workspace->l_facto = zMatAllocSqr( num_equation );
-  workspace->r_facto = zMatAlloc( num_equation, num_variable );
-  workspace->index_lu = zIndexCreate( num_equation );
+  workspace->l_facto = zArenaMatAllocSqr( workspace->_arena, num_equation );
+  workspace->r_facto = zArenaMatAlloc( workspace->_arena, num_equation, num_variable );
+  workspace->index_lu = zArenaIndexCreate( workspace->_arena, num_equation );
   return workspace->l_facto && workspace->r_facto && workspace->index_lu;
 }
 
 /* free workspace for a linear equation solver with matrix decomposition. */
 static void _zLEWorkspaceFreeLR(zLEWorkspace *workspace)
 {
-  zMatFreeAtOnce( 2, workspace->l_facto, workspace->r_facto );
-  zIndexFree( workspace->index_lu );
+  zArenaMatFree( workspace->_arena, workspace->l_facto );
+  zArenaMatFree( workspace->_arena, workspace->r_facto );
+  zArenaIndexFree( workspace->_arena, workspace->index_lu );
 }
 
-/* allocate workspace for LQ/LU decomposition and generalized linear equation solvers based on MP inverse. */
-bool zLEWorkspaceAllocMP(zLEWorkspace *workspace, int num_equation, int num_variable)
+/* allocate workspace for LQ/LU decomposition and generalized linear equation solvers based on MP inverse on an arena. */
+bool zLEWorkspaceAllocMPArena(zLEWorkspace *workspace, int num_equation, int num_variable, zArena *arena)
 {
   zLEWorkspaceInit( workspace );
+  workspace->_arena = arena;
   if( !_zLEWorkspaceAllocLR( workspace, num_equation, num_variable ) ||
       !_zLEWorkspaceAllocMP( workspace, num_equation, num_variable ) ){
     ZALLOCERROR();
@@ -134,6 +146,12 @@ bool zLEWorkspaceAllocMP(zLEWorkspace *workspace, int num_equation, int num_vari
   return true;
 }
 
+/* allocate workspace for LQ/LU decomposition and generalized linear equation solvers based on MP inverse. */
+bool zLEWorkspaceAllocMP(zLEWorkspace *workspace, int num_equation, int num_variable)
+{
+  return zLEWorkspaceAllocMPArena( workspace, num_equation, num_variable, NULL );
+}
+
 /* allocate workspace for generalized linear equation solvers based on MP inverse, and copy the right-hand-side vector. */
 static bool _zLEWorkspaceAllocMPAndCopyAB(zLEWorkspace *workspace, const zMat a, const zVec b)
 {
@@ -295,12 +313,24 @@ zVec zLESolveMPNullDST(zLEWorkspace *workspace, const zVec we, const zVec wn, in
   return ans;
 }
 
+/* generalized linear equation solver with MP-inverse based on pivoted Householder LQ decomposition. */
+static zVec _zLESolveMP_LQFacto(const zMat a, const zVec b, zVec ans)
+{
+  zLQFacto f;
+
+  if( !zLQFactoAlloc( &f, zMatRowSizeNC(a), zMatColSizeNC(a) ) ) return NULL;
+  if( zLQFactoDecomp( &f, a, true ) < 0 || !zLQFactoSolveMP( &f, b, ans ) ) ans = NULL;
+  zLQFactoFree( &f );
+  return ans;
+}
+
 /* generalized linear equation solver with MP-inverse based on LQ decomposition. */
 zVec zLESolveMP_LQ(const zMat a, const zVec b, const zVec wn, const zVec we, zVec ans)
 {
   int rank;
   zLEWorkspace workspace;
 
+  if( !wn && !we ) return _zLESolveMP_LQFacto( a, b, ans );
   if( !_zLEWorkspaceAllocMPAndCopyAB( &workspace, a, b ) ) goto TERMINATE;
   if( ( rank = zMatDecompLQ( a, workspace.l_facto, workspace.r_facto ) ) > 0 ){
     zLEWorkspaceResizeMP( &workspace, rank );
@@ -334,12 +364,16 @@ zVec zLESolveMP_SVD(const zMat a, const zVec b, zVec ans)
   zMat u, v;
   zVec sv, tmp;
 
-  u = zMatAllocSqr( zMatRowSizeNC(a) );
-  v = zMatAlloc( zMatRowSizeNC(a), zMatColSizeNC(a) );
-  sv = zVecAlloc( zMatRowSizeNC(a) );
-  tmp = zVecAlloc( zMatRowSizeNC(a) );
+  u = zMatAlloc( zMatRowSizeNC(a), zMatMinSizeNC(a) ); /* thin SVD */
+  v = zMatAlloc( zMatMinSizeNC(a), zMatColSizeNC(a) );
+  sv = zVecAlloc( zMatMinSizeNC(a) );
+  tmp = zVecAlloc( zMatMinSizeNC(a) );
   if( !u || !v || !sv || !tmp ) goto TERMINATE;
-  if( ( rank = zMatSVD( a, u, sv, v ) ) < zMatRowSizeNC(a) ){
+  if( ( rank = zMatSVD( a, u, sv, v ) ) < 0 ){
+    ans = NULL;
+    goto TERMINATE;
+  }
+  if( rank < zMatMinSizeNC(a) ){
     zMatColResize( u, rank );
     zMatRowResize( v, rank );
     zVecSetSize( sv, rank );
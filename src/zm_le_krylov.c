@@ -0,0 +1,482 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_le_krylov - linear equation: Krylov subspace methods.
+ */
+
+#include <zm/zm_le.h>
+
+/* ********************************************************** */
+/* Krylov subspace solver
+ * ********************************************************** */
+
+/* initialize a Krylov subspace solver. */
+zLEKrylov *zLEKrylovInit(zLEKrylov *krylov)
+{
+  krylov->size = 0;
+  krylov->op = NULL;
+  krylov->op_util = NULL;
+  krylov->pc = NULL;
+  krylov->pc_util = NULL;
+  krylov->tol = ZM_LE_KRYLOV_TOL;
+  krylov->iter = Z_MAX_ITER_NUM;
+  krylov->restart = ZM_LE_KRYLOV_RESTART;
+  krylov->iter_num = 0;
+  krylov->residual = HUGE_VAL;
+  krylov->_r = krylov->_rh = krylov->_p = krylov->_v = NULL;
+  krylov->_s = krylov->_t = krylov->_ph = krylov->_sh = NULL;
+  krylov->_basis = NULL;
+  krylov->_h = NULL;
+  krylov->_c = krylov->_sn = krylov->_g = NULL;
+  return krylov;
+}
+
+/* allocate workspace of a Krylov subspace solver. */
+zLEKrylov *zLEKrylovAlloc(zLEKrylov *krylov, int size, int restart)
+{
+  int i;
+
+  zLEKrylovInit( krylov );
+  krylov->size = size;
+  if( restart > 0 ) krylov->restart = restart;
+  krylov->_r = zVecAlloc( size );
+  krylov->_rh = zVecAlloc( size );
+  krylov->_p = zVecAlloc( size );
+  krylov->_v = zVecAlloc( size );
+  krylov->_s = zVecAlloc( size );
+  krylov->_t = zVecAlloc( size );
+  krylov->_ph = zVecAlloc( size );
+  krylov->_sh = zVecAlloc( size );
+  krylov->_h = zMatAlloc( krylov->restart+1, krylov->restart );
+  krylov->_c = zVecAlloc( krylov->restart );
+  krylov->_sn = zVecAlloc( krylov->restart );
+  krylov->_g = zVecAlloc( krylov->restart+1 );
+  if( !krylov->_r || !krylov->_rh || !krylov->_p || !krylov->_v ||
+      !krylov->_s || !krylov->_t || !krylov->_ph || !krylov->_sh ||
+      !krylov->_h || !krylov->_c || !krylov->_sn || !krylov->_g ) goto FAILURE;
+  if( !( krylov->_basis = zAlloc( zVec, krylov->restart+1 ) ) ) goto FAILURE;
+  for( i=0; i<=krylov->restart; i++ )
+    if( !( krylov->_basis[i] = zVecAlloc( size ) ) ) goto FAILURE;
+  return krylov;
+
+ FAILURE:
+  ZALLOCERROR();
+  zLEKrylovFree( krylov );
+  return NULL;
+}
+
+/* free workspace of a Krylov subspace solver. */
+void zLEKrylovFree(zLEKrylov *krylov)
+{
+  int i;
+
+  zVecFreeAtOnce( 8, krylov->_r, krylov->_rh, krylov->_p, krylov->_v, krylov->_s, krylov->_t, krylov->_ph, krylov->_sh );
+  if( krylov->_basis ){
+    for( i=0; i<=krylov->restart; i++ ) zVecFree( krylov->_basis[i] );
+    free( krylov->_basis );
+  }
+  zMatFree( krylov->_h );
+  zVecFreeAtOnce( 3, krylov->_c, krylov->_sn, krylov->_g );
+  zLEKrylovInit( krylov );
+}
+
+/* set a linear operator of a Krylov subspace solver. */
+zLEKrylov *zLEKrylovSetOp(zLEKrylov *krylov, zVec (* op)(const zVec,zVec,void*), void *util)
+{
+  krylov->op = op;
+  krylov->op_util = util;
+  return krylov;
+}
+
+/* set a preconditioner of a Krylov subspace solver. */
+zLEKrylov *zLEKrylovSetPrecond(zLEKrylov *krylov, zVec (* pc)(const zVec,zVec,void*), void *util)
+{
+  krylov->pc = pc;
+  krylov->pc_util = util;
+  return krylov;
+}
+
+/* set tolerance and the maximum number of iterations of a Krylov subspace solver. */
+zLEKrylov *zLEKrylovSetTol(zLEKrylov *krylov, double tol, int iter)
+{
+  krylov->tol = tol;
+  ZITERINIT( iter );
+  krylov->iter = iter;
+  return krylov;
+}
+
+/* linear operator of a dense matrix. */
+zVec zLEKrylovOpMat(const zVec x, zVec y, void *util)
+{
+  return zMulMatVecNC( (zMat)util, x, y );
+}
+
+/* linear operator of a sparse matrix. */
+zVec zLEKrylovOpSpMat(const zVec x, zVec y, void *util)
+{
+  return zSpMatMulVecNC( (zSpMat)util, x, y );
+}
+
+/* check if a Krylov subspace solver is ready to solve an equation. */
+static bool _zLEKrylovIsReady(zLEKrylov *krylov, const zVec b, zVec ans)
+{
+  if( !krylov->op ){
+    ZRUNERROR( ZM_ERR_LE_KRYLOV_NOOP );
+    return false;
+  }
+  if( zVecSizeNC(b) != krylov->size || zVecSizeNC(ans) != krylov->size ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  krylov->iter_num = 0;
+  return true;
+}
+
+/* apply a preconditioner. */
+static zVec _zLEKrylovPrecond(zLEKrylov *krylov, const zVec r, zVec z)
+{
+  return krylov->pc ? krylov->pc( r, z, krylov->pc_util ) : zVecCopyNC( r, z );
+}
+
+/* residual of a linear equation. */
+static zVec _zLEKrylovResidual(zLEKrylov *krylov, const zVec b, const zVec x, zVec r)
+{
+  krylov->op( x, r, krylov->op_util );
+  return zVecSubNC( b, r, r );
+}
+
+/* norm of the right-hand-side vector, which is replaced with one if zero. */
+static double _zLEKrylovNormB(const zVec b)
+{
+  double bnorm;
+
+  return zIsTiny( ( bnorm = zVecNorm( b ) ) ) ? 1.0 : bnorm;
+}
+
+/* preconditioned conjugate gradient method. */
+zVec zLEKrylovPCG(zLEKrylov *krylov, const zVec b, zVec ans)
+{
+  zVec r, z, p, q;
+  double bnorm, rz, rz_prev, pq, alpha;
+
+  if( !_zLEKrylovIsReady( krylov, b, ans ) ) return NULL;
+  r = krylov->_r; z = krylov->_s; p = krylov->_p; q = krylov->_v;
+  bnorm = _zLEKrylovNormB( b );
+  _zLEKrylovResidual( krylov, b, ans, r );
+  if( ( krylov->residual = zVecNorm( r ) / bnorm ) < krylov->tol ) return ans;
+  _zLEKrylovPrecond( krylov, r, z );
+  zVecCopyNC( z, p );
+  rz = zVecInnerProdNC( r, z );
+  for( ; krylov->iter_num<krylov->iter; ){
+    krylov->op( p, q, krylov->op_util );
+    if( ( pq = zVecInnerProdNC( p, q ) ) <= 0 ){
+      ZRUNERROR( ZM_ERR_LE_KRYLOV_BREAKDOWN );
+      return NULL;
+    }
+    alpha = rz / pq;
+    zVecCatNCDRC( ans, alpha, p );
+    zVecCatNCDRC( r, -alpha, q );
+    krylov->iter_num++;
+    if( ( krylov->residual = zVecNorm( r ) / bnorm ) < krylov->tol ) return ans;
+    _zLEKrylovPrecond( krylov, r, z );
+    rz_prev = rz;
+    rz = zVecInnerProdNC( r, z );
+    zVecCatNC( z, rz / rz_prev, p, p );
+  }
+  ZITERWARN( krylov->iter );
+  return ans;
+}
+
+/* apply the i-th Givens rotation to the j-th column of a Hessenberg matrix. */
+static void _zLEKrylovGivens(zLEKrylov *krylov, int i, int j)
+{
+  double h1, h2;
+
+  h1 = zMatElemNC(krylov->_h,i,j);
+  h2 = zMatElemNC(krylov->_h,i+1,j);
+  zMatSetElemNC( krylov->_h, i,   j,  zVecElemNC(krylov->_c,i)*h1 + zVecElemNC(krylov->_sn,i)*h2 );
+  zMatSetElemNC( krylov->_h, i+1, j, -zVecElemNC(krylov->_sn,i)*h1 + zVecElemNC(krylov->_c,i)*h2 );
+}
+
+/* restarted generalized minimal residual method with right preconditioning. */
+zVec zLEKrylovGMRES(zLEKrylov *krylov, const zVec b, zVec ans)
+{
+  zVec r, u, w;
+  double bnorm, beta, h, den;
+  int i, j, k;
+
+  if( !_zLEKrylovIsReady( krylov, b, ans ) ) return NULL;
+  r = krylov->_r; u = krylov->_s; w = krylov->_ph;
+  bnorm = _zLEKrylovNormB( b );
+  while( 1 ){
+    _zLEKrylovResidual( krylov, b, ans, r );
+    beta = zVecNorm( r );
+    if( ( krylov->residual = beta / bnorm ) < krylov->tol ) return ans;
+    if( krylov->iter_num >= krylov->iter ) break;
+    zVecMulNC( r, 1.0/beta, krylov->_basis[0] );
+    zVecZero( krylov->_g );
+    zVecSetElemNC( krylov->_g, 0, beta );
+    for( j=0; j<krylov->restart && krylov->iter_num<krylov->iter; ){
+      _zLEKrylovPrecond( krylov, krylov->_basis[j], w );
+      krylov->op( w, krylov->_basis[j+1], krylov->op_util );
+      for( i=0; i<=j; i++ ){ /* modified Gram-Schmidt orthogonalization */
+        zMatSetElemNC( krylov->_h, i, j, ( h = zVecInnerProdNC( krylov->_basis[j+1], krylov->_basis[i] ) ) );
+        zVecCatNCDRC( krylov->_basis[j+1], -h, krylov->_basis[i] );
+      }
+      zMatSetElemNC( krylov->_h, j+1, j, ( h = zVecNorm( krylov->_basis[j+1] ) ) );
+      if( h > 0 ) zVecDivNCDRC( krylov->_basis[j+1], h );
+      for( i=0; i<j; i++ ) _zLEKrylovGivens( krylov, i, j );
+      if( zIsTiny( den = sqrt( zSqr(zMatElemNC(krylov->_h,j,j)) + zSqr(h) ) ) ){
+        ZRUNERROR( ZM_ERR_LE_KRYLOV_BREAKDOWN );
+        return NULL;
+      }
+      zVecSetElemNC( krylov->_c, j, zMatElemNC(krylov->_h,j,j) / den );
+      zVecSetElemNC( krylov->_sn, j, h / den );
+      zMatSetElemNC( krylov->_h, j, j, den );
+      zMatSetElemNC( krylov->_h, j+1, j, 0 );
+      zVecSetElemNC( krylov->_g, j+1, -zVecElemNC(krylov->_sn,j)*zVecElemNC(krylov->_g,j) );
+      zVecElemNC(krylov->_g,j) *= zVecElemNC(krylov->_c,j);
+      j++;
+      krylov->iter_num++;
+      if( fabs( zVecElemNC(krylov->_g,j) ) / bnorm < krylov->tol || h == 0 ) break;
+    }
+    /* solve the projected least square problem and update the answer */
+    for( k=j-1; k>=0; k-- ){
+      for( i=k+1; i<j; i++ )
+        zVecElemNC(krylov->_g,k) -= zMatElemNC(krylov->_h,k,i) * zVecElemNC(krylov->_g,i);
+      zVecElemNC(krylov->_g,k) /= zMatElemNC(krylov->_h,k,k);
+    }
+    zVecZero( u );
+    for( k=0; k<j; k++ )
+      zVecCatNCDRC( u, zVecElemNC(krylov->_g,k), krylov->_basis[k] );
+    _zLEKrylovPrecond( krylov, u, w );
+    zVecAddNCDRC( ans, w );
+  }
+  ZITERWARN( krylov->iter );
+  return ans;
+}
+
+/* biconjugate gradient stabilized method with right preconditioning. */
+zVec zLEKrylovBiCGSTAB(zLEKrylov *krylov, const zVec b, zVec ans)
+{
+  zVec r, rh, p, v, s, t, ph, sh;
+  double bnorm, rho, rho_prev, alpha, omega, tt;
+
+  if( !_zLEKrylovIsReady( krylov, b, ans ) ) return NULL;
+  r = krylov->_r; rh = krylov->_rh; p = krylov->_p; v = krylov->_v;
+  s = krylov->_s; t = krylov->_t; ph = krylov->_ph; sh = krylov->_sh;
+  bnorm = _zLEKrylovNormB( b );
+  _zLEKrylovResidual( krylov, b, ans, r );
+  if( ( krylov->residual = zVecNorm( r ) / bnorm ) < krylov->tol ) return ans;
+  zVecCopyNC( r, rh );
+  zVecZero( p );
+  zVecZero( v );
+  rho = alpha = omega = 1;
+  for( ; krylov->iter_num<krylov->iter; ){
+    rho_prev = rho;
+    if( ( rho = zVecInnerProdNC( rh, r ) ) == 0 ) goto BREAKDOWN;
+    zVecCatNCDRC( p, -omega, v );
+    zVecCatNC( r, ( rho / rho_prev ) * ( alpha / omega ), p, p );
+    _zLEKrylovPrecond( krylov, p, ph );
+    krylov->op( ph, v, krylov->op_util );
+    if( ( alpha = zVecInnerProdNC( rh, v ) ) == 0 ) goto BREAKDOWN;
+    alpha = rho / alpha;
+    zVecCatNC( r, -alpha, v, s );
+    zVecCatNCDRC( ans, alpha, ph );
+    krylov->iter_num++;
+    if( ( krylov->residual = zVecNorm( s ) / bnorm ) < krylov->tol ) return ans;
+    _zLEKrylovPrecond( krylov, s, sh );
+    krylov->op( sh, t, krylov->op_util );
+    if( ( tt = zVecSqrNorm( t ) ) == 0 ) goto BREAKDOWN;
+    omega = zVecInnerProdNC( t, s ) / tt;
+    zVecCatNCDRC( ans, omega, sh );
+    zVecCatNC( s, -omega, t, r );
+    if( ( krylov->residual = zVecNorm( r ) / bnorm ) < krylov->tol ) return ans;
+    if( omega == 0 ) goto BREAKDOWN;
+  }
+  ZITERWARN( krylov->iter );
+  return ans;
+
+ BREAKDOWN:
+  ZRUNERROR( ZM_ERR_LE_KRYLOV_BREAKDOWN );
+  return NULL;
+}
+
+/* ********************************************************** */
+/* preconditioners
+ * ********************************************************** */
+
+/* initialize a preconditioner with a diagonal vector of a sparse matrix. */
+static zLEPrecond *_zLEPrecondInit(zLEPrecond *pc, const zSpMat a, zLEPrecondType type)
+{
+  int i;
+
+  pc->type = ZM_LE_PRECOND_NONE;
+  pc->m = NULL;
+  pc->d = NULL;
+  pc->omega = 1.0;
+  if( a->rowsize != a->colsize ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return NULL;
+  }
+  if( !( pc->d = zVecAlloc( a->rowsize ) ) ) return NULL;
+  for( i=0; i<a->rowsize; i++ )
+    if( ( zVecElemNC(pc->d,i) = zSpMatElem( a, i, i ) ) == 0 ){
+      ZRUNERROR( ZM_ERR_LE_PRECOND_ZERODIAG, i );
+      zLEPrecondFree( pc );
+      return NULL;
+    }
+  pc->type = type;
+  return pc;
+}
+
+/* create a Jacobi preconditioner. */
+zLEPrecond *zLEPrecondJacobi(zLEPrecond *pc, const zSpMat a)
+{
+  return _zLEPrecondInit( pc, a, ZM_LE_PRECOND_JACOBI );
+}
+
+/* create an SSOR preconditioner. */
+zLEPrecond *zLEPrecondSSOR(zLEPrecond *pc, const zSpMat a, double omega)
+{
+  if( !_zLEPrecondInit( pc, a, ZM_LE_PRECOND_SSOR ) ) return NULL;
+  if( omega <= 0 || omega >= 2 ){
+    ZRUNERROR( ZM_ERR_LE_PRECOND_INVALID_OMEGA, omega );
+    zLEPrecondFree( pc );
+    return NULL;
+  }
+  if( !( pc->m = zSpMatConvert( a, ZM_SPMAT_CSR ) ) ){
+    zLEPrecondFree( pc );
+    return NULL;
+  }
+  pc->omega = omega;
+  return pc;
+}
+
+/* incomplete Cholesky factorization without fill-in of the lower triangular part stored in CSR. */
+static bool _zLEPrecondICFactorize(zSpMat l, const double *a, double shift)
+{
+  int i, j, k, p, q, qk;
+  double s;
+
+  for( i=0; i<l->rowsize; i++ ){
+    for( p=l->ptr[i]; p<l->ptr[i+1]-1; p++ ){
+      k = l->ind[p];
+      s = a[p];
+      for( q=l->ptr[i], qk=l->ptr[k]; q<p && qk<l->ptr[k+1]-1; ){ /* merge rows i and k */
+        if( ( j = l->ind[q] ) == l->ind[qk] ){
+          s -= l->val[q++] * l->val[qk++];
+        } else
+        if( j < l->ind[qk] ) q++; else qk++;
+      }
+      l->val[p] = s / l->val[l->ptr[k+1]-1];
+    }
+    for( s=a[p]*( 1 + shift ), q=l->ptr[i]; q<p; q++ ) s -= zSqr( l->val[q] );
+    if( s <= 0 ) return false;
+    l->val[p] = sqrt( s );
+  }
+  return true;
+}
+
+/* initial diagonal shift to retry incomplete Cholesky factorization. */
+#define ZM_LE_PRECOND_IC_SHIFT ( 1.0e-3 )
+
+/* create an incomplete Cholesky preconditioner. */
+zLEPrecond *zLEPrecondIC(zLEPrecond *pc, const zSpMat a)
+{
+  zSpMat csr;
+  double *val;
+  double shift;
+  int i, k, n;
+
+  if( !_zLEPrecondInit( pc, a, ZM_LE_PRECOND_IC ) ) return NULL;
+  if( !( csr = zSpMatConvert( a, ZM_SPMAT_CSR ) ) ) goto FAILURE;
+  /* lower triangular part including the diagonal at the tail of each row */
+  for( n=0, i=0; i<csr->rowsize; i++ ){
+    k = csr->ptr[i];
+    csr->ptr[i] = n;
+    for( ; k<csr->ptr[i+1] && csr->ind[k]<=i; k++ ){
+      csr->ind[n] = csr->ind[k];
+      csr->val[n++] = csr->val[k];
+    }
+  }
+  csr->ptr[csr->rowsize] = csr->nnz = n;
+  pc->m = csr;
+  if( !( val = zAlloc( double, zMax( n, 1 ) ) ) ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  memcpy( val, csr->val, sizeof(double)*n );
+  for( shift=0; !_zLEPrecondICFactorize( csr, val, shift ); ){
+    if( ( shift = shift == 0 ? ZM_LE_PRECOND_IC_SHIFT : 2 * shift ) > 1 ){
+      ZRUNERROR( ZM_ERR_MAT_NOTPOSITIVEDEFINITE );
+      free( val );
+      goto FAILURE;
+    }
+  }
+  free( val );
+  return pc;
+
+ FAILURE:
+  zLEPrecondFree( pc );
+  return NULL;
+}
+
+/* apply a preconditioner. */
+zVec zLEPrecondApply(const zVec r, zVec z, void *util)
+{
+  zLEPrecond *pc;
+  zSpMat m;
+  int i, k, n;
+  double s, w;
+
+  pc = (zLEPrecond *)util;
+  m = pc->m;
+  n = zVecSizeNC(r);
+  switch( pc->type ){
+  case ZM_LE_PRECOND_JACOBI:
+    for( i=0; i<n; i++ )
+      zVecSetElemNC( z, i, zVecElemNC(r,i) / zVecElemNC(pc->d,i) );
+    break;
+  case ZM_LE_PRECOND_SSOR:
+    w = pc->omega;
+    for( i=0; i<n; i++ ){ /* (D/w+L) y = r */
+      for( s=zVecElemNC(r,i), k=m->ptr[i]; k<m->ptr[i+1] && m->ind[k]<i; k++ )
+        s -= m->val[k] * zVecElemNC(z,m->ind[k]);
+      zVecSetElemNC( z, i, s * w / zVecElemNC(pc->d,i) );
+    }
+    for( i=0; i<n; i++ ) zVecElemNC(z,i) *= zVecElemNC(pc->d,i) / w;
+    for( i=n-1; i>=0; i-- ){ /* (D/w+U) z = D/w y */
+      for( s=zVecElemNC(z,i), k=m->ptr[i+1]-1; k>=m->ptr[i] && m->ind[k]>i; k-- )
+        s -= m->val[k] * zVecElemNC(z,m->ind[k]);
+      zVecSetElemNC( z, i, s * w / zVecElemNC(pc->d,i) );
+    }
+    zVecMulNCDRC( z, ( 2 - w ) / w );
+    break;
+  case ZM_LE_PRECOND_IC:
+    for( i=0; i<n; i++ ){ /* L y = r */
+      for( s=zVecElemNC(r,i), k=m->ptr[i]; k<m->ptr[i+1]-1; k++ )
+        s -= m->val[k] * zVecElemNC(z,m->ind[k]);
+      zVecSetElemNC( z, i, s / m->val[k] );
+    }
+    for( i=n-1; i>=0; i-- ){ /* L^T z = y */
+      zVecElemNC(z,i) /= m->val[m->ptr[i+1]-1];
+      for( k=m->ptr[i]; k<m->ptr[i+1]-1; k++ )
+        zVecElemNC(z,m->ind[k]) -= m->val[k] * zVecElemNC(z,i);
+    }
+    break;
+  default:
+    zVecCopyNC( r, z );
+  }
+  return z;
+}
+
+/* free a preconditioner. */
+void zLEPrecondFree(zLEPrecond *pc)
+{
+  zSpMatFree( pc->m );
+  zVecFree( pc->d );
+  pc->m = NULL;
+  pc->d = NULL;
+  pc->type = ZM_LE_PRECOND_NONE;
+}
@@ -182,3 +182,457 @@ int zMatDecompQR(const zMat m, zMat q, zMat r)
   zMatFreeAtOnce( 3, mcp, qcp, rcp );
   return rank;
 }
+
+/* QR decomposition based on Householder method. */
+int zMatDecompQR_Householder(const zMat m, zMat q, zMat r)
+{
+  zLQFacto f;
+  zMat mt, qt = NULL, rt = NULL;
+  int rank = -1;
+
+  zLQFactoInit( &f );
+  if( !( mt = zMatAlloc( zMatColSizeNC(m), zMatRowSizeNC(m) ) ) ||
+      !zLQFactoAlloc( &f, zMatColSizeNC(m), zMatRowSizeNC(m) ) ){
+    ZALLOCERROR();
+    goto TERMINATE;
+  }
+  zMatTNC( m, mt );
+  if( ( rank = zLQFactoDecomp( &f, mt, false ) ) <= 0 ) goto TERMINATE;
+  qt = zMatAlloc( rank, zMatRowSizeNC(m) );
+  rt = r ? zMatAlloc( zMatColSizeNC(m), rank ) : NULL;
+  if( !qt || ( r && !rt ) ){
+    ZALLOCERROR();
+    rank = -1;
+    goto TERMINATE;
+  }
+  zLQFactoGetQ( &f, qt );
+  zMatSetColSizeNC( q, rank );
+  zMatTNC( qt, q );
+  if( r ){
+    zLQFactoGetL( &f, rt );
+    zMatSetRowSizeNC( r, rank );
+    zMatTNC( rt, r );
+  }
+ TERMINATE:
+  zMatFreeAtOnce( 3, mt, qt, rt );
+  zLQFactoFree( &f );
+  return rank;
+}
+
+/* ********************************************************** */
+/* Householder LQ decomposition with compact WY representation
+ * ********************************************************** */
+
+/* initialize a Householder LQ decomposition. */
+zLQFacto *zLQFactoInit(zLQFacto *f)
+{
+  f->a = f->t = NULL;
+  f->tau = NULL;
+  f->idx = NULL;
+  f->num = f->rank = 0;
+  f->_v = f->_y = f->_z = NULL;
+  f->_w = NULL;
+  f->_cod = NULL;
+  return f;
+}
+
+/* allocate a Householder LQ decomposition. */
+zLQFacto *zLQFactoAlloc(zLQFacto *f, int rowsize, int colsize)
+{
+  int k;
+
+  zLQFactoInit( f );
+  k = zMax( zMin( rowsize, colsize ), 1 );
+  f->a = zMatAlloc( rowsize, colsize );
+  f->tau = zVecAlloc( k );
+  f->t = zMatAlloc( k, ZM_LQ_FACTO_BLOCK );
+  f->idx = zIndexCreate( rowsize );
+  f->_v = zMatAlloc( ZM_LQ_FACTO_BLOCK, colsize );
+  f->_y = zMatAlloc( rowsize, ZM_LQ_FACTO_BLOCK );
+  f->_z = zMatAlloc( rowsize, ZM_LQ_FACTO_BLOCK );
+  f->_w = zVecAlloc( zMax( rowsize, colsize ) );
+  if( !f->a || !f->tau || !f->t || !f->idx || !f->_v || !f->_y || !f->_z || !f->_w ){
+    ZALLOCERROR();
+    zLQFactoFree( f );
+    return NULL;
+  }
+  return f;
+}
+
+/* free a Householder LQ decomposition. */
+void zLQFactoFree(zLQFacto *f)
+{
+  zMatFreeAtOnce( 5, f->a, f->t, f->_v, f->_y, f->_z );
+  zVecFreeAtOnce( 2, f->tau, f->_w );
+  zIndexFree( f->idx );
+  if( f->_cod ){
+    zLQFactoFree( f->_cod );
+    free( f->_cod );
+  }
+  zLQFactoInit( f );
+}
+
+/* create a Householder reflector which maps a raw vector to a multiple of the first unit vector. */
+static double _zLQFactoReflector(double *x, int n)
+{
+  double alpha, beta, xnorm;
+
+  if( n <= 1 || ( xnorm = zRawVecNorm( x+1, n-1 ) ) == 0 ) return 0;
+  alpha = x[0];
+  beta = sqrt( zSqr(alpha) + zSqr(xnorm) );
+  if( alpha >= 0 ) beta = -beta;
+  zRawVecDivDRC( x+1, alpha - beta, n-1 );
+  x[0] = beta;
+  return ( beta - alpha ) / beta;
+}
+
+/* apply a Householder reflector with the implicit unit leading component to a raw vector. */
+static void _zLQFactoReflect(const double *v, double tau, double *y, int n)
+{
+  double s;
+
+  if( tau == 0 ) return;
+  s = tau * ( y[0] + zRawVecInnerProd( v+1, y+1, n-1 ) );
+  y[0] -= s;
+  zRawVecCatDRC( y+1, -s, v+1, n-1 );
+}
+
+/* explicit Householder vectors of a block. */
+static void _zLQFactoBlockV(zLQFacto *f, int i0, int nb)
+{
+  double *v;
+  int j, n;
+
+  n = zLQFactoColSize(f) - i0;
+  for( j=0; j<nb; j++ ){
+    v = zMatRowBufNC(f->_v,j);
+    zRawVecZero( v, j );
+    v[j] = 1;
+    zRawVecCopy( &zMatElemNC(f->a,i0+j,i0+j+1), v+j+1, n-j-1 );
+  }
+}
+
+/* triangular factor of the compact WY representation of a block. */
+static void _zLQFactoBlockT(zLQFacto *f, int i0, int nb)
+{
+  double tau, s;
+  int j, l, q, n;
+
+  n = zLQFactoColSize(f) - i0;
+  _zLQFactoBlockV( f, i0, nb );
+  for( j=0; j<nb; j++ ){
+    zRawVecZero( zMatRowBufNC(f->t,i0+j), ZM_LQ_FACTO_BLOCK );
+    tau = zVecElemNC(f->tau,i0+j);
+    for( l=0; l<j; l++ )
+      zMatElemNC(f->t,i0+l,j) = zRawVecInnerProd( zMatRowBufNC(f->_v,l)+j, zMatRowBufNC(f->_v,j)+j, n-j );
+    for( l=0; l<j; l++ ){
+      for( s=0, q=l; q<j; q++ ) s += zMatElemNC(f->t,i0+l,q) * zMatElemNC(f->t,i0+q,j);
+      zMatElemNC(f->t,i0+l,j) = -tau * s;
+    }
+    zMatElemNC(f->t,i0+j,j) = tau;
+  }
+}
+
+/* factorize a panel of rows and apply reflectors to rows up to rowend. */
+static void _zLQFactoPanel(zLQFacto *f, int i0, int nb, int rowend)
+{
+  int i, j, n;
+
+  n = zLQFactoColSize(f);
+  for( i=i0; i<i0+nb; i++ ){
+    zVecSetElemNC( f->tau, i, _zLQFactoReflector( &zMatElemNC(f->a,i,i), n-i ) );
+    for( j=i+1; j<rowend; j++ )
+      _zLQFactoReflect( &zMatElemNC(f->a,i,i), zVecElemNC(f->tau,i), &zMatElemNC(f->a,j,i), n-i );
+  }
+}
+
+/* blocked Householder LQ decomposition without pivoting. */
+static bool _zLQFactoDecompBlock(zLQFacto *f)
+{
+  int i0, nb, r0, m, n, k;
+
+  m = zLQFactoRowSize(f);
+  n = zLQFactoColSize(f);
+  k = zMin( m, n );
+  for( i0=0; i0<k; i0+=nb ){
+    nb = zMin( ZM_LQ_FACTO_BLOCK, k - i0 );
+    r0 = i0 + nb;
+    if( zRawGEMMIsSmall( m - r0, n - i0, nb ) ){
+      _zLQFactoPanel( f, i0, nb, m );
+      _zLQFactoBlockT( f, i0, nb );
+      continue;
+    }
+    _zLQFactoPanel( f, i0, nb, r0 );
+    _zLQFactoBlockT( f, i0, nb );
+    /* trailing rows A2 <- A2 - ( A2 V ) T V^T */
+    if( !zRawGEMM( false, true, m-r0, nb, n-i0, 1.0, &zMatElemNC(f->a,r0,i0), zMatColCapacity(f->a), zMatBufNC(f->_v), zMatColCapacity(f->_v), 0.0, zMatBufNC(f->_y), zMatColCapacity(f->_y) ) ||
+        !zRawGEMM( false, false, m-r0, nb, nb, 1.0, zMatBufNC(f->_y), zMatColCapacity(f->_y), zMatRowBufNC(f->t,i0), zMatColCapacity(f->t), 0.0, zMatBufNC(f->_z), zMatColCapacity(f->_z) ) ||
+        !zRawGEMM( false, false, m-r0, n-i0, nb, -1.0, zMatBufNC(f->_z), zMatColCapacity(f->_z), zMatBufNC(f->_v), zMatColCapacity(f->_v), 1.0, &zMatElemNC(f->a,r0,i0), zMatColCapacity(f->a) ) ) return false;
+  }
+  f->num = k;
+  return true;
+}
+
+/* Householder LQ decomposition with row pivoting. */
+static bool _zLQFactoDecompPivot(zLQFacto *f)
+{
+  double *norm, *norm0, ref = 0;
+  int i, j, p, m, n, k;
+
+  m = zLQFactoRowSize(f);
+  n = zLQFactoColSize(f);
+  k = zMin( m, n );
+  if( !( norm = zAlloc( double, 2*m ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  norm0 = norm + m;
+  for( i=0; i<m; i++ )
+    norm[i] = norm0[i] = zRawVecSqrNorm( zMatRowBufNC(f->a,i), n );
+  for( i=0; i<k; i++ ){
+    for( p=i, j=i+1; j<m; j++ )
+      if( norm[j] > norm[p] ) p = j;
+    if( i == 0 ) ref = norm[p];
+    if( norm[p] <= zSqr( ZM_LQ_FACTO_TOL ) * ref || norm[p] == 0 ) break;
+    if( p != i ){
+      zMatSwapRowNC( f->a, i, p );
+      zSwap( double, norm[i], norm[p] );
+      zSwap( double, norm0[i], norm0[p] );
+      zIndexSwapNC( f->idx, i, p );
+    }
+    zVecSetElemNC( f->tau, i, _zLQFactoReflector( &zMatElemNC(f->a,i,i), n-i ) );
+    for( j=i+1; j<m; j++ ){
+      _zLQFactoReflect( &zMatElemNC(f->a,i,i), zVecElemNC(f->tau,i), &zMatElemNC(f->a,j,i), n-i );
+      /* downdate the remaining norm, which is recomputed on cancellation */
+      if( ( norm[j] -= zSqr( zMatElemNC(f->a,j,i) ) ) <= ZM_LQ_FACTO_TOL * 1.0e2 * norm0[j] )
+        norm[j] = norm0[j] = zRawVecSqrNorm( &zMatElemNC(f->a,j,i+1), n-i-1 );
+    }
+  }
+  free( norm );
+  f->num = f->rank = i;
+  for( i=0; i<f->num; i+=ZM_LQ_FACTO_BLOCK )
+    _zLQFactoBlockT( f, i, zMin( ZM_LQ_FACTO_BLOCK, f->num - i ) );
+  return true;
+}
+
+/* complete orthogonal decomposition of a rank-deficient matrix. */
+static bool _zLQFactoCOD(zLQFacto *f)
+{
+  int i, j;
+
+  if( f->_cod && ( zLQFactoRowSize(f->_cod) != f->rank || zLQFactoColSize(f->_cod) != zLQFactoRowSize(f) ) ){
+    zLQFactoFree( f->_cod );
+    free( f->_cod );
+    f->_cod = NULL;
+  }
+  if( !f->_cod ){
+    if( !( f->_cod = zAlloc( zLQFacto, 1 ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    if( !zLQFactoAlloc( f->_cod, f->rank, zLQFactoRowSize(f) ) ){
+      free( f->_cod );
+      f->_cod = NULL;
+      return false;
+    }
+  }
+  for( i=0; i<f->rank; i++ )
+    for( j=0; j<zLQFactoRowSize(f); j++ )
+      zMatSetElemNC( f->_cod->a, i, j, j >= i ? zMatElemNC(f->a,j,i) : 0 );
+  zIndexOrder( f->_cod->idx, 0 );
+  return _zLQFactoDecompBlock( f->_cod );
+}
+
+/* Householder LQ decomposition. */
+int zLQFactoDecomp(zLQFacto *f, const zMat m, bool pivot)
+{
+  double dmax;
+  int i;
+
+  if( !zMatSizeEqual( m, f->a ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return -1;
+  }
+  zMatCopyNC( m, f->a );
+  zIndexOrder( f->idx, 0 );
+  if( pivot ){
+    if( !_zLQFactoDecompPivot( f ) ) return -1;
+  } else{
+    if( !_zLQFactoDecompBlock( f ) ) return -1;
+    for( dmax=0, i=0; i<f->num; i++ )
+      if( fabs( zMatElemNC(f->a,i,i) ) > dmax ) dmax = fabs( zMatElemNC(f->a,i,i) );
+    for( f->rank=0, i=0; i<f->num; i++ )
+      if( fabs( zMatElemNC(f->a,i,i) ) > ZM_LQ_FACTO_TOL * dmax ) f->rank++;
+  }
+  if( f->rank > 0 && f->rank < zLQFactoRowSize(f) && !_zLQFactoCOD( f ) ) return -1;
+  return f->rank;
+}
+
+/* multiply a raw vector by Q of a Householder LQ decomposition. */
+static void _zLQFactoMulQRaw(const zLQFacto *f, double *v)
+{
+  int i, n;
+
+  n = zLQFactoColSize(f);
+  for( i=0; i<f->num; i++ )
+    _zLQFactoReflect( &zMatElemNC(f->a,i,i), zVecElemNC(f->tau,i), v+i, n-i );
+}
+
+/* multiply a raw vector by Q^T of a Householder LQ decomposition. */
+static void _zLQFactoMulQTRaw(const zLQFacto *f, double *v)
+{
+  int i, n;
+
+  n = zLQFactoColSize(f);
+  for( i=f->num-1; i>=0; i-- )
+    _zLQFactoReflect( &zMatElemNC(f->a,i,i), zVecElemNC(f->tau,i), v+i, n-i );
+}
+
+/* multiply a vector by Q of a Householder LQ decomposition. */
+zVec zLQFactoMulQ(const zLQFacto *f, const zVec v, zVec qv)
+{
+  if( zVecSizeNC(v) != zLQFactoColSize(f) || !zVecSizeEqual( v, qv ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  zVecCopyNC( v, qv );
+  _zLQFactoMulQRaw( f, zVecBufNC(qv) );
+  return qv;
+}
+
+/* multiply a vector by Q^T of a Householder LQ decomposition. */
+zVec zLQFactoMulQT(const zLQFacto *f, const zVec v, zVec qv)
+{
+  if( zVecSizeNC(v) != zLQFactoColSize(f) || !zVecSizeEqual( v, qv ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  zVecCopyNC( v, qv );
+  _zLQFactoMulQTRaw( f, zVecBufNC(qv) );
+  return qv;
+}
+
+/* multiply a matrix by Q or Q^T of a Householder LQ decomposition with the compact WY representation. */
+static zMat _zLQFactoMulQMat(zLQFacto *f, const zMat m, zMat qm, bool trans)
+{
+  zMat y, z;
+  int b, nblock, i0, nb, n, p;
+
+  if( zMatRowSizeNC(m) != zLQFactoColSize(f) || !zMatSizeEqual( m, qm ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  zMatCopyNC( m, qm );
+  n = zLQFactoColSize(f);
+  p = zMatColSizeNC(qm);
+  y = zMatAlloc( ZM_LQ_FACTO_BLOCK, p );
+  z = zMatAlloc( ZM_LQ_FACTO_BLOCK, p );
+  if( !y || !z ){
+    ZALLOCERROR();
+    qm = NULL;
+    goto TERMINATE;
+  }
+  nblock = ( f->num + ZM_LQ_FACTO_BLOCK - 1 ) / ZM_LQ_FACTO_BLOCK;
+  for( b=0; b<nblock; b++ ){
+    i0 = ( trans ? nblock - 1 - b : b ) * ZM_LQ_FACTO_BLOCK;
+    nb = zMin( ZM_LQ_FACTO_BLOCK, f->num - i0 );
+    _zLQFactoBlockV( f, i0, nb );
+    /* B <- B - V op( T ) V^T B, where op( T ) = T for Q^T and T^T for Q */
+    if( !zRawGEMM( false, false, nb, p, n-i0, 1.0, zMatBufNC(f->_v), zMatColCapacity(f->_v), zMatRowBufNC(qm,i0), zMatColCapacity(qm), 0.0, zMatBufNC(y), zMatColCapacity(y) ) ||
+        !zRawGEMM( !trans, false, nb, p, nb, 1.0, zMatRowBufNC(f->t,i0), zMatColCapacity(f->t), zMatBufNC(y), zMatColCapacity(y), 0.0, zMatBufNC(z), zMatColCapacity(z) ) ||
+        !zRawGEMM( true, false, n-i0, p, nb, -1.0, zMatBufNC(f->_v), zMatColCapacity(f->_v), zMatBufNC(z), zMatColCapacity(z), 1.0, zMatRowBufNC(qm,i0), zMatColCapacity(qm) ) ){
+      qm = NULL;
+      break;
+    }
+  }
+ TERMINATE:
+  zMatFreeAtOnce( 2, y, z );
+  return qm;
+}
+
+/* multiply a matrix by Q of a Householder LQ decomposition. */
+zMat zLQFactoMulQMat(zLQFacto *f, const zMat m, zMat qm)
+{
+  return _zLQFactoMulQMat( f, m, qm, false );
+}
+
+/* multiply a matrix by Q^T of a Householder LQ decomposition. */
+zMat zLQFactoMulQTMat(zLQFacto *f, const zMat m, zMat qm)
+{
+  return _zLQFactoMulQMat( f, m, qm, true );
+}
+
+/* lower trapezoidal factor of a Householder LQ decomposition. */
+zMat zLQFactoGetL(const zLQFacto *f, zMat l)
+{
+  int i, j;
+
+  if( zMatRowSizeNC(l) != zLQFactoRowSize(f) || zMatColSizeNC(l) != f->rank ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  for( i=0; i<zMatRowSizeNC(l); i++ )
+    for( j=0; j<f->rank; j++ )
+      zMatSetElemNC( l, i, j, j <= i ? zMatElemNC(f->a,i,j) : 0 );
+  return l;
+}
+
+/* orthogonal factor of a Householder LQ decomposition. */
+zMat zLQFactoGetQ(zLQFacto *f, zMat q)
+{
+  zMat e;
+  int i;
+
+  if( zMatRowSizeNC(q) != f->rank || zMatColSizeNC(q) != zLQFactoColSize(f) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  if( f->rank == 0 ) return q;
+  if( !( e = zMatAlloc( zLQFactoColSize(f), f->rank ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  for( i=0; i<f->rank; i++ ) zMatSetElemNC( e, i, i, 1.0 );
+  /* the first rows of Q are the transpose of the first columns of Q^T */
+  if( zLQFactoMulQTMat( f, e, e ) )
+    zMatTNC( e, q );
+  else
+    q = NULL;
+  zMatFree( e );
+  return q;
+}
+
+/* Moore-Penrose inverse solution with a Householder LQ decomposition. */
+zVec zLQFactoSolveMP(zLQFacto *f, const zVec b, zVec ans)
+{
+  zMat l;
+  double *w, s;
+  int i, j, m, n;
+
+  m = zLQFactoRowSize(f);
+  n = zLQFactoColSize(f);
+  if( zVecSizeNC(b) != m || zVecSizeNC(ans) != n ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  w = zVecBufNC(f->_w);
+  for( i=0; i<m; i++ ) w[i] = zVecElemNC(b,zIndexElemNC(f->idx,i));
+  if( f->rank == m ){ /* L y = P b */
+    for( i=0; i<m; i++ ){
+      for( s=w[i], j=0; j<i; j++ ) s -= zMatElemNC(f->a,i,j) * w[j];
+      w[i] = s / zMatElemNC(f->a,i,i);
+    }
+  } else
+  if( f->rank > 0 ){ /* L'^T y = Q' P b */
+    _zLQFactoMulQRaw( f->_cod, w );
+    l = f->_cod->a;
+    for( i=f->rank-1; i>=0; i-- ){
+      for( s=w[i], j=i+1; j<f->rank; j++ ) s -= zMatElemNC(l,j,i) * w[j];
+      w[i] = s / zMatElemNC(l,i,i);
+    }
+  }
+  zRawVecZero( w + f->rank, n - f->rank );
+  _zLQFactoMulQTRaw( f, w );
+  zRawVecCopy( w, zVecBufNC(ans), n );
+  return ans;
+}
@@ -6,8 +6,8 @@
 
 #include <zm/zm_le.h>
 
-/* LU decomposition of a matrix (destructive). */
-int zMatDecompLUDST(zMat m, zMat l, zMat u, zIndex idx)
+/* LU decomposition of a matrix by element-wise elimination (destructive). */
+static int _zMatDecompLUDSTElem(zMat m, zMat l, zMat u, zIndex idx)
 {
   int r, c, i, j, p, q;
   double ahead;
@@ -35,6 +35,231 @@ int zMatDecompLUDST(zMat m, zMat l, zMat u, zIndex idx)
   return r; /* rank */
 }
 
+/* subtract a product of raw matrices 'c -= a b'. */
+static void _zMatDecompLUUpdate(const double *a, int acolcapacity, const double *b, int bcolcapacity, double *c, int ccolcapacity, int rowsize, int colsize, int innersize)
+{
+  int i, k;
+
+  if( rowsize <= 0 || colsize <= 0 || innersize <= 0 ) return;
+  if( !zRawGEMMIsSmall( rowsize, colsize, innersize ) &&
+      zRawGEMM( false, false, rowsize, colsize, innersize, -1.0, a, acolcapacity, b, bcolcapacity, 1.0, c, ccolcapacity ) )
+    return;
+  for( i=0; i<rowsize; i++ )
+    for( k=0; k<innersize; k++ )
+      zRawVecCatDRC( c+i*ccolcapacity, -a[i*acolcapacity+k], b+k*bcolcapacity, colsize );
+}
+
+/* solve 'l x = b' for a unit lower triangular raw matrix l, where x is overwritten to b. */
+static void _zMatDecompLUSolveL(const double *l, int lcolcapacity, double *x, int xcolcapacity, int size, int colsize)
+{
+  int i, k, size1;
+
+  if( size <= ZM_LE_LU_BLOCK_MIN ){
+    for( i=1; i<size; i++ )
+      for( k=0; k<i; k++ )
+        zRawVecCatDRC( x+i*xcolcapacity, -l[i*lcolcapacity+k], x+k*xcolcapacity, colsize );
+    return;
+  }
+  size1 = size / 2;
+  _zMatDecompLUSolveL( l, lcolcapacity, x, xcolcapacity, size1, colsize );
+  _zMatDecompLUUpdate( l+size1*lcolcapacity, lcolcapacity, x, xcolcapacity, x+size1*xcolcapacity, xcolcapacity, size-size1, colsize, size1 );
+  _zMatDecompLUSolveL( l+size1*(lcolcapacity+1), lcolcapacity, x+size1*xcolcapacity, xcolcapacity, size-size1, colsize );
+}
+
+/* solve 'u x = b' for an upper triangular raw matrix u, where x is overwritten to b. */
+static void _zMatDecompLUSolveU(const double *u, int ucolcapacity, double *x, int xcolcapacity, int size, int colsize)
+{
+  int i, k, size1;
+
+  if( size <= ZM_LE_LU_BLOCK_MIN ){
+    for( i=size-1; i>=0; i-- ){
+      for( k=i+1; k<size; k++ )
+        zRawVecCatDRC( x+i*xcolcapacity, -u[i*ucolcapacity+k], x+k*xcolcapacity, colsize );
+      zRawVecDivDRC( x+i*xcolcapacity, u[i*ucolcapacity+i], colsize );
+    }
+    return;
+  }
+  size1 = size / 2;
+  _zMatDecompLUSolveU( u+size1*(ucolcapacity+1), ucolcapacity, x+size1*xcolcapacity, xcolcapacity, size-size1, colsize );
+  _zMatDecompLUUpdate( u+size1, ucolcapacity, x+size1*xcolcapacity, xcolcapacity, x, xcolcapacity, size1, colsize, size-size1 );
+  _zMatDecompLUSolveU( u, ucolcapacity, x, xcolcapacity, size1, colsize );
+}
+
+/* unblocked LU decomposition of a panel of a raw matrix from the c-th column with the width w. */
+static int _zMatDecompLUPanel(double *m, int colcapacity, int rowsize, int colsize, zIndex idx, int c, int w)
+{
+  int i, j, p;
+  double *mj, ahead, max, tmp;
+
+  for( j=c; j<c+w; j++ ){
+    mj = m + j*colcapacity;
+    for( max=fabs(mj[j]), p=j, i=j+1; i<rowsize; i++ )
+      if( ( tmp = fabs( m[i*colcapacity+j] ) ) > max ){
+        max = tmp;
+        p = i;
+      }
+    if( zIsTiny( max ) ) return j;
+    if( p != j ){
+      zRawMatSwapRow( m, colcapacity, rowsize, colsize, j, p );
+      zIndexSwapNC( idx, j, p );
+    }
+    ahead = mj[j];
+    for( i=j+1; i<rowsize; i++ ){
+      m[i*colcapacity+j] /= ahead;
+      zRawVecCatDRC( m+i*colcapacity+j+1, -m[i*colcapacity+j], mj+j+1, c+w-j-1 );
+    }
+  }
+  return j;
+}
+
+/* update the rest of rows and columns after a panel from the c-th column with the width w is decomposed. */
+static void _zMatDecompLUTrail(double *m, int colcapacity, int rowsize, int colsize, int c, int w, int colsize_trail)
+{
+  double *mc;
+
+  mc = m + c*(colcapacity+1);
+  _zMatDecompLUSolveL( mc, colcapacity, mc+w, colcapacity, w, colsize_trail );
+  _zMatDecompLUUpdate( mc+w*colcapacity, colcapacity, mc+w, colcapacity, mc+w*(colcapacity+1), colcapacity, rowsize-c-w, colsize_trail, w );
+}
+
+/* recursive LU decomposition of columns from the c-th with the width w of a raw matrix. */
+static int _zMatDecompLURecursive(double *m, int colcapacity, int rowsize, int colsize, zIndex idx, int c, int w)
+{
+  int w1, ret;
+
+  if( w <= ZM_LE_LU_BLOCK_MIN )
+    return _zMatDecompLUPanel( m, colcapacity, rowsize, colsize, idx, c, w );
+  w1 = w / 2;
+  if( ( ret = _zMatDecompLURecursive( m, colcapacity, rowsize, colsize, idx, c, w1 ) ) < c + w1 )
+    return ret;
+  _zMatDecompLUTrail( m, colcapacity, rowsize, colsize, c, w1, w - w1 );
+  return _zMatDecompLURecursive( m, colcapacity, rowsize, colsize, idx, c+w1, w-w1 );
+}
+
+/* blocked LU decomposition of a matrix into a packed form (destructive). */
+int zMatDecompLUBlockDST(zMat m, zIndex idx)
+{
+  int c, w, size, ret;
+
+  size = zMatMinSize( m );
+  for( c=0; c<size; c+=w ){
+    w = zMin( ZM_LE_LU_BLOCK_SIZE, size - c );
+    if( ( ret = _zMatDecompLUPanel( zMatBufNC(m), zMatColCapacity(m), zMatRowSizeNC(m), zMatColSizeNC(m), idx, c, w ) ) < c + w )
+      return ret;
+    _zMatDecompLUTrail( zMatBufNC(m), zMatColCapacity(m), zMatRowSizeNC(m), zMatColSizeNC(m), c, w, zMatColSizeNC(m) - c - w );
+  }
+  return size;
+}
+
+/* recursive LU decomposition of a matrix into a packed form (destructive). */
+int zMatDecompLURecursiveDST(zMat m, zIndex idx)
+{
+  int size, ret;
+
+  size = zMatMinSize( m );
+  if( ( ret = _zMatDecompLURecursive( zMatBufNC(m), zMatColCapacity(m), zMatRowSizeNC(m), zMatColSizeNC(m), idx, 0, size ) ) < size )
+    return ret;
+  _zMatDecompLUTrail( zMatBufNC(m), zMatColCapacity(m), zMatRowSizeNC(m), zMatColSizeNC(m), 0, size, zMatColSizeNC(m) - size );
+  return size;
+}
+
+/* blocked LU decomposition of a full-rank matrix into lower and upper triangular matrices (destructive). */
+static int _zMatDecompLUDSTBlock(zMat m, zMat l, zMat u, zIndex idx)
+{
+  zMat lu;
+  zIndex idx_org;
+  int i, j, size, rank = -1;
+
+  lu = zMatAlloc( zMatRowSizeNC(m), zMatColSizeNC(m) );
+  idx_org = zIndexAlloc( zIndexSizeNC(idx) );
+  if( !lu || !idx_org ) goto TERMINATE;
+  for( i=0; i<zMatRowSizeNC(m); i++ ){
+    zRawVecCopy( zMatRowBufNC(m,zIndexElemNC(idx,i)), zMatRowBufNC(lu,i), zMatColSizeNC(m) );
+    zIndexSetElemNC( idx_org, i, zIndexElemNC(idx,i) );
+  }
+  size = zMatMinSize( m );
+  if( zMatDecompLUBlockDST( lu, idx ) < size ){
+    for( i=0; i<zIndexSizeNC(idx); i++ )
+      zIndexSetElemNC( idx, i, zIndexElemNC(idx_org,i) );
+    goto TERMINATE;
+  }
+  zMatZero( l );
+  zMatZero( u );
+  for( i=0; i<zMatRowSizeNC(lu); i++ ){
+    for( j=0; j<i && j<size; j++ )
+      zMatSetElemNC( l, zIndexElemNC(idx,i), j, zMatElemNC(lu,i,j) * zMatElemNC(lu,j,j) );
+    if( i >= size ) continue;
+    zMatSetElemNC( l, zIndexElemNC(idx,i), i, zMatElemNC(lu,i,i) );
+    zMatSetElemNC( u, i, i, 1 );
+    for( j=i+1; j<zMatColSizeNC(lu); j++ )
+      zMatSetElemNC( u, i, j, zMatElemNC(lu,i,j) / zMatElemNC(lu,i,i) );
+  }
+  rank = size;
+ TERMINATE:
+  zMatFree( lu );
+  zIndexFree( idx_org );
+  return rank;
+}
+
+/* LU decomposition of a matrix (destructive). */
+int zMatDecompLUDST(zMat m, zMat l, zMat u, zIndex idx)
+{
+  int rank;
+
+  if( zMatMinSize(m) >= ZM_LE_LU_BLOCK_THRESHOLD &&
+      ( rank = _zMatDecompLUDSTBlock( m, l, u, idx ) ) >= 0 ) return rank;
+  return _zMatDecompLUDSTElem( m, l, u, idx );
+}
+
+/* solve a linear equation with a packed LU decomposition. */
+zVec zLESolveLUBlock(const zMat lu, const zIndex idx, const zVec b, zVec ans)
+{
+  zVec src, c = NULL;
+  int i;
+
+  if( !zMatIsSqr(lu) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return NULL;
+  }
+  if( zMatRowSizeNC(lu) != zIndexSizeNC(idx) ||
+      zVecSize(b) != zIndexSizeNC(idx) ||
+      zVecSize(ans) != zIndexSizeNC(idx) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  if( ( src = b ) == ans && !( src = c = zVecClone( b ) ) ) return NULL;
+  for( i=0; i<zIndexSizeNC(idx); i++ )
+    zVecSetElemNC( ans, i, zVecElemNC(src,zIndexElemNC(idx,i)) );
+  _zMatDecompLUSolveL( zMatBufNC(lu), zMatColCapacity(lu), zVecBufNC(ans), 1, zVecSizeNC(ans), 1 );
+  _zMatDecompLUSolveU( zMatBufNC(lu), zMatColCapacity(lu), zVecBufNC(ans), 1, zVecSizeNC(ans), 1 );
+  zVecFree( c );
+  return ans;
+}
+
+/* solve linear equations with a packed LU decomposition for a matrix. */
+zMat zLESolveLUBlockMat(const zMat lu, const zIndex idx, const zMat b, zMat ans)
+{
+  zMat src, c = NULL;
+  int i;
+
+  if( !zMatIsSqr(lu) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return NULL;
+  }
+  if( zMatRowSizeNC(lu) != zIndexSizeNC(idx) ||
+      zMatRowSize(b) != zIndexSizeNC(idx) || !zMatSizeEqual(b,ans) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  if( ( src = b ) == ans && !( src = c = zMatClone( b ) ) ) return NULL;
+  for( i=0; i<zIndexSizeNC(idx); i++ )
+    zRawVecCopy( zMatRowBufNC(src,zIndexElemNC(idx,i)), zMatRowBufNC(ans,i), zMatColSizeNC(ans) );
+  _zMatDecompLUSolveL( zMatBufNC(lu), zMatColCapacity(lu), zMatBufNC(ans), zMatColCapacity(ans), zMatRowSizeNC(ans), zMatColSizeNC(ans) );
+  _zMatDecompLUSolveU( zMatBufNC(lu), zMatColCapacity(lu), zMatBufNC(ans), zMatColCapacity(ans), zMatRowSizeNC(ans), zMatColSizeNC(ans) );
+  zMatFree( c );
+  return ans;
+}
+
 /* LU decomposition of a matrix. */
 int zMatDecompLU(const zMat m, zMat l, zMat u, zIndex idx)
 {
@@ -89,8 +314,90 @@ int zMatDecompLUAlloc(const zMat m, zMat *l, zMat *u, zIndex *idx)
   return zMatDecompLUAndResize( m, *l, *u, *idx );
 }
 
-/* Cholesky decomposition of a matrix (destructive). */
-int zMatDecompCholeskyDST(zMat m, zMat l, zIndex idx)
+/* swap the j-th and p-th rows and columns of a symmetric raw matrix stored in the lower triangular part. */
+static void _zMatDecompSymSwap(double *m, int colcapacity, int size, int j, int p)
+{
+  int k;
+
+  if( j == p ) return;
+  if( j > p ) zSwap( int, j, p );
+  for( k=0; k<j; k++ )
+    zSwap( double, m[j*colcapacity+k], m[p*colcapacity+k] );
+  zSwap( double, m[j*colcapacity+j], m[p*colcapacity+p] );
+  for( k=j+1; k<p; k++ )
+    zSwap( double, m[k*colcapacity+j], m[p*colcapacity+k] );
+  for( k=p+1; k<size; k++ )
+    zSwap( double, m[k*colcapacity+j], m[k*colcapacity+p] );
+}
+
+/* update the lower triangular part of a trailing submatrix 'c -= a a^T' after a panel is decomposed. */
+static void _zMatDecompCholeskyTrail(double *m, int colcapacity, int size, int c, int w)
+{
+  int i, j, k, b;
+  double *a;
+
+  a = m + c;
+  for( j=c+w; j<size; j+=b ){
+    b = zMin( ZM_LE_LU_BLOCK_SIZE, size - j );
+    if( !zRawGEMMIsSmall( size-j, b, w ) &&
+        zRawGEMM( false, true, size-j, b, w, -1.0, a+j*colcapacity, colcapacity, a+j*colcapacity, colcapacity, 1.0, m+j*(colcapacity+1), colcapacity ) )
+      continue;
+    for( i=j; i<size; i++ )
+      for( k=j; k<=i && k<j+b; k++ )
+        m[i*colcapacity+k] -= zRawVecInnerProd( a+i*colcapacity, a+k*colcapacity, w );
+  }
+}
+
+/* blocked Cholesky decomposition with diagonal pivoting into a packed form (destructive). */
+int zMatDecompCholeskyBlockDST(zMat m, zIndex idx)
+{
+  int i, j, c, p, w, n, cap;
+  double *a, *aj, *d, max, tmp;
+
+  n = zMatRowSizeNC(m);
+  cap = zMatColCapacity(m);
+  a = zMatBufNC(m);
+  if( !( d = zAlloc( double, n ) ) ){
+    ZALLOCERROR();
+    return -1;
+  }
+  for( c=0; c<n; c+=w ){
+    w = zMin( ZM_LE_LU_BLOCK_SIZE, n - c );
+    for( i=c; i<n; i++ ) d[i] = a[i*cap+i];
+    for( j=c; j<c+w; j++ ){
+      for( max=fabs(d[j]), p=j, i=j+1; i<n; i++ )
+        if( ( tmp = fabs( d[i] ) ) > max ){
+          max = tmp;
+          p = i;
+        }
+      if( zIsTiny( max ) ){
+        n = j;
+        goto TERMINATE;
+      }
+      if( d[p] < 0 ){
+        ZRUNERROR( ZM_ERR_MAT_NOTPOSITIVESEMIDEFINITE );
+        n = -1;
+        goto TERMINATE;
+      }
+      _zMatDecompSymSwap( a, cap, zMatRowSizeNC(m), j, p );
+      zSwap( double, d[j], d[p] );
+      zIndexSwapNC( idx, j, p );
+      aj = a + j*cap;
+      aj[j] = sqrt( d[j] );
+      for( i=j+1; i<zMatRowSizeNC(m); i++ ){
+        a[i*cap+j] = ( a[i*cap+j] - zRawVecInnerProd( a+i*cap+c, aj+c, j-c ) ) / aj[j];
+        d[i] -= zSqr( a[i*cap+j] );
+      }
+    }
+    _zMatDecompCholeskyTrail( a, cap, n, c, w );
+  }
+ TERMINATE:
+  zFree( d );
+  return n;
+}
+
+/* Cholesky decomposition of a matrix by element-wise elimination (destructive). */
+static int _zMatDecompCholeskyDSTElem(zMat m, zMat l, zIndex idx)
 {
   int i, j, k, n, p, rank;
   double a;
@@ -126,6 +433,33 @@ int zMatDecompCholeskyDST(zMat m, zMat l, zIndex idx)
   return rank;
 }
 
+/* blocked Cholesky decomposition of a matrix into a lower triangular matrix (destructive). */
+static int _zMatDecompCholeskyDSTBlock(zMat m, zMat l, zIndex idx)
+{
+  zMat lc;
+  int i, j, rank;
+
+  if( !( lc = zMatAllocSqr( zMatRowSizeNC(m) ) ) ) return -1;
+  for( i=0; i<zMatRowSizeNC(m); i++ )
+    for( j=0; j<=i; j++ )
+      zMatSetElemNC( lc, i, j, zMatElemNC(m,zIndexElemNC(idx,i),zIndexElemNC(idx,j)) );
+  zMatZero( l );
+  if( ( rank = zMatDecompCholeskyBlockDST( lc, idx ) ) > 0 )
+    for( i=0; i<zMatRowSizeNC(lc); i++ )
+      for( j=0; j<=i && j<rank; j++ )
+        zMatSetElemNC( l, zIndexElemNC(idx,i), j, zMatElemNC(lc,i,j) );
+  zMatFree( lc );
+  return rank;
+}
+
+/* Cholesky decomposition of a matrix (destructive). */
+int zMatDecompCholeskyDST(zMat m, zMat l, zIndex idx)
+{
+  if( zMatRowSizeNC(m) >= ZM_LE_LU_BLOCK_THRESHOLD )
+    return _zMatDecompCholeskyDSTBlock( m, l, idx );
+  return _zMatDecompCholeskyDSTElem( m, l, idx );
+}
+
 /* Cholesky decomposition of a matrix */
 int zMatDecompCholesky(const zMat m, zMat l, zIndex idx)
 {
@@ -170,3 +504,86 @@ int zMatDecompCholeskyAlloc(const zMat m, zMat *l, zIndex *idx)
   }
   return zMatDecompCholeskyAndResize( m, *l, *idx );
 }
+
+/* LDL^T decomposition of a symmetric matrix with Bunch-Kaufman pivoting into a packed form (destructive). */
+int zMatDecompLDLDST(zMat m, zVec d, zVec e, zIndex idx)
+{
+  const double alpha = ( 1 + sqrt(17.0) ) / 8;
+  int i, j, k, r, s, n, cap, rank = 0;
+  double *a, *t0, *t1, akk, colmax, rowmax, tmp, det, l0, l1;
+
+  n = zMatRowSizeNC(m);
+  cap = zMatColCapacity(m);
+  a = zMatBufNC(m);
+  t0 = zAlloc( double, n );
+  t1 = zAlloc( double, n );
+  if( !t0 || !t1 ){
+    ZALLOCERROR();
+    rank = -1;
+    goto TERMINATE;
+  }
+  for( k=0; k<n; k+=s ){
+    s = 1;
+    akk = fabs( a[k*cap+k] );
+    for( colmax=0, r=k, i=k+1; i<n; i++ )
+      if( ( tmp = fabs( a[i*cap+k] ) ) > colmax ){
+        colmax = tmp;
+        r = i;
+      }
+    if( zIsTiny( zMax( akk, colmax ) ) ){ /* singular */
+      zVecSetElemNC( d, k, 0 );
+      zVecSetElemNC( e, k, 0 );
+      for( i=k+1; i<n; i++ ) a[i*cap+k] = 0;
+      continue;
+    }
+    if( akk < alpha * colmax ){
+      for( rowmax=0, j=k; j<n; j++ )
+        if( j != r && ( tmp = fabs( j < r ? a[r*cap+j] : a[j*cap+r] ) ) > rowmax ) rowmax = tmp;
+      if( akk * rowmax >= alpha * colmax * colmax ){
+        /* 1x1 pivot without swapping */
+      } else
+      if( fabs( a[r*cap+r] ) >= alpha * rowmax ){
+        _zMatDecompSymSwap( a, cap, n, k, r );
+        zIndexSwapNC( idx, k, r );
+      } else{
+        _zMatDecompSymSwap( a, cap, n, k+1, r );
+        zIndexSwapNC( idx, k+1, r );
+        s = 2;
+      }
+    }
+    if( s == 1 ){
+      zVecSetElemNC( d, k, a[k*cap+k] );
+      zVecSetElemNC( e, k, 0 );
+      for( j=k+1; j<n; j++ ) t0[j] = a[j*cap+k];
+      for( i=k+1; i<n; i++ ){
+        a[i*cap+k] = t0[i] / zVecElemNC(d,k);
+        zRawVecCatDRC( a+i*cap+k+1, -a[i*cap+k], t0+k+1, i-k );
+      }
+      rank++;
+    } else{
+      zVecSetElemNC( d, k, a[k*cap+k] );
+      zVecSetElemNC( d, k+1, a[(k+1)*cap+k+1] );
+      zVecSetElemNC( e, k, a[(k+1)*cap+k] );
+      zVecSetElemNC( e, k+1, 0 );
+      det = zVecElemNC(d,k) * zVecElemNC(d,k+1) - zSqr( zVecElemNC(e,k) );
+      for( j=k+2; j<n; j++ ){
+        t0[j] = a[j*cap+k];
+        t1[j] = a[j*cap+k+1];
+      }
+      for( i=k+2; i<n; i++ ){
+        l0 = ( zVecElemNC(d,k+1) * t0[i] - zVecElemNC(e,k) * t1[i] ) / det;
+        l1 = ( zVecElemNC(d,k) * t1[i] - zVecElemNC(e,k) * t0[i] ) / det;
+        zRawVecCatDRC( a+i*cap+k+2, -l0, t0+k+2, i-k-1 );
+        zRawVecCatDRC( a+i*cap+k+2, -l1, t1+k+2, i-k-1 );
+        a[i*cap+k] = l0;
+        a[i*cap+k+1] = l1;
+      }
+      a[(k+1)*cap+k] = 0;
+      rank += 2;
+    }
+  }
+ TERMINATE:
+  zFree( t0 );
+  zFree( t1 );
+  return rank;
+}
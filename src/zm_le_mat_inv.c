@@ -30,6 +30,22 @@ double zMatDetDST(zMat m, zIndex idx)
   return det;
 }
 
+/* determinant of a matrix from its packed LU decomposition (the pivot index is destroyed). */
+static double _zMatDetLU(const zMat lu, zIndex idx)
+{
+  int i, j;
+  double det = 1.0;
+
+  for( i=0; i<zMatRowSizeNC(lu); i++ ) /* parity of the permutation */
+    while( ( j = zIndexElemNC(idx,i) ) != i ){
+      zIndexSwapNC( idx, i, j );
+      det = -det;
+    }
+  for( i=0; i<zMatRowSizeNC(lu); i++ )
+    if( zIsTiny( ( det *= zMatElemNC(lu,i,i) ) ) ) return 0;
+  return det;
+}
+
 /* determinant of matrix. */
 double zMatDet(const zMat m)
 {
@@ -43,9 +59,18 @@ double zMatDet(const zMat m)
   }
   mcp = zMatClone( m );
   idx = zIndexCreate( zMatRowSizeNC(m) );
-  if( mcp && idx )
-    det = zMatDetDST( mcp, idx );
+  if( !mcp || !idx ) goto TERMINATE;
+  if( zMatRowSizeNC(m) >= ZM_LE_LU_BLOCK_THRESHOLD ){
+    if( zMatDecompLUBlockDST( mcp, idx ) == zMatRowSizeNC(m) ){
+      det = _zMatDetLU( mcp, idx );
+      goto TERMINATE;
+    }
+    zMatCopyNC( m, mcp );
+    zIndexOrder( idx, 0 );
+  }
+  det = zMatDetDST( mcp, idx );
 
+ TERMINATE:
   zMatFree( mcp );
   zIndexFree( idx );
   return det;
@@ -156,9 +181,21 @@ zMat _zMulInvMatMatNC(const zMat m1, const zMat m2, zMat m)
   mcp2 = zMatClone( m2 );
   idx = zIndexCreate( zMatRowSizeNC(m1) );
   s = zVecAlloc( zMatRowSizeNC(m1) );
-  if( !mcp1 || !mcp2 || !idx || !s ||
-      !_zMulInvMat( mcp1, mcp2, m, idx, s ) ) m = NULL;
+  if( !mcp1 || !mcp2 || !idx || !s ){
+    m = NULL;
+    goto TERMINATE;
+  }
+  if( zMatRowSizeNC(m1) >= ZM_LE_LU_BLOCK_THRESHOLD ){
+    if( zMatDecompLUBlockDST( mcp1, idx ) == zMatRowSizeNC(m1) ){
+      m = zLESolveLUBlockMat( mcp1, idx, mcp2, m );
+      goto TERMINATE;
+    }
+    zMatCopyNC( m1, mcp1 );
+    zIndexOrder( idx, 0 );
+  }
+  if( !_zMulInvMat( mcp1, mcp2, m, idx, s ) ) m = NULL;
 
+ TERMINATE:
   zMatFree( mcp1 );
   zMatFree( mcp2 );
   zIndexFree( idx );
@@ -0,0 +1,513 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_le_spchol - linear equation: sparse Cholesky factorization.
+ */
+
+#include <zm/zm_le.h>
+
+/* ********************************************************** */
+/* approximate minimum degree ordering
+ * ********************************************************** */
+
+/* growable list of node indices on the quotient graph. */
+typedef struct{
+  int size;
+  int capacity;
+  int *buf;
+} _zSpAMDList;
+
+/* add a node to a list. */
+static bool _zSpAMDListAdd(_zSpAMDList *list, int node)
+{
+  int *buf;
+
+  if( list->size >= list->capacity ){
+    if( !( buf = zRealloc( list->buf, int, zMax( 2*list->capacity, 4 ) ) ) ){
+      ZALLOCERROR();
+      return false;
+    }
+    list->buf = buf;
+    list->capacity = zMax( 2*list->capacity, 4 );
+  }
+  list->buf[list->size++] = node;
+  return true;
+}
+
+/* free a list. */
+static void _zSpAMDListFree(_zSpAMDList *list)
+{
+  zFree( list->buf );
+  list->size = list->capacity = 0;
+}
+
+/* workspace of approximate minimum degree ordering. */
+typedef struct{
+  int size;
+  _zSpAMDList *a;  /* adjacent variables of variables */
+  _zSpAMDList *e;  /* adjacent elements of variables */
+  _zSpAMDList *le; /* variables of elements */
+  int *state;      /* 0: variable, 1: element, 2: absorbed element */
+  int *deg;        /* approximate degrees */
+  int *mark;       /* marks of variables in the current element */
+  int *wmark;      /* marks of initialized external degrees */
+  int *w;          /* external degrees of elements */
+  int *head;       /* heads of degree buckets */
+  int *next;       /* next node in a degree bucket */
+  int *prev;       /* previous node in a degree bucket */
+} _zSpAMD;
+
+#define ZM_SPAMD_VAR      0
+#define ZM_SPAMD_ELEM     1
+#define ZM_SPAMD_ABSORBED 2
+
+/* free workspace of approximate minimum degree ordering. */
+static void _zSpAMDFree(_zSpAMD *amd)
+{
+  int i;
+
+  if( amd->a && amd->e && amd->le )
+    for( i=0; i<amd->size; i++ ){
+      _zSpAMDListFree( &amd->a[i] );
+      _zSpAMDListFree( &amd->e[i] );
+      _zSpAMDListFree( &amd->le[i] );
+    }
+  zFree( amd->a );
+  zFree( amd->e );
+  zFree( amd->le );
+  zFree( amd->state );
+  zFree( amd->deg );
+  zFree( amd->mark );
+  zFree( amd->wmark );
+  zFree( amd->w );
+  zFree( amd->head );
+  zFree( amd->next );
+  zFree( amd->prev );
+}
+
+/* allocate workspace of approximate minimum degree ordering. */
+static bool _zSpAMDAlloc(_zSpAMD *amd, int size)
+{
+  int i;
+
+  amd->size = size;
+  amd->a = zAlloc( _zSpAMDList, size );
+  amd->e = zAlloc( _zSpAMDList, size );
+  amd->le = zAlloc( _zSpAMDList, size );
+  amd->state = zAlloc( int, size );
+  amd->deg = zAlloc( int, size );
+  amd->mark = zAlloc( int, size );
+  amd->wmark = zAlloc( int, size );
+  amd->w = zAlloc( int, size );
+  amd->head = zAlloc( int, size );
+  amd->next = zAlloc( int, size );
+  amd->prev = zAlloc( int, size );
+  if( !amd->a || !amd->e || !amd->le || !amd->state || !amd->deg || !amd->mark || !amd->wmark ||
+      !amd->w || !amd->head || !amd->next || !amd->prev ){
+    ZALLOCERROR();
+    _zSpAMDFree( amd );
+    return false;
+  }
+  for( i=0; i<size; i++ ){
+    amd->mark[i] = amd->wmark[i] = amd->head[i] = -1;
+  }
+  return true;
+}
+
+/* insert a variable to a degree bucket. */
+static void _zSpAMDBucketInsert(_zSpAMD *amd, int i)
+{
+  int d;
+
+  d = amd->deg[i];
+  amd->prev[i] = -1;
+  if( ( amd->next[i] = amd->head[d] ) >= 0 ) amd->prev[amd->head[d]] = i;
+  amd->head[d] = i;
+}
+
+/* remove a variable from a degree bucket. */
+static void _zSpAMDBucketRemove(_zSpAMD *amd, int i)
+{
+  if( amd->next[i] >= 0 ) amd->prev[amd->next[i]] = amd->prev[i];
+  if( amd->prev[i] >= 0 )
+    amd->next[amd->prev[i]] = amd->next[i];
+  else
+    amd->head[amd->deg[i]] = amd->next[i];
+}
+
+/* build the adjacency graph of a sparse matrix. */
+static bool _zSpAMDGraph(_zSpAMD *amd, const zSpMat a)
+{
+  int i, j, l, k, n;
+
+  zSpMatForEach( a, l, k ){
+    if( ( i = zSpMatIterRow(a,l,k) ) == ( j = zSpMatIterCol(a,l,k) ) ) continue;
+    if( !_zSpAMDListAdd( &amd->a[i], j ) || !_zSpAMDListAdd( &amd->a[j], i ) ) return false;
+  }
+  for( i=0; i<amd->size; i++ ){ /* remove duplicates */
+    for( n=0, k=0; k<amd->a[i].size; k++ ){
+      if( amd->mark[( j = amd->a[i].buf[k] )] == i ) continue;
+      amd->mark[j] = i;
+      amd->a[i].buf[n++] = j;
+    }
+    amd->a[i].size = amd->deg[i] = n;
+    _zSpAMDBucketInsert( amd, i );
+  }
+  for( i=0; i<amd->size; i++ ) amd->mark[i] = -1;
+  return true;
+}
+
+/* eliminate a variable and make it an element, absorbing adjacent elements. */
+static bool _zSpAMDEliminate(_zSpAMD *amd, int p, int stamp)
+{
+  _zSpAMDList *lp;
+  int i, j, k;
+
+  lp = &amd->le[p];
+  amd->state[p] = ZM_SPAMD_ELEM;
+  amd->mark[p] = stamp;
+  for( k=0; k<amd->a[p].size; k++ ){
+    i = amd->a[p].buf[k];
+    if( amd->state[i] != ZM_SPAMD_VAR || amd->mark[i] == stamp ) continue;
+    amd->mark[i] = stamp;
+    if( !_zSpAMDListAdd( lp, i ) ) return false;
+  }
+  for( k=0; k<amd->e[p].size; k++ ){
+    if( amd->state[( i = amd->e[p].buf[k] )] != ZM_SPAMD_ELEM ) continue;
+    for( j=0; j<amd->le[i].size; j++ ){
+      if( amd->state[amd->le[i].buf[j]] != ZM_SPAMD_VAR || amd->mark[amd->le[i].buf[j]] == stamp ) continue;
+      amd->mark[amd->le[i].buf[j]] = stamp;
+      if( !_zSpAMDListAdd( lp, amd->le[i].buf[j] ) ) return false;
+    }
+    amd->state[i] = ZM_SPAMD_ABSORBED;
+    _zSpAMDListFree( &amd->le[i] );
+  }
+  _zSpAMDListFree( &amd->a[p] );
+  _zSpAMDListFree( &amd->e[p] );
+  return true;
+}
+
+/* update approximate degrees of variables adjacent to a new element. */
+static bool _zSpAMDUpdate(_zSpAMD *amd, int p, int stamp, int rest, int *mindeg)
+{
+  _zSpAMDList *lp;
+  int i, j, k, n, d;
+
+  lp = &amd->le[p];
+  /* external degrees |Le \ Lp| of elements adjacent to Lp */
+  for( k=0; k<lp->size; k++ ){
+    i = lp->buf[k];
+    for( j=0; j<amd->e[i].size; j++ ){
+      if( amd->state[( n = amd->e[i].buf[j] )] != ZM_SPAMD_ELEM ) continue;
+      if( amd->wmark[n] != stamp ){
+        amd->wmark[n] = stamp;
+        amd->w[n] = amd->le[n].size;
+      }
+      amd->w[n]--;
+    }
+  }
+  for( k=0; k<lp->size; k++ ){
+    i = lp->buf[k];
+    _zSpAMDBucketRemove( amd, i );
+    d = lp->size - 1;
+    for( n=0, j=0; j<amd->e[i].size; j++ ){
+      if( amd->state[amd->e[i].buf[j]] != ZM_SPAMD_ELEM ) continue;
+      d += amd->w[amd->e[i].buf[j]];
+      amd->e[i].buf[n++] = amd->e[i].buf[j];
+    }
+    amd->e[i].size = n;
+    if( !_zSpAMDListAdd( &amd->e[i], p ) ) return false;
+    /* variables covered by the new element are pruned */
+    for( n=0, j=0; j<amd->a[i].size; j++ ){
+      if( amd->state[amd->a[i].buf[j]] != ZM_SPAMD_VAR || amd->mark[amd->a[i].buf[j]] == stamp ) continue;
+      amd->a[i].buf[n++] = amd->a[i].buf[j];
+    }
+    amd->a[i].size = n;
+    d += n;
+    amd->deg[i] = zMin( d, rest - 1 );
+    _zSpAMDBucketInsert( amd, i );
+    if( amd->deg[i] < *mindeg ) *mindeg = amd->deg[i];
+  }
+  return true;
+}
+
+/* approximate minimum degree ordering. */
+int *zSpMatOrderAMD(const zSpMat a, int *perm)
+{
+  _zSpAMD amd;
+  int k, p, mindeg;
+  int *ret = NULL;
+
+  if( a->rowsize != a->colsize ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return NULL;
+  }
+  if( a->rowsize == 0 ) return perm;
+  if( !_zSpAMDAlloc( &amd, a->rowsize ) ) return NULL;
+  if( !_zSpAMDGraph( &amd, a ) ) goto TERMINATE;
+  for( mindeg=0, k=0; k<amd.size; k++ ){
+    while( amd.head[mindeg] < 0 ) mindeg++;
+    _zSpAMDBucketRemove( &amd, ( p = amd.head[mindeg] ) );
+    perm[k] = p;
+    if( !_zSpAMDEliminate( &amd, p, k ) ||
+        !_zSpAMDUpdate( &amd, p, k, amd.size - k - 1, &mindeg ) ) goto TERMINATE;
+  }
+  ret = perm;
+ TERMINATE:
+  _zSpAMDFree( &amd );
+  return ret;
+}
+
+/* ********************************************************** */
+/* sparse Cholesky factorization
+ * ********************************************************** */
+
+/* initialize a sparse Cholesky factorization. */
+zSpCholesky *zSpCholeskyInit(zSpCholesky *chol)
+{
+  chol->size = 0;
+  chol->perm = chol->pinv = chol->parent = NULL;
+  chol->l = NULL;
+  chol->factorized = false;
+  chol->_format = ZM_SPMAT_CSR;
+  chol->_nnz = 0;
+  chol->_c = NULL;
+  chol->_ptr = chol->_ind = chol->_map = chol->_s = chol->_w = chol->_count = NULL;
+  chol->_x = NULL;
+  return chol;
+}
+
+/* free a sparse Cholesky factorization. */
+void zSpCholeskyFree(zSpCholesky *chol)
+{
+  zFree( chol->perm );
+  zFree( chol->pinv );
+  zFree( chol->parent );
+  zSpMatFree( chol->l );
+  zSpMatFree( chol->_c );
+  zFree( chol->_ptr );
+  zFree( chol->_ind );
+  zFree( chol->_map );
+  zFree( chol->_s );
+  zFree( chol->_w );
+  zFree( chol->_count );
+  zFree( chol->_x );
+  zSpCholeskyInit( chol );
+}
+
+/* nonzero pattern of the k-th row of L, which is stored in s[top], ..., s[n-1]. */
+static int _zSpCholeskyEReach(zSpCholesky *chol, int k)
+{
+  zSpMat c;
+  int i, p, len, top;
+
+  c = chol->_c;
+  top = chol->size;
+  chol->_w[k] = k;
+  for( p=c->ptr[k]; p<c->ptr[k+1]; p++ ){
+    for( len=0, i=c->ind[p]; chol->_w[i]!=k; i=chol->parent[i] ){
+      chol->_s[len++] = i;
+      chol->_w[i] = k;
+    }
+    while( len > 0 ) chol->_s[--top] = chol->_s[--len];
+  }
+  return top;
+}
+
+/* upper triangular part of the permuted matrix and the map from the original components. */
+static bool _zSpCholeskyPermute(zSpCholesky *chol, const zSpMat a)
+{
+  int i, j, l, k, p;
+
+  if( !( chol->_c = zSpMatAlloc( chol->size, chol->size, a->nnz, ZM_SPMAT_CSC ) ) ) return false;
+  for( j=0; j<=chol->size; j++ ) chol->_c->ptr[j] = 0;
+  zSpMatForEach( a, l, k ){
+    if( ( i = zSpMatIterRow(a,l,k) ) > ( j = zSpMatIterCol(a,l,k) ) ) continue;
+    chol->_c->ptr[zMax( chol->pinv[i], chol->pinv[j] )+1]++;
+  }
+  for( j=0; j<chol->size; j++ ) chol->_c->ptr[j+1] += chol->_c->ptr[j];
+  for( j=0; j<chol->size; j++ ) chol->_count[j] = chol->_c->ptr[j];
+  zSpMatForEach( a, l, k ){
+    if( ( i = zSpMatIterRow(a,l,k) ) > ( j = zSpMatIterCol(a,l,k) ) ){
+      chol->_map[k] = -1;
+      continue;
+    }
+    p = chol->_count[zMax( chol->pinv[i], chol->pinv[j] )]++;
+    chol->_c->ind[p] = zMin( chol->pinv[i], chol->pinv[j] );
+    chol->_map[k] = p;
+  }
+  chol->_c->nnz = chol->_c->ptr[chol->size];
+  return true;
+}
+
+/* elimination tree of the permuted matrix. */
+static void _zSpCholeskyETree(zSpCholesky *chol)
+{
+  int i, k, p, inext;
+  int *ancestor;
+
+  ancestor = chol->_count;
+  for( k=0; k<chol->size; k++ ){
+    chol->parent[k] = ancestor[k] = -1;
+    for( p=chol->_c->ptr[k]; p<chol->_c->ptr[k+1]; p++ )
+      for( i=chol->_c->ind[p]; i>=0 && i<k; i=inext ){
+        inext = ancestor[i];
+        ancestor[i] = k;
+        if( inext < 0 ) chol->parent[i] = k;
+      }
+  }
+}
+
+/* symbolic analysis of a sparse Cholesky factorization. */
+bool zSpCholeskyAnalyze(zSpCholesky *chol, const zSpMat a)
+{
+  int k, top, n;
+
+  zSpCholeskyFree( chol );
+  if( a->rowsize != a->colsize ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return false;
+  }
+  n = chol->size = a->rowsize;
+  chol->_format = a->format;
+  chol->_nnz = a->nnz;
+  chol->_ptr = zAlloc( int, n+1 );
+  chol->_ind = zAlloc( int, zMax( a->nnz, 1 ) );
+  chol->perm = zAlloc( int, zMax( n, 1 ) );
+  chol->pinv = zAlloc( int, zMax( n, 1 ) );
+  chol->parent = zAlloc( int, zMax( n, 1 ) );
+  chol->_map = zAlloc( int, zMax( a->nnz, 1 ) );
+  chol->_s = zAlloc( int, zMax( n, 1 ) );
+  chol->_w = zAlloc( int, zMax( n, 1 ) );
+  chol->_count = zAlloc( int, zMax( n, 1 ) );
+  chol->_x = zAlloc( double, zMax( n, 1 ) );
+  if( !chol->perm || !chol->pinv || !chol->parent || !chol->_ptr || !chol->_ind || !chol->_map ||
+      !chol->_s || !chol->_w || !chol->_count || !chol->_x ){
+    ZALLOCERROR();
+    goto FAILURE;
+  }
+  memcpy( chol->_ptr, a->ptr, sizeof(int)*(n+1) );
+  memcpy( chol->_ind, a->ind, sizeof(int)*a->nnz );
+  if( !zSpMatOrderAMD( a, chol->perm ) ) goto FAILURE;
+  for( k=0; k<n; k++ ) chol->pinv[chol->perm[k]] = k;
+  if( !_zSpCholeskyPermute( chol, a ) ) goto FAILURE;
+  _zSpCholeskyETree( chol );
+  /* column counts of L */
+  for( k=0; k<n; k++ ){
+    chol->_count[k] = 1;
+    chol->_w[k] = -1;
+  }
+  for( k=0; k<n; k++ )
+    for( top=_zSpCholeskyEReach( chol, k ); top<n; top++ )
+      chol->_count[chol->_s[top]]++;
+  for( top=0, k=0; k<n; k++ ) top += chol->_count[k];
+  if( !( chol->l = zSpMatAlloc( n, n, top, ZM_SPMAT_CSC ) ) ) goto FAILURE;
+  for( chol->l->ptr[0]=0, k=0; k<n; k++ )
+    chol->l->ptr[k+1] = chol->l->ptr[k] + chol->_count[k];
+  chol->l->nnz = top;
+  return true;
+
+ FAILURE:
+  zSpCholeskyFree( chol );
+  return false;
+}
+
+/* check if the sparsity pattern of a matrix is the same with the analyzed one. */
+static bool _zSpCholeskyPatternMatch(zSpCholesky *chol, const zSpMat a)
+{
+  if( !chol->l || a->rowsize != chol->size || a->colsize != chol->size ||
+      a->format != chol->_format || a->nnz != chol->_nnz ) return false;
+  return memcmp( a->ptr, chol->_ptr, sizeof(int)*(chol->size+1) ) == 0 &&
+         memcmp( a->ind, chol->_ind, sizeof(int)*a->nnz ) == 0;
+}
+
+/* numeric factorization of a sparse Cholesky factorization. */
+bool zSpCholeskyFactorize(zSpCholesky *chol, const zSpMat a)
+{
+  zSpMat l;
+  int i, k, p, top, l0;
+  double d, lki;
+
+  chol->factorized = false;
+  if( !_zSpCholeskyPatternMatch( chol, a ) ){
+    ZRUNERROR( ZM_ERR_SPMAT_PATTERNMISMATCH );
+    return false;
+  }
+  for( k=0; k<a->nnz; k++ )
+    if( chol->_map[k] >= 0 ) chol->_c->val[chol->_map[k]] = a->val[k];
+  l = chol->l;
+  for( k=0; k<chol->size; k++ ){
+    chol->_count[k] = l->ptr[k];
+    chol->_w[k] = -1;
+    chol->_x[k] = 0;
+  }
+  for( k=0; k<chol->size; k++ ){
+    top = _zSpCholeskyEReach( chol, k );
+    for( p=chol->_c->ptr[k]; p<chol->_c->ptr[k+1]; p++ )
+      chol->_x[chol->_c->ind[p]] += chol->_c->val[p];
+    d = chol->_x[k];
+    chol->_x[k] = 0;
+    for( ; top<chol->size; top++ ){
+      i = chol->_s[top];
+      lki = chol->_x[i] / l->val[l->ptr[i]];
+      chol->_x[i] = 0;
+      for( p=l->ptr[i]+1; p<chol->_count[i]; p++ )
+        chol->_x[l->ind[p]] -= l->val[p] * lki;
+      d -= lki * lki;
+      l0 = chol->_count[i]++;
+      l->ind[l0] = k;
+      l->val[l0] = lki;
+    }
+    if( d <= 0 ){
+      ZRUNERROR( ZM_ERR_MAT_NOTPOSITIVEDEFINITE );
+      return false;
+    }
+    l0 = chol->_count[k]++;
+    l->ind[l0] = k;
+    l->val[l0] = sqrt( d );
+  }
+  return ( chol->factorized = true );
+}
+
+/* solve a linear equation with a sparse Cholesky factorization. */
+zVec zSpCholeskySolve(zSpCholesky *chol, const zVec b, zVec ans)
+{
+  zSpMat l;
+  int j, p;
+
+  if( !chol->factorized ){
+    ZRUNERROR( ZM_ERR_LE_FACTO_NOTFACTORIZED );
+    return NULL;
+  }
+  if( zVecSizeNC(b) != chol->size || zVecSizeNC(ans) != chol->size ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  l = chol->l;
+  for( j=0; j<chol->size; j++ ) chol->_x[j] = zVecElemNC(b,chol->perm[j]);
+  for( j=0; j<chol->size; j++ ){ /* L y = P b */
+    chol->_x[j] /= l->val[l->ptr[j]];
+    for( p=l->ptr[j]+1; p<l->ptr[j+1]; p++ )
+      chol->_x[l->ind[p]] -= l->val[p] * chol->_x[j];
+  }
+  for( j=chol->size-1; j>=0; j-- ){ /* L^T z = y */
+    for( p=l->ptr[j]+1; p<l->ptr[j+1]; p++ )
+      chol->_x[j] -= l->val[p] * chol->_x[l->ind[p]];
+    chol->_x[j] /= l->val[l->ptr[j]];
+  }
+  for( j=0; j<chol->size; j++ ) zVecSetElemNC( ans, chol->perm[j], chol->_x[j] );
+  return ans;
+}
+
+/* solve a sparse linear equation by Cholesky factorization. */
+zVec zLESolveSpCholesky(const zSpMat a, const zVec b, zVec ans)
+{
+  zSpCholesky chol;
+  zVec ret = NULL;
+
+  zSpCholeskyInit( &chol );
+  if( zSpCholeskyAnalyze( &chol, a ) && zSpCholeskyFactorize( &chol, a ) )
+    ret = zSpCholeskySolve( &chol, b, ans );
+  zSpCholeskyFree( &chol );
+  return ret;
+}
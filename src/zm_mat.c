@@ -798,6 +798,36 @@ zMat zMulMatTMatNC(const zMat m1, const zMat m2, zMat m)
   return m;
 }
 
+/* multiply two matrices on multiple threads without checking size consistency. */
+zMat zMulMatMatThreadNC(const zMat m1, const zMat m2, zMat m, int num)
+{
+  if( zRawGEMMIsSmall( zMatRowSizeNC(m1), zMatColSizeNC(m2), zMatColSizeNC(m1) ) ||
+      !zRawGEMMThread( false, false, zMatRowSizeNC(m1), zMatColSizeNC(m2), zMatColSizeNC(m1),
+        1.0, zMatBufNC(m1), zMatColCapacity(m1), zMatBufNC(m2), zMatColCapacity(m2), 0.0, zMatBufNC(m), zMatColCapacity(m), num ) )
+    zMulMatMatNC( m1, m2, m );
+  return m;
+}
+
+/* multiply a matrix and transpose of a matrix ('m = m1 m2^T') on multiple threads without checking size consistency. */
+zMat zMulMatMatTThreadNC(const zMat m1, const zMat m2, zMat m, int num)
+{
+  if( zRawGEMMIsSmall( zMatRowSizeNC(m1), zMatRowSizeNC(m2), zMatColSizeNC(m1) ) ||
+      !zRawGEMMThread( false, true, zMatRowSizeNC(m1), zMatRowSizeNC(m2), zMatColSizeNC(m1),
+        1.0, zMatBufNC(m1), zMatColCapacity(m1), zMatBufNC(m2), zMatColCapacity(m2), 0.0, zMatBufNC(m), zMatColCapacity(m), num ) )
+    zMulMatMatTNC( m1, m2, m );
+  return m;
+}
+
+/* multiply transpose of a matrix and a matrix 'm = m1^T m2' on multiple threads without checking size consistency. */
+zMat zMulMatTMatThreadNC(const zMat m1, const zMat m2, zMat m, int num)
+{
+  if( zRawGEMMIsSmall( zMatColSizeNC(m1), zMatColSizeNC(m2), zMatRowSizeNC(m1) ) ||
+      !zRawGEMMThread( true, false, zMatColSizeNC(m1), zMatColSizeNC(m2), zMatRowSizeNC(m1),
+        1.0, zMatBufNC(m1), zMatColCapacity(m1), zMatBufNC(m2), zMatColCapacity(m2), 0.0, zMatBufNC(m), zMatColCapacity(m), num ) )
+    zMulMatTMatNC( m1, m2, m );
+  return m;
+}
+
 /* multiply a vector by a matrix from the left side. */
 zVec zMulMatVec(const zMat m, const zVec v1, zVec v)
 {
@@ -876,25 +906,63 @@ zVec zMulMatTVecDRC(const zMat m, zVec v)
   return v;
 }
 
-/* quadratic multiplication of matrices ('q = a diag{w} a^T') without checking size consistency. */
-zMat zMatQuadNC(const zMat a, const zVec w, zMat q)
+/* matrices and a weighting vector shared by threads of a quadratic multiplication. */
+typedef struct{
+  zMat a, q;
+  zVec w;
+} _zMatQuadThreadData;
+
+/* quadratic multiplication of matrices ('q = a diag{w} a^T') for a part of rows. */
+static void _zMatQuadThreadTask(void *util, int from, int to)
 {
+  _zMatQuadThreadData *data;
+  double *ai, *aj, *qij;
   int i, j, k;
-  double wa;
 
-  zMatZero( q );
-  for( k=0; k<zMatColSizeNC(a); k++ )
-    for( i=0; i<zMatRowSizeNC(a); i++ ){
-      wa = w ? zVecElem(w,k) * zMatElemNC(a,i,k) : zMatElemNC(a,i,k);
-      for( j=i; j<zMatRowSizeNC(a); j++ )
-        zMatElemNC(q,i,j) += wa * zMatElemNC(a,j,k);
+  data = (_zMatQuadThreadData *)util;
+  for( i=from; i<to; i++ ){
+    ai = zMatRowBufNC(data->a,i);
+    for( j=i; j<zMatRowSizeNC(data->a); j++ ){
+      aj = zMatRowBufNC(data->a,j);
+      qij = &zMatElemNC(data->q,i,j);
+      *qij = 0;
+      if( data->w )
+        for( k=0; k<zMatColSizeNC(data->a); k++ )
+          *qij += zVecElemNC(data->w,k) * ai[k] * aj[k];
+      else
+        for( k=0; k<zMatColSizeNC(data->a); k++ )
+          *qij += ai[k] * aj[k];
     }
+  }
+}
+
+/* quadratic multiplication of matrices ('q = a diag{w} a^T') on multiple threads without checking size consistency. */
+zMat zMatQuadThreadNC(const zMat a, const zVec w, zMat q, int num)
+{
+  _zMatQuadThreadData data;
+  int i, j;
+
+  data.a = a;
+  data.w = w;
+  data.q = q;
+  if( num <= 0 ) num = zThreadNum();
+  if( zRawGEMMIsSmall( zMatRowSizeNC(a), zMatRowSizeNC(a), zMatColSizeNC(a) ) ) num = 1;
+  if( num == 1 )
+    _zMatQuadThreadTask( &data, 0, zMatRowSizeNC(a) );
+  else
+    zThreadFor( num, 0, zMatRowSizeNC(a), zThreadGrain( zMatRowSizeNC(a), num, 1 ), _zMatQuadThreadTask, &data );
   for( i=0; i<zMatRowSizeNC(a); i++ )
     for( j=i; j<zMatRowSizeNC(a); j++ )
       zMatSetElemNC( q, j, i, zMatElemNC(q,i,j) );
   return q;
 }
 
+/* quadratic multiplication of matrices ('q = a diag{w} a^T') without checking size consistency. */
+zMat zMatQuadNC(const zMat a, const zVec w, zMat q)
+{
+  return zMatQuadThreadNC( a, w, q, 0 );
+}
+
 /* quadratic multiplication of matrices ('q = a diag{w} a^T'). */
 zMat zMatQuad(const zMat a, const zVec w, zMat q)
 {
@@ -950,24 +1018,55 @@ zMat zMatTQuad(const zMat a, const zVec w, zMat q)
   return zMatTQuadNC( a, w, q );
 }
 
-/* quadratic multiplication of matrices ('m = a q a^T') without checking size consistency. */
-zMat zMulMatMatMatTNC(const zMat a, const zMat q, zMat m)
+/* matrices shared by threads of a quadratic multiplication. */
+typedef struct{
+  zMat a, q, m;
+} _zMulMatMatMatTThreadData;
+
+/* quadratic multiplication of matrices ('m = a q a^T') for a part of columns. */
+static void _zMulMatMatMatTThreadTask(void *util, int from, int to)
 {
+  _zMulMatMatMatTThreadData *data;
   int i, j, k;
   double y;
 
-  zMatZero( m );
-  for( i=0; i<zMatRowSizeNC(q); i++ )
-    for( j=0; j<zMatRowSizeNC(a); j++ ){
+  data = (_zMulMatMatMatTThreadData *)util;
+  for( j=from; j<to; j++ ){
+    for( k=0; k<zMatRowSizeNC(data->a); k++ )
+      zMatSetElemNC( data->m, k, j, 0 );
+    for( i=0; i<zMatRowSizeNC(data->q); i++ ){
       y = 0;
-      for( k=0; k<zMatColSizeNC(q); k++ )
-        y += zMatElemNC(q,i,k) * zMatElemNC(a,j,k);
-      for( k=0; k<zMatRowSizeNC(a); k++ )
-        zMatElemNC(m,k,j) += zMatElemNC(a,k,i) * y;
+      for( k=0; k<zMatColSizeNC(data->q); k++ )
+        y += zMatElemNC(data->q,i,k) * zMatElemNC(data->a,j,k);
+      for( k=0; k<zMatRowSizeNC(data->a); k++ )
+        zMatElemNC(data->m,k,j) += zMatElemNC(data->a,k,i) * y;
     }
+  }
+}
+
+/* quadratic multiplication of matrices ('m = a q a^T') on multiple threads without checking size consistency. */
+zMat zMulMatMatMatTThreadNC(const zMat a, const zMat q, zMat m, int num)
+{
+  _zMulMatMatMatTThreadData data;
+
+  data.a = a;
+  data.q = q;
+  data.m = m;
+  if( num <= 0 ) num = zThreadNum();
+  if( zRawGEMMIsSmall( zMatRowSizeNC(a), zMatRowSizeNC(a), zMatColSizeNC(a) ) ) num = 1;
+  if( num == 1 )
+    _zMulMatMatMatTThreadTask( &data, 0, zMatRowSizeNC(a) );
+  else
+    zThreadFor( num, 0, zMatRowSizeNC(a), zThreadGrain( zMatRowSizeNC(a), num, 1 ), _zMulMatMatMatTThreadTask, &data );
   return m;
 }
 
+/* quadratic multiplication of matrices ('m = a q a^T') without checking size consistency. */
+zMat zMulMatMatMatTNC(const zMat a, const zMat q, zMat m)
+{
+  return zMulMatMatMatTThreadNC( a, q, m, 0 );
+}
+
 /* quadratic multiplication of matrices ('m = a q a^T'). */
 zMat zMulMatMatMatT(const zMat a, const zMat q, zMat m)
 {
@@ -576,123 +576,844 @@ bool zMatSymEigJacobi(const zMat m, zVec eigval, zMat eigbase)
   return true;
 }
 
-/* sort singular values and corresponding bases. */
-static int _zMatSVDSort(const zMat m, zVec sv, zMat u)
-{
-  int i, im, rank;
-
-  rank = zMin( zMatRowSizeNC(m), zMatColSizeNC(m) );
-  for( i=0; i<rank; i++ ){
-    if( zIsTol( zDataMax( zVecBuf(sv)+i, zVecSizeNC(sv)-i, &im ), ZM_MAT_SVD_TOL ) ) break;
-    im += i;
-    zVecSwapNC( sv, i, im );
-    zVecSetElemNC( sv, i, sqrt( zVecElemNC(sv,i) ) );
-    zMatSwapColNC( u, i, im );
-  }
-  if( ( rank = i ) < zVecSizeNC(sv) )
-    for( i=rank; i<zVecSizeNC(sv); i++ ) /* replace theoretically zero singular values with zeroes */
-      zVecSetElemNC( sv, i, 0 );
-  return rank;
+/* tridiagonalization and implicit QL method */
+
+/* sqrt( a^2 + b^2 ) without destructive underflow or overflow. */
+static double _zMatSymEigHypot(double a, double b)
+{
+  a = fabs( a );
+  b = fabs( b );
+  if( a > b ) return a * sqrt( 1 + _zSqr( b / a ) );
+  return b == 0 ? 0 : b * sqrt( 1 + _zSqr( a / b ) );
 }
 
-/* singular value decomposition. */
-int zMatSVD(const zMat m, zMat u, zVec sv, zMat v)
+/* Householder reflector which maps a raw vector to a multiple of the first unit vector. */
+static double _zMatEigReflector(double *x, int n)
+{
+  double alpha, beta, xnorm;
+
+  if( n <= 1 || ( xnorm = zRawVecNorm( x+1, n-1 ) ) == 0 ) return 0;
+  alpha = x[0];
+  beta = _zMatSymEigHypot( alpha, xnorm );
+  if( alpha >= 0 ) beta = -beta;
+  zRawVecDivDRC( x+1, alpha - beta, n-1 );
+  x[0] = beta;
+  return ( beta - alpha ) / beta;
+}
+
+/* apply a Householder reflector with the implicit unit leading component to a raw vector. */
+static void _zMatEigReflect(const double *v, double tau, double *y, int n)
 {
-  int i, j, rank;
-  zMat c, w = NULL;
   double s;
 
-  if( !( c = zMatAllocSqr( zMatRowSizeNC(m) ) ) ){
+  if( tau == 0 ) return;
+  s = tau * ( y[0] + zRawVecInnerProd( v+1, y+1, n-1 ) );
+  y[0] -= s;
+  zRawVecCatDRC( y+1, -s, v+1, n-1 );
+}
+
+/* tridiagonalize a symmetric matrix by Householder reflections (destructive).
+ * The reflector of the k-th step is stored in the k-th row of a right of the subdiagonal component. */
+static void _zMatSymTridiagDST(zMat a, double *d, double *e, double *tau, double *p)
+{
+  double *v, *ai, beta, alpha;
+  int i, j, k, n, len;
+
+  n = zMatRowSizeNC(a);
+  for( k=0; k<n-2; k++ ){
+    v = &zMatElemNC(a,k,k+1);
+    len = n - k - 1;
+    if( ( tau[k] = _zMatEigReflector( v, len ) ) == 0 ) continue;
+    beta = v[0];
+    v[0] = 1;
+    /* A22 <- H A22 H = A22 - v w^T - w v^T */
+    for( i=0; i<len; i++ )
+      p[i] = tau[k] * zRawVecInnerProd( &zMatElemNC(a,k+1+i,k+1), v, len );
+    alpha = -0.5 * tau[k] * zRawVecInnerProd( p, v, len );
+    zRawVecCatDRC( p, alpha, v, len );
+    for( i=0; i<len; i++ ){
+      ai = &zMatElemNC(a,k+1+i,k+1);
+      for( j=0; j<len; j++ )
+        ai[j] -= v[i] * p[j] + p[i] * v[j];
+    }
+    v[0] = beta;
+  }
+  for( k=0; k<n; k++ ){
+    d[k] = zMatElemNC(a,k,k);
+    e[k] = k < n-1 ? zMatElemNC(a,k,k+1) : 0;
+  }
+}
+
+/* form the orthonormal matrix of the tridiagonalization from reflectors. */
+static void _zMatSymTridiagQ(const zMat a, const double *tau, zMat q, double *s)
+{
+  const double *v;
+  double *qi;
+  int i, k, n, len;
+
+  n = zMatRowSizeNC(a);
+  zMatIdentNC( q );
+  for( k=n-3; k>=0; k-- ){
+    if( tau[k] == 0 ) continue;
+    v = &zMatElemNC(a,k,k+1);
+    len = n - k - 1;
+    /* Q22 <- H Q22 accessing rows of Q contiguously */
+    zRawVecCopy( &zMatElemNC(q,k+1,k+1), s, len );
+    for( i=1; i<len; i++ )
+      zRawVecCatDRC( s, v[i], &zMatElemNC(q,k+1+i,k+1), len );
+    for( i=0; i<len; i++ ){
+      qi = &zMatElemNC(q,k+1+i,k+1);
+      zRawVecCatDRC( qi, -tau[k] * ( i == 0 ? 1 : v[i] ), s, len );
+    }
+  }
+}
+
+/* tridiagonalize a symmetric matrix. */
+bool zMatSymTridiag(const zMat m, zVec d, zVec e, zMat q)
+{
+  zMat a;
+  double *tau;
+  bool ret = true;
+
+  if( !zMatIsSqr( m ) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return false;
+  }
+  if( !zMatRowVecSizeEqual( m, d ) || !zMatRowVecSizeEqual( m, e ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  if( q && !zMatSizeEqual( m, q ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return false;
+  }
+  a = zMatClone( m );
+  tau = zAlloc( double, 2*zMatRowSizeNC(m) );
+  if( !a || !tau ){
     ZALLOCERROR();
-    rank = -1;
+    ret = false;
     goto TERMINATE;
   }
+  _zMatSymTridiagDST( a, zVecBufNC(d), zVecBufNC(e), tau, tau+zMatRowSizeNC(m) );
+  if( q ) _zMatSymTridiagQ( a, tau, q, tau+zMatRowSizeNC(m) );
+ TERMINATE:
+  zMatFree( a );
+  zFree( tau );
+  return ret;
+}
+
+/* diagonalize a symmetric tridiagonal matrix by the implicit QL method with Wilkinson's shift.
+ * Rotations are applied to rows of zt, namely, the transpose of the transformation matrix. */
+static void _zMatSymEigTridiagQL(double *d, double *e, int n, zMat zt)
+{
+  double b, c, f, g, p, r, s, dd, *zi, *zi1;
+  int i, k, l, m, iter;
+
+  for( l=0; l<n; l++ ){
+    iter = 0;
+    do{
+      for( m=l; m<n-1; m++ ){
+        dd = fabs( d[m] ) + fabs( d[m+1] );
+        if( fabs( e[m] ) + dd == dd ) break;
+      }
+      if( m == l ) break;
+      if( iter++ == Z_MAX_ITER_NUM ){
+        ZITERWARN( Z_MAX_ITER_NUM );
+        break;
+      }
+      g = ( d[l+1] - d[l] ) / ( 2.0 * e[l] );
+      r = _zMatSymEigHypot( g, 1.0 );
+      g = d[m] - d[l] + e[l] / ( g + ( g >= 0 ? r : -r ) );
+      s = c = 1.0;
+      p = 0;
+      for( i=m-1; i>=l; i-- ){
+        f = s * e[i];
+        b = c * e[i];
+        e[i+1] = ( r = _zMatSymEigHypot( f, g ) );
+        if( r == 0 ){ /* underflow */
+          d[i+1] -= p;
+          e[m] = 0;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = d[i+1] - p;
+        r = ( d[i] - g ) * s + 2.0 * c * b;
+        d[i+1] = g + ( p = s * r );
+        g = c * r - b;
+        if( zt ) /* rows i and i+1 of the transpose of the eigenbase */
+          for( zi=zMatRowBufNC(zt,i), zi1=zMatRowBufNC(zt,i+1), k=0; k<n; k++ ){
+            f = zi1[k];
+            zi1[k] = s * zi[k] + c * f;
+            zi[k] = c * zi[k] - s * f;
+          }
+      }
+      if( r == 0 && i >= l ) continue;
+      d[l] -= p;
+      e[l] = g;
+      e[m] = 0;
+    } while( m != l );
+  }
+}
+
+/* sort eigenvalues in ascending order with the corresponding rows of the transpose of the eigenbase. */
+static void _zMatSymEigTridiagSort(double *d, int n, zMat zt)
+{
+  int i, j, k;
+
+  for( i=0; i<n-1; i++ ){
+    for( k=i, j=i+1; j<n; j++ )
+      if( d[j] < d[k] ) k = j;
+    if( k == i ) continue;
+    zSwap( double, d[i], d[k] );
+    if( zt ) zMatSwapRowNC( zt, i, k );
+  }
+}
+
+/* diagonalize a symmetric matrix through tridiagonalization. */
+bool zMatSymEigTridiag(const zMat m, zVec eigval, zMat eigbase)
+{
+  zMat a;
+  double *tau, *e;
+  int n;
+  bool ret = true;
 
-  zMulMatMatTNC( m, m, c );
-  zMatSymEigJacobi( c, sv, u );
-  rank = _zMatSVDSort( m, sv, u );
-  if( !( w = zMatAlloc( zMatRowSizeNC(u), rank ) ) ){
+  if( !zMatIsSqr( m ) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return false;
+  }
+  if( eigbase && !zMatSizeEqual( m, eigbase ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return false;
+  }
+  if( !eigval || !zMatRowVecSizeEqual( m, eigval ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  n = zMatRowSizeNC(m);
+  a = zMatClone( m );
+  tau = zAlloc( double, 3*n );
+  if( !a || !tau ){
     ZALLOCERROR();
+    ret = false;
     goto TERMINATE;
   }
-  zMatGetNC( u, 0, 0, w );
-  zMatSetRowSize( v, rank );
+  e = tau + n;
+  _zMatSymTridiagDST( a, zVecBufNC(eigval), e, tau, tau+2*n );
+  if( eigbase ){
+    _zMatSymTridiagQ( a, tau, eigbase, tau+2*n );
+    zMatTDRC( eigbase );
+  }
+  _zMatSymEigTridiagQL( zVecBufNC(eigval), e, n, eigbase );
+  _zMatSymEigTridiagSort( zVecBufNC(eigval), n, eigbase );
+  if( eigbase ) zMatTDRC( eigbase );
+ TERMINATE:
+  zMatFree( a );
+  zFree( tau );
+  return ret;
+}
+
+/* number of eigenvalues of a symmetric tridiagonal matrix less than x (Sturm sequence). */
+static int _zMatSymEigExtremeSturm(const double *d, const double *e, int n, double x, double pivmin)
+{
+  double q;
+  int i, count;
+
+  q = d[0] - x;
+  for( count=0, i=0; ; ){
+    if( fabs( q ) < pivmin ) q = -pivmin;
+    if( q < 0 ) count++;
+    if( ++i >= n ) break;
+    q = d[i] - x - _zSqr( e[i-1] ) / q;
+  }
+  return count;
+}
+
+/* the j-th smallest eigenvalue of a symmetric tridiagonal matrix by bisection. */
+static double _zMatSymEigExtremeBisec(const double *d, const double *e, int n, int j, double lo, double hi, double pivmin)
+{
+  double mid;
+  int iter;
+
+  for( iter=0; iter<Z_MAX_ITER_NUM; iter++ ){
+    mid = 0.5 * ( lo + hi );
+    if( mid == lo || mid == hi ) break;
+    if( _zMatSymEigExtremeSturm( d, e, n, mid, pivmin ) <= j )
+      lo = mid;
+    else
+      hi = mid;
+  }
+  return 0.5 * ( lo + hi );
+}
+
+/* an eigenvector of a symmetric tridiagonal matrix by inverse iteration.
+ * T - lambda I is decomposed by Gaussian elimination with partial pivoting, and x is orthogonalized
+ * against rows of vt whose eigenvalues are close to lambda. */
+static void _zMatSymEigExtremeInvIter(const double *d, const double *e, int n, double lambda, double tnorm, const double *eigval, zMat vt, int j, double *x, double *w)
+{
+  double *u0, *u1, *u2, *l, *piv, t, eps;
+  int i, k, iter;
+
+  u0 = w; u1 = w + n; u2 = w + 2*n; l = w + 3*n; piv = w + 4*n;
+  eps = zTOL * tnorm;
+  if( eps == 0 ) eps = zTOL;
+  for( i=0; i<n; i++ ){
+    u0[i] = d[i] - lambda;
+    u1[i] = e[i];
+    u2[i] = 0;
+  }
+  for( i=0; i<n-1; i++ ){
+    if( fabs( u0[i] ) >= fabs( e[i] ) ){
+      if( u0[i] == 0 ) u0[i] = eps;
+      l[i] = e[i] / u0[i];
+      u0[i+1] -= l[i] * u1[i];
+      piv[i] = 0;
+    } else{ /* swap rows i and i+1 */
+      l[i] = u0[i] / e[i];
+      u0[i] = e[i];
+      t = u0[i+1];
+      u0[i+1] = u1[i] - l[i] * t;
+      u2[i] = u1[i+1];
+      u1[i+1] = -l[i] * u2[i];
+      u1[i] = t;
+      piv[i] = 1;
+    }
+  }
+  if( u0[n-1] == 0 ) u0[n-1] = eps;
+  for( i=0; i<n; i++ ) x[i] = zRandF(-1,1);
+  for( iter=0; iter<3; iter++ ){
+    for( i=0; i<n-1; i++ ){
+      if( piv[i] != 0 ) zSwap( double, x[i], x[i+1] );
+      x[i+1] -= l[i] * x[i];
+    }
+    for( i=n-1; i>=0; i-- ){
+      t = x[i];
+      if( i < n-1 ) t -= u1[i] * x[i+1];
+      if( i < n-2 ) t -= u2[i] * x[i+2];
+      x[i] = t / u0[i];
+    }
+    for( k=0; k<j; k++ ) /* reorthogonalization in a cluster */
+      if( fabs( eigval[k] - lambda ) < 1.0e-3 * tnorm )
+        zRawVecCatDRC( x, -zRawVecInnerProd( x, zMatRowBufNC(vt,k), n ), zMatRowBufNC(vt,k), n );
+    if( ( t = zRawVecNorm( x, n ) ) == 0 ){
+      x[j%n] = 1;
+      t = 1;
+    }
+    zRawVecDivDRC( x, t, n );
+  }
+}
+
+/* k extreme eigenvalues and eigenvectors of a symmetric matrix. */
+bool zMatSymEigExtreme(const zMat m, bool largest, zVec eigval, zMat eigbase)
+{
+  zMat a, vt = NULL;
+  double *tau, *d, *e, *w, lo, hi, r, tnorm, pivmin;
+  int i, j, n, k;
+  bool ret = true;
+
+  if( !zMatIsSqr( m ) ){
+    ZRUNERROR( ZM_ERR_MAT_NOTSQR );
+    return false;
+  }
+  n = zMatRowSizeNC(m);
+  if( !eigval || ( k = zVecSizeNC(eigval) ) > n ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  if( eigbase && ( zMatRowSizeNC(eigbase) != n || zMatColSizeNC(eigbase) != k ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return false;
+  }
+  a = zMatClone( m );
+  tau = zAlloc( double, 9*n );
+  if( eigbase ) vt = zMatAlloc( k, n );
+  if( !a || !tau || ( eigbase && !vt ) ){
+    ZALLOCERROR();
+    ret = false;
+    goto TERMINATE;
+  }
+  d = tau + n; e = tau + 2*n; w = tau + 3*n;
+  _zMatSymTridiagDST( a, d, e, tau, w );
+  /* Gershgorin's range */
+  lo = HUGE_VAL; hi = -HUGE_VAL;
+  for( pivmin=1, i=0; i<n; i++ ){
+    r = fabs( e[i] ) + ( i > 0 ? fabs( e[i-1] ) : 0 );
+    if( d[i] - r < lo ) lo = d[i] - r;
+    if( d[i] + r > hi ) hi = d[i] + r;
+    if( _zSqr( e[i] ) > pivmin ) pivmin = _zSqr( e[i] );
+  }
+  tnorm = zMax( fabs( lo ), fabs( hi ) );
+  pivmin *= 1.0e-300;
+  lo -= 2 * zTOL * tnorm + pivmin;
+  hi += 2 * zTOL * tnorm + pivmin;
+  for( j=0; j<k; j++ )
+    zVecSetElemNC( eigval, j, _zMatSymEigExtremeBisec( d, e, n, largest ? n-1-j : j, lo, hi, pivmin ) );
+  if( !eigbase ) goto TERMINATE;
+  for( j=0; j<k; j++ )
+    _zMatSymEigExtremeInvIter( d, e, n, zVecElemNC(eigval,j), tnorm, zVecBufNC(eigval), vt, j, zMatRowBufNC(vt,j), w );
+  /* back transformation by reflectors */
+  for( j=0; j<k; j++ )
+    for( i=n-3; i>=0; i-- )
+      _zMatEigReflect( &zMatElemNC(a,i,i+1), tau[i], zMatRowBufNC(vt,j)+i+1, n-i-1 );
+  zMatTNC( vt, eigbase );
+ TERMINATE:
+  zMatFreeAtOnce( 2, a, vt );
+  zFree( tau );
+  return ret;
+}
+
+/* singular value decomposition by Golub-Kahan-Reinsch method */
+
+/* bidiagonalize a tall matrix given as its transpose at by Householder reflections (destructive).
+ * The left reflector of the k-th step is stored in the k-th row of at right of the diagonal, and
+ * the right one in the k-th column of at below the subdiagonal. e[k] is the (k-1, k) component. */
+static void _zMatSVDBidiagDST(zMat at, double *d, double *e, double *taul, double *taur, double *s)
+{
+  double *x, *y;
+  int j, k, r, c, len;
+
+  c = zMatRowSizeNC(at);
+  r = zMatColSizeNC(at);
+  y = s + c;
+  e[0] = 0;
+  for( k=0; k<c; k++ ){
+    /* left reflector from the k-th column */
+    x = zMatRowBufNC(at,k) + k;
+    taul[k] = _zMatEigReflector( x, r-k );
+    d[k] = x[0];
+    for( j=k+1; j<c; j++ )
+      _zMatEigReflect( x, taul[k], zMatRowBufNC(at,j)+k, r-k );
+    taur[k] = 0;
+    if( k >= c-1 ) continue;
+    /* right reflector from the k-th row */
+    len = c - k - 1;
+    for( j=0; j<len; j++ ) s[j] = zMatElemNC(at,k+1+j,k);
+    taur[k] = _zMatEigReflector( s, len );
+    e[k+1] = s[0];
+    for( j=0; j<len; j++ ) zMatElemNC(at,k+1+j,k) = s[j];
+    if( taur[k] == 0 ) continue;
+    /* rows of at are accessed contiguously */
+    zRawVecCopy( zMatRowBufNC(at,k+1)+k+1, y, r-k-1 );
+    for( j=1; j<len; j++ )
+      zRawVecCatDRC( y, s[j], zMatRowBufNC(at,k+1+j)+k+1, r-k-1 );
+    for( j=0; j<len; j++ )
+      zRawVecCatDRC( zMatRowBufNC(at,k+1+j)+k+1, -taur[k] * ( j == 0 ? 1 : s[j] ), y, r-k-1 );
+  }
+}
+
+/* transpose of the left orthonormal matrix of bidiagonalization. */
+static void _zMatSVDBidiagUT(const zMat at, const double *taul, zMat ut)
+{
+  int i, k, c, r;
+
+  c = zMatRowSizeNC(at);
+  r = zMatColSizeNC(at);
+  zMatZero( ut );
+  for( i=0; i<zMatRowSizeNC(ut); i++ ) zMatSetElemNC( ut, i, i, 1.0 );
+  for( k=c-1; k>=0; k-- )
+    for( i=k; i<zMatRowSizeNC(ut); i++ )
+      _zMatEigReflect( zMatRowBufNC(at,k)+k, taul[k], zMatRowBufNC(ut,i)+k, r-k );
+}
+
+/* transpose of the right orthonormal matrix of bidiagonalization. */
+static void _zMatSVDBidiagVT(const zMat at, const double *taur, zMat vt, double *s)
+{
+  int i, j, k, c, len;
+
+  c = zMatRowSizeNC(at);
+  zMatIdentNC( vt );
+  for( k=c-3; k>=0; k-- ){
+    if( taur[k] == 0 ) continue;
+    len = c - k - 1;
+    for( j=0; j<len; j++ ) s[j] = zMatElemNC(at,k+1+j,k);
+    for( i=k+1; i<c; i++ )
+      _zMatEigReflect( s, taur[k], zMatRowBufNC(vt,i)+k+1, len );
+  }
+}
+
+/* rotate two rows of a matrix. */
+static void _zMatSVDRotRow(zMat m, int i1, int i2, double c, double s)
+{
+  double *m1, *m2, y;
+  int j;
+
+  if( !m ) return;
+  m1 = zMatRowBufNC(m,i1);
+  m2 = zMatRowBufNC(m,i2);
+  for( j=0; j<zMatColSizeNC(m); j++ ){
+    y = m1[j];
+    m1[j] = y * c + m2[j] * s;
+    m2[j] = m2[j] * c - y * s;
+  }
+}
+
+/* diagonalize an upper bidiagonal matrix by the implicit QR method with shifts.
+ * Rotations are applied to rows of ut and vt, which are the transposes of the orthonormal matrices. */
+static void _zMatSVDBidiagQR(double *d, double *e, int n, zMat ut, zMat vt)
+{
+  double anorm, c, f, g, h, s, x, y, z;
+  int i, j, k, l, nm = 0, iter;
+  bool flag;
+
+  for( anorm=0, i=0; i<n; i++ )
+    anorm = zMax( anorm, fabs( d[i] ) + fabs( e[i] ) );
+  for( k=n-1; k>=0; k-- ){
+    for( iter=0; ; iter++ ){
+      for( flag=true, l=k; l>=0; l-- ){ /* test for splitting */
+        nm = l - 1;
+        if( fabs( e[l] ) + anorm == anorm ){
+          flag = false;
+          break;
+        }
+        if( fabs( d[nm] ) + anorm == anorm ) break;
+      }
+      if( flag ){ /* cancel e[l] when d[l-1] is negligible */
+        c = 0;
+        s = 1;
+        for( i=l; i<=k; i++ ){
+          f = s * e[i];
+          e[i] *= c;
+          if( fabs( f ) + anorm == anorm ) break;
+          g = d[i];
+          d[i] = ( h = _zMatSymEigHypot( f, g ) );
+          c = g / h;
+          s = -f / h;
+          _zMatSVDRotRow( ut, nm, i, c, s );
+        }
+      }
+      z = d[k];
+      if( l == k ){ /* convergence */
+        if( z < 0 ){
+          d[k] = -z;
+          if( vt ) zRawVecRevDRC( zMatRowBufNC(vt,k), zMatColSizeNC(vt) );
+        }
+        break;
+      }
+      if( iter == Z_MAX_ITER_NUM ){
+        ZITERWARN( Z_MAX_ITER_NUM );
+        break;
+      }
+      /* shift from the bottom 2 x 2 minor */
+      x = d[l];
+      nm = k - 1;
+      y = d[nm];
+      g = e[nm];
+      h = e[k];
+      f = ( ( y - z ) * ( y + z ) + ( g - h ) * ( g + h ) ) / ( 2.0 * h * y );
+      g = _zMatSymEigHypot( f, 1.0 );
+      f = ( ( x - z ) * ( x + z ) + h * ( y / ( f + ( f >= 0 ? g : -g ) ) - h ) ) / x;
+      /* QR step by chasing the bulge */
+      c = s = 1.0;
+      for( j=l; j<=nm; j++ ){
+        i = j + 1;
+        g = e[i];
+        y = d[i];
+        h = s * g;
+        g *= c;
+        e[j] = ( z = _zMatSymEigHypot( f, h ) );
+        c = f / z;
+        s = h / z;
+        f = x * c + g * s;
+        g = g * c - x * s;
+        h = y * s;
+        y *= c;
+        _zMatSVDRotRow( vt, j, i, c, s );
+        d[j] = ( z = _zMatSymEigHypot( f, h ) );
+        if( z != 0 ){
+          c = f / z;
+          s = h / z;
+        }
+        f = c * g + s * y;
+        x = c * y - s * g;
+        _zMatSVDRotRow( ut, j, i, c, s );
+      }
+      e[l] = 0;
+      e[k] = f;
+      d[k] = x;
+    }
+  }
+}
+
+/* sort singular values in descending order with the corresponding rows of ut and vt. */
+static void _zMatSVDBidiagSort(double *d, int n, zMat ut, zMat vt)
+{
+  int i, j, k;
+
+  for( i=0; i<n-1; i++ ){
+    for( k=i, j=i+1; j<n; j++ )
+      if( d[j] > d[k] ) k = j;
+    if( k == i ) continue;
+    zSwap( double, d[i], d[k] );
+    if( ut ) zMatSwapRowNC( ut, i, k );
+    if( vt ) zMatSwapRowNC( vt, i, k );
+  }
+}
+
+/* singular value decomposition of a tall matrix given as its transpose at (destructive).
+ * Rows of ut and vt are left and right singular vectors, respectively, and either can be the null
+ * pointer. ut can have more rows than columns of the tall matrix to form the full orthonormal matrix. */
+static bool _zMatSVDGolubKahanDST(zMat at, double *sv, zMat ut, zMat vt)
+{
+  double *ws;
+  int c, r;
+
+  c = zMatRowSizeNC(at);
+  r = zMatColSizeNC(at);
+  if( !( ws = zAlloc( double, 4*c + r ) ) ){
+    ZALLOCERROR();
+    return false;
+  }
+  _zMatSVDBidiagDST( at, sv, ws, ws+c, ws+2*c, ws+3*c );
+  if( ut ) _zMatSVDBidiagUT( at, ws+c, ut );
+  if( vt ) _zMatSVDBidiagVT( at, ws+2*c, vt, ws+3*c );
+  _zMatSVDBidiagQR( sv, ws, c, ut, vt );
+  _zMatSVDBidiagSort( sv, c, ut, vt );
+  free( ws );
+  return true;
+}
+
+/* rank from singular values, where theoretically zero singular values are replaced with zeroes. */
+static int _zMatSVDRank(zVec sv, int size)
+{
+  int i, rank;
+
+  for( rank=0; rank<size; rank++ )
+    if( zIsTol( _zSqr( zVecElemNC(sv,rank) ), ZM_MAT_SVD_TOL ) ) break;
+  for( i=rank; i<zVecSizeNC(sv); i++ )
+    zVecSetElemNC( sv, i, 0 );
+  return rank;
+}
 
-  zMulMatTMatNC( w, m, v );
-  for( i=0; i<rank; i++ ){
-    s = 1.0 / zVecElemNC(sv,i);
-    for( j=0; j<zMatColSizeNC(m); j++ )
-      zMatElemNC(v,i,j) *= s;
+/* singular value decomposition. */
+int zMatSVD(const zMat m, zMat u, zVec sv, zMat v)
+{
+  zMat at, ut = NULL, vt = NULL;
+  int r, c, k, i, rank = -1;
+
+  r = zMatRowSizeNC(m);
+  c = zMatColSizeNC(m);
+  k = zMin( r, c );
+  if( zMatRowSizeNC(u) != r || ( zMatColSizeNC(u) != r && zMatColSizeNC(u) != k ) ||
+      zMatColSizeNC(v) != c || zMatRowCapacity(v) < k ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return -1;
   }
+  if( zVecSizeNC(sv) < k ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return -1;
+  }
+  if( r >= c ){ /* m = U S V^T */
+    at = zMatAlloc( c, r );
+    ut = zMatAlloc( zMatColSizeNC(u), r );
+    vt = zMatAllocSqr( c );
+  } else{ /* m^T = V S U^T */
+    at = zMatClone( m );
+    ut = zMatAlloc( r, c );
+    vt = zMatAllocSqr( r );
+  }
+  if( !at || !ut || !vt ){
+    ZALLOCERROR();
+    goto TERMINATE;
+  }
+  if( r >= c ){
+    zMatTNC( m, at );
+    if( !_zMatSVDGolubKahanDST( at, zVecBufNC(sv), ut, vt ) ) goto TERMINATE;
+    zMatTNC( ut, u );
+  } else{
+    if( !_zMatSVDGolubKahanDST( at, zVecBufNC(sv), ut, vt ) ) goto TERMINATE;
+    zMatTNC( vt, u );
+    zSwap( zMat, ut, vt );
+  }
+  /* vt holds right singular vectors in its rows */
+  rank = _zMatSVDRank( sv, k );
+  zMatSetRowSize( v, rank );
+  for( i=0; i<rank; i++ )
+    zRawVecCopy( zMatRowBufNC(vt,i), zMatRowBufNC(v,i), c );
  TERMINATE:
-  zMatFree( w );
-  zMatFree( c );
+  zMatFreeAtOnce( 3, at, ut, vt );
   return rank;
 }
 
-/* allocate internal matrix and vector for workspace. */
-static bool _zMatSingularValueMat(const zMat m, zMat *r, zVec *e)
+/* singular values of a matrix. */
+zVec zMatSingularValue(const zMat m, zVec sv)
 {
-  if( zMatRowSizeNC(m) > zMatColSizeNC(m) ){
-    *r = zMatAllocSqr( zMatColSizeNC(m) );
-    *e = zVecAlloc( zMatColSizeNC(m) );
-    if( !*r || !*e ){
+  zLQFacto f;
+  zMat mt = NULL, at = NULL;
+  int r, c, k, i, j;
+
+  r = zMatRowSizeNC(m);
+  c = zMatColSizeNC(m);
+  k = zMin( r, c );
+  if( zVecSizeNC(sv) != k ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  zLQFactoInit( &f );
+  if( zMax( r, c ) >= 2 * k ){ /* reduce to the triangular factor of LQ decomposition */
+    if( r > c && !( mt = zMatTClone( m ) ) ){
       ZALLOCERROR();
-      return false;
+      sv = NULL;
+      goto TERMINATE;
+    }
+    if( !zLQFactoAlloc( &f, k, zMax( r, c ) ) || !( at = zMatAllocSqr( k ) ) ||
+        zLQFactoDecomp( &f, mt ? mt : m, false ) < 0 ){
+      sv = NULL;
+      goto TERMINATE;
     }
-    zMulMatTMat( m, m, *r );
+    for( i=0; i<k; i++ )
+      for( j=0; j<=i; j++ )
+        zMatSetElemNC( at, i, j, zMatElemNC(f.a,i,j) );
   } else{
-    *r = zMatAllocSqr( zMatRowSizeNC(m) );
-    *e = zVecAlloc( zMatRowSizeNC(m) );
-    if( !*r || !*e ){
+    if( !( at = r >= c ? zMatTClone( m ) : zMatClone( m ) ) ){
       ZALLOCERROR();
-      return false;
+      sv = NULL;
+      goto TERMINATE;
     }
-    zMulMatMatT( m, m, *r );
   }
-  zVecRandUniform( *e, -1, 1 );
-  return true;
+  if( !_zMatSVDGolubKahanDST( at, zVecBufNC(sv), NULL, NULL ) ) sv = NULL;
+ TERMINATE:
+  zLQFactoFree( &f );
+  zMatFreeAtOnce( 2, mt, at );
+  return sv;
+}
+
+/* randomized truncated singular value decomposition */
+
+/* orthonormal basis of the range of a matrix. */
+static int _zMatSVDRandOrth(const zMat y, zMat q)
+{
+  zMatSetColSizeNC( q, zMatColSizeNC(y) );
+  return zMatDecompQR_Householder( y, q, NULL );
+}
+
+/* randomized truncated singular value decomposition. */
+int zMatSVDRand(const zMat m, int oversample, int power, zMat u, zVec sv, zMat v)
+{
+  zMat omega = NULL, y = NULL, q = NULL, z = NULL, b = NULL, ut = NULL, vt = NULL;
+  zVec s = NULL;
+  int r, c, k, l, i, rank = -1;
+
+  r = zMatRowSizeNC(m);
+  c = zMatColSizeNC(m);
+  k = zVecSizeNC(sv);
+  if( k > zMin( r, c ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return -1;
+  }
+  if( ( u && ( zMatRowSizeNC(u) != r || zMatColSizeNC(u) != k ) ) ||
+      ( v && ( zMatRowSizeNC(v) != k || zMatColSizeNC(v) != c ) ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return -1;
+  }
+  if( oversample < 0 ) oversample = ZM_MAT_SVD_RAND_OVERSAMPLE;
+  if( power < 0 ) power = ZM_MAT_SVD_RAND_POWER;
+  l = zMin( k + oversample, zMin( r, c ) );
+  omega = zMatAlloc( c, l );
+  y = zMatAlloc( r, l );
+  q = zMatAlloc( r, l );
+  z = zMatAlloc( c, l );
+  if( !omega || !y || !q || !z ){
+    ZALLOCERROR();
+    goto TERMINATE;
+  }
+  /* range finder with power iteration */
+  zMatRandUniform( omega, -1, 1 );
+  zMulMatMatNC( m, omega, y );
+  if( ( l = _zMatSVDRandOrth( y, q ) ) < 0 ) goto TERMINATE;
+  for( i=0; i<power && l>0; i++ ){
+    zMatSetColSizeNC( z, l );
+    zMulMatTMatNC( m, q, z );
+    if( ( l = _zMatSVDRandOrth( z, omega ) ) <= 0 ) break;
+    zMatSetColSizeNC( y, l );
+    zMulMatMatNC( m, omega, y );
+    if( ( l = _zMatSVDRandOrth( y, q ) ) < 0 ) goto TERMINATE;
+  }
+  if( l <= 0 ){
+    zVecZero( sv );
+    if( u ) zMatZero( u );
+    if( v ) zMatZero( v );
+    rank = 0;
+    goto TERMINATE;
+  }
+  /* B = Q^T A = V' S U'^T, which is factorized as the transpose of a tall matrix */
+  b = zMatAlloc( l, c );
+  ut = zMatAlloc( l, c );
+  vt = zMatAllocSqr( l );
+  s = zVecAlloc( l );
+  if( !b || !ut || !vt || !s ){
+    ZALLOCERROR();
+    goto TERMINATE;
+  }
+  zMulMatTMatNC( q, m, b );
+  if( !_zMatSVDGolubKahanDST( b, zVecBufNC(s), ut, vt ) ) goto TERMINATE;
+  l = zMin( l, k );
+  zVecZero( sv );
+  zRawVecCopy( zVecBufNC(s), zVecBufNC(sv), l );
+  if( u ){
+    zMatZero( u );
+    zMatSetRowSizeNC( vt, l );
+    zMatSetColSizeNC( u, l );
+    zMulMatMatTNC( q, vt, u );
+    zMatSetColSizeNC( u, k );
+  }
+  if( v ){
+    zMatZero( v );
+    for( i=0; i<l; i++ )
+      zRawVecCopy( zMatRowBufNC(ut,i), zMatRowBufNC(v,i), c );
+  }
+  rank = _zMatSVDRank( sv, l );
+ TERMINATE:
+  zMatFreeAtOnce( 7, omega, y, q, z, b, ut, vt );
+  zVecFree( s );
+  return rank;
 }
 
 /* maximum singular value of a matrix. */
 double zMatSingularValueMax(const zMat m)
 {
-  zMat r;
-  zVec e;
+  zVec sv;
   double s = 0;
 
-  if( _zMatSingularValueMat( m, &r, &e ) )
-    s = sqrt( zMatEigPower( r, e, 0 ) );
-  zMatFree( r );
-  zVecFree( e );
+  if( !( sv = zVecAlloc( zMatMinSize(m) ) ) ){
+    ZALLOCERROR();
+    return 0;
+  }
+  if( zMatSingularValue( m, sv ) ) s = zVecElemNC(sv,0);
+  zVecFree( sv );
   return s;
 }
 
 /* minimum singular value of a matrix. */
 double zMatSingularValueMin(const zMat m)
 {
-  zMat r;
-  zVec e;
+  zVec sv;
   double s = 0;
 
-  if( _zMatSingularValueMat( m, &r, &e ) )
-    s = sqrt( zMatEigPowerInv( r, e, 0 ) );
-  zMatFree( r );
-  zVecFree( e );
+  if( !( sv = zVecAlloc( zMatMinSize(m) ) ) ){
+    ZALLOCERROR();
+    return 0;
+  }
+  if( zMatSingularValue( m, sv ) ) s = zVecElemNC(sv,zVecSizeNC(sv)-1);
+  zVecFree( sv );
   return s;
 }
 
 /* condition number of a matrix. */
 double zMatCondNum(const zMat m)
 {
-  zMat r;
-  zVec e;
+  zVec sv;
   double smax, smin;
 
-  if( !_zMatSingularValueMat( m, &r, &e ) ) return NAN;
-  smax = sqrt( zMatEigPower( r, e, 0 ) );
-  smin = sqrt( zMatEigPowerInv( r, e, 0 ) );
-  zMatFree( r );
-  zVecFree( e );
+  if( !( sv = zVecAlloc( zMatMinSize(m) ) ) ){
+    ZALLOCERROR();
+    return NAN;
+  }
+  if( !zMatSingularValue( m, sv ) ){
+    zVecFree( sv );
+    return NAN;
+  }
+  smax = zVecElemNC(sv,0);
+  smin = zVecElemNC(sv,zVecSizeNC(sv)-1);
+  zVecFree( sv );
   return smin > zTOL ? smax / smin : HUGE_VAL;
 }
@@ -121,10 +121,15 @@ int zVecListPCA(const zVecList *points, double cr, zVec mean, zVec score, zMat l
     goto TERMINATE;
   }
   if( !zVecListMeanCov( points, mean, cov ) ||
-      !zMatSymEigJacobi( cov, score, loading ) ){
+      !zMatSymEigTridiag( cov, score, loading ) ){
     n = -1;
     goto TERMINATE;
   }
+  /* sort components in descending order of scores */
+  for( n=0; n<s/2; n++ ){
+    zVecSwapNC( score, n, s-1-n );
+    zMatSwapColNC( loading, n, s-1-n );
+  }
   /* contribution ratio */
   score_th = cr * zVecElemSum( score );
   for( score_sum=0, n=0; n<s; n++ ){
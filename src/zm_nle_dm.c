@@ -140,18 +140,20 @@ static int _zNLESolveBroyden(zNLE *nle, zVec var, void *util, double tol, int it
 }
 
 #define Z_NLE_WN_DEFAULT ( 1.0e-4 )
-zNLE *zNLECreate(zNLE *nle, int nv, int ne, double scale, zVec (* f)(const zVec,zVec,void*), zMat (* jac)(const zVec,zMat,void*))
+zNLE *zNLECreateArena(zNLE *nle, int nv, int ne, double scale, zVec (* f)(const zVec,zVec,void*), zMat (* jac)(const zVec,zMat,void*), zArena *arena)
 {
   nle->util = NULL;
-  nle->wn = zVecAlloc( nv );
-  nle->we = zVecAlloc( ne );
-  nle->_f = zVecAlloc( ne );
-  nle->_fw = zVecAlloc( ne );
-  nle->_fp = zVecAlloc( ne );
-  nle->_j = zMatAlloc( ne, nv );
+  nle->_opt._arena = arena;
+  nle->_adg = nle->_prg = NULL;
+  nle->wn = zArenaVecAlloc( arena, nv );
+  nle->we = zArenaVecAlloc( arena, ne );
+  nle->_f = zArenaVecAlloc( arena, ne );
+  nle->_fw = zArenaVecAlloc( arena, ne );
+  nle->_fp = zArenaVecAlloc( arena, ne );
+  nle->_j = zArenaMatAlloc( arena, ne, nv );
   if( !nle->wn || !nle->we || !nle->_f ||
       !nle->_fw || !nle->_fp || !nle->_j ||
-      !zOptDMCreate( &nle->_opt, nv, scale, _zNLEEval, _zNLEGrad, _zNLEHess ) ){
+      !zOptDMCreateArena( &nle->_opt, nv, scale, _zNLEEval, _zNLEGrad, _zNLEHess, arena ) ){
     zNLEDestroy( nle );
     return NULL;
   }
@@ -159,11 +161,10 @@ zNLE *zNLECreate(zNLE *nle, int nv, int ne, double scale, zVec (* f)(const zVec,
   /* Jacobian matrix function */
   if( ( nle->jac = jac ) ){
     nle->_jac = _zNLEJacobi;
-    nle->_adg = nle->_prg = NULL;
   } else{
     nle->_jac = _zNLEJacobiNG;
-    nle->_adg = zVecAlloc( ne );
-    nle->_prg = zVecAlloc( ne );
+    nle->_adg = zArenaVecAlloc( arena, ne );
+    nle->_prg = zArenaVecAlloc( arena, ne );
     if( !nle->_adg || !nle->_prg ){
       zNLEDestroy( nle );
       return NULL;
@@ -174,13 +175,20 @@ zNLE *zNLECreate(zNLE *nle, int nv, int ne, double scale, zVec (* f)(const zVec,
   return zNLEAssignNR( nle );
 }
 
+zNLE *zNLECreate(zNLE *nle, int nv, int ne, double scale, zVec (* f)(const zVec,zVec,void*), zMat (* jac)(const zVec,zMat,void*))
+{
+  return zNLECreateArena( nle, nv, ne, scale, f, jac, NULL );
+}
+
 void zNLEDestroy(zNLE *nle)
 {
   nle->f = NULL;
   nle->jac = NULL;
   nle->util = NULL;
-  zVecFreeAtOnce( 7, nle->wn, nle->we, nle->_f, nle->_fw, nle->_fp, nle->_adg, nle->_prg );
-  zMatFree( nle->_j );
+  if( !nle->_opt._arena ){
+    zVecFreeAtOnce( 7, nle->wn, nle->we, nle->_f, nle->_fw, nle->_fp, nle->_adg, nle->_prg );
+    zMatFree( nle->_j );
+  }
   zOptDMDestroy( &nle->_opt );
 }
 
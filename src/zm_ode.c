@@ -18,9 +18,96 @@ zVec _zODESubDefault(zVec x1, zVec x2, zVec dx, void *dummy)
   return zVecSubNC( x1, x2, dx );
 }
 
+/* fused linear combination of stages. */
+void _zODEStageSum(const double *x, double dt, const double *a, const double *k, int n, int dim, double *xs)
+{
+  int i, j;
+  double s;
+
+  for( i=0; i<dim; i++ ){
+    for( s=0, j=0; j<n; j++ )
+      s += a[j] * k[j*dim+i];
+    xs[i] = x[i] + dt * s;
+  }
+}
+
 /* assign concatenation and subtraction functions to an ODE solver. */
 void zODEAssignFunc(zODE *ode, zVec (* catf)(zVec,double,zVec,zVec,void*), zVec (* subf)(zVec,zVec,zVec,void*))
 {
   ode->cat = catf ? catf : _zODECatDefault;
   ode->sub = subf ? subf : _zODESubDefault;
 }
+
+/* allocate workspace of cubic Hermite interpolation. */
+zODEHermite *_zODEHermiteAlloc(zODEHermite *h, int dim, zArena *arena)
+{
+  h->t0 = h->t1 = 0;
+  h->f0_valid = h->f1_valid = false;
+  if( !( h->x0 = zArenaVecAlloc( arena, dim ) ) ||
+      !( h->x1 = zArenaVecAlloc( arena, dim ) ) ||
+      !( h->f0 = zArenaVecAlloc( arena, dim ) ) ||
+      !( h->f1 = zArenaVecAlloc( arena, dim ) ) ||
+      !( h->_dx = zArenaVecAlloc( arena, dim ) ) ) return NULL;
+  return h;
+}
+
+/* free workspace of cubic Hermite interpolation. */
+void _zODEHermiteFree(zODEHermite *h, zArena *arena)
+{
+  if( arena ) return; /* rewound together with the arena */
+  zVecFreeAtOnce( 5, h->x0, h->x1, h->f0, h->f1, h->_dx );
+}
+
+/* set the head of a step for cubic Hermite interpolation. */
+void _zODEHermiteSetHead(zODEHermite *h, double t, const zVec x, const zVec f)
+{
+  if( f ){
+    zVecCopyNC( f, h->f0 );
+    h->f0_valid = true;
+  } else
+  if( h->f1_valid && t == h->t1 && zVecEqual( x, h->x1, 0 ) ){
+    zVecCopyNC( h->f1, h->f0 ); /* continued from the last step */
+    h->f0_valid = true;
+  } else
+    h->f0_valid = false;
+  h->t0 = t;
+  zVecCopyNC( x, h->x0 );
+}
+
+/* set the tail of a step for cubic Hermite interpolation. */
+void _zODEHermiteSetTail(zODEHermite *h, double t, const zVec x, const zVec f)
+{
+  if( ( h->f1_valid = f ? true : false ) ) zVecCopyNC( f, h->f1 );
+  h->t1 = t;
+  zVecCopyNC( x, h->x1 );
+}
+
+/* cubic Hermite interpolation in a step. */
+zVec _zODEHermiteEval(zODE *ode, zODEHermite *h, double t, zVec x, void *util)
+{
+  double dt, theta, g0, g1, gy;
+  int i;
+
+  dt = h->t1 - h->t0;
+  theta = dt == 0 ? 1.0 : ( t - h->t0 ) / dt;
+  if( theta < -zTOL || theta > 1+zTOL ){
+    ZRUNERROR( ZM_ERR_ODE_DENSE_OUTOFRANGE, t, h->t0, h->t1 );
+    return NULL;
+  }
+  if( !h->f0_valid ){
+    ode->f( h->t0, h->x0, util, h->f0 );
+    h->f0_valid = true;
+  }
+  if( !h->f1_valid ){
+    ode->f( h->t1, h->x1, util, h->f1 );
+    h->f1_valid = true;
+  }
+  ode->sub( h->x1, h->x0, h->_dx, util );
+  if( dt != 0 ) zVecDivDRC( h->_dx, dt );
+  g0 = theta*zSqr(1-theta);
+  g1 = -zSqr(theta)*(1-theta);
+  gy = zSqr(theta)*( 3 - 2*theta );
+  for( i=0; i<zVecSizeNC(h->_dx); i++ )
+    zVecElemNC(h->_dx,i) = gy*zVecElemNC(h->_dx,i) + g0*zVecElemNC(h->f0,i) + g1*zVecElemNC(h->f1,i);
+  return ode->cat( h->x0, dt, h->_dx, x, util );
+}
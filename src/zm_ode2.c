@@ -173,3 +173,126 @@ void zODE2UpdateLeapfrog(zODE2 *ode, double t, zVec x, zVec v, double dt, void *
   ode->f( t, x, ode->_v, util, ode->_a );
   ode->cat_vel( ode->_v, 0.5*dt, ode->_a, v, util );
 }
+
+/* *** symplectic splitting methods *** */
+
+/* create */
+zODE2 *zODE2CreateVerlet(zODE2 *ode, int dim, int step, zVec (* f)(double,zVec,zVec,void*,zVec))
+{
+  ode->f = f;
+  ode->iter = ZODE2_ITER_NUM;
+  ode->tol = zTOL;
+  ode->_x = zVecAlloc(dim);
+  ode->_v = zVecAlloc(dim);
+  ode->_a = zVecAlloc(dim);
+  ode->_a2 = zVecAlloc(dim);
+  ode->_t = 0;
+  ode->_a_valid = false;
+  if( !ode->_x || !ode->_v || !ode->_a || !ode->_a2 ){
+    ZALLOCERROR();
+    zODE2DestroyVerlet( ode );
+    return NULL;
+  }
+  return ode;
+}
+
+/* destroy */
+void zODE2DestroyVerlet(zODE2 *ode)
+{
+  ode->f = NULL;
+  zVecFreeAtOnce( 4, ode->_x, ode->_v, ode->_a, ode->_a2 );
+  ode->_x = ode->_v = ode->_a = ode->_a2 = NULL;
+  ode->_a_valid = false;
+}
+
+/* kick velocity as v <- v + dt * a( t, x, v + dte * a ), where _a is an initial guess of a. */
+static void _zODE2Kick(zODE2 *ode, double t, zVec x, zVec v, double dt, double dte, void *util)
+{
+  zVec tmp;
+  int i;
+
+  for( i=0; i<ode->iter; i++ ){
+    ode->cat_vel( v, dte, ode->_a, ode->_v, util );
+    ode->f( t, x, ode->_v, util, ode->_a2 );
+    tmp = ode->_a; ode->_a = ode->_a2; ode->_a2 = tmp;
+    if( fabs(dte) * zVecDist( ode->_a, ode->_a2 ) < ode->tol ) goto TERMINATE;
+  }
+  if( ode->iter > 0 ) ZITERWARN( ode->iter );
+ TERMINATE:
+  ode->cat_vel( v, dt, ode->_a, v, util );
+}
+
+/* a substep of Stormer-Verlet method in the velocity form. */
+static void _zODE2SubstepVerlet(zODE2 *ode, double t, zVec x, zVec v, double dt, void *util)
+{
+  /* v_(i+1/2) = v_(i) + 0.5dt * a( t_(i), x_(i), v_(i+1/2) ) */
+  _zODE2Kick( ode, t, x, v, 0.5*dt, 0.5*dt, util );
+  /* x_(i+1) = x_(i) + dt * v_(i+1/2) */
+  ode->cat_dis( x, dt, v, x, util );
+  /* v_(i+1) = v_(i+1/2) + 0.5dt * a( t_(i+1), x_(i+1), v_(i+1/2) ) */
+  ode->f( t+dt, x, v, util, ode->_a );
+  ode->cat_vel( v, 0.5*dt, ode->_a, v, util );
+}
+
+/* a substep of Stormer-Verlet method in the position form. */
+static void _zODE2SubstepVerletPos(zODE2 *ode, double t, zVec x, zVec v, double dt, void *util)
+{
+  /* x_(i+1/2) = x_(i) + 0.5dt * v_(i) */
+  ode->cat_dis( x, 0.5*dt, v, x, util );
+  /* v_(i+1) = v_(i) + dt * a( t_(i+1/2), x_(i+1/2), ( v_(i) + v_(i+1) ) / 2 ) */
+  ode->f( t+0.5*dt, x, v, util, ode->_a );
+  _zODE2Kick( ode, t+0.5*dt, x, v, dt, 0.5*dt, util );
+  /* x_(i+1) = x_(i+1/2) + 0.5dt * v_(i+1) */
+  ode->cat_dis( x, 0.5*dt, v, x, util );
+}
+
+/* composition of substeps. */
+static void _zODE2UpdateComposition(zODE2 *ode, double t, zVec x, zVec v, double dt, void (* substep)(zODE2*,double,zVec,zVec,double,void*), const double w[], int n, void *util)
+{
+  double ts;
+  int i;
+
+  /* the acceleration at the tail of the last step is reused unless the state is reset. */
+  if( substep == _zODE2SubstepVerlet && ( !ode->_a_valid || t != ode->_t || !zVecEqual( x, ode->_x, 0 ) ) )
+    ode->f( t, x, v, util, ode->_a );
+  for( ts=t, i=0; i<n; ts+=w[i]*dt, i++ )
+    substep( ode, ts, x, v, w[i]*dt, util );
+  ode->_t = t + dt;
+  zVecCopyNC( x, ode->_x );
+  ode->_a_valid = substep == _zODE2SubstepVerlet;
+}
+
+/* update state destructively */
+void zODE2UpdateVerlet(zODE2 *ode, double t, zVec x, zVec v, double dt, void *util)
+{
+  static const double w[] = { 1.0 };
+  _zODE2UpdateComposition( ode, t, x, v, dt, _zODE2SubstepVerlet, w, 1, util );
+}
+
+/* weights of triple-jump composition: 1/(2-2^(1/3)) and -2^(1/3)/(2-2^(1/3)) */
+#define ZODE2_TRIPLEJUMP_W1  1.35120719195965763
+#define ZODE2_TRIPLEJUMP_W0 -1.70241438391931527
+
+/* update state destructively */
+void zODE2UpdateYoshida4(zODE2 *ode, double t, zVec x, zVec v, double dt, void *util)
+{
+  static const double w[] = { ZODE2_TRIPLEJUMP_W1, ZODE2_TRIPLEJUMP_W0, ZODE2_TRIPLEJUMP_W1 };
+  _zODE2UpdateComposition( ode, t, x, v, dt, _zODE2SubstepVerlet, w, 3, util );
+}
+
+/* update state destructively (solution A by Yoshida) */
+void zODE2UpdateYoshida6(zODE2 *ode, double t, zVec x, zVec v, double dt, void *util)
+{
+  static const double w[] = {
+    0.784513610477560, 0.235573213359357, -1.17767998417887,
+    1.31518632068391,
+    -1.17767998417887, 0.235573213359357, 0.784513610477560 };
+  _zODE2UpdateComposition( ode, t, x, v, dt, _zODE2SubstepVerlet, w, 7, util );
+}
+
+/* update state destructively */
+void zODE2UpdateForestRuth(zODE2 *ode, double t, zVec x, zVec v, double dt, void *util)
+{
+  static const double w[] = { ZODE2_TRIPLEJUMP_W1, ZODE2_TRIPLEJUMP_W0, ZODE2_TRIPLEJUMP_W1 };
+  _zODE2UpdateComposition( ode, t, x, v, dt, _zODE2SubstepVerletPos, w, 3, util );
+}
@@ -14,6 +14,7 @@ typedef struct{
   zVec wb, wm; /* weight vector */
   zVec x1, x2; /* working memory for PC method */
   zVecRing hist; /* history of differential values */
+  zODEHermite dense;
 } _zODE_Adams;
 
 /* allocate working space for zODE_Adams. */
@@ -27,7 +28,8 @@ static zODE *_zODEAllocAdams(zODE *ode, int dim, int step, zVec (* f)(double,zVe
       !( ws->wm = zVecAlloc( step ) ) ||
       !( ws->x1 = zVecAlloc( dim ) ) ||
       !( ws->x2 = zVecAlloc( dim ) ) ||
-      !zVecRingAlloc( &ws->hist, dim, step ) ){
+      !zVecRingAlloc( &ws->hist, dim, step ) ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
@@ -92,6 +94,7 @@ void zODEDestroyAdams(zODE *ode)
   ws->step = 0;
   zVecFreeAtOnce( 5, ws->dx, ws->wb, ws->wm, ws->x1, ws->x2 );
   zVecRingFree( &ws->hist );
+  _zODEHermiteFree( &ws->dense, NULL );
   ode->f = NULL;
   zFree( ode->_ws );
 }
@@ -122,6 +125,14 @@ zVec zODEUpdateAdams(zODE *ode, double t, zVec x, double dt, void *util)
   ZITERWARN( iter );
  UPDATE:
   zRingIncHead( &ws->hist ); /* reset ring */
+  _zODEHermiteSetHead( &ws->dense, t, x, *zRingHead(&ws->hist) );
+  _zODEHermiteSetTail( &ws->dense, t2, xnew, NULL );
   zVecCopy( xnew, x );
   return x;
 }
+
+/* dense output in the last step of Predictor-Corrector method. */
+zVec zODEDenseAdams(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_Adams *)ode->_ws)->dense, t, x, util );
+}
@@ -14,6 +14,7 @@ typedef struct{
   void *util;
   int iter;
   zNLE nle;
+  zODEHermite dense;
 } _zODE_BEuler;
 
 /* backward Euler method */
@@ -37,7 +38,8 @@ zODE* zODECreateBEuler(zODE *ode, int dim, int iter, zVec (* f)(double,zVec,void
   if( !( ws = zAlloc( _zODE_BEuler, 1 ) ) ||
       !( ws->v = zVecAlloc( dim ) ) ||
       !( ws->x = zVecAlloc( dim ) ) ||
-      !zNLECreate( &ws->nle, dim, dim, 0, _zODE_BEuler_Func, NULL ) ){
+      !zNLECreate( &ws->nle, dim, dim, 0, _zODE_BEuler_Func, NULL ) ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
@@ -56,6 +58,7 @@ void zODEDestroyBEuler(zODE *ode)
   ws = (_zODE_BEuler *)ode->_ws;
   zNLEDestroy( &ws->nle );
   zVecFreeAtOnce( 2, ws->v, ws->x );
+  _zODEHermiteFree( &ws->dense, NULL );
   zFree( ws );
   ode->f = NULL;
 }
@@ -70,10 +73,18 @@ zVec zODEUpdateBEuler(zODE *ode, double t, zVec x, double dt, void *util)
   ws->dt = dt;
   ws->util = util;
   zVecCopyNC( x, ws->x );
+  _zODEHermiteSetHead( &ws->dense, t, x, NULL );
   zNLESolve( &ws->nle, x, ode, zTOL, ws->iter, NULL );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
   return x;
 }
 
+/* dense output in the last step of backward Euler method and trapezoidal formula method. */
+zVec zODEDenseBEuler(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_BEuler *)ode->_ws)->dense, t, x, util );
+}
+
 /* trapezoidal formula method */
 
 /* directly integrate variable by ODE based on backward Euler method. */
@@ -87,7 +98,9 @@ zVec zODEUpdateTR(zODE *ode, double t, zVec x, double dt, void *util)
   ws->util = util;
   zVecCopyNC( x, ws->x );
   ode->f( t, ws->x, ws->util, ws->v );  /* NOTE: ws->t != t */
+  _zODEHermiteSetHead( &ws->dense, t, x, ws->v );
   ode->cat( ws->x, ws->dt, ws->v, ws->x, ws->util ); /* NOTE: ws->dt != dt */
   zNLESolve( &ws->nle, x, ode, zTOL, ws->iter, NULL );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
   return x;
 }
@@ -16,6 +16,7 @@ typedef struct{
   void *util;
   int iter;
   zNLE nle;
+  zODEHermite dense;
 } _zODE_BK4;
 
 /* algebraic equation for Butcher-Kuntzmann method. */
@@ -53,7 +54,8 @@ zODE* zODECreateBK4(zODE *ode, int dim, int iter, zVec (* f)(double,zVec,void*,z
       !( ws->x = zVecAlloc( dim ) ) ||
       !( ws->xt = zVecAlloc( dim ) ) ||
       !( ws->k = zVecAlloc( dim*2 ) ) ||
-      !zNLECreate( &ws->nle, dim*2, dim*2, 0, _zODE_BK4_Func, NULL ) ){
+      !zNLECreate( &ws->nle, dim*2, dim*2, 0, _zODE_BK4_Func, NULL ) ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
@@ -74,6 +76,7 @@ void zODEDestroyBK4(zODE *ode)
   ws = (_zODE_BK4 *)ode->_ws;
   zNLEDestroy( &ws->nle );
   zVecFreeAtOnce( 4, ws->v, ws->x, ws->xt, ws->k );
+  _zODEHermiteFree( &ws->dense, NULL );
   zFree( ws );
   ode->f = NULL;
 }
@@ -97,8 +100,10 @@ zVec zODEUpdateGauss(zODE *ode, double t, zVec x, double dt, void *util)
   zVecCopyNC( x, ws->x );
   zVecZero( ws->k );
   zNLESolve( &ws->nle, ws->k, ode, zTOL, ws->iter, NULL );
+  _zODEHermiteSetHead( &ws->dense, t, x, NULL );
   ode->cat( x, dt, &ws->k1, x, util );
   ode->cat( x, dt, &ws->k2, x, util );
+  _zODEHermiteSetTail( &ws->dense, t+2*dt, x, NULL );
   return x;
 }
 
@@ -118,7 +123,15 @@ zVec zODEUpdateRadau(zODE *ode, double t, zVec x, double dt, void *util)
   zVecCopyNC( x, ws->x );
   zVecZero( ws->k );
   zNLESolve( &ws->nle, ws->k, ode, zTOL, ws->iter, NULL );
+  _zODEHermiteSetHead( &ws->dense, t, x, NULL );
   ode->cat( x, ws->a21, &ws->k1, x, util );
   ode->cat( x, ws->a22, &ws->k2, x, util );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
   return x;
 }
+
+/* dense output in the last step of Butcher-Kuntzmann method. */
+zVec zODEDenseBK4(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_BK4 *)ode->_ws)->dense, t, x, util );
+}
@@ -2,7 +2,8 @@
  * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
  *
  * zm_ode_dc - ordinary differential equation quadrature:
- * deferred correction with Richardson's extrapolation.
+ * deferred correction with Richardson's extrapolation and
+ * revisionist integral deferred correction.
  */
 
 #include <zm/zm_ode.h>
@@ -49,3 +50,170 @@ zVec zODEUpdateDC(zODE *ode, double t, zVec x, double dt, void *util)
   }
   return x;
 }
+
+/* revisionist integral deferred correction (RIDC) */
+
+/* weights of the Lagrange interpolation on nodes 0, ..., l integrated over [o, o+1] for o < l. */
+static void _zODERIDCWeight(zODERIDC *ridc, double *c)
+{
+  double *w, p, p1;
+  int l, o, i, j, k, d;
+
+  for( l=1; l<=ridc->level; l++ )
+    for( i=0; i<=l; i++ ){
+      /* coefficients of the i-th Lagrange basis polynomial */
+      c[0] = 1;
+      for( d=0, j=0; j<=l; j++ ){
+        if( j == i ) continue;
+        for( c[++d]=0, k=d; k>0; k-- )
+          c[k] = ( c[k-1] - j * c[k] ) / ( i - j );
+        c[0] *= -j / (double)( i - j );
+      }
+      for( o=0; o<l; o++ ){
+        w = ridc->_w + ( ( l - 1 ) * ridc->level + o ) * ( ridc->level + 1 );
+        for( w[i]=0, p=o, p1=o+1, k=0; k<=l; k++, p*=o, p1*=o+1 )
+          w[i] += c[k] * ( p1 - p ) / ( k + 1 );
+      }
+    }
+}
+
+/* create a RIDC solver. */
+zODERIDC *zODERIDCCreate(zODERIDC *ridc, int dim, int level, int block, zVec (* f)(double,zVec,void*,zVec))
+{
+  double *c;
+  int l, j, nnode;
+
+  if( level < 0 ){
+    ZRUNERROR( ZM_ERR_ODE_RIDC_LEVEL, level );
+    return NULL;
+  }
+  ridc->dim = dim;
+  ridc->level = level;
+  if( block == 0 ) block = ZODE_RIDC_BLOCK;
+  ridc->block = block = zMax( block, 2*level );
+  ridc->thread_num = 0;
+  ridc->f = f;
+  ridc->cat = _zODECatDefault;
+  nnode = block + 1;
+  ridc->_w = level > 0 ? zAlloc( double, level*level*(level+1) ) : NULL;
+  ridc->_fbuf = zAlloc( double, (level+1)*nnode*dim );
+  ridc->_fv = zAlloc( zVecStruct, (level+1)*nnode );
+  ridc->_x = zAlloc( zVec, level+1 );
+  ridc->_d = zAlloc( zVec, level+1 );
+  ridc->_count = zAlloc( zThreadCounter, level+1 );
+  c = zAlloc( double, level+1 );
+  if( ( level > 0 && !ridc->_w ) || !ridc->_fbuf || !ridc->_fv ||
+      !ridc->_x || !ridc->_d || !ridc->_count || !c ) goto FAILURE;
+  for( l=0; l<=level; l++ ){
+    if( !( ridc->_x[l] = zVecAlloc( dim ) ) || !( ridc->_d[l] = zVecAlloc( dim ) ) ||
+        !zThreadCounterInit( &ridc->_count[l] ) ) goto FAILURE;
+    for( j=0; j<nnode; j++ )
+      zVecAssignArray( &ridc->_fv[l*nnode+j], dim, ridc->_fbuf + ( l*nnode + j ) * dim );
+  }
+  _zODERIDCWeight( ridc, c );
+  free( c );
+  return ridc;
+
+ FAILURE:
+  ZALLOCERROR();
+  free( c );
+  zODERIDCDestroy( ridc );
+  return NULL;
+}
+
+/* destroy a RIDC solver. */
+void zODERIDCDestroy(zODERIDC *ridc)
+{
+  int l;
+
+  for( l=0; l<=ridc->level; l++ ){
+    if( ridc->_x ) zVecFree( ridc->_x[l] );
+    if( ridc->_d ) zVecFree( ridc->_d[l] );
+    if( ridc->_count ) zThreadCounterDestroy( &ridc->_count[l] );
+  }
+  zFree( ridc->_w );
+  zFree( ridc->_fbuf );
+  zFree( ridc->_fv );
+  zFree( ridc->_x );
+  zFree( ridc->_d );
+  zFree( ridc->_count );
+  ridc->dim = ridc->level = 0;
+}
+
+/* derivative of a level at a node of the current block. */
+#define _zODERIDCF(ridc,l,j) ( &(ridc)->_fv[(l)*((ridc)->block+1)+(j)] )
+
+/* a sweep of a level over the current block, which proceeds as soon as the preceding level
+ * provides the derivatives at the nodes required for the quadrature. */
+static void _zODERIDCSweep(zODERIDC *ridc, int l)
+{
+  zVec x, d, fl, fp;
+  double *w;
+  int n, i, j, s0;
+
+  x = ridc->_x[l];
+  d = ridc->_d[l];
+  for( n=0; ; n++ ){
+    fl = _zODERIDCF( ridc, l, n );
+    ridc->f( ridc->_t + n*ridc->_h, x, ridc->_util, fl );
+    zThreadCounterSet( &ridc->_count[l], n+1 );
+    if( n == ridc->_n ) break;
+    if( l == 0 ){ /* forward Euler predictor */
+      ridc->cat( x, ridc->_h, fl, x, ridc->_util );
+      continue;
+    }
+    /* forward Euler corrector on the error equation with the integral of the interpolated
+     * derivative of the preceding level on nodes s0, ..., s0+l */
+    zThreadCounterWait( &ridc->_count[l-1], zMax( n+2, l+1 ) );
+    s0 = zMax( n+1-l, 0 );
+    w = ridc->_w + ( ( l - 1 ) * ridc->level + n - s0 ) * ( ridc->level + 1 );
+    fp = _zODERIDCF( ridc, l-1, n );
+    for( i=0; i<ridc->dim; i++ )
+      zVecElemNC(d,i) = zVecElemNC(fl,i) - zVecElemNC(fp,i);
+    for( j=0; j<=l; j++ ){
+      fp = _zODERIDCF( ridc, l-1, s0+j );
+      for( i=0; i<ridc->dim; i++ )
+        zVecElemNC(d,i) += w[j] * zVecElemNC(fp,i);
+    }
+    ridc->cat( x, ridc->_h, d, x, ridc->_util );
+  }
+}
+
+/* sweeps of levels assigned to a thread. */
+static void _zODERIDCSweepThread(void *util, int from, int to)
+{
+  for( ; from<to; from++ )
+    _zODERIDCSweep( (zODERIDC *)util, from );
+}
+
+/* integrate an ODE by RIDC. */
+zVec zODERIDCIntegrate(zODERIDC *ridc, double t, zVec x, double tend, double dt, void *util)
+{
+  int n, nblock, b, l;
+
+  if( zVecSizeNC(x) != ridc->dim ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return NULL;
+  }
+  if( dt <= 0 ){
+    ZRUNERROR( ZM_ERR_ODE_RIDC_STEP, dt );
+    return NULL;
+  }
+  if( tend == t ) return x;
+  n = zMax( (int)ceil( fabs( tend - t ) / dt ), ridc->level );
+  /* each block has at least a half of the maximum steps, which is not less than the level */
+  nblock = ( n + ridc->block - 1 ) / ridc->block;
+  ridc->_h = ( tend - t ) / n;
+  ridc->_util = util;
+  for( b=0; b<nblock; b++ ){
+    ridc->_t = t + ( n * b / nblock ) * ridc->_h;
+    ridc->_n = n * ( b + 1 ) / nblock - n * b / nblock;
+    for( l=0; l<=ridc->level; l++ ){
+      zVecCopyNC( x, ridc->_x[l] );
+      zThreadCounterSet( &ridc->_count[l], 0 );
+    }
+    zThreadFor( ridc->thread_num, 0, ridc->level+1, 1, _zODERIDCSweepThread, ridc );
+    zVecCopyNC( ridc->_x[ridc->level], x );
+  }
+  return x;
+}
@@ -0,0 +1,318 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_ens - ordinary differential equation quadrature:
+ * batched integration of an ensemble of initial states.
+ */
+
+#include <zm/zm_ode.h>
+
+/* create an ensemble ODE solver. */
+zODEEns *zODEEnsCreate(zODEEns *ens, int dim, int num, zMat (* f)(const zVec,const zMat,int,int,void*,zMat))
+{
+  int i;
+  bool check = true;
+
+  ens->dim = dim;
+  ens->num = num;
+  ens->f = f;
+  ens->thread_num = 0;
+  ens->grain = ZODE_ENS_GRAIN;
+  ens->_t = zVecAlloc( num );
+  ens->_ts = zVecAlloc( num );
+  ens->_h = zVecAlloc( num );
+  ens->_dt = zVecAlloc( num );
+  ens->_err_prev = zVecAlloc( num );
+  ens->_xc = zMatAlloc( dim, num );
+  for( i=0; i<7; i++ )
+    if( !( ens->_k[i] = zMatAlloc( dim, num ) ) ) check = false;
+  ens->_step_num = zAlloc( int, num );
+  ens->_reject_num = zAlloc( int, num );
+  ens->_state = zAlloc( int, num );
+  if( !check || !ens->_t || !ens->_ts || !ens->_h || !ens->_dt || !ens->_err_prev || !ens->_xc ||
+      !ens->_step_num || !ens->_reject_num || !ens->_state ){
+    ZALLOCERROR();
+    zODEEnsDestroy( ens );
+    return NULL;
+  }
+  return ens;
+}
+
+/* destroy an ensemble ODE solver. */
+void zODEEnsDestroy(zODEEns *ens)
+{
+  int i;
+
+  zVecFreeAtOnce( 5, ens->_t, ens->_ts, ens->_h, ens->_dt, ens->_err_prev );
+  zMatFree( ens->_xc );
+  for( i=0; i<7; i++ ) zMatFree( ens->_k[i] );
+  zFree( ens->_step_num );
+  zFree( ens->_reject_num );
+  zFree( ens->_state );
+  ens->f = NULL;
+}
+
+/* check the size of the ensemble states. */
+static bool _zODEEnsCheckSize(zODEEns *ens, zMat x)
+{
+  if( zMatRowSizeNC(x) != ens->dim || zMatColSizeNC(x) != ens->num ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return false;
+  }
+  return true;
+}
+
+/* intermediate states xc = x + h sum_l w_l k_l of members [from, to). */
+static void _zODEEnsStage(zODEEns *ens, const zMat x, int n, const double w[], int from, int to)
+{
+  double *xp, *xcp, *kp, *h;
+  int i, j, l;
+
+  h = zVecBufNC(ens->_h);
+  for( i=0; i<ens->dim; i++ ){
+    xp = zMatRowBufNC(x,i);
+    xcp = zMatRowBufNC(ens->_xc,i);
+    for( j=from; j<to; j++ ) xcp[j] = xp[j];
+    for( l=0; l<n; l++ ){
+      if( w[l] == 0 ) continue;
+      kp = zMatRowBufNC(ens->_k[l],i);
+      for( j=from; j<to; j++ ) xcp[j] += w[l] * h[j] * kp[j];
+    }
+  }
+}
+
+/* times of a stage of members [from, to). */
+static void _zODEEnsStageTime(zODEEns *ens, double c, int from, int to)
+{
+  int j;
+
+  for( j=from; j<to; j++ )
+    zVecElemNC(ens->_ts,j) = zVecElemNC(ens->_t,j) + c * zVecElemNC(ens->_h,j);
+}
+
+typedef struct{
+  zODEEns *ens;
+  zODEAdaptCtrl *ctrl;
+  double t, dt, tend;
+  zMat x;
+  void *util;
+} _zODEEnsThreadData;
+
+/* classical Runge-Kutta method */
+
+static const double _zODE_ENS_RK4_a[] = {
+  0.5,
+  0, 0.5,
+  0, 0, 1.0,
+  1.0/6, 1.0/3, 1.0/3, 1.0/6,
+};
+static const double _zODE_ENS_RK4_c[] = { 0.5, 0.5, 1.0 };
+
+/* a step of classical Runge-Kutta method for members [from, to). */
+static void _zODEEnsRK4Task(void *util, int from, int to)
+{
+  _zODEEnsThreadData *data;
+  zODEEns *ens;
+  int i, j, l;
+
+  data = (_zODEEnsThreadData *)util;
+  ens = data->ens;
+  for( j=from; j<to; j++ ){
+    zVecElemNC(ens->_t,j) = zVecElemNC(ens->_ts,j) = data->t;
+    zVecElemNC(ens->_h,j) = data->dt;
+  }
+  ens->f( ens->_ts, data->x, from, to, data->util, ens->_k[0] );
+  for( l=0, i=1; i<4; l+=i++ ){
+    _zODEEnsStage( ens, data->x, i, _zODE_ENS_RK4_a+l, from, to );
+    _zODEEnsStageTime( ens, _zODE_ENS_RK4_c[i-1], from, to );
+    ens->f( ens->_ts, ens->_xc, from, to, data->util, ens->_k[i] );
+  }
+  _zODEEnsStage( ens, data->x, 4, _zODE_ENS_RK4_a+l, from, to );
+  for( i=0; i<ens->dim; i++ )
+    memcpy( zMatRowBufNC(data->x,i)+from, zMatRowBufNC(ens->_xc,i)+from, sizeof(double)*(to-from) );
+}
+
+/* a step of an ensemble by classical Runge-Kutta method. */
+zMat zODEEnsUpdateRK4(zODEEns *ens, double t, zMat x, double dt, void *util)
+{
+  _zODEEnsThreadData data;
+
+  if( !_zODEEnsCheckSize( ens, x ) ) return NULL;
+  data.ens = ens;
+  data.t = t;
+  data.dt = dt;
+  data.x = x;
+  data.util = util;
+  zThreadFor( ens->thread_num, 0, ens->num, ens->grain, _zODEEnsRK4Task, &data );
+  return x;
+}
+
+/* Dormand-Prince method with member-wise adaptive step sizes */
+
+enum{ ZODE_ENS_FAILED=-1, ZODE_ENS_RUNNING, ZODE_ENS_REJECTED, ZODE_ENS_ACCEPTED };
+
+/* scale of a component for the error norm. */
+#define _zODEEnsScale(ctrl,x0,x1) ( (ctrl)->atol + (ctrl)->rtol * zMax( fabs( x0 ), fabs( x1 ) ) )
+
+/* initial step sizes of members [from, to) from the states and the derivatives. */
+static void _zODEEnsInitDT(zODEEns *ens, zODEAdaptCtrl *ctrl, zMat x, double span, int from, int to)
+{
+  double *d0, *d1, *xp, *kp, s;
+  int i, j;
+
+  d0 = zVecBufNC(ens->_h);
+  d1 = zVecBufNC(ens->_ts);
+  for( j=from; j<to; j++ ) d0[j] = d1[j] = 0;
+  for( i=0; i<ens->dim; i++ ){
+    xp = zMatRowBufNC(x,i);
+    kp = zMatRowBufNC(ens->_k[0],i);
+    for( j=from; j<to; j++ ){
+      s = _zODEEnsScale( ctrl, xp[j], xp[j] );
+      d0[j] += zSqr( xp[j] / s );
+      d1[j] += zSqr( kp[j] / s );
+    }
+  }
+  for( j=from; j<to; j++ ){
+    d0[j] = sqrt( d0[j] / ens->dim );
+    d1[j] = sqrt( d1[j] / ens->dim );
+    s = ( d0[j] < 1.0e-5 || d1[j] < 1.0e-5 ) ? 1.0e-6 : 0.01 * d0[j] / d1[j];
+    zVecElemNC(ens->_dt,j) = zMin( s, zMin( fabs( span ), ctrl->dt_max ) );
+  }
+}
+
+/* error norms of members [from, to), which are put into _ts. */
+static void _zODEEnsErr(zODEEns *ens, zODEAdaptCtrl *ctrl, zMat x, int from, int to)
+{
+  double *err, *h, *xp, *xcp, e;
+  int i, j, l;
+
+  err = zVecBufNC(ens->_ts);
+  h = zVecBufNC(ens->_h);
+  for( j=from; j<to; j++ ) err[j] = 0;
+  for( i=0; i<ens->dim; i++ ){
+    xp = zMatRowBufNC(x,i);
+    xcp = zMatRowBufNC(ens->_xc,i);
+    for( j=from; j<to; j++ ){
+      for( e=0, l=0; l<7; l++ )
+        e += ( _zODE_DP45_b5[l] - _zODE_DP45_b4[l] ) * zMatElemNC(ens->_k[l],i,j);
+      err[j] += zSqr( h[j] * e / _zODEEnsScale( ctrl, xp[j], xcp[j] ) );
+    }
+  }
+  for( j=from; j<to; j++ )
+    err[j] = sqrt( err[j] / ens->dim );
+}
+
+/* accept or reject a step of a member and propose the next step size. */
+static void _zODEEnsControl(zODEEns *ens, zODEAdaptCtrl *ctrl, int j, double tend)
+{
+  double err, h, dt_trial, fac;
+
+  h = fabs( zVecElemNC(ens->_h,j) );
+  dt_trial = zVecElemNC(ens->_dt,j);
+  if( ( err = zVecElemNC(ens->_ts,j) ) > 1.0 ){
+    ens->_reject_num[j]++;
+    fac = zMax( ctrl->fac_min, ctrl->safety * pow( err, -0.2 ) );
+    if( ( zVecElemNC(ens->_dt,j) = h * fac ) < ctrl->dt_min ){
+      ZRUNWARN( ZM_WARN_ODE_STEPTOOSMALL, h * fac, zVecElemNC(ens->_t,j) );
+      ens->_state[j] = ZODE_ENS_FAILED;
+    } else
+      ens->_state[j] = ZODE_ENS_REJECTED;
+    return;
+  }
+  ens->_step_num[j]++;
+  err = zMax( err, 1.0e-10 );
+  fac = ctrl->safety * pow( err, -ctrl->alpha ) * pow( zVecElemNC(ens->_err_prev,j), ctrl->beta );
+  fac = zLimit( fac, ctrl->fac_min, ens->_state[j] == ZODE_ENS_REJECTED ? 1.0 : ctrl->fac_max );
+  zVecElemNC(ens->_err_prev,j) = zMax( err, 1.0e-4 );
+  zVecElemNC(ens->_dt,j) = zMin( h * fac, ctrl->dt_max );
+  if( h < dt_trial && zVecElemNC(ens->_dt,j) < dt_trial ) zVecElemNC(ens->_dt,j) = dt_trial; /* truncated at tend */
+  zVecElemNC(ens->_t,j) = h < fabs( tend - zVecElemNC(ens->_t,j) ) ? zVecElemNC(ens->_t,j) + zVecElemNC(ens->_h,j) : tend;
+  ens->_state[j] = ZODE_ENS_ACCEPTED;
+}
+
+/* adaptive integration of members [from, to) by Dormand-Prince method. */
+static void _zODEEnsDP45Task(void *util, int from, int to)
+{
+  _zODEEnsThreadData *data;
+  zODEEns *ens;
+  double span, rest, *xp, *xcp, *k0p, *k6p;
+  int i, j, l;
+  bool active;
+
+  data = (_zODEEnsThreadData *)util;
+  ens = data->ens;
+  span = data->tend - data->t;
+  for( j=from; j<to; j++ ){
+    zVecElemNC(ens->_t,j) = zVecElemNC(ens->_ts,j) = data->t;
+    zVecElemNC(ens->_dt,j) = data->ctrl->dt;
+    zVecElemNC(ens->_err_prev,j) = 1.0e-4;
+    ens->_step_num[j] = ens->_reject_num[j] = 0;
+    ens->_state[j] = ZODE_ENS_RUNNING;
+  }
+  ens->f( ens->_ts, data->x, from, to, data->util, ens->_k[0] );
+  if( data->ctrl->dt <= 0 )
+    _zODEEnsInitDT( ens, data->ctrl, data->x, span, from, to );
+  while( 1 ){
+    for( active=false, j=from; j<to; j++ ){
+      rest = fabs( data->tend - zVecElemNC(ens->_t,j) );
+      if( ens->_state[j] == ZODE_ENS_FAILED || rest == 0 ){
+        zVecElemNC(ens->_h,j) = 0;
+        continue;
+      }
+      active = true;
+      zVecElemNC(ens->_h,j) = zMin( zMin( zVecElemNC(ens->_dt,j), data->ctrl->dt_max ), rest );
+      if( span < 0 ) zVecElemNC(ens->_h,j) *= -1;
+    }
+    if( !active ) break;
+    for( l=0, i=1; i<7; l+=i++ ){
+      _zODEEnsStage( ens, data->x, i, _zODE_DP45_a+l, from, to );
+      _zODEEnsStageTime( ens, _zODE_DP45_c[i-1], from, to );
+      ens->f( ens->_ts, ens->_xc, from, to, data->util, ens->_k[i] );
+    }
+    /* _xc is the fifth-order estimation, at which _k[6] is evaluated (first same as last) */
+    _zODEEnsErr( ens, data->ctrl, data->x, from, to );
+    for( j=from; j<to; j++ )
+      if( zVecElemNC(ens->_h,j) != 0 ) _zODEEnsControl( ens, data->ctrl, j, data->tend );
+    for( i=0; i<ens->dim; i++ ){
+      xp = zMatRowBufNC(data->x,i);
+      xcp = zMatRowBufNC(ens->_xc,i);
+      k0p = zMatRowBufNC(ens->_k[0],i);
+      k6p = zMatRowBufNC(ens->_k[6],i);
+      for( j=from; j<to; j++ )
+        if( ens->_state[j] == ZODE_ENS_ACCEPTED ){
+          xp[j] = xcp[j];
+          k0p[j] = k6p[j];
+        }
+    }
+    for( j=from; j<to; j++ )
+      if( ens->_state[j] == ZODE_ENS_ACCEPTED ) ens->_state[j] = ZODE_ENS_RUNNING;
+  }
+}
+
+/* integrate an ensemble with member-wise adaptive steps of Dormand-Prince method. */
+zMat zODEEnsIntegrateAdaptDP45(zODEEns *ens, zODEAdaptCtrl *ctrl, double t, zMat x, double tend, void *util)
+{
+  _zODEEnsThreadData data;
+  int j;
+  bool result = true;
+
+  if( !_zODEEnsCheckSize( ens, x ) ) return NULL;
+  if( t == tend ) return x;
+  data.ens = ens;
+  data.ctrl = ctrl;
+  data.t = t;
+  data.tend = tend;
+  data.x = x;
+  data.util = util;
+  zThreadFor( ens->thread_num, 0, ens->num, ens->grain, _zODEEnsDP45Task, &data );
+  for( j=0; j<ens->num; j++ ){
+    ctrl->step_num += ens->_step_num[j];
+    ctrl->reject_num += ens->_reject_num[j];
+    /* the first stage at the head, and six stages per trial step (the first same as last) */
+    ctrl->eval_num += 1 + 6 * ( ens->_step_num[j] + ens->_reject_num[j] );
+    if( ens->_state[j] == ZODE_ENS_FAILED ) result = false;
+  }
+  /* the next trial step size that is acceptable for all members */
+  ctrl->dt = zVecElemMin( ens->_dt, NULL );
+  return result ? x : NULL;
+}
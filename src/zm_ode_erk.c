@@ -9,87 +9,160 @@
 
 #define ZODE_ERK_TOL  ( 1.0e-6 )
 #define ZODE_ERK_DT_TOL  ( 1.0e-8 )
+
+/* Butcher tableau of an embedded Runge-Kutta method. */
+typedef struct{
+  int stepsize;
+  const double *a, *bc, *bf, *c; /* bc and bf are passed to the fixed-step update as they are */
+  bool fine_high;          /* true if bf gives the higher-order estimation */
+  bool fsal;               /* first same as last */
+} _zODEERKTableau;
+
 typedef struct{
   int stepsize;
+  const _zODEERKTableau *tab;
   zVec _xc, _xf; /* course and fine estimations */
   zVec *k;
+  zVecStruct *_k; /* stages sharing a contiguous buffer */
+  double *_kbuf;
+  /* for adaptive step size control */
+  zVec _x0, _x1; /* states at the head and the tail of the last step */
+  zVec _f1;      /* derivative at the tail of the last step if not FSAL */
+  zVec _e;       /* error estimation and dense output */
+  double t0, t1; /* head and tail time of the last step */
+  bool f1_valid; /* true if the derivative at the tail of the last step is available */
 } _zODE_ERK;
 
+/* destroy an ODE solver. */
+static void _zODEDestroyERK(zODE *ode)
+{
+  _zODE_ERK *ws;
+
+  ws = (_zODE_ERK *)ode->_ws;
+  ode->f = NULL;
+  ode->_ws = NULL;
+  if( ode->arena ) return; /* rewound together with the arena */
+  zVecFreeAtOnce( 6, ws->_xc, ws->_xf, ws->_x0, ws->_x1, ws->_f1, ws->_e );
+  zFree( ws->_kbuf );
+  zFree( ws->_k );
+  zFree( ws->k );
+  zFree( ws );
+}
+
 /* create an ODE solver based on embedded Runge-Kutta method. */
-static zODE* _zODECreateERK(zODE *ode, int dim, int stepsize, zVec (* f)(double,zVec,void*,zVec))
+static zODE* _zODECreateERK(zODE *ode, int dim, const _zODEERKTableau *tab, zVec (* f)(double,zVec,void*,zVec))
 {
   int i;
   _zODE_ERK *ws;
   bool check = true;
 
-  if( !( ws = zAlloc( _zODE_ERK, 1 ) ) ){
-    ZALLOCERROR();
-    return NULL;
+  if( ode->arena ){
+    if( !( ws = (_zODE_ERK *)zArenaCarve( ode->arena, sizeof(_zODE_ERK) ) ) ) return NULL;
+    if( !( ws->k = (zVec *)zArenaCarve( ode->arena, sizeof(zVec)*tab->stepsize ) ) ||
+        !( ws->_k = (zVecStruct *)zArenaCarve( ode->arena, sizeof(zVecStruct)*tab->stepsize ) ) ||
+        !( ws->_kbuf = (double *)zArenaCarve( ode->arena, sizeof(double)*tab->stepsize*dim ) ) ) return NULL;
+  } else{
+    if( !( ws = zAlloc( _zODE_ERK, 1 ) ) || !( ws->k = zAlloc( zVec, tab->stepsize ) ) ||
+        !( ws->_k = zAlloc( zVecStruct, tab->stepsize ) ) || !( ws->_kbuf = zAlloc( double, tab->stepsize*dim ) ) ){
+      ZALLOCERROR();
+      if( ws ) goto FAILURE;
+      return NULL;
+    }
   }
-  if( !( ws->_xc = zVecAlloc( dim ) ) ||
-      !( ws->_xf = zVecAlloc( dim ) ) ||
-      !( ws->k = zAlloc( zVec, stepsize ) ) ) check = false;
-  for( i=0; i<stepsize; i++ )
-    if( !( ws->k[i] = zVecAlloc( dim ) ) ) check = false;
-  ws->stepsize = stepsize;
+  if( !( ws->_xc = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->_xf = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->_x0 = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->_x1 = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->_f1 = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->_e = zArenaVecAlloc( ode->arena, dim ) ) ) check = false;
+  for( i=0; i<tab->stepsize; i++ ){
+    zVecAssignArray( &ws->_k[i], dim, ws->_kbuf + i*dim );
+    ws->k[i] = &ws->_k[i];
+  }
+  ws->stepsize = tab->stepsize;
+  ws->tab = tab;
+  ws->t0 = ws->t1 = 0;
+  ws->f1_valid = false;
   if( !check ){
     ZALLOCERROR();
-    return NULL;
+    goto FAILURE;
   }
   ode->f = f;
   ode->_ws = ws;
   return ode;
-}
-
-/* destroy an ODE solver. */
-static void _zODEDestroyERK(zODE *ode)
-{
-  int i;
-  _zODE_ERK *ws;
 
-  ws = (_zODE_ERK *)ode->_ws;
-  zVecFreeAtOnce( 2, ws->_xc, ws->_xf );
-  for( i=0; i<ws->stepsize; i++ )
-    zVecFree( ws->k[i] );
-  zFree( ws->k );
-  zFree( ode->_ws );
-  ode->f = NULL;
+ FAILURE:
+  ode->_ws = ws;
+  _zODEDestroyERK( ode );
+  return NULL;
 }
 
 /* directly integrate variable by ODE based on embedded Runge-Kutta method. */
-static zVec _zODEUpdateERK(zODE *ode, double t, zVec x, double dt, double a[], double bc[], double bf[], double c[], void *util)
+static zVec _zODEUpdateERK(zODE *ode, double t, zVec x, double dt, const double a[], const double bc[], const double bf[], const double c[], void *util)
 {
   int i, j, l;
   _zODE_ERK *ws;
 
   ws = (_zODE_ERK *)ode->_ws;
+  ws->f1_valid = false;
   ode->f( t, x, util, ws->k[0] );
-  for( l=0, i=1; i<ws->stepsize; i++ ){
+  if( ode->cat == _zODECatDefault ){ /* fast path on a contiguous stage buffer */
+    for( l=0, i=1; i<ws->stepsize; l+=i, i++ ){
+      _zODEStageSum( zVecBufNC(x), dt, a+l, ws->_kbuf, i, zVecSizeNC(x), zVecBufNC(ws->_xc) );
+      ode->f( t+c[i-1]*dt, ws->_xc, util, ws->k[i] );
+    }
+    _zODEStageSum( zVecBufNC(x), dt, bc, ws->_kbuf, ws->stepsize, zVecSizeNC(x), zVecBufNC(ws->_xc) );
+    _zODEStageSum( zVecBufNC(x), dt, bf, ws->_kbuf, ws->stepsize, zVecSizeNC(x), zVecBufNC(ws->_xf) );
+  } else{
+    for( l=0, i=1; i<ws->stepsize; i++ ){
+      zVecCopyNC( x, ws->_xc );
+      for( j=0; j<i; j++ )
+        ode->cat( ws->_xc, a[l++]*dt, ws->k[j], ws->_xc, util );
+      ode->f( t+c[i-1]*dt, ws->_xc, util, ws->k[i] );
+    }
     zVecCopyNC( x, ws->_xc );
-    for( j=0; j<i; j++ )
-      ode->cat( ws->_xc, a[l++]*dt, ws->k[j], ws->_xc, util );
-    ode->f( t+c[i-1]*dt, ws->_xc, util, ws->k[i] );
-  }
-  zVecCopyNC( x, ws->_xc );
-  zVecCopyNC( x, ws->_xf );
-  for( i=0; i<ws->stepsize; i++ ){
-    ode->cat( ws->_xc, bc[i]*dt, ws->k[i], ws->_xc, util );
-    ode->cat( ws->_xf, bf[i]*dt, ws->k[i], ws->_xf, util );
+    zVecCopyNC( x, ws->_xf );
+    for( i=0; i<ws->stepsize; i++ ){
+      ode->cat( ws->_xc, bc[i]*dt, ws->k[i], ws->_xc, util );
+      ode->cat( ws->_xf, bf[i]*dt, ws->k[i], ws->_xf, util );
+    }
   }
   if( dt > ZODE_ERK_DT_TOL && zVecDist( ws->_xc, ws->_xf ) > ZODE_ERK_TOL ){
     dt *= 0.5;
     _zODEUpdateERK( ode, t, x, dt, a, bc, bf, c, util );
     _zODEUpdateERK( ode, t+dt, x, dt, a, bc, bf, c, util );
-  } else
+  } else{
+    /* the last step for dense output */
+    ws->t0 = t;
+    ws->t1 = t + dt;
+    zVecCopyNC( x, ws->_x0 );
+    zVecCopyNC( ws->_xf, ws->_x1 );
+    ws->f1_valid = ws->tab->fsal;
     zVecCopyNC( ws->_xf, x );
+  }
   return x;
 }
 
 /* Runge-Kutta-Fehlberg method */
 
+static double _zODE_RKF45_a[] = {
+  1.0/4,
+  3.0/32, 9.0/32,
+  1932.0/2197, -7200.0/2197, 7296.0/2197,
+  439.0/216, -8.0, 3680.0/513, -845.0/4104,
+  -8.0/27, 2.0, -3544.0/2565, 1859.0/4104, -11.0/40,
+};
+static double _zODE_RKF45_b4[] = { 25.0/216, 0, 1408.0/2565, 2197.0/4104, -1.0/5, 0 };
+static double _zODE_RKF45_b5[] = { 16.0/135, 0, 6656.0/12825, 28561.0/56430, -9.0/50, 2.0/55 };
+static double _zODE_RKF45_c[] = { 1.0/4, 3.0/8, 12.0/13, 1.0, 1.0/2 };
+
+static const _zODEERKTableau _zODE_RKF45_tab = {
+  6, _zODE_RKF45_a, _zODE_RKF45_b4, _zODE_RKF45_b5, _zODE_RKF45_c, true, false,
+};
+
 zODE* zODECreateRKF45(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec))
 {
-  return _zODECreateERK( ode, dim, 6, f );
+  return _zODECreateERK( ode, dim, &_zODE_RKF45_tab, f );
 }
 
 void zODEDestroyRKF45(zODE *ode)
@@ -99,25 +172,34 @@ void zODEDestroyRKF45(zODE *ode)
 
 zVec zODEUpdateRKF45(zODE *ode, double t, zVec x, double dt, void *util)
 {
-  static double a[] = {
-    1.0/4,
-    3.0/32, 9.0/32,
-    1932.0/2197, -7200.0/2197, 7296.0/2197,
-    439.0/216, -8.0, 3680.0/513, -845.0/4104,
-    -8.0/27, 2.0, -3544.0/2565, 1859.0/4104, -11.0/40,
-  };
-  static double b4[] = { 25.0/216, 0, 1408.0/2565, 2197.0/4104, -1.0/5, 0 };
-  static double b5[] = { 16.0/135, 0, 6656.0/12825, 28561.0/56430, -9.0/50, 2.0/55 };
-  static double c[] = { 1.0/4, 3.0/8, 12.0/13, 1.0, 1.0/2 };
+  return _zODEUpdateERK( ode, t, x, dt, _zODE_RKF45_a, _zODE_RKF45_b4, _zODE_RKF45_b5, _zODE_RKF45_c, util );
+}
 
-  return _zODEUpdateERK( ode, t, x, dt, a, b4, b5, c, util );
+zVec zODEDenseRKF45(zODE *ode, double t, zVec x, void *util)
+{
+  return zODEDenseAdaptERK( ode, t, x, util );
 }
 
 /* Cash-Karp method */
 
+static double _zODE_CK45_a[] = {
+  1.0/5,
+  3.0/40, 9.0/40,
+  3.0/10,-9.0/10, 6.0/5,
+-11.0/54, 5.0/2, -70.0/27, 35.0/27,
+ 1631.0/55296, 175.0/512, 575.0/13824, 44275.0/110592, 253.0/4096,
+};
+static double _zODE_CK45_b5[] = { 37.0/378, 0.0, 250.0/621, 125.0/594, 0.0, 512.0/1771 };
+static double _zODE_CK45_b4[] = { 2825.0/27648, 0.0, 18575.0/48384, 13525.0/55296, 277.0/14336, 1.0/4 };
+static double _zODE_CK45_c[] = { 1.0/5, 3.0/10, 3.0/5, 1.0, 7.0/8.0 };
+
+static const _zODEERKTableau _zODE_CK45_tab = {
+  6, _zODE_CK45_a, _zODE_CK45_b5, _zODE_CK45_b4, _zODE_CK45_c, false, false,
+};
+
 zODE* zODECreateCK45(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec))
 {
-  return _zODECreateERK( ode, dim, 6, f );
+  return _zODECreateERK( ode, dim, &_zODE_CK45_tab, f );
 }
 
 void zODEDestroyCK45(zODE *ode)
@@ -127,25 +209,37 @@ void zODEDestroyCK45(zODE *ode)
 
 zVec zODEUpdateCK45(zODE *ode, double t, zVec x, double dt, void *util)
 {
-  static double a[] = {
-    1.0/5,
-    3.0/40, 9.0/40,
-    3.0/10,-9.0/10, 6.0/5,
-  -11.0/54, 5.0/2, -70.0/27, 35.0/27,
- 1631.0/55296, 175.0/512, 575.0/13824, 44275.0/110592, 253.0/4096,
-  };
-  static double b4[] = { 37.0/378, 0.0, 250.0/621, 125.0/594, 0.0, 512.0/1771 };
-  static double b5[] = { 2825.0/27648, 0.0, 18575.0/48384, 13525.0/55296, 277.0/14336, 1.0/4 };
-  static double c[] = { 1.0/5, 3.0/10, 3.0/5, 1.0, 7.0/8.0 };
+  return _zODEUpdateERK( ode, t, x, dt, _zODE_CK45_a, _zODE_CK45_b5, _zODE_CK45_b4, _zODE_CK45_c, util );
+}
 
-  return _zODEUpdateERK( ode, t, x, dt, a, b4, b5, c, util );
+zVec zODEDenseCK45(zODE *ode, double t, zVec x, void *util)
+{
+  return zODEDenseAdaptERK( ode, t, x, util );
 }
 
-/* Dormand-Prince method */
+/* Dormand-Prince method, of which the tableau is shared with the ensemble and raw-array solvers */
+
+const double _zODE_DP45_a[] = {
+  1.0/5,
+  3.0/40, 9.0/40,
+ 44.0/45, -56.0/15, 32.0/9,
+19372.0/6561,-25360.0/2187, 64448.0/6561, -212.0/729,
+ 9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656,
+ 35.0/384, 0.0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84,
+};
+const double _zODE_DP45_b4[] = {
+  5179.0/57600, 0.0, 7571.0/16695, 393.0/640,-92097.0/339200, 187.0/2100, 1.0/40 };
+const double _zODE_DP45_b5[] = {
+  35.0/384, 0.0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84, 0 };
+const double _zODE_DP45_c[] = { 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1.0, 1.0 };
+
+static const _zODEERKTableau _zODE_DP45_tab = {
+  7, _zODE_DP45_a, _zODE_DP45_b4, _zODE_DP45_b5, _zODE_DP45_c, true, true,
+};
 
 zODE* zODECreateDP45(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec))
 {
-  return _zODECreateERK( ode, dim, 7, f );
+  return _zODECreateERK( ode, dim, &_zODE_DP45_tab, f );
 }
 
 void zODEDestroyDP45(zODE *ode)
@@ -155,19 +249,234 @@ void zODEDestroyDP45(zODE *ode)
 
 zVec zODEUpdateDP45(zODE *ode, double t, zVec x, double dt, void *util)
 {
-  static double a[] = {
-    1.0/5,
-    3.0/40, 9.0/40,
-   44.0/45, -56.0/15, 32.0/9,
-19372.0/6561,-25360.0/2187, 64448.0/6561, -212.0/729,
- 9017.0/3168, -355.0/33, 46732.0/5247, 49.0/176, -5103.0/18656,
-   35.0/384, 0.0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84,
-  };
-  static double b4[] = {
-    5179.0/57600, 0.0, 7571.0/16695, 393.0/640,-92097.0/339200, 187.0/2100, 1.0/40 };
-  static double b5[] = {
-    35.0/384, 0.0, 500.0/1113, 125.0/192, -2187.0/6784, 11.0/84, 0 };
-  static double c[] = { 1.0/5, 3.0/10, 4.0/5, 8.0/9, 1.0, 1.0 };
-
-  return _zODEUpdateERK( ode, t, x, dt, a, b4, b5, c, util );
+  return _zODEUpdateERK( ode, t, x, dt, _zODE_DP45_a, _zODE_DP45_b4, _zODE_DP45_b5, _zODE_DP45_c, util );
+}
+
+zVec zODEDenseDP45(zODE *ode, double t, zVec x, void *util)
+{
+  return zODEDenseAdaptERK( ode, t, x, util );
+}
+
+/* adaptive step size control */
+
+/* initialize a step size controller. */
+zODEAdaptCtrl *zODEAdaptCtrlInit(zODEAdaptCtrl *ctrl)
+{
+  ctrl->atol = ctrl->rtol = ZODE_ERK_TOL;
+  ctrl->dt_min = zTOL;
+  ctrl->dt_max = HUGE_VAL;
+  ctrl->safety = 0.9;
+  ctrl->fac_min = 0.2;
+  ctrl->fac_max = 10.0;
+  ctrl->alpha = 0.17;
+  ctrl->beta = 0.04;
+  ctrl->dt = 0;
+  ctrl->step_num = ctrl->reject_num = ctrl->eval_num = 0;
+  ctrl->_err_prev = 1.0e-4;
+  return ctrl;
+}
+
+/* set tolerances of a step size controller. */
+zODEAdaptCtrl *zODEAdaptCtrlSetTol(zODEAdaptCtrl *ctrl, double atol, double rtol)
+{
+  ctrl->atol = atol;
+  ctrl->rtol = rtol;
+  return ctrl;
+}
+
+/* scale of a component for the error norm. */
+static double _zODEAdaptScale(zODEAdaptCtrl *ctrl, double x0, double x1)
+{
+  return ctrl->atol + ctrl->rtol * zMax( fabs( x0 ), fabs( x1 ) );
+}
+
+/* root mean square of a vector scaled by tolerances. */
+static double _zODEAdaptNorm(zODEAdaptCtrl *ctrl, const zVec v, const zVec x0, const zVec x1)
+{
+  int i;
+  double s = 0;
+
+  for( i=0; i<zVecSizeNC(v); i++ )
+    s += zSqr( zVecElemNC(v,i) / _zODEAdaptScale( ctrl, zVecElemNC(x0,i), zVecElemNC(x1,i) ) );
+  return sqrt( s / zVecSizeNC(v) );
+}
+
+/* initial step size by Hairer's algorithm. */
+static double _zODEAdaptInitDT(zODE *ode, zODEAdaptCtrl *ctrl, double t, double span, void *util)
+{
+  _zODE_ERK *ws;
+  double d0, d1, d2, dt0, dt1;
+
+  ws = (_zODE_ERK *)ode->_ws;
+  d0 = _zODEAdaptNorm( ctrl, ws->_x0, ws->_x0, ws->_x0 );
+  d1 = _zODEAdaptNorm( ctrl, ws->k[0], ws->_x0, ws->_x0 );
+  dt0 = ( d0 < 1.0e-5 || d1 < 1.0e-5 ) ? 1.0e-6 : 0.01 * d0 / d1;
+  dt0 = zMin( dt0, zMin( fabs( span ), ctrl->dt_max ) );
+  ode->cat( ws->_x0, span > 0 ? dt0 : -dt0, ws->k[0], ws->_xc, util );
+  ode->f( t + ( span > 0 ? dt0 : -dt0 ), ws->_xc, util, ws->k[1] );
+  ctrl->eval_num++;
+  zVecSubNC( ws->k[1], ws->k[0], ws->_e );
+  d2 = _zODEAdaptNorm( ctrl, ws->_e, ws->_x0, ws->_x0 ) / dt0;
+  dt1 = ( d1 = zMax( d1, d2 ) ) <= 1.0e-15 ?
+    zMax( 1.0e-6, dt0*1.0e-3 ) : pow( 0.01 / d1, 0.2 );
+  return zMin( 100*dt0, zMin( dt1, ctrl->dt_max ) );
+}
+
+/* compute stages and the lower- and higher-order estimations from _x0 with k[0] given. */
+static void _zODEAdaptStage(zODE *ode, double t, double dt, void *util)
+{
+  _zODE_ERK *ws;
+  const _zODEERKTableau *tab;
+  const double *bl, *bh;
+  int i, j, l;
+
+  ws = (_zODE_ERK *)ode->_ws;
+  tab = ws->tab;
+  if( tab->fine_high ){
+    bl = tab->bc; bh = tab->bf;
+  } else{
+    bl = tab->bf; bh = tab->bc;
+  }
+  if( ode->cat == _zODECatDefault ){ /* fast path on a contiguous stage buffer */
+    for( l=0, i=1; i<tab->stepsize; l+=i, i++ ){
+      _zODEStageSum( zVecBufNC(ws->_x0), dt, tab->a+l, ws->_kbuf, i, zVecSizeNC(ws->_x0), zVecBufNC(ws->_xc) );
+      ode->f( t+tab->c[i-1]*dt, ws->_xc, util, ws->k[i] );
+    }
+    _zODEStageSum( zVecBufNC(ws->_x0), dt, bl, ws->_kbuf, tab->stepsize, zVecSizeNC(ws->_x0), zVecBufNC(ws->_xc) );
+    _zODEStageSum( zVecBufNC(ws->_x0), dt, bh, ws->_kbuf, tab->stepsize, zVecSizeNC(ws->_x0), zVecBufNC(ws->_xf) );
+    return;
+  }
+  for( l=0, i=1; i<tab->stepsize; i++ ){
+    zVecCopyNC( ws->_x0, ws->_xc );
+    for( j=0; j<i; j++ )
+      ode->cat( ws->_xc, tab->a[l++]*dt, ws->k[j], ws->_xc, util );
+    ode->f( t+tab->c[i-1]*dt, ws->_xc, util, ws->k[i] );
+  }
+  /* _xc: lower-order estimation, _xf: higher-order estimation */
+  zVecCopyNC( ws->_x0, ws->_xc );
+  zVecCopyNC( ws->_x0, ws->_xf );
+  for( i=0; i<tab->stepsize; i++ ){
+    if( bl[i] != 0 ) ode->cat( ws->_xc, bl[i]*dt, ws->k[i], ws->_xc, util );
+    if( bh[i] != 0 ) ode->cat( ws->_xf, bh[i]*dt, ws->k[i], ws->_xf, util );
+  }
+}
+
+/* an adaptive step of an embedded Runge-Kutta method. */
+zVec zODEStepAdaptERK(zODE *ode, zODEAdaptCtrl *ctrl, double *t, zVec x, double tend, void *util)
+{
+  _zODE_ERK *ws;
+  double span, dt, dt_trial, err, fac;
+  bool rejected = false;
+
+  ws = (_zODE_ERK *)ode->_ws;
+  if( ( span = tend - *t ) == 0 ) return x;
+  /* reuse the derivative at the tail of the last step if the state is continued */
+  if( ws->f1_valid && *t == ws->t1 && zVecEqual( x, ws->_x1, 0 ) )
+    zVecCopyNC( ws->tab->fsal ? ws->k[ws->stepsize-1] : ws->_f1, ws->k[0] );
+  else{
+    ode->f( *t, x, util, ws->k[0] );
+    ctrl->eval_num++;
+  }
+  zVecCopyNC( x, ws->_x0 );
+  if( ctrl->dt <= 0 ) ctrl->dt = _zODEAdaptInitDT( ode, ctrl, *t, span, util );
+  dt_trial = zMin( ctrl->dt, ctrl->dt_max );
+  dt = zMin( dt_trial, fabs( span ) );
+  while( 1 ){
+    if( span < 0 ) dt = -dt;
+    _zODEAdaptStage( ode, *t, dt, util );
+    ctrl->eval_num += ws->stepsize - 1;
+    ode->sub( ws->_xf, ws->_xc, ws->_e, util );
+    if( ( err = _zODEAdaptNorm( ctrl, ws->_e, ws->_x0, ws->_xf ) ) <= 1.0 ) break;
+    /* reject the step */
+    ctrl->reject_num++;
+    rejected = true;
+    fac = zMax( ctrl->fac_min, ctrl->safety * pow( err, -0.2 ) );
+    if( ( dt = fabs( dt ) * fac ) < ctrl->dt_min ){
+      ZRUNWARN( ZM_WARN_ODE_STEPTOOSMALL, dt, *t );
+      ws->f1_valid = false;
+      return NULL;
+    }
+    dt_trial = dt;
+  }
+  /* accept the step and propose the next step size by the PI controller */
+  ctrl->step_num++;
+  err = zMax( err, 1.0e-10 );
+  fac = ctrl->safety * pow( err, -ctrl->alpha ) * pow( ctrl->_err_prev, ctrl->beta );
+  fac = zLimit( fac, ctrl->fac_min, rejected ? 1.0 : ctrl->fac_max );
+  ctrl->_err_prev = zMax( err, 1.0e-4 );
+  ctrl->dt = zMin( fabs( dt ) * fac, ctrl->dt_max );
+  if( fabs( dt ) < dt_trial && ctrl->dt < dt_trial ) ctrl->dt = dt_trial; /* truncated at tend */
+  ws->t0 = *t;
+  *t = ws->t1 = fabs( dt ) < fabs( span ) ? *t + dt : tend;
+  zVecCopyNC( ws->_xf, ws->_x1 );
+  ws->f1_valid = ws->tab->fsal;
+  return zVecCopyNC( ws->_xf, x );
+}
+
+/* integrate an ODE over a time span with adaptive steps of an embedded Runge-Kutta method. */
+zVec zODEIntegrateAdaptERK(zODE *ode, zODEAdaptCtrl *ctrl, double t, zVec x, double tend, void *util)
+{
+  while( t != tend )
+    if( !zODEStepAdaptERK( ode, ctrl, &t, x, tend, util ) ) return NULL;
+  return x;
+}
+
+/* coefficients of the continuous extension of Dormand-Prince method by Shampine. */
+static double _zODE_DP45_d[] = {
+  -12715105075.0/11282082432, 0, 87487479700.0/32700410799, -10690763975.0/1880347072,
+  701980252875.0/199316789632, -1453857185.0/822651844, 69997945.0/29380423,
+};
+
+/* dense output in the last step of an embedded Runge-Kutta method. */
+zVec zODEDenseAdaptERK(zODE *ode, double t, zVec x, void *util)
+{
+  _zODE_ERK *ws;
+  double theta, theta1, *dx, *y, *k0, *k1;
+  double h, g0, g1, gy;
+  int i, j;
+
+  ws = (_zODE_ERK *)ode->_ws;
+  h = ws->t1 - ws->t0;
+  theta = h == 0 ? 1.0 : ( t - ws->t0 ) / h;
+  if( theta < -zTOL || theta > 1+zTOL ){
+    ZRUNERROR( ZM_ERR_ODE_DENSE_OUTOFRANGE, t, ws->t0, ws->t1 );
+    return NULL;
+  }
+  theta1 = 1 - theta;
+  /* _xc: scaled difference between the head and the tail of the step */
+  ode->sub( ws->_x1, ws->_x0, ws->_xc, util );
+  if( h != 0 ) zVecDivDRC( ws->_xc, h );
+  y = zVecBufNC(ws->_xc);
+  dx = zVecBufNC(ws->_e);
+  k0 = zVecBufNC(ws->k[0]);
+  if( ws->tab->fsal ){ /* Dormand-Prince continuous extension */
+    k1 = zVecBufNC(ws->k[ws->stepsize-1]);
+    for( i=0; i<zVecSizeNC(ws->_e); i++ ){
+      for( gy=0, j=0; j<ws->stepsize; j++ )
+        gy += _zODE_DP45_d[j] * zVecElemNC(ws->k[j],i);
+      g0 = k0[i] - y[i];         /* bspl / h */
+      g1 = y[i] - k1[i] - g0;    /* rcont4 / h */
+      dx[i] = theta*( y[i] + theta1*( g0 + theta*( g1 + theta1*gy ) ) );
+    }
+  } else{ /* cubic Hermite interpolation */
+    if( !ws->f1_valid ){
+      ode->f( ws->t1, ws->_x1, util, ws->_f1 );
+      ws->f1_valid = true;
+    }
+    k1 = zVecBufNC(ws->_f1);
+    g0 = theta*zSqr(theta1);
+    g1 = -zSqr(theta)*theta1;
+    gy = zSqr(theta)*( 3 - 2*theta );
+    for( i=0; i<zVecSizeNC(ws->_e); i++ )
+      dx[i] = gy*y[i] + g0*k0[i] + g1*k1[i];
+  }
+  return ode->cat( ws->_x0, h, ws->_e, x, util );
+}
+
+/* check if a step of an embedded Runge-Kutta method is split. */
+bool zODEIsSplitERK(const zODE *ode, double t)
+{
+  if( ode->update != zODEUpdateRKF45 && ode->update != zODEUpdateCK45 && ode->update != zODEUpdateDP45 )
+    return false;
+  return ((_zODE_ERK *)ode->_ws)->t0 != t;
 }
@@ -7,27 +7,54 @@
 
 #include <zm/zm_ode.h>
 
+typedef struct{
+  zVec dx;
+  zODEHermite dense;
+} _zODE_Euler;
+
 /* create an ODE solver based on Euler method. */
 zODE* zODECreateEuler(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec))
 {
-  if( !( ode->_ws = zVecAlloc( dim ) ) ){
+  _zODE_Euler *ws;
+
+  if( !( ws = zAlloc( _zODE_Euler, 1 ) ) ||
+      !( ws->dx = zVecAlloc( dim ) ) ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
   ode->f = f;
+  ode->_ws = ws;
   return ode;
 }
 
 /* destroy an ODE solver. */
 void zODEDestroyEuler(zODE *ode)
 {
-  zVecFree( (zVec)ode->_ws );
+  _zODE_Euler *ws;
+
+  ws = (_zODE_Euler *)ode->_ws;
+  zVecFree( ws->dx );
+  _zODEHermiteFree( &ws->dense, NULL );
+  zFree( ode->_ws );
   ode->f = NULL;
 }
 
 /* directly integrate variable by ODE based on Euler method. */
 zVec zODEUpdateEuler(zODE *ode, double t, zVec x, double dt, void *util)
 {
-  ode->f( t, x, util, (zVec)ode->_ws );
-  return ode->cat( x, dt, (zVec)ode->_ws, x, util );
+  _zODE_Euler *ws;
+
+  ws = (_zODE_Euler *)ode->_ws;
+  ode->f( t, x, util, ws->dx );
+  _zODEHermiteSetHead( &ws->dense, t, x, ws->dx );
+  ode->cat( x, dt, ws->dx, x, util );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
+  return x;
+}
+
+/* dense output in the last step of Euler method. */
+zVec zODEDenseEuler(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_Euler *)ode->_ws)->dense, t, x, util );
 }
@@ -0,0 +1,287 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_event - ordinary differential equation quadrature:
+ * event detection.
+ */
+
+#include <zm/zm_ode.h>
+#include <zm/zm_nle.h>
+
+/* assign an event function of zODE. */
+zODEEvent *zODEEventAssign(zODEEvent *ev, double (* g)(double,zVec,void*), int direction, bool terminal)
+{
+  ev->g = g;
+  ev->g2 = NULL;
+  ev->direction = direction;
+  ev->terminal = terminal;
+  ev->root = zNLE_VDB;
+  ev->tol = zTOL;
+  ev->fired = false;
+  ev->t = 0;
+  return ev;
+}
+
+/* assign an event function of zODE2. */
+zODEEvent *zODE2EventAssign(zODEEvent *ev, double (* g2)(double,zVec,zVec,void*), int direction, bool terminal)
+{
+  zODEEventAssign( ev, NULL, direction, terminal );
+  ev->g2 = g2;
+  return ev;
+}
+
+/* allocate an event monitor. */
+zODEEventMonitor *zODEEventMonitorAlloc(zODEEventMonitor *mon, int num, int dim)
+{
+  mon->num = num;
+  mon->ev = zAlloc( zODEEvent, num );
+  mon->_g0 = zAlloc( double, num );
+  mon->_g1 = zAlloc( double, num );
+  mon->_t1 = 0;
+  mon->_valid = false;
+  mon->_x = zVecAlloc( dim );
+  mon->_v = zVecAlloc( dim );
+  mon->_x0 = zVecAlloc( dim );
+  mon->_v0 = zVecAlloc( dim );
+  if( !mon->ev || !mon->_g0 || !mon->_g1 || !mon->_x || !mon->_v || !mon->_x0 || !mon->_v0 ){
+    ZALLOCERROR();
+    zODEEventMonitorFree( mon );
+    return NULL;
+  }
+  return mon;
+}
+
+/* free an event monitor. */
+void zODEEventMonitorFree(zODEEventMonitor *mon)
+{
+  zFree( mon->ev );
+  zFree( mon->_g0 );
+  zFree( mon->_g1 );
+  zVecFreeAtOnce( 4, mon->_x, mon->_v, mon->_x0, mon->_v0 );
+  mon->num = 0;
+}
+
+typedef struct{
+  zODE *ode;
+  zODE2 *ode2;
+  zODEEventMonitor *mon;
+  zODEEvent *ev;
+  double t0, t1;
+  zVec x1, v1; /* states at the tail of the step (those at the head are in the monitor) */
+  void *util;
+  bool failed; /* true if the state in the step is not available */
+} _zODEEventData;
+
+/* state in the step, which is put into _x and _v of the monitor. */
+static bool _zODEEventState(_zODEEventData *data, double t)
+{
+  zODEEventMonitor *mon;
+  double h, theta, gy, g0, g1;
+  int i;
+
+  if( data->ode ) return zODEDense( data->ode, t, data->mon->_x, data->util ) ? true : false;
+  /* cubic Hermite interpolation of the displacement and its derivative for the velocity */
+  mon = data->mon;
+  h = data->t1 - data->t0;
+  theta = h == 0 ? 1.0 : ( t - data->t0 ) / h;
+  data->ode2->sub_dis( data->x1, mon->_x0, mon->_x, data->util );
+  if( h != 0 ) zVecDivDRC( mon->_x, h );
+  for( i=0; i<zVecSizeNC(mon->_x); i++ ){
+    gy = zVecElemNC(mon->_x,i);
+    zVecElemNC(mon->_v,i) = 6*theta*(1-theta)*gy
+      + (1-theta)*(1-3*theta)*zVecElemNC(mon->_v0,i) + theta*(3*theta-2)*zVecElemNC(data->v1,i);
+    g0 = theta*zSqr(1-theta);
+    g1 = -zSqr(theta)*(1-theta);
+    zVecElemNC(mon->_x,i) = zSqr(theta)*(3-2*theta)*gy
+      + g0*zVecElemNC(mon->_v0,i) + g1*zVecElemNC(data->v1,i);
+  }
+  data->ode2->cat_dis( mon->_x0, h, mon->_x, mon->_x, data->util );
+  return true;
+}
+
+/* value of an event function. */
+static double _zODEEventValue(zODEEvent *ev, double t, zODEEventMonitor *mon, void *util)
+{
+  return ev->g ? ev->g( t, mon->_x, util ) : ev->g2( t, mon->_x, mon->_v, util );
+}
+
+/* event function along the step for the scalar equation solver. */
+static double _zODEEventFunc(double t, void *priv)
+{
+  _zODEEventData *data;
+
+  data = (_zODEEventData *)priv;
+  if( !_zODEEventState( data, t ) ){
+    data->failed = true;
+    return 0; /* let the scalar equation solver stop */
+  }
+  return _zODEEventValue( data->ev, t, data->mon, data->util );
+}
+
+/* check if an event function crosses zero in a direction. */
+static bool _zODEEventCross(zODEEvent *ev, double g0, double g1)
+{
+  if( g0 < 0 && g1 >= 0 ) return ev->direction >= 0;
+  if( g0 > 0 && g1 <= 0 ) return ev->direction <= 0;
+  return false;
+}
+
+/* relative offset to move the time of a terminal event beyond the zero-crossing. */
+#define ZODE_EVENT_OFFSET ( 1.0e-12 )
+
+/* localize events in a step and find the earliest terminal event, where an event fired in a former
+ * part of a split step is kept as it is. */
+static int _zODEEventLocate(_zODEEventData *data)
+{
+  zODEEventMonitor *mon;
+  zODEEvent *ev;
+  double h, s, tterm, offset, d;
+  int i, term = -1;
+
+  mon = data->mon;
+  h = data->t1 - data->t0;
+  tterm = data->t1;
+  data->failed = false;
+  for( i=0; i<mon->num; i++ ){
+    ev = &mon->ev[i];
+    if( ev->fired || !_zODEEventCross( ev, mon->_g0[i], mon->_g1[i] ) ) continue;
+    ev->fired = true;
+    data->ev = ev;
+    ev->t = ev->root( _zODEEventFunc, data->t0, data->t1, data, ev->tol, 0 );
+    if( data->failed ) return ZODE_EVENT_FAILED;
+    if( !ev->terminal ) continue;
+    /* move it just beyond the zero-crossing */
+    for( offset=ZODE_EVENT_OFFSET*zMax(1.0,fabs(h)); ; offset*=2 ){
+      s = _zODEEventFunc( ev->t, data );
+      if( data->failed ) return ZODE_EVENT_FAILED;
+      if( s == 0 || ( s > 0 ) != ( mon->_g0[i] > 0 ) || ev->t == data->t1 ) break;
+      /* the signed offset applied is the one tested not to go beyond the tail */
+      d = h > 0 ? offset : -offset;
+      ev->t = fabs( ev->t + d - data->t0 ) < fabs( h ) ? ev->t + d : data->t1;
+    }
+    if( term < 0 || ( ev->t - tterm ) * h < 0 ){
+      term = i;
+      tterm = ev->t;
+    }
+  }
+  if( term < 0 ) return -1;
+  /* events after the terminal event do not occur */
+  for( i=0; i<mon->num; i++ )
+    if( i != term && mon->ev[i].fired && ( mon->ev[i].t - tterm ) * h > 0 ) mon->ev[i].fired = false;
+  return term;
+}
+
+/* values of event functions at the head of a step. */
+static void _zODEEventHead(zODEEventMonitor *mon, double t, zVec x, zVec v, void *util)
+{
+  int i;
+
+  if( mon->_valid && t == mon->_t1 && zVecEqual( x, mon->_x0, 0 ) && ( !v || zVecEqual( v, mon->_v0, 0 ) ) ){
+    memcpy( mon->_g0, mon->_g1, sizeof(double)*mon->num );
+    return;
+  }
+  zVecCopyNC( x, mon->_x0 );
+  if( v ) zVecCopyNC( v, mon->_v0 );
+  zVecCopyNC( x, mon->_x );
+  if( v ) zVecCopyNC( v, mon->_v );
+  for( i=0; i<mon->num; i++ )
+    mon->_g0[i] = _zODEEventValue( &mon->ev[i], t, mon, util );
+}
+
+/* values of event functions at the tail of a step. */
+static void _zODEEventTail(zODEEventMonitor *mon, double t, zVec x, zVec v, void *util)
+{
+  int i;
+
+  zVecCopyNC( x, mon->_x );
+  if( v ) zVecCopyNC( v, mon->_v );
+  for( i=0; i<mon->num; i++ )
+    mon->_g1[i] = _zODEEventValue( &mon->ev[i], t, mon, util );
+}
+
+/* reset fired flags of events before a step. */
+static void _zODEEventReset(zODEEventMonitor *mon)
+{
+  int i;
+
+  for( i=0; i<mon->num; i++ ) mon->ev[i].fired = false;
+}
+
+/* update a state of zODE with event detection in a step, on which the dense output is available. */
+static int _zODEUpdateEventStep(zODE *ode, zODEEventMonitor *mon, double *t, zVec x, double dt, void *util)
+{
+  _zODEEventData data;
+  int term;
+
+  _zODEEventHead( mon, *t, x, NULL, util );
+  zODEUpdate( ode, *t, x, dt, util );
+  if( zODEIsSplitERK( ode, *t ) ){
+    /* the dense output covers only the last split step, so that the step is retaken by halves */
+    zVecCopyNC( mon->_x0, x );
+    memcpy( mon->_g1, mon->_g0, sizeof(double)*mon->num );
+    mon->_t1 = *t;
+    mon->_valid = true;
+    dt *= 0.5;
+    if( ( term = _zODEUpdateEventStep( ode, mon, t, x, dt, util ) ) != -1 ) return term;
+    return _zODEUpdateEventStep( ode, mon, t, x, dt, util );
+  }
+  _zODEEventTail( mon, *t+dt, x, NULL, util );
+  data.ode = ode;
+  data.ode2 = NULL;
+  data.mon = mon;
+  data.t0 = *t;
+  data.t1 = *t + dt;
+  data.util = util;
+  if( ( term = _zODEEventLocate( &data ) ) >= 0 ){
+    if( zODEDense( ode, mon->ev[term].t, x, util ) ){
+      *t = mon->ev[term].t;
+      _zODEEventTail( mon, *t, x, NULL, util );
+    } else
+      term = ZODE_EVENT_FAILED;
+  }
+  if( term < 0 ) *t += dt; /* the state at the tail of the step is kept on failure */
+  mon->_t1 = *t;
+  zVecCopyNC( x, mon->_x0 );
+  mon->_valid = term != ZODE_EVENT_FAILED;
+  return term;
+}
+
+/* update a state of zODE with event detection. */
+int zODEUpdateEvent(zODE *ode, zODEEventMonitor *mon, double *t, zVec x, double dt, void *util)
+{
+  _zODEEventReset( mon );
+  return _zODEUpdateEventStep( ode, mon, t, x, dt, util );
+}
+
+/* update a state of zODE2 with event detection. */
+int zODE2UpdateEvent(zODE2 *ode, zODEEventMonitor *mon, double *t, zVec x, zVec v, double dt, void *util)
+{
+  _zODEEventData data;
+  int term;
+
+  _zODEEventReset( mon );
+  _zODEEventHead( mon, *t, x, v, util );
+  zODE2Update( ode, *t, x, v, dt, util );
+  _zODEEventTail( mon, *t+dt, x, v, util );
+  data.ode = NULL;
+  data.ode2 = ode;
+  data.mon = mon;
+  data.t0 = *t;
+  data.t1 = *t + dt;
+  data.x1 = x;
+  data.v1 = v;
+  data.util = util;
+  if( ( term = _zODEEventLocate( &data ) ) >= 0 ){
+    *t = mon->ev[term].t;
+    _zODEEventState( &data, *t );
+    zVecCopyNC( mon->_x, x );
+    zVecCopyNC( mon->_v, v );
+    _zODEEventTail( mon, *t, x, v, util );
+  } else
+    *t += dt;
+  mon->_t1 = *t;
+  zVecCopyNC( x, mon->_x0 );
+  zVecCopyNC( v, mon->_v0 );
+  mon->_valid = true;
+  return term;
+}
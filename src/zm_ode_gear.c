@@ -15,6 +15,7 @@ typedef struct{
   zVecRing hist;
   void *util;
   zNLE nle;
+  zODEHermite dense;
 } _zODE_Gear;
 
 /* algebraic equation for Gear method. */
@@ -64,7 +65,8 @@ zODE* zODECreateGear(zODE *ode, int dim, int step, zVec (* f)(double,zVec,void*,
   if( !( ws->v = zVecAlloc( dim ) ) ||
       !( ws->a = zVecCloneArray( a[step-1], step ) ) ||
       !zVecRingAlloc( &ws->hist, dim, step ) ||
-      !zNLECreate( &ws->nle, dim, dim, 0, _zODE_Gear_Func, NULL ) ){
+      !zNLECreate( &ws->nle, dim, dim, 0, _zODE_Gear_Func, NULL ) ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
@@ -84,6 +86,7 @@ void zODEDestroyGear(zODE *ode)
   zNLEDestroy( &ws->nle );
   zVecFreeAtOnce( 2, ws->v, ws->a );
   zVecRingFree( &ws->hist );
+  _zODEHermiteFree( &ws->dense, NULL );
   ode->f = NULL;
   zFree( ode->_ws );
 }
@@ -104,7 +107,15 @@ zVec zODEUpdateGear(zODE *ode, double t, zVec x, double dt, void *util)
   ws->dt = dt;
   ws->util = util;
   zVecCopyNC( x, *zRingHead(&ws->hist) );
+  _zODEHermiteSetHead( &ws->dense, t, x, NULL );
   zNLESolve( &ws->nle, x, ode, zTOL, 0, NULL ); /* use default maximum iteration number */
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
   zRingDecHead( &ws->hist );
   return x;
 }
+
+/* dense output in the last step of Gear method. */
+zVec zODEDenseGear(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_Gear *)ode->_ws)->dense, t, x, util );
+}
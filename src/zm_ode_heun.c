@@ -9,6 +9,7 @@
 
 typedef struct{
   zVec x, k[3];
+  zODEHermite dense;
 } _zODE_Heun;
 
 /* create an ODE solver based on Heun method. */
@@ -20,7 +21,8 @@ zODE* zODECreateHeun(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*
       !( ws->x = zVecAlloc( dim ) ) /* incremental vector */ ||
       !( ws->k[0] = zVecAlloc( dim ) ) /* step-1 vector */ ||
       !( ws->k[1] = zVecAlloc( dim ) ) /* step-2 vector */ ||
-      !( ws->k[2] = zVecAlloc( dim ) ) /* step-3 vector */ ){
+      !( ws->k[2] = zVecAlloc( dim ) ) /* step-3 vector */ ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
@@ -36,6 +38,7 @@ void zODEDestroyHeun(zODE *ode)
 
   ws = (_zODE_Heun *)ode->_ws;
   zVecFreeAtOnce( 4, ws->x, ws->k[0], ws->k[1], ws->k[2] );
+  _zODEHermiteFree( &ws->dense, NULL );
   zFree( ode->_ws );
   ode->f = NULL;
 }
@@ -47,6 +50,7 @@ zVec zODEUpdateHeun(zODE *ode, double t, zVec x, double dt, void *util)
 
   ws = (_zODE_Heun *)ode->_ws;
   ode->f( t, x, util, ws->k[0] );
+  _zODEHermiteSetHead( &ws->dense, t, x, ws->k[0] );
   ode->cat( x, dt/3, ws->k[0], ws->x, util );
   ode->f( t+dt/3, ws->x, util, ws->k[1] );
   ode->cat( x, dt*2/3, ws->k[1], ws->x, util );
@@ -54,5 +58,12 @@ zVec zODEUpdateHeun(zODE *ode, double t, zVec x, double dt, void *util)
 
   ode->cat( x, 0.25*dt, ws->k[0], x, util );
   ode->cat( x, 0.75*dt, ws->k[2], x, util );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
   return x;
 }
+
+/* dense output in the last step of Heun method. */
+zVec zODEDenseHeun(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_Heun *)ode->_ws)->dense, t, x, util );
+}
@@ -0,0 +1,242 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_imex - ordinary differential equation quadrature:
+ * implicit-explicit additive Runge-Kutta method.
+ */
+
+#include <zm/zm_ode.h>
+#include <zm/zm_le.h>
+
+/* create an implicit-explicit solver. */
+zODEIMEX *zODEIMEXCreate(zODEIMEX *ode, int dim, zVec (* fe)(double,zVec,void*,zVec), zVec (* fi)(double,zVec,void*,zVec), zMat (* jac)(double,zVec,void*,zMat))
+{
+  int i;
+  bool check = true;
+
+  ode->dim = dim;
+  ode->fe = fe;
+  ode->fi = fi;
+  ode->jac = jac;
+  ode->linear = false;
+  ode->iter = ZODE_IMEX_ITER;
+  ode->tol = zTOL;
+  ode->err = 0;
+  ode->fe_num = ode->fi_num = ode->decomp_num = 0;
+  for( i=0; i<ZODE_IMEX_STAGE; i++ ){
+    ode->_ke[i] = zVecAlloc( dim );
+    ode->_ki[i] = zVecAlloc( dim );
+    if( !ode->_ke[i] || !ode->_ki[i] ) check = false;
+  }
+  ode->_z = zVecAlloc( dim );
+  ode->_r = zVecAlloc( dim );
+  ode->_dz = zVecAlloc( dim );
+  ode->_e = zVecAlloc( dim );
+  ode->_j = zMatAllocSqr( dim );
+  ode->_lu = zMatAllocSqr( dim );
+  ode->_idx = zIndexCreate( dim );
+  ode->_hg = 0;
+  ode->_jac_valid = ode->_lu_valid = false;
+  if( !check || !ode->_z || !ode->_r || !ode->_dz || !ode->_e || !ode->_j || !ode->_lu || !ode->_idx ){
+    ZALLOCERROR();
+    zODEIMEXDestroy( ode );
+    return NULL;
+  }
+  return ode;
+}
+
+/* destroy an implicit-explicit solver. */
+void zODEIMEXDestroy(zODEIMEX *ode)
+{
+  int i;
+
+  for( i=0; i<ZODE_IMEX_STAGE; i++ )
+    zVecFreeAtOnce( 2, ode->_ke[i], ode->_ki[i] );
+  zVecFreeAtOnce( 4, ode->_z, ode->_r, ode->_dz, ode->_e );
+  zMatFreeAtOnce( 2, ode->_j, ode->_lu );
+  zIndexFree( ode->_idx );
+  ode->fe = ode->fi = NULL;
+  ode->jac = NULL;
+}
+
+/* Jacobian matrix of the implicit part. */
+static void _zODEIMEXJacobian(zODEIMEX *ode, double t, zVec x, void *util)
+{
+  double delta;
+  int i, k;
+
+  if( ode->jac )
+    ode->jac( t, x, util, ode->_j );
+  else{ /* finite difference */
+    ode->fi( t, x, util, ode->_r );
+    zVecCopyNC( x, ode->_z );
+    for( k=0; k<ode->dim; k++ ){
+      delta = sqrt( DBL_EPSILON ) * zMax( 1.0, fabs( zVecElemNC(x,k) ) );
+      zVecElemNC(ode->_z,k) += delta;
+      ode->fi( t, ode->_z, util, ode->_dz );
+      zVecElemNC(ode->_z,k) = zVecElemNC(x,k);
+      for( i=0; i<ode->dim; i++ )
+        zMatSetElemNC( ode->_j, i, k, ( zVecElemNC(ode->_dz,i) - zVecElemNC(ode->_r,i) ) / delta );
+    }
+    ode->fi_num += ode->dim + 1;
+  }
+  ode->_jac_valid = true;
+  ode->_lu_valid = false;
+}
+
+/* LU decomposition of I - h gamma J. */
+static bool _zODEIMEXDecomp(zODEIMEX *ode, double hg)
+{
+  int i;
+
+  zMatMulNC( ode->_j, -hg, ode->_lu );
+  for( i=0; i<ode->dim; i++ )
+    zMatElemNC(ode->_lu,i,i) += 1.0;
+  zIndexOrder( ode->_idx, 0 );
+  ode->decomp_num++;
+  if( zMatDecompLUBlockDST( ode->_lu, ode->_idx ) < ode->dim ){
+    ZRUNERROR( ZM_ERR_MAT_SINGULAR );
+    return ( ode->_lu_valid = false );
+  }
+  ode->_hg = hg;
+  return ( ode->_lu_valid = true );
+}
+
+/* solve an implicit stage z = r + h gamma fi(t, z) with an initial guess in _z, and put fi(t, z) into ki. */
+static bool _zODEIMEXSolveStage(zODEIMEX *ode, double t, double hg, zVec ki, void *util)
+{
+  int i;
+
+  for( i=0; i<ode->iter; i++ ){
+    /* residual and correction: ( I - h gamma J ) dz = r + h gamma fi(z) - z */
+    ode->fi( t, ode->_z, util, ki );
+    ode->fi_num++;
+    zVecCatNC( ode->_r, hg, ki, ode->_dz );
+    zVecSubNCDRC( ode->_dz, ode->_z );
+    zLESolveLUBlock( ode->_lu, ode->_idx, ode->_dz, ode->_e );
+    zVecAddNCDRC( ode->_z, ode->_e );
+    if( ode->linear || zVecNorm( ode->_e ) < ode->tol ) goto TERMINATE;
+  }
+  ZITERWARN( ode->iter );
+ TERMINATE:
+  /* fi(z) = ( z - r ) / ( h gamma ) consistent with the stage equation */
+  zVecSubNC( ode->_z, ode->_r, ki );
+  zVecDivDRC( ki, hg );
+  return true;
+}
+
+/* Butcher tableaux of an implicit-explicit additive Runge-Kutta method. */
+typedef struct{
+  int stage;
+  const double *ae, *ai; /* stage x stage coefficient matrices of the explicit and implicit methods */
+  const double *be, *bi; /* weights of the explicit and implicit methods */
+  const double *bh;      /* weights of the embedded method, or the null pointer */
+  const double *c;       /* abscissae */
+  double gamma;          /* diagonal coefficient of the implicit method */
+} _zODEIMEXTableau;
+
+/* a step of an implicit-explicit additive Runge-Kutta method. */
+static zVec _zODEIMEXUpdate(zODEIMEX *ode, const _zODEIMEXTableau *tab, double t, zVec x, double dt, void *util)
+{
+  double hg, s;
+  int i, j, k, n;
+
+  n = tab->stage;
+  hg = dt * tab->gamma;
+  if( !ode->_jac_valid || !ode->linear ) _zODEIMEXJacobian( ode, t, x, util );
+  if( !ode->_lu_valid || ode->_hg != hg )
+    if( !_zODEIMEXDecomp( ode, hg ) ) return NULL;
+  /* the first stage is explicit */
+  ode->fe( t, x, util, ode->_ke[0] );
+  ode->fi( t, x, util, ode->_ki[0] );
+  ode->fe_num++;
+  ode->fi_num++;
+  for( i=1; i<n; i++ ){
+    /* _r = x + h sum_j ( ae_ij ke_j + ai_ij ki_j ) */
+    zVecCopyNC( x, ode->_r );
+    for( j=0; j<i; j++ ){
+      zVecCatNCDRC( ode->_r, dt*tab->ae[i*n+j], ode->_ke[j] );
+      zVecCatNCDRC( ode->_r, dt*tab->ai[i*n+j], ode->_ki[j] );
+    }
+    zVecCatNC( ode->_r, hg, ode->_ki[i-1], ode->_z ); /* initial guess */
+    _zODEIMEXSolveStage( ode, t+tab->c[i]*dt, hg, ode->_ki[i], util );
+    ode->fe( t+tab->c[i]*dt, ode->_z, util, ode->_ke[i] );
+    ode->fe_num++;
+  }
+  /* error estimation by the embedded method */
+  ode->err = 0;
+  if( tab->bh ){
+    for( k=0; k<ode->dim; k++ ){
+      for( s=0, j=0; j<n; j++ )
+        s += ( tab->be[j] - tab->bh[j] ) * ( zVecElemNC(ode->_ke[j],k) + zVecElemNC(ode->_ki[j],k) );
+      ode->err += zSqr( dt * s );
+    }
+    ode->err = sqrt( ode->err / ode->dim );
+  }
+  for( j=0; j<n; j++ ){
+    zVecCatNCDRC( x, dt*tab->be[j], ode->_ke[j] );
+    zVecCatNCDRC( x, dt*tab->bi[j], ode->_ki[j] );
+  }
+  return x;
+}
+
+/* ARS(2,2,2): gamma = 1 - 1/sqrt(2), delta = 1 - 1/(2 gamma) */
+#define ZODE_IMEX_ARS222_G  0.29289321881345247560
+#define ZODE_IMEX_ARS222_D -0.70710678118654752440
+
+static const double _zODEIMEX_ARS222_ae[] = {
+  0, 0, 0,
+  ZODE_IMEX_ARS222_G, 0, 0,
+  ZODE_IMEX_ARS222_D, 1-ZODE_IMEX_ARS222_D, 0,
+};
+static const double _zODEIMEX_ARS222_ai[] = {
+  0, 0, 0,
+  0, ZODE_IMEX_ARS222_G, 0,
+  0, 1-ZODE_IMEX_ARS222_G, ZODE_IMEX_ARS222_G,
+};
+static const double _zODEIMEX_ARS222_be[] = { ZODE_IMEX_ARS222_D, 1-ZODE_IMEX_ARS222_D, 0 };
+static const double _zODEIMEX_ARS222_bi[] = { 0, 1-ZODE_IMEX_ARS222_G, ZODE_IMEX_ARS222_G };
+static const double _zODEIMEX_ARS222_c[] = { 0, ZODE_IMEX_ARS222_G, 1 };
+
+static const _zODEIMEXTableau _zODEIMEX_ARS222_tab = {
+  3, _zODEIMEX_ARS222_ae, _zODEIMEX_ARS222_ai, _zODEIMEX_ARS222_be, _zODEIMEX_ARS222_bi, NULL,
+  _zODEIMEX_ARS222_c, ZODE_IMEX_ARS222_G,
+};
+
+zVec zODEIMEXUpdateARS222(zODEIMEX *ode, double t, zVec x, double dt, void *util)
+{
+  return _zODEIMEXUpdate( ode, &_zODEIMEX_ARS222_tab, t, x, dt, util );
+}
+
+/* ARK3(2)4L[2]SA */
+#define ZODE_IMEX_ARK324_G ( 1767732205903.0/4055673282236 )
+
+static const double _zODEIMEX_ARK324_ae[] = {
+  0, 0, 0, 0,
+  1767732205903.0/2027836641118, 0, 0, 0,
+  5535828885825.0/10492691773637, 788022342437.0/10882634858940, 0, 0,
+  6485989280629.0/16251701735622, -4246266847089.0/9704473918619, 10755448449292.0/10357097424841, 0,
+};
+static const double _zODEIMEX_ARK324_ai[] = {
+  0, 0, 0, 0,
+  ZODE_IMEX_ARK324_G, ZODE_IMEX_ARK324_G, 0, 0,
+  2746238789719.0/10658868560708, -640167445237.0/6845629431997, ZODE_IMEX_ARK324_G, 0,
+  1471266399579.0/7840856788654, -4482444167858.0/7529755066697, 11266239266428.0/11593286722821, ZODE_IMEX_ARK324_G,
+};
+static const double _zODEIMEX_ARK324_b[] = {
+  1471266399579.0/7840856788654, -4482444167858.0/7529755066697, 11266239266428.0/11593286722821, ZODE_IMEX_ARK324_G,
+};
+static const double _zODEIMEX_ARK324_bh[] = {
+  2756255671327.0/12835298489170, -10771552573575.0/22201958757719, 9247589265047.0/10645013368117, 2193209047091.0/5459859503100,
+};
+static const double _zODEIMEX_ARK324_c[] = { 0, 1767732205903.0/2027836641118, 3.0/5, 1 };
+
+static const _zODEIMEXTableau _zODEIMEX_ARK324_tab = {
+  4, _zODEIMEX_ARK324_ae, _zODEIMEX_ARK324_ai, _zODEIMEX_ARK324_b, _zODEIMEX_ARK324_b, _zODEIMEX_ARK324_bh,
+  _zODEIMEX_ARK324_c, ZODE_IMEX_ARK324_G,
+};
+
+zVec zODEIMEXUpdateARK324(zODEIMEX *ode, double t, zVec x, double dt, void *util)
+{
+  return _zODEIMEXUpdate( ode, &_zODEIMEX_ARK324_tab, t, x, dt, util );
+}
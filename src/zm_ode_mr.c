@@ -0,0 +1,118 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_mr - ordinary differential equation quadrature:
+ * multirate integration of fast-slow systems.
+ */
+
+#include <zm/zm_ode.h>
+
+static zVec _zODEMRFastFunc(double t, zVec x, void *ode, zVec dx);
+
+/* create a multirate solver. */
+zODEMR *zODEMRCreate(zODEMR *ode, zODE *fast, int dim, int step, zVec (* ff)(double,zVec,void*,zVec), zVec (* fs)(double,zVec,void*,zVec), int ratio)
+{
+  int i;
+  bool check = true;
+
+  ode->dim = dim;
+  ode->ff = ff;
+  ode->fs = fs;
+  ode->ratio = zMax( ratio, 1 );
+  ode->fs_num = 0;
+  ode->_util = NULL;
+  for( i=0; i<ZODE_MR_STAGE; i++ )
+    if( !( ode->_ks[i] = zVecAlloc( dim ) ) ) check = false;
+  if( !( ode->_g = zVecAlloc( dim ) ) ) check = false;
+  ode->_fast = *fast;
+  ode->_fast.arena = NULL;
+  ode->_fast._ws = NULL;
+  ode->_fast._x1 = ode->_fast._x2 = NULL;
+  if( !zODECreate( &ode->_fast, dim, step, _zODEMRFastFunc ) ){
+    ode->_fast.destroy = NULL;
+    check = false;
+  }
+  if( !check ){
+    ZALLOCERROR();
+    zODEMRDestroy( ode );
+    return NULL;
+  }
+  return ode;
+}
+
+/* destroy a multirate solver. */
+void zODEMRDestroy(zODEMR *ode)
+{
+  int i;
+
+  for( i=0; i<ZODE_MR_STAGE; i++ ) zVecFree( ode->_ks[i] );
+  zVecFree( ode->_g );
+  if( ode->_fast.destroy ) zODEDestroy( &ode->_fast );
+  ode->ff = ode->fs = NULL;
+}
+
+/* modified fast system with a constant forcing by the slow part. */
+zVec _zODEMRFastFunc(double t, zVec x, void *ode, zVec dx)
+{
+  ((zODEMR *)ode)->ff( t, x, ((zODEMR *)ode)->_util, dx );
+  return zVecAddNCDRC( dx, ((zODEMR *)ode)->_g );
+}
+
+/* coupling coefficients of an MRI-GARK method. */
+typedef struct{
+  int stage;
+  const double *gamma; /* (stage-1) x (stage-1) lower-triangular coefficients of slow stages */
+  const double *c;     /* abscissae */
+} _zODEMRTableau;
+
+/* a step of an MRI-GARK method. */
+static zVec _zODEMRUpdate(zODEMR *ode, const _zODEMRTableau *tab, double t, zVec x, double dt, void *util)
+{
+  double dc, h;
+  int i, j, k, n;
+
+  ode->_util = util;
+  for( i=1; i<tab->stage; i++ ){
+    ode->fs( t+tab->c[i-1]*dt, x, util, ode->_ks[i-1] );
+    ode->fs_num++;
+    /* forcing sum_j g_ij fs_j, scaled for the fraction of the step */
+    zVecZero( ode->_g );
+    for( j=0; j<i; j++ )
+      zVecCatNCDRC( ode->_g, tab->gamma[(i-1)*(tab->stage-1)+j], ode->_ks[j] );
+    if( ( dc = tab->c[i] - tab->c[i-1] ) == 0 ){ /* a stage without the fast evolution */
+      zVecCatNCDRC( x, dt, ode->_g );
+      continue;
+    }
+    zVecDivDRC( ode->_g, dc );
+    n = zMax( (int)ceil( ode->ratio * dc - zTOL ), 1 );
+    for( h=dc*dt/n, k=0; k<n; k++ )
+      zODEUpdate( &ode->_fast, t+tab->c[i-1]*dt+k*h, x, h, ode );
+  }
+  return x;
+}
+
+/* MRI-GARK-ERK22a: explicit midpoint rule for the slow part */
+static const double _zODEMR_ERK22a_gamma[] = {
+  0.5, 0,
+ -0.5, 1.0,
+};
+static const double _zODEMR_ERK22a_c[] = { 0, 0.5, 1.0 };
+static const _zODEMRTableau _zODEMR_ERK22a_tab = { 3, _zODEMR_ERK22a_gamma, _zODEMR_ERK22a_c };
+
+zVec zODEMRUpdateERK22a(zODEMR *ode, double t, zVec x, double dt, void *util)
+{
+  return _zODEMRUpdate( ode, &_zODEMR_ERK22a_tab, t, x, dt, util );
+}
+
+/* MRI-GARK-ERK22b: Heun method for the slow part */
+static const double _zODEMR_ERK22b_gamma[] = {
+  1.0, 0,
+ -0.5, 0.5,
+};
+static const double _zODEMR_ERK22b_c[] = { 0, 1.0, 1.0 };
+static const _zODEMRTableau _zODEMR_ERK22b_tab = { 3, _zODEMR_ERK22b_gamma, _zODEMR_ERK22b_c };
+
+zVec zODEMRUpdateERK22b(zODEMR *ode, double t, zVec x, double dt, void *util)
+{
+  return _zODEMRUpdate( ode, &_zODEMR_ERK22b_tab, t, x, dt, util );
+}
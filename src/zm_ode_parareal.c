@@ -0,0 +1,177 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_parareal - ordinary differential equation quadrature:
+ * parallel-in-time integration by Parareal method.
+ */
+
+#include <zm/zm_ode.h>
+
+/* create a solver from a template solver to which a method is assigned. */
+static zODE *_zODEPararealClone(zODE *ode, zODE *src, int dim, int step, zVec (* f)(double,zVec,void*,zVec))
+{
+  *ode = *src;
+  ode->arena = NULL; /* an arena is not shared by solvers */
+  ode->_ws = NULL;
+  ode->_x1 = ode->_x2 = NULL;
+  if( !zODECreate( ode, dim, step, f ) ){
+    ode->destroy = NULL;
+    return NULL;
+  }
+  return ode;
+}
+
+/* create a Parareal solver. */
+zODEParareal *zODEPararealCreate(zODEParareal *pr, zODE *coarse, zODE *fine, int dim, int step, int num, zVec (* f)(double,zVec,void*,zVec))
+{
+  int i;
+  bool check = true;
+
+  if( num <= 0 ){
+    ZRUNERROR( ZM_ERR_ODE_PARAREAL_SLICENUM, num );
+    return NULL;
+  }
+  pr->dim = dim;
+  pr->num = num;
+  pr->iter = num;
+  pr->tol = ZODE_PARAREAL_TOL;
+  pr->iter_num = 0;
+  pr->thread_num = 0;
+  pr->_coarse.destroy = NULL;
+  pr->_fine = zAlloc( zODE, num );
+  pr->_u = zAlloc( zVec, num+1 );
+  pr->_g = zAlloc( zVec, num );
+  pr->_f = zAlloc( zVec, num );
+  pr->_d = zVecAlloc( dim );
+  pr->_w = zVecAlloc( dim );
+  if( !pr->_fine || !pr->_u || !pr->_g || !pr->_f || !pr->_d || !pr->_w ){
+    ZALLOCERROR();
+    zODEPararealDestroy( pr );
+    return NULL;
+  }
+  for( i=0; i<=num; i++ )
+    if( !( pr->_u[i] = zVecAlloc( dim ) ) ) check = false;
+  for( i=0; i<num; i++ )
+    if( !( pr->_g[i] = zVecAlloc( dim ) ) || !( pr->_f[i] = zVecAlloc( dim ) ) ) check = false;
+  if( !check ) goto FAILURE;
+  if( !_zODEPararealClone( &pr->_coarse, coarse, dim, step, f ) ) goto FAILURE;
+  for( i=0; i<num; i++ )
+    if( !_zODEPararealClone( &pr->_fine[i], fine, dim, step, f ) ){
+      /* destroy the solvers cloned so far */
+      while( --i >= 0 ){
+        zODEDestroy( &pr->_fine[i] );
+        pr->_fine[i].destroy = NULL;
+      }
+      zODEDestroy( &pr->_coarse );
+      pr->_coarse.destroy = NULL;
+      goto FAILURE;
+    }
+  return pr;
+
+ FAILURE:
+  ZALLOCERROR();
+  zODEPararealDestroy( pr );
+  return NULL;
+}
+
+/* destroy a Parareal solver. */
+void zODEPararealDestroy(zODEParareal *pr)
+{
+  int i;
+
+  if( pr->_coarse.destroy ) zODEDestroy( &pr->_coarse );
+  for( i=0; i<pr->num; i++ ){
+    if( pr->_fine && pr->_fine[i].destroy ) zODEDestroy( &pr->_fine[i] );
+    if( pr->_g ) zVecFree( pr->_g[i] );
+    if( pr->_f ) zVecFree( pr->_f[i] );
+  }
+  for( i=0; i<=pr->num; i++ )
+    if( pr->_u ) zVecFree( pr->_u[i] );
+  zFree( pr->_fine );
+  zFree( pr->_u );
+  zFree( pr->_g );
+  zFree( pr->_f );
+  zVecFreeAtOnce( 2, pr->_d, pr->_w );
+  pr->num = 0;
+}
+
+/* propagate a state over a slice by equal steps not larger than a given step size. */
+static zVec _zODEPararealPropagate(zODE *ode, double t, zVec x, double span, double dt, void *util)
+{
+  int i, n;
+
+  n = dt > 0 ? (int)ceil( fabs( span ) / dt - zTOL ) : 1;
+  if( n < 1 ) n = 1;
+  for( dt=span/n, i=0; i<n; i++ )
+    zODEUpdate( ode, t+i*dt, x, dt, util );
+  return x;
+}
+
+typedef struct{
+  zODEParareal *pr;
+  double t, span, dt;
+  void *util;
+} _zODEPararealThreadData;
+
+/* fine propagation of slices [from, to). */
+static void _zODEPararealFineTask(void *util, int from, int to)
+{
+  _zODEPararealThreadData *data;
+  zODEParareal *pr;
+  int n;
+
+  data = (_zODEPararealThreadData *)util;
+  pr = data->pr;
+  for( n=from; n<to; n++ ){
+    zVecCopyNC( pr->_u[n], pr->_f[n] );
+    _zODEPararealPropagate( &pr->_fine[n], data->t+n*data->span, pr->_f[n], data->span, data->dt, data->util );
+  }
+}
+
+/* parallel-in-time integration by Parareal method. */
+zVec zODEPararealIntegrate(zODEParareal *pr, double t, zVec x, double tend, double dt_coarse, double dt_fine, void *util)
+{
+  _zODEPararealThreadData data;
+  zODE *fine;
+  double span, err = HUGE_VAL, e;
+  int k, n;
+
+  if( zVecSizeNC(x) != pr->dim ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return NULL;
+  }
+  span = ( tend - t ) / pr->num;
+  fine = &pr->_fine[0];
+  /* initial coarse sweep */
+  zVecCopyNC( x, pr->_u[0] );
+  for( n=0; n<pr->num; n++ ){
+    zVecCopyNC( pr->_u[n], pr->_g[n] );
+    _zODEPararealPropagate( &pr->_coarse, t+n*span, pr->_g[n], span, dt_coarse, util );
+    zVecCopyNC( pr->_g[n], pr->_u[n+1] );
+  }
+  data.pr = pr;
+  data.t = t;
+  data.span = span;
+  data.dt = dt_fine;
+  data.util = util;
+  for( k=0; k<pr->iter && k<pr->num; k++ ){
+    /* the states on the first k slices have already converged */
+    zThreadFor( pr->thread_num, k, pr->num, 1, _zODEPararealFineTask, &data );
+    for( err=0, n=k; n<pr->num; n++ ){
+      /* U_(n+1) = G( U_n ) + F( U_n ) - G( U_n ) of the previous iterate */
+      fine->sub( pr->_f[n], pr->_g[n], pr->_d, util );
+      zVecCopyNC( pr->_u[n], pr->_g[n] );
+      _zODEPararealPropagate( &pr->_coarse, t+n*span, pr->_g[n], span, dt_coarse, util );
+      fine->cat( pr->_g[n], 1.0, pr->_d, pr->_w, util );
+      fine->sub( pr->_w, pr->_u[n+1], pr->_d, util );
+      if( ( e = zVecInfNorm( pr->_d ) ) > err ) err = e;
+      zVecCopyNC( pr->_w, pr->_u[n+1] );
+    }
+    if( err < pr->tol ){
+      k++;
+      break;
+    }
+  }
+  if( ( pr->iter_num = k ) < pr->num && err >= pr->tol ) ZITERWARN( pr->iter );
+  return zVecCopyNC( pr->_u[pr->num], x );
+}
@@ -0,0 +1,86 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_raw - ordinary differential equation quadrature:
+ * allocation-free solver on raw arrays.
+ */
+
+#include <zm/zm_ode.h>
+
+/* number of stages of the largest method */
+#define ZODE_RAW_STAGE 7
+
+/* create an allocation-free ODE solver. */
+zODERaw *zODERawCreate(zODERaw *ode, int dim, void (* f)(double,const double*,void*,double*))
+{
+  if( !( ode->_k = zAlloc( double, ( ZODE_RAW_STAGE + 2 ) * dim ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  ode->_xc = ode->_k + ZODE_RAW_STAGE * dim;
+  ode->_xf = ode->_xc + dim;
+  ode->dim = dim;
+  ode->f = f;
+  ode->err = 0;
+  ode->_t1 = 0;
+  ode->_fsal = false;
+  return ode;
+}
+
+/* destroy an allocation-free ODE solver. */
+void zODERawDestroy(zODERaw *ode)
+{
+  zFree( ode->_k );
+  ode->_xc = ode->_xf = NULL;
+  ode->dim = 0;
+  ode->f = NULL;
+}
+
+/* weights of classical Runge-Kutta method. */
+static const double _zODERaw_RK4_b[] = { 1.0/6, 1.0/3, 1.0/3, 1.0/6 };
+
+/* update a state by classical Runge-Kutta method. */
+double *zODERawUpdateRK4(zODERaw *ode, double t, double *x, double dt, void *util)
+{
+  double dt1;
+
+  dt1 = 0.5 * dt;
+  ode->_fsal = false;
+  ode->f( t, x, util, ode->_k );
+  zRawVecCat( x, dt1, ode->_k, ode->_xc, ode->dim );
+  ode->f( t+dt1, ode->_xc, util, ode->_k+ode->dim );
+  zRawVecCat( x, dt1, ode->_k+ode->dim, ode->_xc, ode->dim );
+  ode->f( t+dt1, ode->_xc, util, ode->_k+2*ode->dim );
+  zRawVecCat( x, dt, ode->_k+2*ode->dim, ode->_xc, ode->dim );
+  ode->f( t+dt, ode->_xc, util, ode->_k+3*ode->dim );
+  _zODEStageSum( x, dt, _zODERaw_RK4_b, ode->_k, 4, ode->dim, x );
+  return x;
+}
+
+/* update a state by Dormand-Prince method. */
+double *zODERawUpdateDP45(zODERaw *ode, double t, double *x, double dt, void *util)
+{
+  int i, l;
+  double e;
+
+  if( ode->_fsal && t == ode->_t1 && memcmp( x, ode->_xf, sizeof(double)*ode->dim ) == 0 )
+    memcpy( ode->_k, ode->_k+(ZODE_RAW_STAGE-1)*ode->dim, sizeof(double)*ode->dim );
+  else
+    ode->f( t, x, util, ode->_k );
+  for( l=0, i=1; i<ZODE_RAW_STAGE; l+=i, i++ ){
+    _zODEStageSum( x, dt, _zODE_DP45_a+l, ode->_k, i, ode->dim, ode->_xc );
+    ode->f( t+_zODE_DP45_c[i-1]*dt, ode->_xc, util, ode->_k+i*ode->dim );
+  }
+  /* the last stage is evaluated at the fifth-order estimation */
+  memcpy( ode->_xf, ode->_xc, sizeof(double)*ode->dim );
+  _zODEStageSum( x, dt, _zODE_DP45_b4, ode->_k, ZODE_RAW_STAGE, ode->dim, ode->_xc );
+  for( ode->err=0, i=0; i<ode->dim; i++ ){
+    e = ode->_xf[i] - ode->_xc[i];
+    ode->err += e * e;
+  }
+  ode->err = sqrt( ode->err / ode->dim );
+  memcpy( x, ode->_xf, sizeof(double)*ode->dim );
+  ode->_t1 = t + dt;
+  ode->_fsal = true;
+  return x;
+}
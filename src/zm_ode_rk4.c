@@ -9,24 +9,36 @@
 
 typedef struct{
   zVec x, k[4];
+  zVecStruct _k[4]; /* stages sharing a contiguous buffer */
+  double *_kbuf;
+  zVec x0;       /* state at the head of the last step */
+  double t0, dt; /* head time and size of the last step */
 } _zODE_RK4;
 
 /* create an ODE solver based on classical Runge-Kutta method. */
 zODE* zODECreateRK4(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec))
 {
   _zODE_RK4 *ws;
+  int i;
 
-  if( !( ws = zAlloc( _zODE_RK4, 1 ) ) ||
-      !( ws->x = zVecAlloc( dim ) ) /* incremental vector */ ||
-      !( ws->k[0] = zVecAlloc( dim ) ) /* step-1 vector */ ||
-      !( ws->k[1] = zVecAlloc( dim ) ) /* step-2 vector */ ||
-      !( ws->k[2] = zVecAlloc( dim ) ) /* step-3 vector */ ||
-      !( ws->k[3] = zVecAlloc( dim ) ) /* step-4 vector */ ){
+  if( !( ws = zAlloc( _zODE_RK4, 1 ) ) ){
     ZALLOCERROR();
     return NULL;
   }
-  ode->f = f;
+  ws->x = zVecAlloc( dim );  /* incremental vector */
+  ws->x0 = zVecAlloc( dim ); /* head state */
+  ws->_kbuf = zAlloc( double, 4*dim ); /* step-1 to step-4 vectors */
   ode->_ws = ws;
+  if( !ws->x || !ws->x0 || !ws->_kbuf ){
+    ZALLOCERROR();
+    zODEDestroyRK4( ode );
+    return NULL;
+  }
+  for( i=0; i<4; i++ ){
+    zVecAssignArray( &ws->_k[i], dim, ws->_kbuf + i*dim );
+    ws->k[i] = &ws->_k[i];
+  }
+  ode->f = f;
   return ode;
 }
 
@@ -36,11 +48,15 @@ void zODEDestroyRK4(zODE *ode)
   _zODE_RK4 *ws;
 
   ws = (_zODE_RK4 *)ode->_ws;
-  zVecFreeAtOnce( 5, ws->x, ws->k[0], ws->k[1], ws->k[2], ws->k[3] );
+  zVecFreeAtOnce( 2, ws->x, ws->x0 );
+  zFree( ws->_kbuf );
   zFree( ode->_ws );
   ode->f = NULL;
 }
 
+/* weights of classical Runge-Kutta method. */
+static const double _zODE_RK4_b[] = { 1.0/6, 1.0/3, 1.0/3, 1.0/6 };
+
 /* directly integrate variable by ODE based on classical Runge-Kutta method. */
 zVec zODEUpdateRK4(zODE *ode, double t, zVec x, double dt, void *util)
 {
@@ -48,7 +64,21 @@ zVec zODEUpdateRK4(zODE *ode, double t, zVec x, double dt, void *util)
   double dt1, dt2, dt3;
 
   ws = (_zODE_RK4 *)ode->_ws;
+  ws->t0 = t;
+  ws->dt = dt;
+  zVecCopyNC( x, ws->x0 );
   dt1 = dt * 0.5;
+  if( ode->cat == _zODECatDefault ){ /* fast path on a contiguous stage buffer */
+    ode->f( t, x, util, ws->k[0] );
+    zRawVecCat( zVecBufNC(x), dt1, zVecBufNC(ws->k[0]), zVecBufNC(ws->x), zVecSizeNC(x) );
+    ode->f( t+dt1, ws->x, util, ws->k[1] );
+    zRawVecCat( zVecBufNC(x), dt1, zVecBufNC(ws->k[1]), zVecBufNC(ws->x), zVecSizeNC(x) );
+    ode->f( t+dt1, ws->x, util, ws->k[2] );
+    zRawVecCat( zVecBufNC(x), dt, zVecBufNC(ws->k[2]), zVecBufNC(ws->x), zVecSizeNC(x) );
+    ode->f( t+dt, ws->x, util, ws->k[3] );
+    _zODEStageSum( zVecBufNC(x), dt, _zODE_RK4_b, ws->_kbuf, 4, zVecSizeNC(x), zVecBufNC(x) );
+    return x;
+  }
   dt2 = dt / 6;
   dt3 = dt2 * 2;
   ode->f( t, x, util, ws->k[0] );
@@ -65,3 +95,26 @@ zVec zODEUpdateRK4(zODE *ode, double t, zVec x, double dt, void *util)
   ode->cat( x, dt2, ws->k[3], x, util );
   return x;
 }
+
+/* dense output in the last step of classical Runge-Kutta method. */
+zVec zODEDenseRK4(zODE *ode, double t, zVec x, void *util)
+{
+  _zODE_RK4 *ws;
+  double theta, b1, b2, b4;
+
+  ws = (_zODE_RK4 *)ode->_ws;
+  theta = ws->dt == 0 ? 1.0 : ( t - ws->t0 ) / ws->dt;
+  if( theta < -zTOL || theta > 1+zTOL ){
+    ZRUNERROR( ZM_ERR_ODE_DENSE_OUTOFRANGE, t, ws->t0, ws->t0+ws->dt );
+    return NULL;
+  }
+  /* third-order continuous extension */
+  b1 = theta*( 1 + theta*( -1.5 + theta*2.0/3 ) );
+  b2 = zSqr(theta)*( 1 - theta*2.0/3 );
+  b4 = zSqr(theta)*( -0.5 + theta*2.0/3 );
+  zVecMulNC( ws->k[0], b1, ws->x );
+  zVecCatNCDRC( ws->x, b2, ws->k[1] );
+  zVecCatNCDRC( ws->x, b2, ws->k[2] );
+  zVecCatNCDRC( ws->x, b4, ws->k[3] );
+  return ode->cat( ws->x0, ws->dt, ws->x, x, util );
+}
@@ -10,6 +10,7 @@
 /* Runge-Kutta-Gill method */
 typedef struct{
   zVec u, v; /* working space */
+  zODEHermite dense;
 } _zODE_RKG;
 
 /* create an ODE solver based on Runge-Kutta-Gill method. */
@@ -19,7 +20,8 @@ zODE* zODECreateRKG(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,
 
   if( !( ws = zAlloc( _zODE_RKG, 1 ) ) ||
       !( ws->u = zVecAlloc( dim ) ) /* workspace 1 */ ||
-      !( ws->v = zVecAlloc( dim ) ) /* workspace 2 */ ){
+      !( ws->v = zVecAlloc( dim ) ) /* workspace 2 */ ||
+      !_zODEHermiteAlloc( &ws->dense, dim, NULL ) ){
     ZALLOCERROR();
     return NULL;
   }
@@ -35,6 +37,7 @@ void zODEDestroyRKG(zODE *ode)
 
   ws = (_zODE_RKG *)ode->_ws;
   zVecFreeAtOnce( 2, ws->u, ws->v );
+  _zODEHermiteFree( &ws->dense, NULL );
   zFree( ode->_ws );
   ode->f = NULL;
 }
@@ -54,6 +57,7 @@ zVec zODEUpdateRKG(zODE *ode, double t, zVec x, double dt, void *util)
   dt3 = c2 * dt;
   /* first step */
   ode->f( t, x, util, ws->u );
+  _zODEHermiteSetHead( &ws->dense, t, x, ws->u );
   ode->cat( x, dt1, ws->u, x, util );
   zVecCopyNC( ws->u, ws->v );
   /* second step */
@@ -72,5 +76,12 @@ zVec zODEUpdateRKG(zODE *ode, double t, zVec x, double dt, void *util)
   ode->f( t+dt, x, util, ws->u );
   ode->cat( x, dt/6, ws->u, x, util );
   ode->cat( x,-dt/3, ws->v, x, util );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
   return x;
 }
+
+/* dense output in the last step of Runge-Kutta-Gill method. */
+zVec zODEDenseRKG(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_RKG *)ode->_ws)->dense, t, x, util );
+}
@@ -0,0 +1,336 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_ode_ros - ordinary differential equation quadrature:
+ * Rosenbrock-W method for stiff systems.
+ */
+
+#include <zm/zm_ode.h>
+#include <zm/zm_le.h>
+
+#define ZODE_ROS_STAGE 4
+
+/* ROS34PW2 in the original form: alpha_ij, gamma_ij (i>j), gamma_ii, b and the embedded b. */
+static const double _zODE_ROS34_alpha[ZODE_ROS_STAGE][ZODE_ROS_STAGE] = {
+  { 0, 0, 0, 0 },
+  { 8.7173304301691801e-01, 0, 0, 0 },
+  { 8.4457060015369423e-01, -1.1299064236484185e-01, 0, 0 },
+  { 0, 0, 1, 0 },
+};
+static const double _zODE_ROS34_gamma[ZODE_ROS_STAGE][ZODE_ROS_STAGE] = {
+  { 0, 0, 0, 0 },
+  { -8.7173304301691801e-01, 0, 0, 0 },
+  { -9.0338057013044082e-01, 5.4180672388095326e-02, 0, 0 },
+  { 2.4212380706095346e-01, -1.2232505839045147e+00, 5.4526025533510214e-01, 0 },
+};
+static const double _zODE_ROS34_gamma_diag = 4.3586652150845900e-01;
+static const double _zODE_ROS34_b[] = {
+  2.4212380706095346e-01, -1.2232505839045147e+00, 1.5452602553351020e+00, 4.3586652150845900e-01 };
+static const double _zODE_ROS34_be[] = {
+  3.7810903145819369e-01, -9.6042292212423178e-02, 0.5, 2.1793326075422950e-01 };
+
+typedef struct{
+  /* coefficients transformed to avoid multiplications of the Jacobian matrix */
+  double a[ZODE_ROS_STAGE][ZODE_ROS_STAGE];
+  double c[ZODE_ROS_STAGE][ZODE_ROS_STAGE];
+  double m[ZODE_ROS_STAGE], me[ZODE_ROS_STAGE];
+  double alpha[ZODE_ROS_STAGE], gamma[ZODE_ROS_STAGE];
+  /* Jacobian matrix and its finite difference */
+  zMat (* jac)(double,zVec,void*,zMat);
+  zMat j;
+  zVec ft;         /* partial derivative with respect to time */
+  zSpMat pattern;  /* sparsity pattern in the CSC format */
+  int *color;      /* colors of columns */
+  int color_num;
+  /* LU decomposition of I/(h gamma) - J */
+  zMat lu;
+  zIndex idx;
+  double dt_lu;
+  /* workspace */
+  zVec u[ZODE_ROS_STAGE];
+  zVec xs, fs, rhs, dx, e;
+  /* reuse control */
+  bool jac_valid, lu_valid;
+  int age;
+  double err_ref;
+  int jac_num, decomp_num;
+  zODEHermite dense;
+} _zODE_Ros;
+
+/* transform coefficients of a Rosenbrock method to the form without multiplications of J. */
+static void _zODERosTransform(_zODE_Ros *ws)
+{
+  double ginv[ZODE_ROS_STAGE][ZODE_ROS_STAGE];
+  int i, j, k;
+
+  for( i=0; i<ZODE_ROS_STAGE; i++ ){
+    ginv[i][i] = 1.0 / _zODE_ROS34_gamma_diag;
+    for( j=0; j<i; j++ ){
+      for( ginv[i][j]=0, k=j; k<i; k++ )
+        ginv[i][j] -= _zODE_ROS34_gamma[i][k] * ginv[k][j];
+      ginv[i][j] /= _zODE_ROS34_gamma_diag;
+    }
+    for( j=i+1; j<ZODE_ROS_STAGE; j++ ) ginv[i][j] = 0;
+  }
+  for( i=0; i<ZODE_ROS_STAGE; i++ ){
+    ws->alpha[i] = 0;
+    ws->gamma[i] = _zODE_ROS34_gamma_diag;
+    for( j=0; j<i; j++ ){
+      ws->alpha[i] += _zODE_ROS34_alpha[i][j];
+      ws->gamma[i] += _zODE_ROS34_gamma[i][j];
+      for( ws->a[i][j]=0, k=j; k<i; k++ )
+        ws->a[i][j] += _zODE_ROS34_alpha[i][k] * ginv[k][j];
+      ws->c[i][j] = -ginv[i][j];
+    }
+    for( ws->m[i]=ws->me[i]=0, k=i; k<ZODE_ROS_STAGE; k++ ){
+      ws->m[i] += _zODE_ROS34_b[k] * ginv[k][i];
+      ws->me[i] += ( _zODE_ROS34_b[k] - _zODE_ROS34_be[k] ) * ginv[k][i];
+    }
+  }
+}
+
+/* create an ODE solver based on Rosenbrock-W method. */
+zODE *zODECreateRos34(zODE *ode, int dim, int dummy, zVec (* f)(double,zVec,void*,zVec))
+{
+  _zODE_Ros *ws;
+  int i;
+  bool check = true;
+
+  if( ode->arena ){
+    if( !( ws = (_zODE_Ros *)zArenaCarve( ode->arena, sizeof(_zODE_Ros) ) ) ) return NULL;
+  } else
+  if( !( ws = zAlloc( _zODE_Ros, 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  _zODERosTransform( ws );
+  ws->jac = NULL;
+  ws->pattern = NULL;
+  ws->color = NULL;
+  ws->color_num = dim;
+  if( !( ws->j = zArenaMatAllocSqr( ode->arena, dim ) ) ||
+      !( ws->lu = zArenaMatAllocSqr( ode->arena, dim ) ) ||
+      !( ws->idx = zArenaIndexCreate( ode->arena, dim ) ) ||
+      !( ws->ft = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->xs = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->fs = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->rhs = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->dx = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !( ws->e = zArenaVecAlloc( ode->arena, dim ) ) ||
+      !_zODEHermiteAlloc( &ws->dense, dim, ode->arena ) ) check = false;
+  for( i=0; i<ZODE_ROS_STAGE; i++ )
+    if( !( ws->u[i] = zArenaVecAlloc( ode->arena, dim ) ) ) check = false;
+  if( !check ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  ws->jac_valid = ws->lu_valid = false;
+  ws->dt_lu = 0;
+  ws->age = 0;
+  ws->err_ref = 0;
+  ws->jac_num = ws->decomp_num = 0;
+  ode->f = f;
+  ode->_ws = ws;
+  return ode;
+}
+
+/* destroy an ODE solver. */
+void zODEDestroyRos34(zODE *ode)
+{
+  _zODE_Ros *ws;
+  int i;
+
+  ws = (_zODE_Ros *)ode->_ws;
+  ode->f = NULL;
+  ode->_ws = NULL;
+  zSpMatFree( ws->pattern );
+  zFree( ws->color );
+  _zODEHermiteFree( &ws->dense, ode->arena );
+  if( ode->arena ) return; /* rewound together with the arena */
+  zMatFreeAtOnce( 2, ws->j, ws->lu );
+  zIndexFree( ws->idx );
+  zVecFreeAtOnce( 6, ws->ft, ws->xs, ws->fs, ws->rhs, ws->dx, ws->e );
+  for( i=0; i<ZODE_ROS_STAGE; i++ )
+    zVecFree( ws->u[i] );
+  zFree( ws );
+}
+
+/* assign a Jacobian function to the Rosenbrock-W method. */
+zODE *zODESetJacobianRos34(zODE *ode, zMat (* jac)(double,zVec,void*,zMat))
+{
+  ((_zODE_Ros *)ode->_ws)->jac = jac;
+  return zODERefreshJacobianRos34( ode );
+}
+
+/* assign a sparsity pattern of the Jacobian matrix to the Rosenbrock-W method. */
+zODE *zODESetJacobianPatternRos34(zODE *ode, const zSpMat pattern)
+{
+  _zODE_Ros *ws;
+  zSpMat csr = NULL;
+  int *forbid = NULL;
+  int n, i, j, k, l, p;
+
+  ws = (_zODE_Ros *)ode->_ws;
+  n = zMatRowSizeNC(ws->j);
+  zSpMatFree( ws->pattern );
+  zFree( ws->color );
+  ws->pattern = NULL;
+  ws->color_num = n;
+  zODERefreshJacobianRos34( ode );
+  if( !pattern ) return ode;
+  if( zSpMatRowSize(pattern) != n || zSpMatColSize(pattern) != n ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  ws->pattern = zSpMatIsCSC(pattern) ? zSpMatClone( pattern ) : zSpMatConvert( pattern, ZM_SPMAT_CSC );
+  csr = zSpMatIsCSR(pattern) ? pattern : zSpMatConvert( pattern, ZM_SPMAT_CSR );
+  ws->color = zAlloc( int, n );
+  forbid = zAlloc( int, n );
+  if( !ws->pattern || !csr || !ws->color || !forbid ){
+    ZALLOCERROR();
+    ode = NULL;
+    goto TERMINATE;
+  }
+  /* greedy coloring of columns so that no two columns in a color share a row */
+  for( j=0; j<n; j++ ) forbid[j] = -1;
+  for( ws->color_num=0, j=0; j<n; j++ ){
+    for( k=ws->pattern->ptr[j]; k<ws->pattern->ptr[j+1]; k++ ){
+      i = ws->pattern->ind[k];
+      for( l=csr->ptr[i]; l<csr->ptr[i+1]; l++ )
+        if( ( p = csr->ind[l] ) < j ) forbid[ws->color[p]] = j;
+    }
+    for( ws->color[j]=0; forbid[ws->color[j]] == j; ws->color[j]++ );
+    if( ws->color[j] >= ws->color_num ) ws->color_num = ws->color[j] + 1;
+  }
+ TERMINATE:
+  if( csr != pattern ) zSpMatFree( csr );
+  zFree( forbid );
+  if( !ode ){
+    zSpMatFree( ws->pattern );
+    zFree( ws->color );
+  }
+  return ode;
+}
+
+/* mark the Jacobian matrix of the Rosenbrock-W method to be re-evaluated. */
+zODE *zODERefreshJacobianRos34(zODE *ode)
+{
+  ((_zODE_Ros *)ode->_ws)->jac_valid = false;
+  return ode;
+}
+
+/* statistics of the Rosenbrock-W method. */
+int zODEJacobianNumRos34(zODE *ode){ return ((_zODE_Ros *)ode->_ws)->jac_num; }
+int zODEDecompNumRos34(zODE *ode){ return ((_zODE_Ros *)ode->_ws)->decomp_num; }
+int zODEColorNumRos34(zODE *ode){ return ((_zODE_Ros *)ode->_ws)->color_num; }
+
+/* Jacobian matrix and partial derivative with respect to time by finite difference. */
+static void _zODERosJacobian(zODE *ode, double t, zVec x, void *util)
+{
+  _zODE_Ros *ws;
+  double dt, *delta;
+  int n, c, i, k;
+
+  ws = (_zODE_Ros *)ode->_ws;
+  n = zVecSizeNC(x);
+  ode->f( t, x, util, ws->fs );
+  if( ws->jac )
+    ws->jac( t, x, util, ws->j );
+  else{
+    zMatZero( ws->j );
+    delta = zVecBufNC(ws->rhs);
+    for( k=0; k<n; k++ )
+      delta[k] = sqrt( DBL_EPSILON ) * zMax( 1.0, fabs( zVecElemNC(x,k) ) );
+    for( c=0; c<ws->color_num; c++ ){
+      zVecZero( ws->dx );
+      for( k=0; k<n; k++ )
+        if( ( ws->color ? ws->color[k] : k ) == c ) zVecSetElemNC( ws->dx, k, delta[k] );
+      ode->cat( x, 1.0, ws->dx, ws->xs, util );
+      ode->f( t, ws->xs, util, ws->e );
+      for( k=0; k<n; k++ ){
+        if( ( ws->color ? ws->color[k] : k ) != c ) continue;
+        if( ws->pattern ){
+          for( i=ws->pattern->ptr[k]; i<ws->pattern->ptr[k+1]; i++ )
+            zMatSetElemNC( ws->j, ws->pattern->ind[i], k,
+              ( zVecElemNC(ws->e,ws->pattern->ind[i]) - zVecElemNC(ws->fs,ws->pattern->ind[i]) ) / delta[k] );
+        } else
+          for( i=0; i<n; i++ )
+            zMatSetElemNC( ws->j, i, k, ( zVecElemNC(ws->e,i) - zVecElemNC(ws->fs,i) ) / delta[k] );
+      }
+    }
+  }
+  dt = sqrt( DBL_EPSILON ) * zMax( 1.0, fabs( t ) );
+  ode->f( t+dt, x, util, ws->ft );
+  zVecSubNCDRC( ws->ft, ws->fs );
+  zVecDivDRC( ws->ft, dt );
+  ws->jac_num++;
+  ws->jac_valid = true;
+  ws->lu_valid = false;
+  ws->age = 0;
+  ws->err_ref = -1;
+}
+
+/* LU decomposition of I/(h gamma) - J. */
+static bool _zODERosDecomp(_zODE_Ros *ws, double dt)
+{
+  int i, n;
+
+  n = zMatRowSizeNC(ws->j);
+  zMatRevNC( ws->j, ws->lu );
+  for( i=0; i<n; i++ )
+    zMatElemNC(ws->lu,i,i) += 1.0 / ( dt * _zODE_ROS34_gamma_diag );
+  zIndexOrder( ws->idx, 0 );
+  ws->decomp_num++;
+  if( zMatDecompLUBlockDST( ws->lu, ws->idx ) < n ){
+    ZRUNERROR( ZM_ERR_MAT_SINGULAR );
+    return ( ws->lu_valid = false );
+  }
+  ws->dt_lu = dt;
+  return ( ws->lu_valid = true );
+}
+
+/* directly integrate variable by ODE based on Rosenbrock-W method. */
+zVec zODEUpdateRos34(zODE *ode, double t, zVec x, double dt, void *util)
+{
+  _zODE_Ros *ws;
+  double err;
+  int i, j, k;
+
+  ws = (_zODE_Ros *)ode->_ws;
+  if( !ws->jac_valid ) _zODERosJacobian( ode, t, x, util );
+  if( !ws->lu_valid || dt != ws->dt_lu )
+    if( !_zODERosDecomp( ws, dt ) ) return NULL;
+  zVecZero( ws->dx );
+  zVecZero( ws->e );
+  for( i=0; i<ZODE_ROS_STAGE; i++ ){
+    zVecCopyNC( x, ws->xs );
+    for( j=0; j<i; j++ )
+      if( ws->a[i][j] != 0 ) ode->cat( ws->xs, ws->a[i][j], ws->u[j], ws->xs, util );
+    ode->f( t+ws->alpha[i]*dt, ws->xs, util, ws->rhs );
+    if( i == 0 ) _zODEHermiteSetHead( &ws->dense, t, x, ws->rhs );
+    for( j=0; j<i; j++ )
+      zVecCatNCDRC( ws->rhs, ws->c[i][j]/dt, ws->u[j] );
+    zVecCatNCDRC( ws->rhs, ws->gamma[i]*dt, ws->ft );
+    zLESolveLUBlock( ws->lu, ws->idx, ws->rhs, ws->u[i] );
+    zVecCatNCDRC( ws->dx, ws->m[i], ws->u[i] );
+    zVecCatNCDRC( ws->e, ws->me[i], ws->u[i] );
+  }
+  /* error estimation by the embedded method to check if the Jacobian matrix is still valid */
+  for( err=0, k=0; k<zVecSizeNC(ws->e); k++ )
+    err += zSqr( zVecElemNC(ws->e,k) / ( 1 + fabs( zVecElemNC(x,k) ) ) );
+  err = sqrt( err / zVecSizeNC(ws->e) );
+  if( ws->err_ref < 0 )
+    ws->err_ref = zMax( err, zTOL );
+  else
+  if( err > ZODE_ROS_DEGRADE * ws->err_ref || ++ws->age >= ZODE_ROS_JAC_AGE )
+    ws->jac_valid = false;
+  ode->cat( x, 1.0, ws->dx, x, util );
+  _zODEHermiteSetTail( &ws->dense, t+dt, x, NULL );
+  return x;
+}
+
+/* dense output in the last step of Rosenbrock-W method. */
+zVec zODEDenseRos34(zODE *ode, double t, zVec x, void *util)
+{
+  return _zODEHermiteEval( ode, &((_zODE_Ros *)ode->_ws)->dense, t, x, util );
+}
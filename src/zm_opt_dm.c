@@ -38,9 +38,11 @@ static zMat _zOptDMHessNG(zOptDM *opt, const zVec var, zMat h, void *util)
   int i;
   double org;
   zVec adg, prg;
+  zArenaMark mark = 0;
 
-  adg = zVecAlloc( zVecSizeNC(var) );
-  prg = zVecAlloc( zVecSizeNC(var) );
+  if( opt->_arena ) mark = zArenaMarkGet( opt->_arena );
+  adg = zArenaVecAlloc( opt->_arena, zVecSizeNC(var) );
+  prg = zArenaVecAlloc( opt->_arena, zVecSizeNC(var) );
   if( !adg || !prg ){
     ZALLOCERROR();
     h = NULL;
@@ -57,8 +59,12 @@ static zMat _zOptDMHessNG(zOptDM *opt, const zVec var, zMat h, void *util)
   }
   zMatMulDRC( h, 0.5/Z_OPT_EPS );
  TERMINATE:
-  zVecFree( adg );
-  zVecFree( prg );
+  if( opt->_arena )
+    zArenaRelease( opt->_arena, mark );
+  else{
+    zVecFree( adg );
+    zVecFree( prg );
+  }
   return h;
 }
 
@@ -334,8 +340,9 @@ static zVec _zOptDMVecCG(zOptDM *opt, const zVec var, zVec d, void *util)
 /* constructor and destructor */
 
 #define Z_OPT_DM_SCALE ( 1.0e3 )
-zOptDM *zOptDMCreate(zOptDM *opt, int dim, double scale, double (* eval)(const zVec,void*), zVec (* grad)(const zVec,zVec,void*), zMat (* hess)(const zVec,zMat,void*))
+zOptDM *zOptDMCreateArena(zOptDM *opt, int dim, double scale, double (* eval)(const zVec,void*), zVec (* grad)(const zVec,zVec,void*), zMat (* hess)(const zVec,zMat,void*), zArena *arena)
 {
+  opt->_arena = arena;
   if( !( opt->eval = eval ) ){
     ZRUNERROR( ZM_ERR_OPT_NOEVALUATOR );
     return NULL;
@@ -343,14 +350,14 @@ zOptDM *zOptDMCreate(zOptDM *opt, int dim, double scale, double (* eval)(const z
   opt->_grad = ( opt->grad = grad ) ? _zOptDMGrad : _zOptDMGradNG;
   opt->_hess = ( opt->hess = hess ) ? _zOptDMHess : _zOptDMHessNG;
   opt->_scale = ( scale == 0 ) ? Z_OPT_DM_SCALE : scale;
-  opt->_x = zVecAlloc( dim );
-  opt->_d = zVecAlloc( dim );
-  opt->_g = zVecAlloc( dim );
-  opt->_p = zVecAlloc( dim );
-  opt->_q = zVecAlloc( dim );
-  opt->_r = zVecAlloc( dim );
-  opt->_h = zMatAllocSqr( dim );
-  opt->_idx = zIndexCreate( dim );
+  opt->_x = zArenaVecAlloc( arena, dim );
+  opt->_d = zArenaVecAlloc( arena, dim );
+  opt->_g = zArenaVecAlloc( arena, dim );
+  opt->_p = zArenaVecAlloc( arena, dim );
+  opt->_q = zArenaVecAlloc( arena, dim );
+  opt->_r = zArenaVecAlloc( arena, dim );
+  opt->_h = zArenaMatAllocSqr( arena, dim );
+  opt->_idx = zArenaIndexCreate( arena, dim );
   if( !opt->_x || !opt->_d || !opt->_g || !opt->_p || !opt->_q || !opt->_r || !opt->_h || !opt->_idx ){
     zOptDMDestroy( opt );
     return NULL;
@@ -360,6 +367,11 @@ zOptDM *zOptDMCreate(zOptDM *opt, int dim, double scale, double (* eval)(const z
   return zOptDMAssignSD( opt, NULL );
 }
 
+zOptDM *zOptDMCreate(zOptDM *opt, int dim, double scale, double (* eval)(const zVec,void*), zVec (* grad)(const zVec,zVec,void*), zMat (* hess)(const zVec,zMat,void*))
+{
+  return zOptDMCreateArena( opt, dim, scale, eval, grad, hess, NULL );
+}
+
 static void _zOptDMAssignStep(zOptDM *opt, const char *method)
 {
   if( !method )
@@ -416,9 +428,11 @@ zOptDM *zOptDMAssignCG(zOptDM *opt)
 
 void zOptDMDestroy(zOptDM *opt)
 {
-  zVecFreeAtOnce( 6, opt->_x, opt->_d, opt->_g, opt->_p, opt->_q, opt->_r );
-  zMatFree( opt->_h );
-  zIndexFree( opt->_idx );
+  if( !opt->_arena ){
+    zVecFreeAtOnce( 6, opt->_x, opt->_d, opt->_g, opt->_p, opt->_q, opt->_r );
+    zMatFree( opt->_h );
+    zIndexFree( opt->_idx );
+  }
   opt->eval = NULL;
   opt->grad = NULL;
   opt->hess = NULL;
@@ -0,0 +1,188 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_opt_lcp_pgs - optimization tools: projected Gauss-Seidel method for linear complementarity problem.
+ */
+
+#include <zm/zm_opt.h>
+
+/* initialize parameters of the projected Gauss-Seidel method. */
+zLCPPGS *zLCPPGSInit(zLCPPGS *pgs)
+{
+  pgs->omega = ZLCP_PGS_OMEGA;
+  pgs->tol = ZLCP_PGS_TOL;
+  pgs->iter_max = 0;
+  pgs->iter_num = 0;
+  pgs->residual = 0;
+  return pgs;
+}
+
+/* check sizes of vectors and matrices and diagonal components of the matrix. */
+static bool _zLCPPGSCheck(const zMat m, const zVec p, const zVec w, const zVec z)
+{
+  int i;
+
+  if( !zMatIsSqr( m ) || !zMatColVecSizeEqual( m, p ) || !zVecSizeEqual( p, z ) ||
+      ( w && !zVecSizeEqual( p, w ) ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  for( i=0; i<zVecSizeNC(z); i++ )
+    if( zMatElemNC(m,i,i) <= 0 ){
+      ZRUNERROR( ZM_ERR_MAT_NOTPOSITIVEDEFINITE );
+      return false;
+    }
+  return true;
+}
+
+/* the i-th component of m z + p. */
+#define _zLCPPGSRow(m,p,z,i) \
+  ( zRawVecInnerProd( zMatRowBufNC(m,i), zVecBufNC(z), zVecSizeNC(z) ) + zVecElemNC(p,i) )
+
+/* one sweep of the projected Gauss-Seidel method, which returns the residual estimated on the way. */
+static double _zLCPPGSSweep(zLCPPGS *pgs, const zMat m, const zVec p, zVec z)
+{
+  int i;
+  double r, zi, res = 0;
+
+  for( i=0; i<zVecSizeNC(z); i++ ){
+    r = _zLCPPGSRow( m, p, z, i );
+    zi = zVecElemNC(z,i);
+    res = zMax( res, fabs( zMin( zi, r ) ) );
+    zVecSetElemNC( z, i, zMax( 0, zi - pgs->omega * r / zMatElemNC(m,i,i) ) );
+  }
+  return res;
+}
+
+/* w = m z + p and the natural residual of an LCP. */
+static double _zLCPPGSResidual(const zMat m, const zVec p, zVec w, const zVec z)
+{
+  int i;
+  double r, res = 0;
+
+  for( i=0; i<zVecSizeNC(z); i++ ){
+    r = _zLCPPGSRow( m, p, z, i );
+    if( w ) zVecSetElemNC( w, i, r );
+    res = zMax( res, fabs( zMin( zVecElemNC(z,i), r ) ) );
+  }
+  return res;
+}
+
+/* solve LCP by projected Gauss-Seidel method. */
+bool zLCPPGSSolve(zLCPPGS *pgs, const zMat m, const zVec p, zVec w, zVec z)
+{
+  int iter_max;
+  double res;
+
+  if( !_zLCPPGSCheck( m, p, w, z ) ) return false;
+  iter_max = pgs->iter_max > 0 ? pgs->iter_max : Z_MAX_ITER_NUM;
+  for( pgs->iter_num=0; pgs->iter_num<iter_max; ){
+    res = _zLCPPGSSweep( pgs, m, p, z );
+    pgs->iter_num++;
+    if( pgs->tol > 0 && res <= pgs->tol &&
+        ( pgs->residual = _zLCPPGSResidual( m, p, w, z ) ) <= pgs->tol ) return true;
+  }
+  pgs->residual = _zLCPPGSResidual( m, p, w, z );
+  if( pgs->tol <= 0 ) return true;
+  ZITERWARN( iter_max );
+  return false;
+}
+
+/* projection of a contact force onto the friction cone with the coefficient mu. */
+static void _zLCPPGSProjCone(double mu, double *v)
+{
+  double t, n;
+
+  t = sqrt( zSqr(v[1]) + zSqr(v[2]) );
+  if( t <= mu * v[0] ) return; /* inside the cone */
+  if( mu * t <= -v[0] ){ /* inside the polar cone */
+    v[0] = v[1] = v[2] = 0;
+    return;
+  }
+  n = ( mu * t + v[0] ) / ( zSqr(mu) + 1 );
+  v[0] = n;
+  v[1] *= mu * n / t;
+  v[2] *= mu * n / t;
+}
+
+/* one sweep of the blocked projected Gauss-Seidel method, which returns the residual estimated on the way. */
+static double _zLCPPGSSweepFriction(zLCPPGS *pgs, const zMat m, const zVec p, const zVec mu, zVec z)
+{
+  int k, j, b;
+  double r[3], v[3], eta, res = 0;
+
+  for( k=0; k<zVecSizeNC(mu); k++ ){
+    b = 3 * k;
+    for( j=0; j<3; j++ ){
+      r[j] = _zLCPPGSRow( m, p, z, b+j );
+      v[j] = zVecElemNC(z,b+j) - r[j];
+    }
+    _zLCPPGSProjCone( zVecElemNC(mu,k), v );
+    for( j=0; j<3; j++ )
+      res = zMax( res, fabs( zVecElemNC(z,b+j) - v[j] ) );
+    eta = pgs->omega * 3.0 / ( zMatElemNC(m,b,b) + zMatElemNC(m,b+1,b+1) + zMatElemNC(m,b+2,b+2) );
+    for( j=0; j<3; j++ )
+      v[j] = zVecElemNC(z,b+j) - eta * r[j];
+    _zLCPPGSProjCone( zVecElemNC(mu,k), v );
+    for( j=0; j<3; j++ )
+      zVecSetElemNC( z, b+j, v[j] );
+  }
+  return res;
+}
+
+/* w = m z + p and the natural residual of a cone complementarity problem. */
+static double _zLCPPGSResidualFriction(const zMat m, const zVec p, const zVec mu, zVec w, const zVec z)
+{
+  int k, j, b;
+  double r[3], v[3], res = 0;
+
+  for( k=0; k<zVecSizeNC(mu); k++ ){
+    b = 3 * k;
+    for( j=0; j<3; j++ ){
+      r[j] = _zLCPPGSRow( m, p, z, b+j );
+      if( w ) zVecSetElemNC( w, b+j, r[j] );
+      v[j] = zVecElemNC(z,b+j) - r[j];
+    }
+    _zLCPPGSProjCone( zVecElemNC(mu,k), v );
+    for( j=0; j<3; j++ )
+      res = zMax( res, fabs( zVecElemNC(z,b+j) - v[j] ) );
+  }
+  return res;
+}
+
+/* solve a cone complementarity problem of contacts with friction by blocked projected Gauss-Seidel method. */
+bool zLCPPGSSolveFriction(zLCPPGS *pgs, const zMat m, const zVec p, const zVec mu, zVec w, zVec z)
+{
+  int iter_max;
+  double res;
+
+  if( !_zLCPPGSCheck( m, p, w, z ) ) return false;
+  if( zVecSizeNC(z) != 3 * zVecSizeNC(mu) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  if( zVecSizeNC(mu) > 0 && zVecElemMin( mu, NULL ) < 0 ){
+    ZRUNERROR( ZM_ERR_OPT_LCP_NEGATIVEFRICTION );
+    return false;
+  }
+  iter_max = pgs->iter_max > 0 ? pgs->iter_max : Z_MAX_ITER_NUM;
+  for( pgs->iter_num=0; pgs->iter_num<iter_max; ){
+    res = _zLCPPGSSweepFriction( pgs, m, p, mu, z );
+    pgs->iter_num++;
+    if( pgs->tol > 0 && res <= pgs->tol &&
+        ( pgs->residual = _zLCPPGSResidualFriction( m, p, mu, w, z ) ) <= pgs->tol ) return true;
+  }
+  pgs->residual = _zLCPPGSResidualFriction( m, p, mu, w, z );
+  if( pgs->tol <= 0 ) return true;
+  ZITERWARN( iter_max );
+  return false;
+}
+
+/* solve LCP by projected Gauss-Seidel method with the default parameters. */
+bool zLCPSolvePGS(const zMat m, const zVec p, zVec w, zVec z)
+{
+  zLCPPGS pgs;
+
+  zVecZero( z );
+  return zLCPPGSSolve( zLCPPGSInit( &pgs ), m, p, w, z );
+}
@@ -6,6 +6,7 @@
  */
 
 #include <zm/zm_opt.h>
+#include <zm/zm_data.h>
 
 /* common matrix-vector set for primal-dual interior-point method */
 typedef struct{
@@ -268,3 +269,473 @@ bool zLPSolvePDIP_PC(const zMat a, const zVec b, const zVec c, zVec x, double *c
   if( cost ) *cost = zVecInnerProd( x, c );
   return ret;
 }
+
+/* primal-dual interior-point method with normal equations */
+
+/* ratio of a step to the boundary of the positive orthant */
+#define ZLP_PDIP_STEP_RATIO    ( 0.99 )
+/* regularization of the normal matrix relative to each diagonal component */
+#define ZLP_PDIP_REGULAR       ( 1.0e-14 )
+/* number of trials of factorization with enlarged regularization */
+#define ZLP_PDIP_REGULAR_TRIAL 6
+/* duality gap per variable relative to the cost of an iterate kept for a warm start */
+#define ZLP_PDIP_WARM_GAP      ( 1.0e-2 )
+/* magnitude of iterates regarded as divergent relative to the scale of the problem; the iteration
+ * also stops when the duality gap vanishes before the residuals converge */
+#define ZLP_PDIP_DIVERGE       ( 1.0e12 )
+/* duality gap per variable relative to the cost of a nearly optimal iterate, from which a crossover to
+ * a basic solution is tried, and which is kept for a fallback in case of a numerical breakdown */
+#define ZLP_PDIP_NEAR_GAP      ( 1.0e-4 )
+/* maximum number of iterative refinements of a basic solution at the crossover */
+#define ZLP_PDIP_REFINE_MAX    32
+
+/* sparsity pattern of the normal matrix and positions of products of columns of the constraint matrix. */
+static bool _zLPPDIPPattern(zLPPDIP *lp)
+{
+  zSpTriplet t;
+  int m, i, j, k, p, r, npair = 0;
+  int *ind, lo, hi, mid;
+
+  m = zSpMatRowSize(lp->a);
+  for( j=0; j<zSpMatColSize(lp->a); j++ ){
+    k = lp->a->ptr[j+1] - lp->a->ptr[j];
+    npair += k * ( k + 1 ) / 2;
+  }
+  if( !zSpTripletAlloc( &t, npair + m ) ) return false;
+  for( i=0; i<m; i++ ) zSpTripletAdd( &t, i, i, 1 );
+  for( j=0; j<zSpMatColSize(lp->a); j++ )
+    for( p=lp->a->ptr[j]; p<lp->a->ptr[j+1]; p++ )
+      for( r=p; r<lp->a->ptr[j+1]; r++ )
+        zSpTripletAdd( &t, lp->a->ind[p], lp->a->ind[r], 1 );
+  lp->_m = zSpMatFromTriplet( &t, m, m, ZM_SPMAT_CSC );
+  zSpTripletFree( &t );
+  lp->_map = zAlloc( int, zMax( npair, 1 ) );
+  lp->_diag = zAlloc( int, zMax( m, 1 ) );
+  if( !lp->_m || !lp->_map || !lp->_diag ) return false;
+  /* positions of components found by bisection on rows of each column */
+  for( k=0, j=0; j<zSpMatColSize(lp->a); j++ )
+    for( p=lp->a->ptr[j]; p<lp->a->ptr[j+1]; p++ )
+      for( r=p; r<lp->a->ptr[j+1]; r++ ){
+        ind = lp->_m->ind;
+        lo = lp->_m->ptr[lp->a->ind[r]];
+        hi = lp->_m->ptr[lp->a->ind[r]+1] - 1;
+        while( lo < hi ){
+          mid = ( lo + hi ) / 2;
+          if( ind[mid] < lp->a->ind[p] ) lo = mid + 1; else hi = mid;
+        }
+        lp->_map[k++] = lo;
+      }
+  for( i=0; i<m; i++ )
+    for( p=lp->_m->ptr[i]; p<lp->_m->ptr[i+1]; p++ )
+      if( lp->_m->ind[p] == i ) lp->_diag[i] = p;
+  return zSpCholeskyAnalyze( &lp->_chol, lp->_m );
+}
+
+/* create a primal-dual interior-point solver on an arena. */
+zLPPDIP *zLPPDIPCreateArena(zLPPDIP *lp, const zSpMat a, const zVec b, const zVec c, zArena *arena)
+{
+  int m, n;
+
+  m = zSpMatRowSize(a);
+  n = zSpMatColSize(a);
+  if( zVecSizeNC(b) != m ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  if( zVecSizeNC(c) != n ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return NULL;
+  }
+  lp->tol = ZLP_PDIP_TOL;
+  lp->iter_max = 0;
+  lp->iter_num = 0;
+  lp->q = NULL;
+  lp->_m = NULL;
+  lp->_map = lp->_diag = NULL;
+  lp->_warm = false;
+  lp->_arena = arena;
+  zSpCholeskyInit( &lp->_chol );
+  lp->a = zSpMatConvert( a, ZM_SPMAT_CSC );
+  lp->b = zArenaVecAlloc( arena, m );
+  lp->c = zArenaVecAlloc( arena, n );
+  lp->x = zArenaVecAlloc( arena, n );
+  lp->y = zArenaVecAlloc( arena, m );
+  lp->z = zArenaVecAlloc( arena, n );
+  lp->_d = zArenaVecAlloc( arena, n );
+  lp->_rd = zArenaVecAlloc( arena, n );
+  lp->_rc = zArenaVecAlloc( arena, n );
+  lp->_dx = zArenaVecAlloc( arena, n );
+  lp->_dz = zArenaVecAlloc( arena, n );
+  lp->_v = zArenaVecAlloc( arena, n );
+  lp->_rp = zArenaVecAlloc( arena, m );
+  lp->_dy = zArenaVecAlloc( arena, m );
+  lp->_w = zArenaVecAlloc( arena, m );
+  lp->_wx = zArenaVecAlloc( arena, n );
+  lp->_wy = zArenaVecAlloc( arena, m );
+  lp->_wz = zArenaVecAlloc( arena, n );
+  if( !lp->a || !lp->b || !lp->c || !lp->x || !lp->y || !lp->z ||
+      !lp->_d || !lp->_rd || !lp->_rc || !lp->_dx || !lp->_dz || !lp->_v ||
+      !lp->_rp || !lp->_dy || !lp->_w || !lp->_wx || !lp->_wy || !lp->_wz || !_zLPPDIPPattern( lp ) ){
+    ZALLOCERROR();
+    zLPPDIPDestroy( lp );
+    return NULL;
+  }
+  zVecCopyNC( b, lp->b );
+  zVecCopyNC( c, lp->c );
+  return lp;
+}
+
+/* create a primal-dual interior-point solver. */
+zLPPDIP *zLPPDIPCreate(zLPPDIP *lp, const zSpMat a, const zVec b, const zVec c)
+{
+  return zLPPDIPCreateArena( lp, a, b, c, NULL );
+}
+
+/* destroy a primal-dual interior-point solver. */
+void zLPPDIPDestroy(zLPPDIP *lp)
+{
+  zSpMatFree( lp->a );
+  zSpMatFree( lp->_m );
+  zFree( lp->_map );
+  zFree( lp->_diag );
+  zSpCholeskyFree( &lp->_chol );
+  if( !lp->_arena ){
+    zVecFreeAtOnce( 6, lp->b, lp->c, lp->q, lp->x, lp->y, lp->z );
+    zVecFreeAtOnce( 9, lp->_d, lp->_rd, lp->_rc, lp->_dx, lp->_dz, lp->_v, lp->_rp, lp->_dy, lp->_w );
+    zVecFreeAtOnce( 3, lp->_wx, lp->_wy, lp->_wz );
+  }
+  lp->a = lp->_m = NULL;
+  lp->b = lp->c = lp->q = lp->x = lp->y = lp->z = NULL;
+  lp->_d = lp->_rd = lp->_rc = lp->_dx = lp->_dz = lp->_v = lp->_rp = lp->_dy = lp->_w = NULL;
+  lp->_wx = lp->_wy = lp->_wz = NULL;
+}
+
+/* replace the cost vector. */
+bool zLPPDIPSetCost(zLPPDIP *lp, const zVec c)
+{
+  if( !zVecSizeEqual( c, lp->c ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  zVecCopyNC( c, lp->c );
+  return true;
+}
+
+/* replace the constraint vector. */
+bool zLPPDIPSetRHS(zLPPDIP *lp, const zVec b)
+{
+  if( !zVecSizeEqual( b, lp->b ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  zVecCopyNC( b, lp->b );
+  return true;
+}
+
+/* set the diagonal of the quadratic cost. */
+bool zLPPDIPSetQuad(zLPPDIP *lp, const zVec q)
+{
+  if( !q ){
+    zArenaVecFree( lp->_arena, lp->q );
+    lp->q = NULL;
+    return true;
+  }
+  if( !zVecSizeEqual( q, lp->c ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  if( zVecElemMin( q, NULL ) < 0 ){
+    ZRUNERROR( ZM_ERR_OPT_LP_NEGATIVEQUAD );
+    return false;
+  }
+  if( !lp->q && !( lp->q = zArenaVecAlloc( lp->_arena, zVecSizeNC(q) ) ) ) return false;
+  zVecCopyNC( q, lp->q );
+  return true;
+}
+
+/* factorize the normal matrix A D A^T for the diagonal D given by _d. */
+static bool _zLPPDIPFactorizeD(zLPPDIP *lp)
+{
+  double dj, reg;
+  int i, j, k, p, r, trial;
+
+  for( p=0; p<lp->_m->nnz; p++ ) lp->_m->val[p] = 0;
+  for( k=0, j=0; j<zSpMatColSize(lp->a); j++ ){
+    dj = zVecElemNC(lp->_d,j);
+    for( p=lp->a->ptr[j]; p<lp->a->ptr[j+1]; p++ )
+      for( r=p; r<lp->a->ptr[j+1]; r++ )
+        lp->_m->val[lp->_map[k++]] += lp->a->val[p] * lp->a->val[r] * dj;
+  }
+  for( i=0; i<zSpMatRowSize(lp->a); i++ )
+    zVecSetElemNC( lp->_w, i, lp->_m->val[lp->_diag[i]] );
+  for( reg=ZLP_PDIP_REGULAR, trial=0; trial<ZLP_PDIP_REGULAR_TRIAL; trial++, reg*=100 ){
+    for( i=0; i<zSpMatRowSize(lp->a); i++ )
+      lp->_m->val[lp->_diag[i]] = zVecElemNC(lp->_w,i) * ( 1 + reg ) + reg;
+    if( zSpCholeskyFactorize( &lp->_chol, lp->_m ) ) return true;
+  }
+  return false;
+}
+
+/* factorize the normal matrix A D A^T for the current point. */
+static bool _zLPPDIPFactorize(zLPPDIP *lp)
+{
+  int j;
+
+  for( j=0; j<zVecSizeNC(lp->x); j++ )
+    zVecSetElemNC( lp->_d, j, 1.0 / ( zVecElemNC(lp->z,j) / zVecElemNC(lp->x,j) + ( lp->q ? zVecElemNC(lp->q,j) : 0 ) ) );
+  return _zLPPDIPFactorizeD( lp );
+}
+
+/* solve the Newton system for the complementarity residual _rc by the normal equation. */
+static void _zLPPDIPNewton(zLPPDIP *lp)
+{
+  int j;
+
+  for( j=0; j<zVecSizeNC(lp->x); j++ ) /* v = X^-1 rc - rd */
+    zVecSetElemNC( lp->_v, j, zVecElemNC(lp->_rc,j) / zVecElemNC(lp->x,j) - zVecElemNC(lp->_rd,j) );
+  zVecAmpNC( lp->_d, lp->_v, lp->_dx );
+  zSpMatMulVecNC( lp->a, lp->_dx, lp->_w );
+  zVecSubNC( lp->_rp, lp->_w, lp->_w );
+  zSpCholeskySolve( &lp->_chol, lp->_w, lp->_dy );
+  /* an iterative refinement against A D A^T, which also cancels the regularization */
+  zSpMatTMulVecNC( lp->a, lp->_dy, lp->_dx );
+  zVecAddNCDRC( lp->_dx, lp->_v );
+  zVecAmpNCDRC( lp->_dx, lp->_d );
+  zSpMatMulVecNC( lp->a, lp->_dx, lp->_w );
+  zVecSubNC( lp->_rp, lp->_w, lp->_w );
+  zSpCholeskySolve( &lp->_chol, lp->_w, lp->_w );
+  zVecAddNCDRC( lp->_dy, lp->_w );
+  zSpMatTMulVecNC( lp->a, lp->_dy, lp->_dx );
+  zVecAddNCDRC( lp->_dx, lp->_v );
+  zVecAmpNCDRC( lp->_dx, lp->_d );
+  for( j=0; j<zVecSizeNC(lp->x); j++ ) /* dz = X^-1 ( rc - Z dx ) */
+    zVecSetElemNC( lp->_dz, j, ( zVecElemNC(lp->_rc,j) - zVecElemNC(lp->z,j) * zVecElemNC(lp->_dx,j) ) / zVecElemNC(lp->x,j) );
+}
+
+/* maximum step length up to one within the positive orthant. */
+static double _zLPPDIPStep(const zVec x, const zVec dx)
+{
+  double alpha = 1, d;
+  int j;
+
+  for( j=0; j<zVecSizeNC(x); j++ )
+    if( ( d = zVecElemNC(dx,j) ) < 0 && -zVecElemNC(x,j) > alpha * d )
+      alpha = -zVecElemNC(x,j) / d;
+  return alpha;
+}
+
+/* crossover from the current point to a basic solution of a linear programming problem.
+ * The columns with the largest ratios of the variables to the dual slack variables are chosen for a basis
+ * B. The current x_B and y are projected onto A_B x_B = b and A_B^T y = c_B, respectively, by the normal
+ * equation with D = diag(1 on B). The basic solution is accepted only if it is primal and dual feasible,
+ * namely, it is certified to be optimal, which removes the error of the interior point amplified by an
+ * ill-conditioned basis. */
+static bool _zLPPDIPCrossover(zLPPDIP *lp, zVec ans, double scale_b, double scale_c)
+{
+  double th, res, res_prev;
+  int m, n, j, k;
+
+  m = zSpMatRowSize(lp->a);
+  n = zSpMatColSize(lp->a);
+  if( m == 0 || m > n ) return false;
+  for( j=0; j<n; j++ )
+    zVecSetElemNC( lp->_v, j, zVecElemNC(lp->x,j) / zVecElemNC(lp->z,j) );
+  th = zDataSelect( zVecBufNC(lp->_v), n, n - m );
+  for( j=0; j<n; j++ )
+    if( zVecElemNC(lp->_v,j) >= th ){
+      zVecSetElemNC( lp->_d, j, 1 );
+      zVecSetElemNC( lp->_dx, j, zVecElemNC(lp->x,j) );
+    } else{
+      zVecSetElemNC( lp->_d, j, 0 );
+      zVecSetElemNC( lp->_dx, j, 0 );
+    }
+  if( !_zLPPDIPFactorizeD( lp ) ) return false;
+  /* x_B projected onto A_B x_B = b, iteratively refined while the residual decreases */
+  for( res_prev=HUGE_VAL, k=0; k<ZLP_PDIP_REFINE_MAX; k++, res_prev=res ){
+    zSpMatMulVecNC( lp->a, lp->_dx, lp->_w );
+    zVecSubNC( lp->b, lp->_w, lp->_w );
+    if( ( res = zVecElemAbsMax( lp->_w, NULL ) ) >= res_prev ) break;
+    zSpCholeskySolve( &lp->_chol, lp->_w, lp->_w );
+    zSpMatTMulVecNC( lp->a, lp->_w, lp->_v );
+    zVecAmpNCDRC( lp->_v, lp->_d );
+    zVecAddNCDRC( lp->_dx, lp->_v );
+  }
+  /* y projected onto A_B^T y = c_B, refined as well */
+  zVecCopyNC( lp->y, lp->_dy );
+  for( res_prev=HUGE_VAL, k=0; k<ZLP_PDIP_REFINE_MAX; k++, res_prev=res ){
+    zSpMatTMulVecNC( lp->a, lp->_dy, lp->_v );
+    zVecSubNC( lp->c, lp->_v, lp->_v );
+    zVecAmpNCDRC( lp->_v, lp->_d );
+    if( ( res = zVecElemAbsMax( lp->_v, NULL ) ) >= res_prev ) break;
+    zSpMatMulVecNC( lp->a, lp->_v, lp->_w );
+    zSpCholeskySolve( &lp->_chol, lp->_w, lp->_w );
+    zVecAddNCDRC( lp->_dy, lp->_w );
+  }
+  zSpMatTMulVecNC( lp->a, lp->_dy, lp->_dz );
+  zVecSubNC( lp->c, lp->_dz, lp->_dz ); /* z = c - A^T y */
+  for( j=0; j<n; j++ ){
+    if( zVecElemNC(lp->_dx,j) < -lp->tol * scale_b || zVecElemNC(lp->_dz,j) < -lp->tol * scale_c ) return false;
+    if( zVecElemNC(lp->_d,j) > 0 && zVecElemNC(lp->_dz,j) > lp->tol * scale_c ) return false;
+  }
+  zSpMatMulVecNC( lp->a, lp->_dx, lp->_w );
+  zVecSubNCDRC( lp->_w, lp->b );
+  if( zVecElemAbsMax( lp->_w, NULL ) > lp->tol * scale_b ) return false;
+  for( j=0; j<n; j++ )
+    zVecSetElemNC( ans, j, zMax( zVecElemNC(lp->_dx,j), 0 ) );
+  return true;
+}
+
+/* residuals of the primal and dual feasibility. */
+static void _zLPPDIPResidual(zLPPDIP *lp)
+{
+  zSpMatMulVecNC( lp->a, lp->x, lp->_rp );
+  zVecSubNC( lp->b, lp->_rp, lp->_rp );   /* rp = b - A x */
+  zSpMatTMulVecNC( lp->a, lp->y, lp->_rd );
+  zVecSubNC( lp->c, lp->_rd, lp->_rd );
+  zVecSubNCDRC( lp->_rd, lp->z );         /* rd = c + Q x - A^T y - z */
+  if( lp->q ){
+    zVecAmpNC( lp->q, lp->x, lp->_v );
+    zVecAddNCDRC( lp->_rd, lp->_v );
+  }
+}
+
+/* initial point by least-square solutions shifted into the interior (1992 S. Mehrotra). */
+static bool _zLPPDIPColdStart(zLPPDIP *lp)
+{
+  double dx, dz, xz;
+  int j;
+
+  zVecSetAll( lp->x, 1.0 );
+  zVecSetAll( lp->z, 1.0 );
+  if( !_zLPPDIPFactorize( lp ) ) return false;
+  /* x = A^T ( A A^T )^-1 b */
+  zSpCholeskySolve( &lp->_chol, lp->b, lp->_w );
+  zSpMatTMulVecNC( lp->a, lp->_w, lp->x );
+  /* y = ( A A^T )^-1 A c, z = c - A^T y */
+  zSpMatMulVecNC( lp->a, lp->c, lp->_w );
+  zSpCholeskySolve( &lp->_chol, lp->_w, lp->y );
+  zSpMatTMulVecNC( lp->a, lp->y, lp->z );
+  zVecSubNC( lp->c, lp->z, lp->z );
+  dx = zMax( -1.5 * zVecElemMin( lp->x, NULL ), 0 );
+  dz = zMax( -1.5 * zVecElemMin( lp->z, NULL ), 0 );
+  zVecShiftDRC( lp->x, dx );
+  zVecShiftDRC( lp->z, dz );
+  xz = zVecInnerProd( lp->x, lp->z );
+  dx = 0.5 * xz / zMax( zVecElemSum( lp->z ), zTOL );
+  dz = 0.5 * xz / zMax( zVecElemSum( lp->x ), zTOL );
+  for( j=0; j<zVecSizeNC(lp->x); j++ ){
+    zVecElemNC(lp->x,j) = zMax( zVecElemNC(lp->x,j) + dx, zTOL );
+    zVecElemNC(lp->z,j) = zMax( zVecElemNC(lp->z,j) + dz, zTOL );
+  }
+  return true;
+}
+
+/* solve a problem by primal-dual interior-point method with normal equations. */
+bool zLPPDIPSolve(zLPPDIP *lp, zVec ans, double *cost)
+{
+  double mu, mu_aff, sigma, ap, ad, scale_b, scale_c, scale, gap;
+  int n, j, iter;
+  bool fallback = false;
+
+  if( zVecSizeNC(ans) != ( n = zSpMatColSize(lp->a) ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  lp->iter_num = 0;
+  if( lp->_warm ){
+    zVecCopyNC( lp->_wx, lp->x );
+    zVecCopyNC( lp->_wy, lp->y );
+    zVecCopyNC( lp->_wz, lp->z );
+  } else
+  if( !_zLPPDIPColdStart( lp ) ) goto FAILURE;
+  lp->_warm = false;
+  scale_b = 1 + zVecElemAbsMax( lp->b, NULL );
+  scale_c = 1 + zVecElemAbsMax( lp->c, NULL );
+  scale = ZLP_PDIP_DIVERGE * scale_b * scale_c;
+  iter = lp->iter_max;
+  ZITERINIT( iter );
+  for( ; lp->iter_num<iter; lp->iter_num++ ){
+    _zLPPDIPResidual( lp );
+    mu = zVecInnerProd( lp->x, lp->z ) / zMax( n, 1 );
+    gap = mu / ( 1 + fabs( zVecInnerProd( lp->c, lp->x ) ) / zMax( n, 1 ) );
+    if( zVecElemAbsMax( lp->_rp, NULL ) <= lp->tol * scale_b &&
+        zVecElemAbsMax( lp->_rd, NULL ) <= lp->tol * scale_c && gap <= ZLP_PDIP_NEAR_GAP ){
+      /* a certified basic solution, or the interior point with a small absolute gap */
+      if( !lp->q && _zLPPDIPCrossover( lp, ans, scale_b, scale_c ) ) goto COST;
+      if( gap <= lp->tol && ( lp->q || mu <= lp->tol ) ) goto TERMINATE;
+      zVecCopyNC( lp->x, ans );
+      fallback = true;
+    }
+    if( gap >= ZLP_PDIP_WARM_GAP || !lp->_warm ){
+      zVecCopyNC( lp->x, lp->_wx );
+      zVecCopyNC( lp->y, lp->_wy );
+      zVecCopyNC( lp->z, lp->_wz );
+      lp->_warm = true;
+    }
+    if( zVecElemAbsMax( lp->x, NULL ) > scale || zVecElemAbsMax( lp->z, NULL ) > scale || gap < zSqr(lp->tol) ){
+      if( !lp->q && _zLPPDIPCrossover( lp, ans, scale_b, scale_c ) ) goto COST;
+      if( fallback ) goto COST;
+      ZRUNWARN( ZM_ERR_OPT_UNSOLVABLE );
+      goto FAILURE;
+    }
+    if( !_zLPPDIPFactorize( lp ) ){
+      if( fallback ) goto COST;
+      goto FAILURE;
+    }
+    /* predictor */
+    zVecAmpNC( lp->x, lp->z, lp->_rc );
+    zVecRevNCDRC( lp->_rc );
+    _zLPPDIPNewton( lp );
+    ap = _zLPPDIPStep( lp->x, lp->_dx );
+    ad = _zLPPDIPStep( lp->z, lp->_dz );
+    for( mu_aff=0, j=0; j<n; j++ )
+      mu_aff += ( zVecElemNC(lp->x,j) + ap*zVecElemNC(lp->_dx,j) ) * ( zVecElemNC(lp->z,j) + ad*zVecElemNC(lp->_dz,j) );
+    sigma = zCube( mu_aff / n / mu );
+    /* corrector */
+    for( j=0; j<n; j++ )
+      zVecSetElemNC( lp->_rc, j, sigma*mu - zVecElemNC(lp->x,j)*zVecElemNC(lp->z,j) - zVecElemNC(lp->_dx,j)*zVecElemNC(lp->_dz,j) );
+    _zLPPDIPNewton( lp );
+    ap = ZLP_PDIP_STEP_RATIO * _zLPPDIPStep( lp->x, lp->_dx );
+    ad = ZLP_PDIP_STEP_RATIO * _zLPPDIPStep( lp->z, lp->_dz );
+    if( lp->q ) ap = ad = zMin( ap, ad );
+    zVecCatNCDRC( lp->x, ap, lp->_dx );
+    zVecCatNCDRC( lp->y, ad, lp->_dy );
+    zVecCatNCDRC( lp->z, ad, lp->_dz );
+  }
+  if( !lp->q && _zLPPDIPCrossover( lp, ans, scale_b, scale_c ) ) goto COST;
+  if( fallback ) goto COST;
+  ZITERWARN( iter );
+ FAILURE:
+  lp->_warm = false;
+  return false;
+
+ TERMINATE:
+  zVecCopyNC( lp->x, ans );
+ COST:
+  if( cost ){
+    *cost = zVecInnerProd( lp->c, ans );
+    if( lp->q )
+      for( j=0; j<n; j++ ) *cost += 0.5 * zVecElemNC(lp->q,j) * zSqr( zVecElemNC(ans,j) );
+  }
+  return true;
+}
+
+/* linear programming solver with the primal-dual interior-point method for a dense constraint matrix. */
+bool zLPSolvePDIP_Cholesky(const zMat a, const zVec b, const zVec c, zVec x, double *cost)
+{
+  zSpMat sa;
+  zLPPDIP lp;
+  bool ret = false;
+
+  if( !zMatColVecSizeEqual(a,x) || !zMatRowVecSizeEqual(a,b) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  if( !( sa = zSpMatFromMat( a, 0, ZM_SPMAT_CSC ) ) ) return false;
+  if( zLPPDIPCreate( &lp, sa, b, c ) ){
+    ret = zLPPDIPSolve( &lp, x, cost );
+    zLPPDIPDestroy( &lp );
+  }
+  zSpMatFree( sa );
+  return ret;
+}
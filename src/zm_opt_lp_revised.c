@@ -0,0 +1,730 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_opt_lp_revised - optimization tools:
+ * linear programming by revised simplex method.
+ */
+
+#include <zm/zm_opt.h>
+
+/* tolerance of optimality and feasibility */
+#define ZLP_REVISED_TOL        ( 1.0e-9 )
+/* minimum absolute value of a pivot */
+#define ZLP_REVISED_PIVOT_TOL  ( 1.0e-7 )
+/* relative magnitude of a pivot in the factorization regarded as zero */
+#define ZLP_REVISED_SINGULAR_TOL ( 1.0e-11 )
+/* relative threshold of the partial pivoting in the factorization */
+#define ZLP_REVISED_THRESHOLD  ( 0.1 )
+/* default maximum number of iterations per the number of variables */
+#define ZLP_REVISED_ITER_RATIO 10
+/* number of successive degenerate pivots before Bland's rule is applied */
+#define ZLP_REVISED_DEGENERATE 50
+/* maximum Devex weight, beyond which the reference framework is reset */
+#define ZLP_REVISED_DEVEX_MAX  ( 1.0e6 )
+
+/* sparse LU factorization of a basis with product-form updates.
+ * The basis with columns reordered by q is factorized as B = L U, where the k-th pivot is on the
+ * original row prow[k]. The k-th column of L holds the multipliers on the original rows pivoted
+ * after k, and the k-th column of U holds the components on the pivots before k, and udiag[k]. */
+struct _zLPRevisedFactor{
+  int m;
+  int *prow, *pinv, *q;
+  int *lptr, *lind, lcap;
+  double *lval;
+  int *uptr, *uind, ucap;
+  double *uval, *udiag;
+  /* eta file of the product form */
+  int eta_num, eta_max, *eta_p, *eta_ptr, *eta_ind, eta_cap;
+  double *eta_val, *eta_piv;
+  /* workspace */
+  double *x, *w;
+  int *list, *mark, *heap, *order, *count, *rowcount;
+};
+
+/* enlarge index and value arrays of a factor. */
+static bool _zLPRevisedReserve(int **ind, double **val, int *cap, int size)
+{
+  int *ind_new;
+  double *val_new;
+
+  if( size <= *cap ) return true;
+  size = zMax( size, 2*(*cap) );
+  if( !( ind_new = zRealloc( *ind, int, size ) ) ) return false;
+  *ind = ind_new;
+  if( !( val_new = zRealloc( *val, double, size ) ) ) return false;
+  *val = val_new;
+  *cap = size;
+  return true;
+}
+
+/* free a factorization. */
+static void _zLPRevisedFactorFree(struct _zLPRevisedFactor *lu)
+{
+  if( !lu ) return;
+  free( lu->prow ); free( lu->pinv ); free( lu->q );
+  free( lu->lptr ); free( lu->lind ); free( lu->lval );
+  free( lu->uptr ); free( lu->uind ); free( lu->uval ); free( lu->udiag );
+  free( lu->eta_p ); free( lu->eta_ptr ); free( lu->eta_ind ); free( lu->eta_val ); free( lu->eta_piv );
+  free( lu->x ); free( lu->w );
+  free( lu->list ); free( lu->mark ); free( lu->heap ); free( lu->order ); free( lu->count ); free( lu->rowcount );
+  free( lu );
+}
+
+/* allocate a factorization. */
+static struct _zLPRevisedFactor *_zLPRevisedFactorAlloc(int m, int refactor)
+{
+  struct _zLPRevisedFactor *lu;
+
+  if( !( lu = zAlloc( struct _zLPRevisedFactor, 1 ) ) ) return NULL;
+  lu->m = m;
+  lu->eta_max = refactor;
+  lu->lcap = lu->ucap = lu->eta_cap = 4*m;
+  lu->prow = zAlloc( int, m ); lu->pinv = zAlloc( int, m ); lu->q = zAlloc( int, m );
+  lu->lptr = zAlloc( int, m+1 ); lu->lind = zAlloc( int, lu->lcap ); lu->lval = zAlloc( double, lu->lcap );
+  lu->uptr = zAlloc( int, m+1 ); lu->uind = zAlloc( int, lu->ucap ); lu->uval = zAlloc( double, lu->ucap );
+  lu->udiag = zAlloc( double, m );
+  lu->eta_p = zAlloc( int, refactor ); lu->eta_ptr = zAlloc( int, refactor+1 );
+  lu->eta_ind = zAlloc( int, lu->eta_cap ); lu->eta_val = zAlloc( double, lu->eta_cap );
+  lu->eta_piv = zAlloc( double, refactor );
+  lu->x = zAlloc( double, m ); lu->w = zAlloc( double, m );
+  lu->list = zAlloc( int, m ); lu->mark = zAlloc( int, m ); lu->heap = zAlloc( int, m );
+  lu->order = zAlloc( int, m ); lu->count = zAlloc( int, m+1 ); lu->rowcount = zAlloc( int, m );
+  if( !lu->prow || !lu->pinv || !lu->q || !lu->lptr || !lu->lind || !lu->lval ||
+      !lu->uptr || !lu->uind || !lu->uval || !lu->udiag ||
+      !lu->eta_p || !lu->eta_ptr || !lu->eta_ind || !lu->eta_val || !lu->eta_piv ||
+      !lu->x || !lu->w || !lu->list || !lu->mark || !lu->heap || !lu->order || !lu->count || !lu->rowcount ){
+    _zLPRevisedFactorFree( lu );
+    return NULL;
+  }
+  return lu;
+}
+
+/* push a pivot position to a binary min-heap. */
+static void _zLPRevisedHeapPush(int *heap, int *size, int k)
+{
+  int i, parent;
+
+  for( i=(*size)++; i>0 && heap[parent=(i-1)/2]>k; i=parent )
+    heap[i] = heap[parent];
+  heap[i] = k;
+}
+
+/* pop the minimum pivot position from a binary min-heap. */
+static int _zLPRevisedHeapPop(int *heap, int *size)
+{
+  int top, last, i, child;
+
+  top = heap[0];
+  last = heap[--(*size)];
+  for( i=0; ( child = 2*i+1 ) < *size; i=child ){
+    if( child+1 < *size && heap[child+1] < heap[child] ) child++;
+    if( heap[child] >= last ) break;
+    heap[i] = heap[child];
+  }
+  heap[i] = last;
+  return top;
+}
+
+/* components of a column of the constraint matrix or an artificial variable. */
+static int _zLPRevisedColumn(const zLPRevised *lp, int j, const int **ind, const double **val)
+{
+  int n;
+
+  if( j < ( n = zSpMatColSize(lp->a) ) ){
+    *ind = lp->a->ind + lp->a->ptr[j];
+    *val = lp->a->val + lp->a->ptr[j];
+    return lp->a->ptr[j+1] - lp->a->ptr[j];
+  }
+  *ind = &lp->_iota[j-n];
+  *val = &lp->_sign[j-n];
+  return 1;
+}
+
+/* inner product of a column and a vector on rows. */
+static double _zLPRevisedColumnDot(const zLPRevised *lp, int j, const double *y)
+{
+  const int *ind;
+  const double *val;
+  double s = 0;
+  int k, nnz;
+
+  nnz = _zLPRevisedColumn( lp, j, &ind, &val );
+  for( k=0; k<nnz; k++ ) s += val[k] * y[ind[k]];
+  return s;
+}
+
+/* LU factorization of the current basis. Slots of columns found to be linearly dependent are
+ * replaced by artificial variables. It returns the false value if it fails to allocate memory or
+ * to repair the basis. */
+static bool _zLPRevisedFactorize(zLPRevised *lp)
+{
+  struct _zLPRevisedFactor *lu;
+  const int *ind;
+  const double *val;
+  double v, amax, cmax;
+  int m, n, jj, s, k, kk, r, i, p, nnz, nl, nh, nu, nsing;
+
+  lu = lp->_lu;
+  m = lu->m;
+  n = zSpMatColSize(lp->a);
+  lu->eta_num = 0;
+  lu->eta_ptr[0] = 0;
+  /* order slots in ascending number of nonzero components, and count components of rows */
+  for( i=0; i<=m; i++ ) lu->count[i] = 0;
+  for( i=0; i<m; i++ ) lu->rowcount[i] = 0;
+  for( s=0; s<m; s++ ){
+    nnz = _zLPRevisedColumn( lp, lp->_basis[s], &ind, &val );
+    lu->count[zMin(nnz,m)]++;
+    for( k=0; k<nnz; k++ ) lu->rowcount[ind[k]]++;
+  }
+  for( p=0, i=0; i<=m; i++ ){
+    nnz = lu->count[i];
+    lu->count[i] = p;
+    p += nnz;
+  }
+  for( s=0; s<m; s++ ){
+    nnz = _zLPRevisedColumn( lp, lp->_basis[s], &ind, &val );
+    lu->order[lu->count[zMin(nnz,m)]++] = s;
+  }
+  for( i=0; i<m; i++ ){
+    lu->pinv[i] = -1;
+    lu->mark[i] = 0;
+    lu->x[i] = 0;
+  }
+  lu->lptr[0] = lu->uptr[0] = 0;
+  for( nsing=0, k=0, jj=0; jj<m; jj++ ){
+    s = lu->order[jj];
+    nnz = _zLPRevisedColumn( lp, lp->_basis[s], &ind, &val );
+    /* scatter the column */
+    for( cmax=0, nl=nh=0, p=0; p<nnz; p++ ){
+      r = ind[p];
+      cmax = zMax( cmax, fabs( val[p] ) );
+      lu->x[r] += val[p];
+      lu->mark[r] = 1;
+      if( lu->pinv[r] >= 0 )
+        _zLPRevisedHeapPush( lu->heap, &nh, lu->pinv[r] );
+      else
+        lu->list[nl++] = r;
+    }
+    /* eliminate components on pivoted rows in the order of pivots */
+    nu = lu->uptr[k];
+    while( nh > 0 ){
+      kk = _zLPRevisedHeapPop( lu->heap, &nh );
+      r = lu->prow[kk];
+      v = lu->x[r];
+      lu->x[r] = 0;
+      lu->mark[r] = 0;
+      if( v == 0 ) continue;
+      if( !_zLPRevisedReserve( &lu->uind, &lu->uval, &lu->ucap, nu+1 ) ) return false;
+      lu->uind[nu] = kk;
+      lu->uval[nu++] = v;
+      for( p=lu->lptr[kk]; p<lu->lptr[kk+1]; p++ ){
+        i = lu->lind[p];
+        if( !lu->mark[i] ){
+          lu->mark[i] = 1;
+          if( lu->pinv[i] >= 0 )
+            _zLPRevisedHeapPush( lu->heap, &nh, lu->pinv[i] );
+          else
+            lu->list[nl++] = i;
+        }
+        lu->x[i] -= lu->lval[p] * v;
+      }
+    }
+    /* threshold partial pivoting preferring sparse rows */
+    for( amax=0, p=0; p<nl; p++ )
+      if( fabs( lu->x[lu->list[p]] ) > amax ) amax = fabs( lu->x[lu->list[p]] );
+    if( amax <= ZLP_REVISED_SINGULAR_TOL * cmax ){ /* linearly dependent column */
+      for( p=0; p<nl; p++ ){
+        lu->x[lu->list[p]] = 0;
+        lu->mark[lu->list[p]] = 0;
+      }
+      lu->order[nsing++] = s; /* slots in order[0..jj] are no longer referred */
+      continue;
+    }
+    for( r=-1, p=0; p<nl; p++ ){
+      i = lu->list[p];
+      if( fabs( lu->x[i] ) < ZLP_REVISED_THRESHOLD * amax ) continue;
+      if( r < 0 || lu->rowcount[i] < lu->rowcount[r] ||
+          ( lu->rowcount[i] == lu->rowcount[r] && fabs( lu->x[i] ) > fabs( lu->x[r] ) ) ) r = i;
+    }
+    lu->udiag[k] = lu->x[r];
+    lu->prow[k] = r;
+    lu->pinv[r] = k;
+    lu->q[k] = s;
+    lu->uptr[k+1] = nu;
+    if( !_zLPRevisedReserve( &lu->lind, &lu->lval, &lu->lcap, lu->lptr[k]+nl ) ) return false;
+    for( lu->lptr[k+1]=lu->lptr[k], p=0; p<nl; p++ ){
+      i = lu->list[p];
+      if( i != r && lu->x[i] != 0 ){
+        lu->lind[lu->lptr[k+1]] = i;
+        lu->lval[lu->lptr[k+1]++] = lu->x[i] / lu->udiag[k];
+      }
+      lu->x[i] = 0;
+      lu->mark[i] = 0;
+    }
+    k++;
+  }
+  /* replace linearly dependent columns with artificial variables of unpivoted rows */
+  for( r=0, jj=0; jj<nsing; jj++ ){
+    for( ; r<m; r++ )
+      if( lu->pinv[r] < 0 && lp->_pos[n+r] < 0 ) break;
+    if( r == m ) return false;
+    s = lu->order[jj];
+    lp->_pos[lp->_basis[s]] = -1;
+    lp->_basis[s] = n + r;
+    lp->_pos[n+r] = s;
+    lu->udiag[k] = lp->_sign[r];
+    lu->prow[k] = r;
+    lu->pinv[r] = k;
+    lu->q[k] = s;
+    lu->uptr[k+1] = lu->uptr[k];
+    lu->lptr[k+1] = lu->lptr[k];
+    k++;
+  }
+  return true;
+}
+
+/* solve B y = z, where z on rows is destroyed and y is on slots. */
+static void _zLPRevisedFTRAN(zLPRevised *lp, double *z, double *y)
+{
+  struct _zLPRevisedFactor *lu;
+  double v;
+  int k, p, e;
+
+  lu = lp->_lu;
+  for( k=0; k<lu->m; k++ ){
+    if( ( v = z[lu->prow[k]] ) == 0 ) continue;
+    for( p=lu->lptr[k]; p<lu->lptr[k+1]; p++ )
+      z[lu->lind[p]] -= lu->lval[p] * v;
+  }
+  for( k=lu->m-1; k>=0; k-- ){
+    y[lu->q[k]] = v = z[lu->prow[k]] / lu->udiag[k];
+    if( v == 0 ) continue;
+    for( p=lu->uptr[k]; p<lu->uptr[k+1]; p++ )
+      z[lu->prow[lu->uind[p]]] -= lu->uval[p] * v;
+  }
+  for( e=0; e<lu->eta_num; e++ ){
+    if( ( v = ( y[lu->eta_p[e]] /= lu->eta_piv[e] ) ) == 0 ) continue;
+    for( p=lu->eta_ptr[e]; p<lu->eta_ptr[e+1]; p++ )
+      y[lu->eta_ind[p]] -= lu->eta_val[p] * v;
+  }
+}
+
+/* solve B^T y = c, where c on slots is destroyed and y is on rows. */
+static void _zLPRevisedBTRAN(zLPRevised *lp, double *c, double *y)
+{
+  struct _zLPRevisedFactor *lu;
+  double v;
+  int k, p, e;
+
+  lu = lp->_lu;
+  for( e=lu->eta_num-1; e>=0; e-- ){
+    v = c[lu->eta_p[e]];
+    for( p=lu->eta_ptr[e]; p<lu->eta_ptr[e+1]; p++ )
+      v -= lu->eta_val[p] * c[lu->eta_ind[p]];
+    c[lu->eta_p[e]] = v / lu->eta_piv[e];
+  }
+  for( k=0; k<lu->m; k++ ){
+    v = c[lu->q[k]];
+    for( p=lu->uptr[k]; p<lu->uptr[k+1]; p++ )
+      v -= lu->uval[p] * lu->w[lu->uind[p]];
+    lu->w[k] = v / lu->udiag[k];
+  }
+  for( k=lu->m-1; k>=0; k-- ){
+    v = lu->w[k];
+    for( p=lu->lptr[k]; p<lu->lptr[k+1]; p++ )
+      v -= lu->lval[p] * y[lu->lind[p]];
+    y[lu->prow[k]] = v;
+  }
+}
+
+/* append an eta vector of a basis change at a slot p with the transformed entering column d. */
+static bool _zLPRevisedAddEta(zLPRevised *lp, int p, const double *d)
+{
+  struct _zLPRevisedFactor *lu;
+  int i, e;
+
+  lu = lp->_lu;
+  e = lu->eta_num;
+  if( !_zLPRevisedReserve( &lu->eta_ind, &lu->eta_val, &lu->eta_cap, lu->eta_ptr[e]+lu->m ) )
+    return false;
+  lu->eta_p[e] = p;
+  lu->eta_piv[e] = d[p];
+  for( lu->eta_ptr[e+1]=lu->eta_ptr[e], i=0; i<lu->m; i++ )
+    if( i != p && d[i] != 0 ){
+      lu->eta_ind[lu->eta_ptr[e+1]] = i;
+      lu->eta_val[lu->eta_ptr[e+1]++] = d[i];
+    }
+  lu->eta_num++;
+  return true;
+}
+
+/* enlarge the eta file for the number of updates before refactorization. */
+static bool _zLPRevisedReserveEta(zLPRevised *lp)
+{
+  struct _zLPRevisedFactor *lu;
+  int *p, *ptr;
+  double *piv;
+
+  lu = lp->_lu;
+  if( lp->refactor < 1 ) lp->refactor = 1;
+  if( lp->refactor <= lu->eta_max ) return true;
+  if( !( p = zRealloc( lu->eta_p, int, lp->refactor ) ) ) goto FAILURE;
+  lu->eta_p = p;
+  if( !( ptr = zRealloc( lu->eta_ptr, int, lp->refactor+1 ) ) ) goto FAILURE;
+  lu->eta_ptr = ptr;
+  if( !( piv = zRealloc( lu->eta_piv, double, lp->refactor ) ) ) goto FAILURE;
+  lu->eta_piv = piv;
+  lu->eta_max = lp->refactor;
+  return true;
+ FAILURE:
+  ZALLOCERROR();
+  return false;
+}
+
+/* values of basic variables. */
+static void _zLPRevisedBasicValue(zLPRevised *lp)
+{
+  memcpy( lp->_work, zVecBufNC(lp->b), sizeof(double)*zVecSizeNC(lp->b) );
+  _zLPRevisedFTRAN( lp, lp->_work, lp->_xb );
+}
+
+/* create a revised simplex solver. */
+zLPRevised *zLPRevisedCreate(zLPRevised *lp, const zSpMat a, const zVec b, const zVec c)
+{
+  int m, n, i;
+
+  m = zSpMatRowSize(a);
+  n = zSpMatColSize(a);
+  if( zVecSizeNC(b) != m ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  if( zVecSizeNC(c) != n ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return NULL;
+  }
+  lp->iter_max = 0;
+  lp->refactor = ZLP_REVISED_REFACTOR;
+  lp->iter_num = 0;
+  lp->_warm = false;
+  lp->a = zSpMatConvert( a, ZM_SPMAT_CSC );
+  lp->b = zVecClone( b );
+  lp->c = zVecClone( c );
+  lp->_basis = zAlloc( int, m );
+  lp->_pos = zAlloc( int, n+m );
+  lp->_sign = zAlloc( double, m );
+  lp->_iota = zAlloc( int, m );
+  lp->_xb = zAlloc( double, m );
+  lp->_w = zAlloc( double, n+m );
+  lp->_y = zAlloc( double, m );
+  lp->_d = zAlloc( double, m );
+  lp->_rho = zAlloc( double, m );
+  lp->_work = zAlloc( double, m );
+  lp->_lu = _zLPRevisedFactorAlloc( m, lp->refactor );
+  if( !lp->a || !lp->b || !lp->c || !lp->_basis || !lp->_pos || !lp->_sign || !lp->_iota ||
+      !lp->_xb || !lp->_w || !lp->_y || !lp->_d || !lp->_rho || !lp->_work || !lp->_lu ){
+    ZALLOCERROR();
+    zLPRevisedDestroy( lp );
+    return NULL;
+  }
+  for( i=0; i<m; i++ ) lp->_iota[i] = i;
+  return lp;
+}
+
+/* destroy a revised simplex solver. */
+void zLPRevisedDestroy(zLPRevised *lp)
+{
+  zSpMatFree( lp->a );
+  zVecFree( lp->b );
+  zVecFree( lp->c );
+  zFree( lp->_basis );
+  zFree( lp->_pos );
+  zFree( lp->_sign );
+  zFree( lp->_iota );
+  zFree( lp->_xb );
+  zFree( lp->_w );
+  zFree( lp->_y );
+  zFree( lp->_d );
+  zFree( lp->_rho );
+  zFree( lp->_work );
+  _zLPRevisedFactorFree( lp->_lu );
+  lp->_lu = NULL;
+  lp->a = NULL;
+  lp->b = lp->c = NULL;
+}
+
+/* replace the cost vector. */
+bool zLPRevisedSetCost(zLPRevised *lp, const zVec c)
+{
+  if( !zVecSizeEqual( c, lp->c ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  zVecCopyNC( c, lp->c );
+  return true;
+}
+
+/* replace the constraint vector. */
+bool zLPRevisedSetRHS(zLPRevised *lp, const zVec b)
+{
+  if( !zVecSizeEqual( b, lp->b ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  zVecCopyNC( b, lp->b );
+  return true;
+}
+
+/* set the basis. */
+bool zLPRevisedSetBasis(zLPRevised *lp, const zIndex basis)
+{
+  int m, n, i, j;
+
+  m = zSpMatRowSize(lp->a);
+  n = zSpMatColSize(lp->a);
+  if( zIndexSizeNC(basis) != m ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  for( j=0; j<n+m; j++ ) lp->_pos[j] = -1;
+  for( i=0; i<m; i++ ){
+    j = zIndexElemNC(basis,i);
+    if( j < 0 || j >= n+m || lp->_pos[j] >= 0 ){
+      ZRUNERROR( ZM_ERR_OPT_LP_INVALIDBASIS, j );
+      lp->_warm = false;
+      return false;
+    }
+    lp->_basis[i] = j;
+    lp->_pos[j] = i;
+  }
+  for( i=0; i<m; i++ ) lp->_sign[i] = 1;
+  lp->_warm = true;
+  return true;
+}
+
+/* get the basis. */
+bool zLPRevisedGetBasis(const zLPRevised *lp, zIndex basis)
+{
+  int i;
+
+  if( zIndexSizeNC(basis) != zSpMatRowSize(lp->a) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  for( i=0; i<zIndexSizeNC(basis); i++ )
+    zIndexSetElemNC( basis, i, lp->_basis[i] );
+  return true;
+}
+
+/* initial basis of artificial variables and column singletons. */
+static void _zLPRevisedColdStart(zLPRevised *lp)
+{
+  const int *ind;
+  const double *val;
+  int m, n, i, j;
+
+  m = zSpMatRowSize(lp->a);
+  n = zSpMatColSize(lp->a);
+  for( j=0; j<n+m; j++ ) lp->_pos[j] = -1;
+  for( i=0; i<m; i++ ){
+    lp->_sign[i] = zVecElemNC(lp->b,i) >= 0 ? 1 : -1;
+    lp->_basis[i] = n + i;
+    lp->_pos[n+i] = i;
+  }
+  for( j=0; j<n; j++ ){
+    if( _zLPRevisedColumn( lp, j, &ind, &val ) != 1 || val[0] == 0 ) continue;
+    i = ind[0];
+    if( lp->_basis[i] < n || zVecElemNC(lp->b,i) / val[0] < 0 ) continue;
+    lp->_pos[lp->_basis[i]] = -1;
+    lp->_basis[i] = j;
+    lp->_pos[j] = i;
+  }
+}
+
+/* cost of a variable in a phase. */
+#define _zLPRevisedCost(lp,j,n,phase) \
+  ( (j) < (n) ? ( (phase) == 1 ? 0 : zVecElemNC((lp)->c,j) ) : ( (phase) == 1 ? 1 : 0 ) )
+
+/* iterations of the revised simplex method in a phase.
+ * It returns 1 at the optimum, 0 if the number of iterations exceeds the limit or it fails to
+ * allocate memory, and -1 if the solution is unbounded. */
+static int _zLPRevisedIterate(zLPRevised *lp, int phase, double tol)
+{
+  struct _zLPRevisedFactor *lu;
+  const int *ind;
+  const double *val;
+  double dj, score, score_max, t, t_min, t_max, arj, wq, wmax, *d;
+  int m, n, i, j, k, p, q, nnz, iter, degenerate = 0;
+  bool bland = false;
+
+  lu = lp->_lu;
+  m = lu->m;
+  n = zSpMatColSize(lp->a);
+  d = lp->_d;
+  for( j=0; j<n+m; j++ ) lp->_w[j] = 1;
+  iter = lp->iter_max > 0 ? lp->iter_max : zMax( Z_MAX_ITER_NUM, ZLP_REVISED_ITER_RATIO*(m+n) );
+  for( k=0; k<iter; k++ ){
+    /* simplex multipliers */
+    for( i=0; i<m; i++ )
+      lp->_work[i] = _zLPRevisedCost( lp, lp->_basis[i], n, phase );
+    _zLPRevisedBTRAN( lp, lp->_work, lp->_y );
+    /* Devex pricing, or Bland's rule against cycling */
+    for( score_max=0, q=-1, j=0; j<n; j++ ){
+      if( lp->_pos[j] >= 0 ) continue;
+      if( ( dj = _zLPRevisedCost( lp, j, n, phase ) - _zLPRevisedColumnDot( lp, j, lp->_y ) ) >= -ZLP_REVISED_TOL )
+        continue;
+      if( bland ){
+        q = j;
+        break;
+      }
+      if( ( score = dj * dj / lp->_w[j] ) > score_max || q < 0 ){
+        score_max = score;
+        q = j;
+      }
+    }
+    if( q < 0 ) return 1;
+    /* transformed entering column */
+    for( i=0; i<m; i++ ) lp->_work[i] = 0;
+    nnz = _zLPRevisedColumn( lp, q, &ind, &val );
+    for( i=0; i<nnz; i++ ) lp->_work[ind[i]] = val[i];
+    _zLPRevisedFTRAN( lp, lp->_work, d );
+    /* two-pass ratio test of Harris, which relaxes the bounds by the feasibility tolerance to choose
+     * a large pivot; artificial variables are bounded at zero in the second phase */
+    for( t_max=HUGE_VAL, i=0; i<m; i++ ){
+      if( lp->_basis[i] >= n && phase == 2 ){
+        if( fabs( d[i] ) > ZLP_REVISED_PIVOT_TOL ) t_max = zMin( t_max, tol / fabs( d[i] ) );
+      } else
+      if( d[i] > ZLP_REVISED_PIVOT_TOL ) t_max = zMin( t_max, ( zMax( lp->_xb[i], 0 ) + tol ) / d[i] );
+    }
+    if( t_max == HUGE_VAL ) return -1;
+    for( t_min=0, p=-1, i=0; i<m; i++ ){
+      if( lp->_basis[i] >= n && phase == 2 ){
+        if( fabs( d[i] ) <= ZLP_REVISED_PIVOT_TOL ) continue;
+        t = 0;
+      } else{
+        if( d[i] <= ZLP_REVISED_PIVOT_TOL ) continue;
+        if( ( t = zMax( lp->_xb[i], 0 ) / d[i] ) > t_max ) continue;
+      }
+      if( p < 0 || ( bland ? lp->_basis[i] < lp->_basis[p] : fabs( d[i] ) > fabs( d[p] ) ) ){
+        t_min = t;
+        p = i;
+      }
+    }
+    if( p < 0 ) return -1;
+    /* Devex weights updated with the pivot row */
+    for( i=0; i<m; i++ ) lp->_work[i] = 0;
+    lp->_work[p] = 1;
+    _zLPRevisedBTRAN( lp, lp->_work, lp->_rho );
+    wq = lp->_w[q];
+    for( wmax=0, j=0; j<n; j++ ){
+      if( lp->_pos[j] >= 0 || j == q ) continue;
+      if( ( arj = _zLPRevisedColumnDot( lp, j, lp->_rho ) ) == 0 ) continue;
+      arj /= d[p];
+      lp->_w[j] = zMax( lp->_w[j], arj * arj * wq );
+      wmax = zMax( wmax, lp->_w[j] );
+    }
+    lp->_w[lp->_basis[p]] = zMax( wq / ( d[p] * d[p] ), 1 );
+    if( zMax( wmax, lp->_w[lp->_basis[p]] ) > ZLP_REVISED_DEVEX_MAX )
+      for( j=0; j<n+m; j++ ) lp->_w[j] = 1;
+    /* pivot */
+    if( t_min > tol ){
+      degenerate = 0;
+      bland = false;
+    } else
+    if( ++degenerate > ZLP_REVISED_DEGENERATE ) bland = true;
+    for( i=0; i<m; i++ ) lp->_xb[i] -= t_min * d[i];
+    lp->_xb[p] = t_min;
+    lp->_pos[lp->_basis[p]] = -1;
+    lp->_basis[p] = q;
+    lp->_pos[q] = p;
+    lp->iter_num++;
+    /* refactorized also when the eta file gets larger than the factors */
+    if( lu->eta_num + 1 >= lp->refactor || lu->eta_ptr[lu->eta_num] > lu->lptr[m] + lu->uptr[m] + m ){
+      if( !_zLPRevisedFactorize( lp ) ) return 0;
+      _zLPRevisedBasicValue( lp );
+    } else
+    if( !_zLPRevisedAddEta( lp, p, d ) ) return 0;
+  }
+  ZITERWARN( iter );
+  return 0;
+}
+
+/* check if the basis is feasible in the second phase. */
+static bool _zLPRevisedIsFeasible(zLPRevised *lp, double tol)
+{
+  int i, n;
+
+  n = zSpMatColSize(lp->a);
+  for( i=0; i<zSpMatRowSize(lp->a); i++ )
+    if( lp->_xb[i] < -tol || ( lp->_basis[i] >= n && lp->_xb[i] > tol ) ) return false;
+  return true;
+}
+
+/* solve a linear programming problem by revised simplex method. */
+bool zLPRevisedSolve(zLPRevised *lp, zVec ans, double *cost)
+{
+  double tol;
+  int i, n, status;
+
+  if( zVecSizeNC(ans) != ( n = zSpMatColSize(lp->a) ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  lp->iter_num = 0;
+  tol = ZLP_REVISED_TOL * ( 1 + zVecElemAbsMax( lp->b, NULL ) );
+  if( !_zLPRevisedReserveEta( lp ) ) goto FAILURE;
+  if( lp->_warm ){
+    if( _zLPRevisedFactorize( lp ) )
+      _zLPRevisedBasicValue( lp );
+    else
+      lp->_warm = false;
+  }
+  if( !lp->_warm || !_zLPRevisedIsFeasible( lp, tol ) ){
+    _zLPRevisedColdStart( lp );
+    if( !_zLPRevisedFactorize( lp ) ) goto FAILURE;
+    _zLPRevisedBasicValue( lp );
+    /* first phase */
+    if( ( status = _zLPRevisedIterate( lp, 1, tol ) ) == 0 ) goto FAILURE;
+    if( !_zLPRevisedIsFeasible( lp, tol ) ){
+      ZRUNWARN( ZM_ERR_OPT_UNSOLVABLE );
+      lp->_warm = false;
+      return false;
+    }
+  }
+  lp->_warm = true;
+  /* second phase */
+  if( ( status = _zLPRevisedIterate( lp, 2, tol ) ) <= 0 ){
+    if( status < 0 ) ZRUNERROR( ZM_ERR_OPT_INFINITESOLUTION );
+    return false;
+  }
+  zVecZero( ans );
+  for( i=0; i<zSpMatRowSize(lp->a); i++ )
+    if( lp->_basis[i] < n ) zVecSetElemNC( ans, lp->_basis[i], zMax( lp->_xb[i], 0 ) );
+  if( cost ) *cost = zVecInnerProd( lp->c, ans );
+  return true;
+
+ FAILURE:
+  lp->_warm = false;
+  return false;
+}
+
+/* linear programming solver with the revised simplex method for a dense constraint matrix. */
+bool zLPSolveSimplexRevised(const zMat a, const zVec b, const zVec c, zVec ans, double *cost)
+{
+  zSpMat sa;
+  zLPRevised lp;
+  bool ret = false;
+
+  if( !zMatColVecSizeEqual(a,ans) || !zMatRowVecSizeEqual(a,b) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  if( !( sa = zSpMatFromMat( a, 0, ZM_SPMAT_CSC ) ) ) return false;
+  if( zLPRevisedCreate( &lp, sa, b, c ) ){
+    ret = zLPRevisedSolve( &lp, ans, cost );
+    zLPRevisedDestroy( &lp );
+  }
+  zSpMatFree( sa );
+  return ret;
+}
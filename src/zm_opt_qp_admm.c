@@ -0,0 +1,436 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_opt_qp_admm - optimization tools: alternating direction method of multipliers for quadratic programming.
+ */
+
+#include <zm/zm_opt.h>
+
+/* tolerance of the certificate of primal infeasibility */
+#define ZQP_ADMM_TOL_INFEAS ( 1.0e-6 )
+/* ratio of step sizes to trigger refactorization */
+#define ZQP_ADMM_RHO_TRIGGER ( 5.0 )
+
+/* position of the (i,j) component (i <= j) in a sparse matrix in the CSC format. */
+static int _zQPADMMPos(const zSpMat m, int i, int j)
+{
+  int lo, hi, mid;
+
+  lo = m->ptr[j];
+  hi = m->ptr[j+1] - 1;
+  while( lo < hi ){
+    mid = ( lo + hi ) / 2;
+    if( m->ind[mid] < i ) lo = mid + 1; else hi = mid;
+  }
+  return lo;
+}
+
+/* sparsity pattern of p + sigma I + A^T diag(rho) A and positions of its terms. */
+static bool _zQPADMMPattern(zQPADMM *qp)
+{
+  zSpTriplet t;
+  zSpMat ar;
+  int n, i, j, k, p, r, npair = 0;
+
+  n = zSpMatColSize(qp->a);
+  ar = qp->_ar;
+  for( i=0; i<zSpMatRowSize(ar); i++ ){
+    k = ar->ptr[i+1] - ar->ptr[i];
+    npair += k * ( k + 1 ) / 2;
+  }
+  if( !zSpTripletAlloc( &t, n + qp->p->nnz + npair ) ) return false;
+  for( j=0; j<n; j++ ) zSpTripletAdd( &t, j, j, 1 );
+  for( j=0; j<n; j++ )
+    for( p=qp->p->ptr[j]; p<qp->p->ptr[j+1]; p++ )
+      zSpTripletAdd( &t, qp->p->ind[p], j, 1 );
+  for( i=0; i<zSpMatRowSize(ar); i++ )
+    for( p=ar->ptr[i]; p<ar->ptr[i+1]; p++ )
+      for( r=p; r<ar->ptr[i+1]; r++ )
+        zSpTripletAdd( &t, ar->ind[p], ar->ind[r], 1 );
+  qp->_m = zSpMatFromTriplet( &t, n, n, ZM_SPMAT_CSC );
+  zSpTripletFree( &t );
+  qp->_pmap = zAlloc( int, zMax( qp->p->nnz, 1 ) );
+  qp->_amap = zAlloc( int, zMax( npair, 1 ) );
+  qp->_diag = zAlloc( int, zMax( n, 1 ) );
+  if( !qp->_m || !qp->_pmap || !qp->_amap || !qp->_diag ) return false;
+  for( j=0; j<n; j++ ){
+    qp->_diag[j] = _zQPADMMPos( qp->_m, j, j );
+    for( p=qp->p->ptr[j]; p<qp->p->ptr[j+1]; p++ )
+      qp->_pmap[p] = _zQPADMMPos( qp->_m, qp->p->ind[p], j );
+  }
+  for( k=0, i=0; i<zSpMatRowSize(ar); i++ )
+    for( p=ar->ptr[i]; p<ar->ptr[i+1]; p++ )
+      for( r=p; r<ar->ptr[i+1]; r++ )
+        qp->_amap[k++] = _zQPADMMPos( qp->_m, ar->ind[p], ar->ind[r] );
+  return zSpCholeskyAnalyze( &qp->_chol, qp->_m );
+}
+
+/* step sizes of rows for the types of constraints, which need refactorization if changed. */
+static void _zQPADMMSetRho(zQPADMM *qp)
+{
+  int i;
+  double l, u, rho;
+
+  for( i=0; i<zVecSizeNC(qp->_rho); i++ ){
+    l = zVecElemNC(qp->l,i);
+    u = zVecElemNC(qp->u,i);
+    if( l <= -ZQP_ADMM_INF && u >= ZQP_ADMM_INF )
+      rho = ZQP_ADMM_RHO_MIN;
+    else if( u - l < zTOL )
+      rho = ZQP_ADMM_RHO_EQ * qp->rho;
+    else
+      rho = qp->rho;
+    rho *= zVecElemNC(qp->_w,i);
+    if( rho != zVecElemNC(qp->_rho,i) ){
+      zVecSetElemNC( qp->_rho, i, rho );
+      qp->_factorized = false;
+    }
+  }
+}
+
+/* factorize p + sigma I + A^T diag(rho) A. */
+static bool _zQPADMMFactorize(zQPADMM *qp)
+{
+  zSpMat ar;
+  int i, j, k, p, r;
+  double rho;
+
+  ar = qp->_ar;
+  for( p=0; p<qp->_m->nnz; p++ ) qp->_m->val[p] = 0;
+  for( p=0; p<qp->p->nnz; p++ ) qp->_m->val[qp->_pmap[p]] += qp->p->val[p];
+  for( j=0; j<zSpMatColSize(qp->a); j++ ) qp->_m->val[qp->_diag[j]] += qp->sigma;
+  for( k=0, i=0; i<zSpMatRowSize(ar); i++ ){
+    rho = zVecElemNC(qp->_rho,i);
+    for( p=ar->ptr[i]; p<ar->ptr[i+1]; p++ )
+      for( r=p; r<ar->ptr[i+1]; r++ )
+        qp->_m->val[qp->_amap[k++]] += rho * ar->val[p] * ar->val[r];
+  }
+  if( !( qp->_factorized = zSpCholeskyFactorize( &qp->_chol, qp->_m ) ) )
+    ZRUNERROR( ZM_ERR_OPT_NONCONVEX );
+  return qp->_factorized;
+}
+
+/* create an ADMM solver. */
+zQPADMM *zQPADMMCreate(zQPADMM *qp, const zSpMat p, const zSpMat a)
+{
+  zSpTriplet t;
+  zSpMat pc;
+  int m, n, i, k;
+
+  n = zSpMatColSize(p);
+  m = a ? zSpMatRowSize(a) : 0;
+  if( zSpMatRowSize(p) != n || ( a && zSpMatColSize(a) != n ) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  qp->rho = ZQP_ADMM_RHO;
+  qp->sigma = ZQP_ADMM_SIGMA;
+  qp->alpha = ZQP_ADMM_ALPHA;
+  qp->tol_abs = qp->tol_rel = ZQP_ADMM_TOL;
+  qp->iter_max = 0;
+  qp->iter_num = 0;
+  qp->res_prim = qp->res_dual = 0;
+  qp->p = qp->a = qp->_m = qp->_ar = NULL;
+  qp->_pmap = qp->_amap = qp->_diag = NULL;
+  qp->_factorized = qp->_warm = false;
+  zSpCholeskyInit( &qp->_chol );
+  /* upper triangular part of p */
+  zSpTripletInit( &t );
+  if( ( pc = zSpMatConvert( p, ZM_SPMAT_CSC ) ) ){
+    zSpMatForEach( pc, i, k )
+      if( pc->ind[k] <= i ) zSpTripletAdd( &t, pc->ind[k], i, pc->val[k] );
+    qp->p = zSpMatFromTriplet( &t, n, n, ZM_SPMAT_CSC );
+    zSpMatFree( pc );
+  }
+  zSpTripletFree( &t );
+  /* constraint matrix stacked with the identity */
+  zSpTripletInit( &t );
+  if( a ){
+    zSpMatForEach( a, i, k )
+      zSpTripletAdd( &t, zSpMatIterRow(a,i,k), zSpMatIterCol(a,i,k), a->val[k] );
+  }
+  for( i=0; i<n; i++ ) zSpTripletAdd( &t, m+i, i, 1 );
+  qp->a = zSpMatFromTriplet( &t, m+n, n, ZM_SPMAT_CSC );
+  zSpTripletFree( &t );
+  if( qp->a ) qp->_ar = zSpMatConvert( qp->a, ZM_SPMAT_CSR );
+  qp->q = zVecAlloc( n );
+  qp->l = zVecAlloc( m+n );
+  qp->u = zVecAlloc( m+n );
+  qp->x = zVecAlloc( n );
+  qp->z = zVecAlloc( m+n );
+  qp->y = zVecAlloc( m+n );
+  qp->_rho = zVecAlloc( m+n );
+  qp->_w = zVecAlloc( m+n );
+  qp->_xt = zVecAlloc( n );
+  qp->_px = zVecAlloc( n );
+  qp->_aty = zVecAlloc( n );
+  qp->_rhs = zVecAlloc( n );
+  qp->_zt = zVecAlloc( m+n );
+  qp->_ax = zVecAlloc( m+n );
+  qp->_dy = zVecAlloc( m+n );
+  if( !qp->p || !qp->a || !qp->_ar || !qp->q || !qp->l || !qp->u || !qp->x || !qp->z || !qp->y ||
+      !qp->_rho || !qp->_w || !qp->_xt || !qp->_px || !qp->_aty || !qp->_rhs || !qp->_zt || !qp->_ax || !qp->_dy ||
+      !_zQPADMMPattern( qp ) ){
+    ZALLOCERROR();
+    zQPADMMDestroy( qp );
+    return NULL;
+  }
+  for( i=0; i<m+n; i++ ){
+    zVecSetElemNC( qp->_w, i, zRawVecSqrNorm( qp->_ar->val+qp->_ar->ptr[i], qp->_ar->ptr[i+1]-qp->_ar->ptr[i] ) );
+    zVecSetElemNC( qp->_w, i, zIsTiny( zVecElemNC(qp->_w,i) ) ? 1.0 : 1.0 / zVecElemNC(qp->_w,i) );
+  }
+  zVecSetAll( qp->l, -HUGE_VAL );
+  zVecSetAll( qp->u, HUGE_VAL );
+  _zQPADMMSetRho( qp );
+  if( !_zQPADMMFactorize( qp ) ){
+    zQPADMMDestroy( qp );
+    return NULL;
+  }
+  return qp;
+}
+
+/* destroy an ADMM solver. */
+void zQPADMMDestroy(zQPADMM *qp)
+{
+  zSpMatFree( qp->p );
+  zSpMatFree( qp->a );
+  zSpMatFree( qp->_m );
+  zSpMatFree( qp->_ar );
+  zFree( qp->_pmap );
+  zFree( qp->_amap );
+  zFree( qp->_diag );
+  zSpCholeskyFree( &qp->_chol );
+  zVecFreeAtOnce( 6, qp->q, qp->l, qp->u, qp->x, qp->z, qp->y );
+  zVecFreeAtOnce( 9, qp->_rho, qp->_w, qp->_xt, qp->_px, qp->_aty, qp->_rhs, qp->_zt, qp->_ax, qp->_dy );
+  qp->p = qp->a = qp->_m = qp->_ar = NULL;
+  qp->q = qp->l = qp->u = qp->x = qp->z = qp->y = NULL;
+  qp->_rho = qp->_w = qp->_xt = qp->_px = qp->_aty = qp->_rhs = qp->_zt = qp->_ax = qp->_dy = NULL;
+}
+
+/* replace the cost vector. */
+bool zQPADMMSetCost(zQPADMM *qp, const zVec q)
+{
+  if( !zVecSizeEqual( q, qp->q ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  zVecCopyNC( q, qp->q );
+  return true;
+}
+
+/* set bounds of constraints from the offset-th row. */
+static bool _zQPADMMSetBound(zQPADMM *qp, int offset, int size, const zVec l, const zVec u)
+{
+  int i;
+  double li, ui;
+
+  if( ( l && zVecSizeNC(l) != size ) || ( u && zVecSizeNC(u) != size ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  for( i=0; i<size; i++ ){
+    li = l ? zVecElemNC(l,i) : -HUGE_VAL;
+    ui = u ? zVecElemNC(u,i) : HUGE_VAL;
+    if( li > ui ){
+      ZRUNERROR( ZM_ERR_OPT_QP_INVALIDBOUND, li, ui );
+      return false;
+    }
+  }
+  for( i=0; i<size; i++ ){
+    zVecSetElemNC( qp->l, offset+i, l ? zVecElemNC(l,i) : -HUGE_VAL );
+    zVecSetElemNC( qp->u, offset+i, u ? zVecElemNC(u,i) : HUGE_VAL );
+  }
+  _zQPADMMSetRho( qp );
+  return true;
+}
+
+/* set bounds of general constraints. */
+bool zQPADMMSetBound(zQPADMM *qp, const zVec l, const zVec u)
+{
+  int n;
+
+  n = zSpMatColSize(qp->a);
+  return _zQPADMMSetBound( qp, 0, zSpMatRowSize(qp->a)-n, l, u );
+}
+
+/* set bounds of box constraints. */
+bool zQPADMMSetBox(zQPADMM *qp, const zVec xl, const zVec xu)
+{
+  int n;
+
+  n = zSpMatColSize(qp->a);
+  return _zQPADMMSetBound( qp, zSpMatRowSize(qp->a)-n, n, xl, xu );
+}
+
+/* set primal variables and Lagrange multipliers for a warm start. */
+bool zQPADMMWarmStart(zQPADMM *qp, const zVec x, const zVec y)
+{
+  int i;
+
+  if( ( x && !zVecSizeEqual( x, qp->x ) ) || ( y && !zVecSizeEqual( y, qp->y ) ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  if( !qp->_warm ){
+    zVecZero( qp->x );
+    zVecZero( qp->y );
+  }
+  if( x ) zVecCopyNC( x, qp->x );
+  if( y ) zVecCopyNC( y, qp->y );
+  /* z is the projection of A x onto the bounds */
+  zSpMatMulVecNC( qp->a, qp->x, qp->z );
+  for( i=0; i<zVecSizeNC(qp->z); i++ )
+    zVecSetElemNC( qp->z, i, zLimit( zVecElemNC(qp->z,i), zVecElemNC(qp->l,i), zVecElemNC(qp->u,i) ) );
+  qp->_warm = true;
+  return true;
+}
+
+/* p x from the upper triangular part of p. */
+static void _zQPADMMMulP(zQPADMM *qp, const zVec x, zVec px)
+{
+  int i, j, k;
+
+  zVecZero( px );
+  for( j=0; j<zSpMatColSize(qp->p); j++ )
+    for( k=qp->p->ptr[j]; k<qp->p->ptr[j+1]; k++ ){
+      i = qp->p->ind[k];
+      zVecElemNC(px,i) += qp->p->val[k] * zVecElemNC(x,j);
+      if( i != j ) zVecElemNC(px,j) += qp->p->val[k] * zVecElemNC(x,i);
+    }
+}
+
+/* primal and dual residuals, and their scales for termination. */
+static void _zQPADMMResidual(zQPADMM *qp, double *sp, double *sd)
+{
+  int i;
+  double r;
+
+  zSpMatMulVecNC( qp->a, qp->x, qp->_ax );
+  for( qp->res_prim=0, i=0; i<zVecSizeNC(qp->z); i++ )
+    if( ( r = fabs( zVecElemNC(qp->_ax,i) - zVecElemNC(qp->z,i) ) ) > qp->res_prim ) qp->res_prim = r;
+  _zQPADMMMulP( qp, qp->x, qp->_px );
+  zSpMatTMulVecNC( qp->a, qp->y, qp->_aty );
+  for( qp->res_dual=0, i=0; i<zVecSizeNC(qp->x); i++ )
+    if( ( r = fabs( zVecElemNC(qp->_px,i) + zVecElemNC(qp->q,i) + zVecElemNC(qp->_aty,i) ) ) > qp->res_dual )
+      qp->res_dual = r;
+  *sp = zMax( zVecInfNorm( qp->_ax ), zVecInfNorm( qp->z ) );
+  *sd = zMax( zMax( zVecInfNorm( qp->_px ), zVecInfNorm( qp->_aty ) ), zVecInfNorm( qp->q ) );
+}
+
+/* check if the difference of Lagrange multipliers is a certificate of primal infeasibility. */
+static bool _zQPADMMInfeasible(zQPADMM *qp)
+{
+  int i;
+  double norm, tol, dy, s = 0;
+
+  if( zIsTiny( norm = zVecInfNorm( qp->_dy ) ) ) return false;
+  tol = ZQP_ADMM_TOL_INFEAS * norm;
+  for( i=0; i<zVecSizeNC(qp->_dy); i++ ){
+    if( ( dy = zVecElemNC(qp->_dy,i) ) > tol ){
+      if( zVecElemNC(qp->u,i) >= ZQP_ADMM_INF ) return false;
+      s += zVecElemNC(qp->u,i) * dy;
+    } else
+    if( dy < -tol ){
+      if( zVecElemNC(qp->l,i) <= -ZQP_ADMM_INF ) return false;
+      s += zVecElemNC(qp->l,i) * dy;
+    }
+  }
+  if( s > -tol ) return false;
+  zSpMatTMulVecNC( qp->a, qp->_dy, qp->_xt );
+  return zVecInfNorm( qp->_xt ) <= tol;
+}
+
+/* adapt the step size to balance the primal and dual residuals. */
+static void _zQPADMMAdaptRho(zQPADMM *qp, double sp, double sd)
+{
+  double rho;
+
+  rho = qp->rho * sqrt( ( qp->res_prim / ( sp + zTOL ) ) / ( qp->res_dual / ( sd + zTOL ) + zTOL ) );
+  rho = zLimit( rho, ZQP_ADMM_RHO_MIN, ZQP_ADMM_RHO_MAX );
+  if( rho > qp->rho * ZQP_ADMM_RHO_TRIGGER || rho < qp->rho / ZQP_ADMM_RHO_TRIGGER ){
+    qp->rho = rho;
+    _zQPADMMSetRho( qp );
+  }
+}
+
+/* solve a quadratic programming problem by ADMM. */
+bool zQPADMMSolve(zQPADMM *qp, zVec ans, double *cost)
+{
+  int i, iter_max;
+  double rho, zh, zn, sp, sd;
+  bool ret = false;
+
+  if( !zVecSizeEqual( ans, qp->x ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  if( !qp->_warm ){
+    zVecZero( qp->x );
+    zVecZero( qp->z );
+    zVecZero( qp->y );
+    qp->_warm = true;
+  }
+  _zQPADMMSetRho( qp );
+  iter_max = qp->iter_max > 0 ? qp->iter_max : Z_MAX_ITER_NUM;
+  for( qp->iter_num=0; qp->iter_num<iter_max; ){
+    if( !qp->_factorized && !_zQPADMMFactorize( qp ) ) return false;
+    /* x~ = ( p + sigma I + A^T R A )^-1 ( sigma x - q + A^T ( R z - y ) ) */
+    for( i=0; i<zVecSizeNC(qp->z); i++ )
+      zVecSetElemNC( qp->_zt, i, zVecElemNC(qp->_rho,i) * zVecElemNC(qp->z,i) - zVecElemNC(qp->y,i) );
+    zSpMatTMulVecNC( qp->a, qp->_zt, qp->_rhs );
+    for( i=0; i<zVecSizeNC(qp->x); i++ )
+      zVecElemNC(qp->_rhs,i) += qp->sigma * zVecElemNC(qp->x,i) - zVecElemNC(qp->q,i);
+    zSpCholeskySolve( &qp->_chol, qp->_rhs, qp->_xt );
+    zSpMatMulVecNC( qp->a, qp->_xt, qp->_zt );
+    /* relaxed update of x, projection of z and update of y */
+    for( i=0; i<zVecSizeNC(qp->x); i++ )
+      zVecSetElemNC( qp->x, i, qp->alpha * zVecElemNC(qp->_xt,i) + ( 1 - qp->alpha ) * zVecElemNC(qp->x,i) );
+    for( i=0; i<zVecSizeNC(qp->z); i++ ){
+      rho = zVecElemNC(qp->_rho,i);
+      zh = qp->alpha * zVecElemNC(qp->_zt,i) + ( 1 - qp->alpha ) * zVecElemNC(qp->z,i);
+      zn = zLimit( zh + zVecElemNC(qp->y,i) / rho, zVecElemNC(qp->l,i), zVecElemNC(qp->u,i) );
+      zVecSetElemNC( qp->_dy, i, rho * ( zh - zn ) );
+      zVecElemNC(qp->y,i) += zVecElemNC(qp->_dy,i);
+      zVecSetElemNC( qp->z, i, zn );
+    }
+    qp->iter_num++;
+    _zQPADMMResidual( qp, &sp, &sd );
+    if( qp->res_prim <= qp->tol_abs + qp->tol_rel * sp &&
+        qp->res_dual <= qp->tol_abs + qp->tol_rel * sd ){
+      ret = true;
+      break;
+    }
+    if( _zQPADMMInfeasible( qp ) ){
+      ZRUNWARN( ZM_ERR_OPT_UNSOLVABLE );
+      break;
+    }
+    if( qp->iter_num % ZQP_ADMM_RHO_INTERVAL == 0 ) _zQPADMMAdaptRho( qp, sp, sd );
+  }
+  if( qp->iter_num >= iter_max && !ret ) ZITERWARN( iter_max );
+  zVecCopyNC( qp->x, ans );
+  if( cost ){
+    _zQPADMMMulP( qp, qp->x, qp->_px );
+    *cost = 0.5 * zVecInnerProd( qp->x, qp->_px ) + zVecInnerProd( qp->q, qp->x );
+  }
+  return ret;
+}
+
+/* solve quadratic programming by ADMM. */
+bool zQPSolveADMM(const zMat q, const zVec c, const zMat a, const zVec b, zVec ans, double *cost)
+{
+  zQPADMM qp;
+  zSpMat qs, as;
+  bool ret = false;
+
+  qs = zSpMatFromMat( q, 0, ZM_SPMAT_CSC );
+  as = zSpMatFromMat( a, 0, ZM_SPMAT_CSC );
+  if( !qs || !as ) goto TERMINATE;
+  if( !zQPADMMCreate( &qp, qs, as ) ) goto TERMINATE;
+  if( zQPADMMSetCost( &qp, c ) && zQPADMMSetBound( &qp, b, NULL ) )
+    ret = zQPADMMSolve( &qp, ans, cost );
+  zQPADMMDestroy( &qp );
+ TERMINATE:
+  zSpMatFree( qs );
+  zSpMatFree( as );
+  return ret;
+}
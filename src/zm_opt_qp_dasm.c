@@ -0,0 +1,405 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_opt_qp_dasm - optimization tools: dual active set method for quadratic programming.
+ */
+
+#include <zm/zm_opt.h>
+#include <time.h>
+
+/* tolerance of violation of a constraint relative to the norm of its normal */
+#define ZQP_DUALASM_TOL ( 1.0e-10 )
+
+/* J = L^-T for the Cholesky factor L of q. */
+static bool _zQPDualASMFactorize(zQPDualASM *qp)
+{
+  int n, i, j, k;
+  double s;
+
+  n = zMatRowSizeNC(qp->q);
+  /* Cholesky factor L into the lower triangular part of _r */
+  for( j=0; j<n; j++ ){
+    for( i=j; i<n; i++ ){
+      s = zMatElemNC(qp->q,i,j);
+      for( k=0; k<j; k++ )
+        s -= zMatElemNC(qp->_r,i,k) * zMatElemNC(qp->_r,j,k);
+      if( i == j ){
+        if( s <= 0 || zIsTiny( s ) ){
+          ZRUNERROR( ZM_ERR_OPT_NONCONVEX );
+          return false;
+        }
+        zMatSetElemNC( qp->_r, j, j, sqrt( s ) );
+      } else
+        zMatSetElemNC( qp->_r, i, j, s / zMatElemNC(qp->_r,j,j) );
+    }
+  }
+  /* L^-1 by forward substitution, which is transposed into _j0 */
+  zMatZero( qp->_j0 );
+  for( k=0; k<n; k++ ){
+    zMatSetElemNC( qp->_j0, k, k, 1.0 / zMatElemNC(qp->_r,k,k) );
+    for( i=k+1; i<n; i++ ){
+      for( s=0, j=k; j<i; j++ )
+        s -= zMatElemNC(qp->_r,i,j) * zMatElemNC(qp->_j0,k,j);
+      zMatSetElemNC( qp->_j0, k, i, s / zMatElemNC(qp->_r,i,i) );
+    }
+  }
+  zMatZero( qp->_r );
+  return true;
+}
+
+/* create a dual active set solver. */
+zQPDualASM *zQPDualASMCreate(zQPDualASM *qp, const zMat q, const zMat a)
+{
+  int m, n, i;
+
+  n = zMatRowSizeNC(q);
+  m = zMatRowSizeNC(a);
+  if( !zMatIsSqr( q ) || zMatColSizeNC(a) != n ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  qp->iter_max = 0;
+  qp->time_max = 0;
+  qp->iter_num = 0;
+  qp->truncated = false;
+  qp->_nact = 0;
+  qp->_warm = false;
+  qp->q = zMatClone( q );
+  qp->a = zMatClone( a );
+  qp->_j0 = zMatAllocSqr( n );
+  qp->_j = zMatAllocSqr( n );
+  qp->_r = zMatAllocSqr( n );
+  qp->_anorm = zVecAlloc( m );
+  qp->_active = zAlloc( int, n );
+  qp->_slot = zAlloc( int, m );
+  qp->_u = zAlloc( double, n );
+  qp->_d = zAlloc( double, n );
+  qp->_z = zAlloc( double, n );
+  qp->_s = zAlloc( double, n );
+  qp->_w = zAlloc( double, n );
+  if( !qp->q || !qp->a || !qp->_j0 || !qp->_j || !qp->_r || !qp->_anorm || !qp->_active ||
+      !qp->_slot || !qp->_u || !qp->_d || !qp->_z || !qp->_s || !qp->_w ){
+    ZALLOCERROR();
+    zQPDualASMDestroy( qp );
+    return NULL;
+  }
+  if( !_zQPDualASMFactorize( qp ) ){
+    zQPDualASMDestroy( qp );
+    return NULL;
+  }
+  for( i=0; i<m; i++ ){
+    zVecSetElemNC( qp->_anorm, i, zRawVecNorm( zMatRowBufNC(qp->a,i), n ) );
+    /* a zero row is regarded as infeasible if the corresponding constraint is violated */
+    if( zIsTiny( zVecElemNC(qp->_anorm,i) ) ) zVecSetElemNC( qp->_anorm, i, 1.0 );
+  }
+  return qp;
+}
+
+/* destroy a dual active set solver. */
+void zQPDualASMDestroy(zQPDualASM *qp)
+{
+  zMatFree( qp->q );
+  zMatFree( qp->a );
+  zMatFree( qp->_j0 );
+  zMatFree( qp->_j );
+  zMatFree( qp->_r );
+  zVecFree( qp->_anorm );
+  zFree( qp->_active );
+  zFree( qp->_slot );
+  zFree( qp->_u );
+  zFree( qp->_d );
+  zFree( qp->_z );
+  zFree( qp->_s );
+  zFree( qp->_w );
+}
+
+/* empty working set. */
+static void _zQPDualASMClear(zQPDualASM *qp)
+{
+  int i;
+
+  zMatCopyNC( qp->_j0, qp->_j );
+  for( i=0; i<zMatRowSizeNC(qp->a); i++ ) qp->_slot[i] = -1;
+  qp->_nact = 0;
+  qp->_warm = true;
+}
+
+/* Givens rotation of the i-th and (i+1)-th columns of J. */
+static void _zQPDualASMRotJ(zQPDualASM *qp, int i, double c, double s)
+{
+  int k;
+  double x, y;
+
+  for( k=0; k<zMatRowSizeNC(qp->_j); k++ ){
+    x = zMatElemNC(qp->_j,k,i);
+    y = zMatElemNC(qp->_j,k,i+1);
+    zMatSetElemNC( qp->_j, k, i,   c*x + s*y );
+    zMatSetElemNC( qp->_j, k, i+1,-s*x + c*y );
+  }
+}
+
+/* d = J^T a_p. */
+static void _zQPDualASMProj(zQPDualASM *qp, int p)
+{
+  int n, i, k;
+  double *ap;
+
+  n = zMatColSizeNC(qp->a);
+  ap = zMatRowBufNC(qp->a,p);
+  for( i=0; i<n; i++ ) qp->_d[i] = 0;
+  for( k=0; k<n; k++ )
+    for( i=0; i<n; i++ )
+      qp->_d[i] += zMatElemNC(qp->_j,k,i) * ap[k];
+}
+
+/* squared norm of the component of d orthogonal to the active constraints. */
+static double _zQPDualASMProjNorm(zQPDualASM *qp)
+{
+  return zRawVecSqrNorm( qp->_d+qp->_nact, zMatColSizeNC(qp->a)-qp->_nact );
+}
+
+/* add the p-th constraint with the multiplier u to the working set, where d = J^T a_p is given. */
+static void _zQPDualASMAdd(zQPDualASM *qp, int p, double u)
+{
+  int n, i;
+  double h, c, s;
+
+  n = zMatColSizeNC(qp->a);
+  for( i=n-1; i>qp->_nact; i-- ){
+    if( qp->_d[i] == 0 ) continue;
+    h = sqrt( zSqr(qp->_d[i-1]) + zSqr(qp->_d[i]) );
+    c = qp->_d[i-1] / h;
+    s = qp->_d[i] / h;
+    qp->_d[i-1] = h;
+    qp->_d[i] = 0;
+    _zQPDualASMRotJ( qp, i-1, c, s );
+  }
+  for( i=0; i<=qp->_nact; i++ )
+    zMatSetElemNC( qp->_r, i, qp->_nact, qp->_d[i] );
+  qp->_active[qp->_nact] = p;
+  qp->_u[qp->_nact] = u;
+  qp->_slot[p] = qp->_nact++;
+}
+
+/* drop the k-th active constraint from the working set. */
+static void _zQPDualASMDrop(zQPDualASM *qp, int k)
+{
+  int i, j;
+  double h, c, s, x, y;
+
+  qp->_slot[qp->_active[k]] = -1;
+  qp->_nact--;
+  for( j=k; j<qp->_nact; j++ ){
+    qp->_active[j] = qp->_active[j+1];
+    qp->_u[j] = qp->_u[j+1];
+    qp->_slot[qp->_active[j]] = j;
+    for( i=0; i<=j+1; i++ )
+      zMatSetElemNC( qp->_r, i, j, zMatElemNC(qp->_r,i,j+1) );
+  }
+  for( i=0; i<=qp->_nact; i++ )
+    zMatSetElemNC( qp->_r, i, qp->_nact, 0 );
+  /* restore the upper triangular form of the Hessenberg matrix */
+  for( j=k; j<qp->_nact; j++ ){
+    if( ( y = zMatElemNC(qp->_r,j+1,j) ) == 0 ) continue;
+    x = zMatElemNC(qp->_r,j,j);
+    h = sqrt( zSqr(x) + zSqr(y) );
+    c = x / h;
+    s = y / h;
+    zMatSetElemNC( qp->_r, j, j, h );
+    zMatSetElemNC( qp->_r, j+1, j, 0 );
+    for( i=j+1; i<qp->_nact; i++ ){
+      x = zMatElemNC(qp->_r,j,i);
+      y = zMatElemNC(qp->_r,j+1,i);
+      zMatSetElemNC( qp->_r, j,   i,  c*x + s*y );
+      zMatSetElemNC( qp->_r, j+1, i, -s*x + c*y );
+    }
+    _zQPDualASMRotJ( qp, j, c, s );
+  }
+}
+
+/* r = R^-1 d for the active part of d. */
+static void _zQPDualASMSolveR(zQPDualASM *qp, double *d, double *r)
+{
+  int i, j;
+  double s;
+
+  for( i=qp->_nact-1; i>=0; i-- ){
+    for( s=d[i], j=i+1; j<qp->_nact; j++ )
+      s -= zMatElemNC(qp->_r,i,j) * r[j];
+    r[i] = s / zMatElemNC(qp->_r,i,i);
+  }
+}
+
+/* minimum and Lagrange multipliers on the working set. */
+static void _zQPDualASMInitPoint(zQPDualASM *qp, const zVec c, const zVec b, zVec x)
+{
+  int n, i, k;
+  double s;
+
+  n = zMatColSizeNC(qp->a);
+  /* w = J^T c */
+  for( i=0; i<n; i++ ) qp->_w[i] = 0;
+  for( k=0; k<n; k++ )
+    for( i=0; i<n; i++ )
+      qp->_w[i] += zMatElemNC(qp->_j,k,i) * zVecElemNC(c,k);
+  /* s = R^-T b_A */
+  for( i=0; i<qp->_nact; i++ ){
+    for( s=zVecElemNC(b,qp->_active[i]), k=0; k<i; k++ )
+      s -= zMatElemNC(qp->_r,k,i) * qp->_s[k];
+    qp->_s[i] = s / zMatElemNC(qp->_r,i,i);
+  }
+  /* x = J1 s - J2 J2^T c */
+  for( k=0; k<n; k++ ){
+    for( s=0, i=0; i<qp->_nact; i++ )
+      s += zMatElemNC(qp->_j,k,i) * qp->_s[i];
+    for( ; i<n; i++ )
+      s -= zMatElemNC(qp->_j,k,i) * qp->_w[i];
+    zVecSetElemNC( x, k, s );
+  }
+  /* u = R^-1 ( s + J1^T c ) */
+  for( i=0; i<qp->_nact; i++ ) qp->_s[i] += qp->_w[i];
+  _zQPDualASMSolveR( qp, qp->_s, qp->_u );
+}
+
+/* check the budget of the iteration. */
+static bool _zQPDualASMBudget(zQPDualASM *qp, clock_t start)
+{
+  if( qp->iter_num++ >= ( qp->iter_max > 0 ? qp->iter_max : Z_MAX_ITER_NUM ) ||
+      ( qp->time_max > 0 && (double)( clock() - start ) / CLOCKS_PER_SEC > qp->time_max ) ){
+    qp->truncated = true;
+    return false;
+  }
+  return true;
+}
+
+/* choose the most violated constraint. */
+static int _zQPDualASMViolated(zQPDualASM *qp, const zVec b, const zVec x)
+{
+  int i, p;
+  double s, smin;
+
+  for( p=-1, smin=-ZQP_DUALASM_TOL, i=0; i<zMatRowSizeNC(qp->a); i++ ){
+    if( qp->_slot[i] >= 0 ) continue;
+    s = ( zRawVecInnerProd( zMatRowBufNC(qp->a,i), zVecBufNC(x), zVecSizeNC(x) ) - zVecElemNC(b,i) )
+      / zVecElemNC(qp->_anorm,i);
+    if( s < smin ){
+      smin = s;
+      p = i;
+    }
+  }
+  return p;
+}
+
+/* solve a quadratic programming problem by dual active set method. */
+bool zQPDualASMSolve(zQPDualASM *qp, const zVec c, const zVec b, zVec ans, double *cost)
+{
+  int n, p, i, k;
+  double up, sp, zn, t, t1, t2;
+  clock_t start;
+
+  n = zMatColSizeNC(qp->a);
+  if( !zVecSizeEqual( c, ans ) || zVecSizeNC(ans) != n ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  if( zVecSizeNC(b) != zMatRowSizeNC(qp->a) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return false;
+  }
+  start = qp->time_max > 0 ? clock() : 0;
+  qp->iter_num = 0;
+  qp->truncated = false;
+  if( !qp->_warm ) _zQPDualASMClear( qp );
+  /* minimum on the previous working set, which is dual feasible */
+  while( 1 ){
+    _zQPDualASMInitPoint( qp, c, b, ans );
+    for( k=-1, t=-ZQP_DUALASM_TOL, i=0; i<qp->_nact; i++ )
+      if( qp->_u[i] < t ) t = qp->_u[k = i];
+    if( k < 0 ) break;
+    if( !_zQPDualASMBudget( qp, start ) ) return false;
+    _zQPDualASMDrop( qp, k );
+  }
+  while( ( p = _zQPDualASMViolated( qp, b, ans ) ) >= 0 ){
+    up = 0;
+    do{
+      if( !_zQPDualASMBudget( qp, start ) ) return false;
+      _zQPDualASMProj( qp, p );
+      /* primal step direction z = J2 J2^T a_p and dual step direction r = R^-1 J1^T a_p */
+      for( i=0; i<n; i++ )
+        for( qp->_z[i]=0, k=qp->_nact; k<n; k++ )
+          qp->_z[i] += zMatElemNC(qp->_j,i,k) * qp->_d[k];
+      _zQPDualASMSolveR( qp, qp->_d, qp->_s );
+      /* partial step to drop a constraint */
+      for( k=-1, t1=HUGE_VAL, i=0; i<qp->_nact; i++ )
+        if( qp->_s[i] > zTOL && qp->_u[i] / qp->_s[i] < t1 ){
+          t1 = qp->_u[i] / qp->_s[i];
+          k = i;
+        }
+      /* full step to satisfy the p-th constraint */
+      sp = zRawVecInnerProd( zMatRowBufNC(qp->a,p), zVecBufNC(ans), n ) - zVecElemNC(b,p);
+      zn = _zQPDualASMProjNorm( qp );
+      t2 = zn > zTOL * zSqr(zVecElemNC(qp->_anorm,p)) ? -sp / zn : HUGE_VAL;
+      if( ( t = zMin( t1, t2 ) ) == HUGE_VAL ){
+        ZRUNWARN( ZM_ERR_OPT_UNSOLVABLE );
+        return false;
+      }
+      if( t2 < HUGE_VAL )
+        zRawVecCatDRC( zVecBufNC(ans), t, qp->_z, n );
+      for( i=0; i<qp->_nact; i++ ) qp->_u[i] -= t * qp->_s[i];
+      up += t;
+      if( t == t2 ){
+        _zQPDualASMAdd( qp, p, up );
+        break;
+      }
+      _zQPDualASMDrop( qp, k );
+    } while( 1 );
+  }
+  if( cost ) *cost = zQuadraticValue( qp->q, c, ans );
+  return true;
+}
+
+/* set the working set. */
+bool zQPDualASMSetWorkingSet(zQPDualASM *qp, const zIndex ws)
+{
+  int i, p;
+
+  _zQPDualASMClear( qp );
+  for( i=0; i<zIndexSizeNC(ws); i++ ){
+    p = zIndexElemNC(ws,i);
+    if( p < 0 || p >= zMatRowSizeNC(qp->a) || qp->_slot[p] >= 0 ){
+      ZRUNERROR( ZM_ERR_OPT_QP_INVALIDWORKINGSET, p );
+      _zQPDualASMClear( qp );
+      return false;
+    }
+    _zQPDualASMProj( qp, p );
+    if( _zQPDualASMProjNorm( qp ) > zTOL * zSqr(zVecElemNC(qp->_anorm,p)) )
+      _zQPDualASMAdd( qp, p, 0 );
+  }
+  return true;
+}
+
+/* get the working set. */
+bool zQPDualASMGetWorkingSet(const zQPDualASM *qp, zIndex ws)
+{
+  int i;
+
+  if( !zIndexSetSize( ws, qp->_warm ? qp->_nact : 0 ) ){
+    ZRUNERROR( ZM_ERR_VEC_SIZEMISMATCH );
+    return false;
+  }
+  for( i=0; i<zIndexSizeNC(ws); i++ )
+    zIndexSetElemNC( ws, i, qp->_active[i] );
+  return true;
+}
+
+/* solve quadratic programming by dual active set method. */
+bool zQPSolveDualASM(const zMat q, const zVec c, const zMat a, const zVec b, zVec ans, double *cost)
+{
+  zQPDualASM qp;
+  bool ret;
+
+  if( !zQPDualASMCreate( &qp, q, a ) ) return false;
+  ret = zQPDualASMSolve( &qp, c, b, ans, cost );
+  zQPDualASMDestroy( &qp );
+  return ret;
+}
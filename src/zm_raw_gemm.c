@@ -0,0 +1,330 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_raw_gemm - raw vector and matrix : general matrix-matrix multiplication.
+ */
+
+#include <zm/zm_raw.h>
+
+#if defined(__GNUC__) && ( defined(__x86_64__) || defined(__i386__) )
+#define __ZM_RAW_GEMM_X86
+#include <immintrin.h>
+#endif /* __GNUC__ && x86 */
+
+/* a micro-kernel computes c += a b for a ZM_RAW_GEMM_MR x ZM_RAW_GEMM_NR tile, where a and b are
+ * packed panels of kc columns and kc rows, respectively. */
+typedef void (* _zRawGEMMKernelFunc)(int kc, const double *a, const double *b, double *c, int colcapacity);
+
+/* portable scalar micro-kernel. */
+static void _zRawGEMMKernelScalar(int kc, const double *a, const double *b, double *c, int colcapacity)
+{
+  double ab[ZM_RAW_GEMM_MR*ZM_RAW_GEMM_NR];
+  int i, j;
+
+  for( i=0; i<ZM_RAW_GEMM_MR*ZM_RAW_GEMM_NR; i++ ) ab[i] = 0;
+  for( ; kc>0; kc--, a+=ZM_RAW_GEMM_MR, b+=ZM_RAW_GEMM_NR )
+    for( i=0; i<ZM_RAW_GEMM_MR; i++ )
+      for( j=0; j<ZM_RAW_GEMM_NR; j++ )
+        ab[i*ZM_RAW_GEMM_NR+j] += a[i] * b[j];
+  for( i=0; i<ZM_RAW_GEMM_MR; i++, c+=colcapacity )
+    for( j=0; j<ZM_RAW_GEMM_NR; j++ )
+      c[j] += ab[i*ZM_RAW_GEMM_NR+j];
+}
+
+#ifdef __ZM_RAW_GEMM_X86
+/* SSE2 micro-kernel; a 4x8 tile is processed as two 4x4 halves to fit in 16 registers. */
+__attribute__((target("sse2")))
+static void _zRawGEMMKernelSSE2(int kc, const double *a, const double *b, double *c, int colcapacity)
+{
+  __m128d c00, c01, c10, c11, c20, c21, c30, c31, b0, b1, ai;
+  const double *ap, *bp;
+  int half, p;
+
+  for( half=0; half<ZM_RAW_GEMM_NR; half+=4 ){
+    c00 = c01 = c10 = c11 = c20 = c21 = c30 = c31 = _mm_setzero_pd();
+    for( ap=a, bp=b+half, p=kc; p>0; p--, ap+=ZM_RAW_GEMM_MR, bp+=ZM_RAW_GEMM_NR ){
+      b0 = _mm_loadu_pd( bp );
+      b1 = _mm_loadu_pd( bp+2 );
+      ai = _mm_load1_pd( ap );
+      c00 = _mm_add_pd( c00, _mm_mul_pd( ai, b0 ) );
+      c01 = _mm_add_pd( c01, _mm_mul_pd( ai, b1 ) );
+      ai = _mm_load1_pd( ap+1 );
+      c10 = _mm_add_pd( c10, _mm_mul_pd( ai, b0 ) );
+      c11 = _mm_add_pd( c11, _mm_mul_pd( ai, b1 ) );
+      ai = _mm_load1_pd( ap+2 );
+      c20 = _mm_add_pd( c20, _mm_mul_pd( ai, b0 ) );
+      c21 = _mm_add_pd( c21, _mm_mul_pd( ai, b1 ) );
+      ai = _mm_load1_pd( ap+3 );
+      c30 = _mm_add_pd( c30, _mm_mul_pd( ai, b0 ) );
+      c31 = _mm_add_pd( c31, _mm_mul_pd( ai, b1 ) );
+    }
+    _mm_storeu_pd( c+half,                 _mm_add_pd( _mm_loadu_pd( c+half ),                 c00 ) );
+    _mm_storeu_pd( c+half+2,               _mm_add_pd( _mm_loadu_pd( c+half+2 ),               c01 ) );
+    _mm_storeu_pd( c+half+colcapacity,     _mm_add_pd( _mm_loadu_pd( c+half+colcapacity ),     c10 ) );
+    _mm_storeu_pd( c+half+colcapacity+2,   _mm_add_pd( _mm_loadu_pd( c+half+colcapacity+2 ),   c11 ) );
+    _mm_storeu_pd( c+half+colcapacity*2,   _mm_add_pd( _mm_loadu_pd( c+half+colcapacity*2 ),   c20 ) );
+    _mm_storeu_pd( c+half+colcapacity*2+2, _mm_add_pd( _mm_loadu_pd( c+half+colcapacity*2+2 ), c21 ) );
+    _mm_storeu_pd( c+half+colcapacity*3,   _mm_add_pd( _mm_loadu_pd( c+half+colcapacity*3 ),   c30 ) );
+    _mm_storeu_pd( c+half+colcapacity*3+2, _mm_add_pd( _mm_loadu_pd( c+half+colcapacity*3+2 ), c31 ) );
+  }
+}
+
+/* AVX2/FMA micro-kernel. */
+__attribute__((target("avx2,fma")))
+static void _zRawGEMMKernelAVX2(int kc, const double *a, const double *b, double *c, int colcapacity)
+{
+  __m256d c00, c01, c10, c11, c20, c21, c30, c31, b0, b1, ai;
+
+  c00 = c01 = c10 = c11 = c20 = c21 = c30 = c31 = _mm256_setzero_pd();
+  for( ; kc>0; kc--, a+=ZM_RAW_GEMM_MR, b+=ZM_RAW_GEMM_NR ){
+    b0 = _mm256_loadu_pd( b );
+    b1 = _mm256_loadu_pd( b+4 );
+    ai = _mm256_broadcast_sd( a );
+    c00 = _mm256_fmadd_pd( ai, b0, c00 );
+    c01 = _mm256_fmadd_pd( ai, b1, c01 );
+    ai = _mm256_broadcast_sd( a+1 );
+    c10 = _mm256_fmadd_pd( ai, b0, c10 );
+    c11 = _mm256_fmadd_pd( ai, b1, c11 );
+    ai = _mm256_broadcast_sd( a+2 );
+    c20 = _mm256_fmadd_pd( ai, b0, c20 );
+    c21 = _mm256_fmadd_pd( ai, b1, c21 );
+    ai = _mm256_broadcast_sd( a+3 );
+    c30 = _mm256_fmadd_pd( ai, b0, c30 );
+    c31 = _mm256_fmadd_pd( ai, b1, c31 );
+  }
+  _mm256_storeu_pd( c,   _mm256_add_pd( _mm256_loadu_pd( c ),   c00 ) );
+  _mm256_storeu_pd( c+4, _mm256_add_pd( _mm256_loadu_pd( c+4 ), c01 ) ); c += colcapacity;
+  _mm256_storeu_pd( c,   _mm256_add_pd( _mm256_loadu_pd( c ),   c10 ) );
+  _mm256_storeu_pd( c+4, _mm256_add_pd( _mm256_loadu_pd( c+4 ), c11 ) ); c += colcapacity;
+  _mm256_storeu_pd( c,   _mm256_add_pd( _mm256_loadu_pd( c ),   c20 ) );
+  _mm256_storeu_pd( c+4, _mm256_add_pd( _mm256_loadu_pd( c+4 ), c21 ) ); c += colcapacity;
+  _mm256_storeu_pd( c,   _mm256_add_pd( _mm256_loadu_pd( c ),   c30 ) );
+  _mm256_storeu_pd( c+4, _mm256_add_pd( _mm256_loadu_pd( c+4 ), c31 ) );
+}
+#endif /* __ZM_RAW_GEMM_X86 */
+
+static zRawGEMMKernelType __zm_raw_gemm_kernel_type = ZM_RAW_GEMM_KERNEL_AUTO;
+static _zRawGEMMKernelFunc __zm_raw_gemm_kernel = NULL;
+
+/* check if a micro-kernel is supported by the running processor. */
+static bool _zRawGEMMKernelIsSupported(zRawGEMMKernelType type)
+{
+  switch( type ){
+  case ZM_RAW_GEMM_KERNEL_SCALAR: return true;
+#ifdef __ZM_RAW_GEMM_X86
+  case ZM_RAW_GEMM_KERNEL_SSE2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports( "sse2" ) ? true : false;
+  case ZM_RAW_GEMM_KERNEL_AVX2:
+    __builtin_cpu_init();
+    return __builtin_cpu_supports( "avx2" ) && __builtin_cpu_supports( "fma" ) ? true : false;
+#endif /* __ZM_RAW_GEMM_X86 */
+  default: ;
+  }
+  return false;
+}
+
+/* select a micro-kernel of the packed matrix-matrix multiplication. */
+zRawGEMMKernelType zRawGEMMSelectKernel(zRawGEMMKernelType type)
+{
+  if( type == ZM_RAW_GEMM_KERNEL_AUTO || !_zRawGEMMKernelIsSupported( type ) ){
+    for( type=ZM_RAW_GEMM_KERNEL_AVX2; type>ZM_RAW_GEMM_KERNEL_SCALAR; type-- )
+      if( _zRawGEMMKernelIsSupported( type ) ) break;
+  }
+  switch( type ){
+#ifdef __ZM_RAW_GEMM_X86
+  case ZM_RAW_GEMM_KERNEL_AVX2: __zm_raw_gemm_kernel = _zRawGEMMKernelAVX2; break;
+  case ZM_RAW_GEMM_KERNEL_SSE2: __zm_raw_gemm_kernel = _zRawGEMMKernelSSE2; break;
+#endif /* __ZM_RAW_GEMM_X86 */
+  default: __zm_raw_gemm_kernel = _zRawGEMMKernelScalar; type = ZM_RAW_GEMM_KERNEL_SCALAR;
+  }
+  return ( __zm_raw_gemm_kernel_type = type );
+}
+
+/* the currently selected micro-kernel of the packed matrix-matrix multiplication. */
+zRawGEMMKernelType zRawGEMMKernel(void)
+{
+  return __zm_raw_gemm_kernel ? __zm_raw_gemm_kernel_type : zRawGEMMSelectKernel( ZM_RAW_GEMM_KERNEL_AUTO );
+}
+
+/* pack a block of op(m1) into row panels of ZM_RAW_GEMM_MR rows multiplied by a scalar value. */
+static void _zRawGEMMPackA(bool trans, const double *m, int colcapacity, int row, int col, int mc, int kc, double alpha, double *buf)
+{
+  int ir, i, p, mr;
+  const double *mp;
+
+  for( ir=0; ir<mc; ir+=ZM_RAW_GEMM_MR ){
+    mr = _zMin( ZM_RAW_GEMM_MR, mc - ir );
+    for( p=0; p<kc; p++, buf+=ZM_RAW_GEMM_MR ){
+      if( trans ){
+        mp = m + ( col + p ) * colcapacity + row + ir;
+        for( i=0; i<mr; i++ ) buf[i] = alpha * mp[i];
+      } else{
+        mp = m + ( row + ir ) * colcapacity + col + p;
+        for( i=0; i<mr; i++, mp+=colcapacity ) buf[i] = alpha * *mp;
+      }
+      for( ; i<ZM_RAW_GEMM_MR; i++ ) buf[i] = 0;
+    }
+  }
+}
+
+/* pack a block of op(m2) into column panels of ZM_RAW_GEMM_NR columns. */
+static void _zRawGEMMPackB(bool trans, const double *m, int colcapacity, int row, int col, int kc, int nc, double *buf)
+{
+  int jr, j, p, nr;
+  const double *mp;
+
+  for( jr=0; jr<nc; jr+=ZM_RAW_GEMM_NR ){
+    nr = _zMin( ZM_RAW_GEMM_NR, nc - jr );
+    for( p=0; p<kc; p++, buf+=ZM_RAW_GEMM_NR ){
+      if( trans ){
+        mp = m + ( col + jr ) * colcapacity + row + p;
+        for( j=0; j<nr; j++, mp+=colcapacity ) buf[j] = *mp;
+      } else{
+        mp = m + ( row + p ) * colcapacity + col + jr;
+        for( j=0; j<nr; j++ ) buf[j] = mp[j];
+      }
+      for( ; j<ZM_RAW_GEMM_NR; j++ ) buf[j] = 0;
+    }
+  }
+}
+
+/* multiply packed blocks and accumulate the result to a block of a raw matrix. */
+static void _zRawGEMMMacroKernel(_zRawGEMMKernelFunc kernel, int mc, int nc, int kc, const double *a, const double *b, double *m, int colcapacity)
+{
+  double tile[ZM_RAW_GEMM_MR*ZM_RAW_GEMM_NR];
+  int ir, jr, i, j, mr, nr;
+
+  for( jr=0; jr<nc; jr+=ZM_RAW_GEMM_NR ){
+    nr = _zMin( ZM_RAW_GEMM_NR, nc - jr );
+    for( ir=0; ir<mc; ir+=ZM_RAW_GEMM_MR ){
+      mr = _zMin( ZM_RAW_GEMM_MR, mc - ir );
+      if( mr == ZM_RAW_GEMM_MR && nr == ZM_RAW_GEMM_NR ){
+        kernel( kc, a+ir*kc, b+jr*kc, m+ir*colcapacity+jr, colcapacity );
+        continue;
+      }
+      /* a fringe tile is computed on a temporary buffer. */
+      zRawVecZero( tile, ZM_RAW_GEMM_MR*ZM_RAW_GEMM_NR );
+      kernel( kc, a+ir*kc, b+jr*kc, tile, ZM_RAW_GEMM_NR );
+      for( i=0; i<mr; i++ )
+        for( j=0; j<nr; j++ )
+          m[(ir+i)*colcapacity+jr+j] += tile[i*ZM_RAW_GEMM_NR+j];
+    }
+  }
+}
+
+/* general matrix-matrix multiplication of raw matrices on the calling thread. */
+static bool _zRawGEMM(bool trans1, bool trans2, int rowsize, int colsize, int innersize, double alpha, const double *m1, int colcapacity1, const double *m2, int colcapacity2, double beta, double *m, int colcapacity3)
+{
+  _zRawGEMMKernelFunc kernel;
+  double *a, *b;
+  int ic, jc, pc, mc, nc, kc, mcmax, ncmax, kcmax;
+
+  if( rowsize <= 0 || colsize <= 0 ) return true;
+  if( beta == 0 )
+    zRawMatZero( m, colcapacity3, rowsize, colsize );
+  else if( beta != 1 )
+    zRawMatMulDRC( m, colcapacity3, beta, rowsize, colsize );
+  if( innersize <= 0 || alpha == 0 ) return true;
+  if( !__zm_raw_gemm_kernel ) zRawGEMMSelectKernel( ZM_RAW_GEMM_KERNEL_AUTO );
+  kernel = __zm_raw_gemm_kernel;
+
+  mcmax = _zMin( ZM_RAW_GEMM_MC, rowsize + ZM_RAW_GEMM_MR - 1 ) / ZM_RAW_GEMM_MR * ZM_RAW_GEMM_MR;
+  ncmax = _zMin( ZM_RAW_GEMM_NC, colsize + ZM_RAW_GEMM_NR - 1 ) / ZM_RAW_GEMM_NR * ZM_RAW_GEMM_NR;
+  kcmax = _zMin( ZM_RAW_GEMM_KC, innersize );
+  a = zAlloc( double, mcmax*kcmax );
+  b = zAlloc( double, kcmax*ncmax );
+  if( !a || !b ){
+    ZALLOCERROR();
+    free( a );
+    free( b );
+    return false;
+  }
+  for( jc=0; jc<colsize; jc+=ZM_RAW_GEMM_NC ){
+    nc = _zMin( ZM_RAW_GEMM_NC, colsize - jc );
+    for( pc=0; pc<innersize; pc+=ZM_RAW_GEMM_KC ){
+      kc = _zMin( ZM_RAW_GEMM_KC, innersize - pc );
+      _zRawGEMMPackB( trans2, m2, colcapacity2, pc, jc, kc, nc, b );
+      for( ic=0; ic<rowsize; ic+=ZM_RAW_GEMM_MC ){
+        mc = _zMin( ZM_RAW_GEMM_MC, rowsize - ic );
+        _zRawGEMMPackA( trans1, m1, colcapacity1, ic, pc, mc, kc, alpha, a );
+        _zRawGEMMMacroKernel( kernel, mc, nc, kc, a, b, m+ic*colcapacity3+jc, colcapacity3 );
+      }
+    }
+  }
+  free( a );
+  free( b );
+  return true;
+}
+
+/* workspace for parallel matrix-matrix multiplication. */
+typedef struct{
+  bool trans1, trans2;
+  int rowsize, colsize, innersize;
+  double alpha, beta;
+  const double *m1, *m2;
+  double *m;
+  int colcapacity1, colcapacity2, colcapacity3;
+  bool split_row;
+} _zRawGEMMThreadData;
+
+/* multiply a row or column stripe of matrices, which returns one if it succeeds, or zero otherwise. */
+static double _zRawGEMMThreadTask(void *util, int from, int to)
+{
+  _zRawGEMMThreadData *data;
+  bool ret;
+
+  data = (_zRawGEMMThreadData *)util;
+  if( data->split_row )
+    ret = _zRawGEMM( data->trans1, data->trans2, to - from, data->colsize, data->innersize,
+      data->alpha, data->trans1 ? data->m1 + from : data->m1 + from * data->colcapacity1, data->colcapacity1,
+      data->m2, data->colcapacity2, data->beta, data->m + from * data->colcapacity3, data->colcapacity3 );
+  else
+    ret = _zRawGEMM( data->trans1, data->trans2, data->rowsize, to - from, data->innersize,
+      data->alpha, data->m1, data->colcapacity1,
+      data->trans2 ? data->m2 + from * data->colcapacity2 : data->m2 + from, data->colcapacity2,
+      data->beta, data->m + from, data->colcapacity3 );
+  return ret ? 1 : 0;
+}
+
+/* general matrix-matrix multiplication of raw matrices on multiple threads. */
+bool zRawGEMMThread(bool trans1, bool trans2, int rowsize, int colsize, int innersize, double alpha, const double *m1, int colcapacity1, const double *m2, int colcapacity2, double beta, double *m, int colcapacity3, int num)
+{
+  _zRawGEMMThreadData data;
+  int size, grain;
+
+  if( num <= 0 ) num = zThreadNum();
+  data.split_row = rowsize / ZM_RAW_GEMM_MR >= colsize / ZM_RAW_GEMM_NR;
+  if( num == 1 || ( data.split_row ? rowsize < 2*ZM_RAW_GEMM_MR : colsize < 2*ZM_RAW_GEMM_NR ) )
+    return _zRawGEMM( trans1, trans2, rowsize, colsize, innersize, alpha, m1, colcapacity1, m2, colcapacity2, beta, m, colcapacity3 );
+  /* the micro-kernel has to be selected before threads run. */
+  if( !__zm_raw_gemm_kernel ) zRawGEMMSelectKernel( ZM_RAW_GEMM_KERNEL_AUTO );
+  data.trans1 = trans1;
+  data.trans2 = trans2;
+  data.rowsize = rowsize;
+  data.colsize = colsize;
+  data.innersize = innersize;
+  data.alpha = alpha;
+  data.beta = beta;
+  data.m1 = m1;
+  data.m2 = m2;
+  data.m = m;
+  data.colcapacity1 = colcapacity1;
+  data.colcapacity2 = colcapacity2;
+  data.colcapacity3 = colcapacity3;
+  if( data.split_row ){
+    size = rowsize;
+    grain = zThreadGrain( rowsize, num, ZM_RAW_GEMM_MR );
+  } else{
+    size = colsize;
+    grain = zThreadGrain( colsize, num, ZM_RAW_GEMM_NR );
+  }
+  /* succeeded only if all stripes are successfully multiplied. */
+  return zThreadReduce( num, 0, size, grain, _zRawGEMMThreadTask, &data ) == ( size + grain - 1 ) / grain;
+}
+
+/* general matrix-matrix multiplication of raw matrices. */
+bool zRawGEMM(bool trans1, bool trans2, int rowsize, int colsize, int innersize, double alpha, const double *m1, int colcapacity1, const double *m2, int colcapacity2, double beta, double *m, int colcapacity3)
+{
+  return zRawGEMMThread( trans1, trans2, rowsize, colsize, innersize, alpha, m1, colcapacity1, m2, colcapacity2, beta, m, colcapacity3, 0 );
+}
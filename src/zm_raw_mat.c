@@ -393,6 +393,8 @@ void zRawMulMatTVec(const double *m, int colcapacity, const double *v, int rowsi
 void zRawMulMatMat(const double *m1, int colcapacity1, int rowsize1, int colsize1, const double *m2, int colcapacity2, int rowsize2, int colsize2, double *m, int colcapacity3)
 {
   /* rowsize2 must be equal to colsize1. */
+  if( !zRawGEMMIsSmall( rowsize1, colsize2, colsize1 ) &&
+      zRawGEMM( false, false, rowsize1, colsize2, colsize1, 1.0, m1, colcapacity1, m2, colcapacity2, 0.0, m, colcapacity3 ) ) return;
   for( ; --rowsize1>=0; m1+=colcapacity1, m+=colcapacity3 )
     zRawMulMatTVec( m2, colcapacity2, m1, rowsize2, colsize2, m );
 }
@@ -401,6 +403,8 @@ void zRawMulMatMat(const double *m1, int colcapacity1, int rowsize1, int colsize
 void zRawMulMatMatT(const double *m1, int colcapacity1, int rowsize1, int colsize1, const double *m2, int colcapacity2, int rowsize2, int colsize2, double *m, int colcapacity3)
 {
   /* colsize2 must be equal to colsize1. */
+  if( !zRawGEMMIsSmall( rowsize1, rowsize2, colsize1 ) &&
+      zRawGEMM( false, true, rowsize1, rowsize2, colsize1, 1.0, m1, colcapacity1, m2, colcapacity2, 0.0, m, colcapacity3 ) ) return;
   for( ; --rowsize1>=0; m1+=colcapacity1, m+=colcapacity3 )
     zRawMulMatVec( m2, colcapacity2, m1, rowsize2, colsize2, m );
 }
@@ -413,6 +417,8 @@ void zRawMulMatTMat(const double *m1, int colcapacity1, int rowsize1, int colsiz
   int i, j;
 
   /* rowsize2 must be equal to rowsize1. */
+  if( !zRawGEMMIsSmall( colsize1, colsize2, rowsize1 ) &&
+      zRawGEMM( true, false, colsize1, colsize2, rowsize1, 1.0, m1, colcapacity1, m2, colcapacity2, 0.0, m, colcapacity3 ) ) return;
   for( ; --colsize1>=0; m1++, m+=colcapacity3 )
     for( i=0, mp=m; i<colsize2; i++, mp++ )
       for( j=0, mp1=m1, mp2=m2+i, *mp=0; j<rowsize1; j++, mp1+=colcapacity1, mp2+=colcapacity2 )
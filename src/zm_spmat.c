@@ -0,0 +1,405 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_spmat - sparse matrix class.
+ */
+
+#include <zm/zm_spmat.h>
+
+/* allocate a sparse matrix. */
+zSpMat zSpMatAlloc(int rowsize, int colsize, int capacity, zSpMatFormat format)
+{
+  zSpMat m;
+
+  if( rowsize < 0 || colsize < 0 ){
+    ZRUNERROR( ZM_ERR_MAT_SIZENOTFOUND );
+    return NULL;
+  }
+  if( !( m = zAlloc( zSpMatStruct, 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  m->format = format;
+  m->rowsize = rowsize;
+  m->colsize = colsize;
+  m->nnz = 0;
+  m->capacity = zMax( capacity, 1 );
+  m->ptr = zAlloc( int, zSpMatLineSize(m) + 1 );
+  m->ind = zAlloc( int, m->capacity );
+  m->val = zAlloc( double, m->capacity );
+  if( !m->ptr || !m->ind || !m->val ){
+    ZALLOCERROR();
+    zSpMatFree( m );
+    return NULL;
+  }
+  return m;
+}
+
+/* clone a sparse matrix. */
+zSpMat zSpMatClone(const zSpMat src)
+{
+  zSpMat m;
+
+  if( !( m = zSpMatAlloc( src->rowsize, src->colsize, src->nnz, src->format ) ) ) return NULL;
+  memcpy( m->ptr, src->ptr, sizeof(int)*( zSpMatLineSize(src) + 1 ) );
+  memcpy( m->ind, src->ind, sizeof(int)*src->nnz );
+  memcpy( m->val, src->val, sizeof(double)*src->nnz );
+  m->nnz = src->nnz;
+  return m;
+}
+
+/* free a sparse matrix. */
+void zSpMatFree(zSpMat m)
+{
+  if( !m ) return;
+  zFree( m->ptr );
+  zFree( m->ind );
+  zFree( m->val );
+  free( m );
+}
+
+/* component of a sparse matrix. */
+double zSpMatElem(const zSpMat m, int row, int col)
+{
+  int line, key, lo, hi, mid;
+
+  if( row < 0 || row >= m->rowsize || col < 0 || col >= m->colsize ){
+    ZRUNERROR( ZM_ERR_OUTOFRANGE );
+    return 0;
+  }
+  if( zSpMatIsCSR(m) ){
+    line = row; key = col;
+  } else{
+    line = col; key = row;
+  }
+  for( lo=m->ptr[line], hi=m->ptr[line+1]-1; lo<=hi; ){
+    mid = ( lo + hi ) / 2;
+    if( m->ind[mid] == key ) return m->val[mid];
+    if( m->ind[mid] < key ) lo = mid + 1; else hi = mid - 1;
+  }
+  return 0;
+}
+
+/* initialize a triplet list. */
+zSpTriplet *zSpTripletInit(zSpTriplet *t)
+{
+  t->size = t->capacity = 0;
+  t->row = t->col = NULL;
+  t->val = NULL;
+  return t;
+}
+
+/* allocate arrays of a triplet list. */
+zSpTriplet *zSpTripletAlloc(zSpTriplet *t, int capacity)
+{
+  zSpTripletInit( t );
+  t->capacity = zMax( capacity, 1 );
+  t->row = zAlloc( int, t->capacity );
+  t->col = zAlloc( int, t->capacity );
+  t->val = zAlloc( double, t->capacity );
+  if( !t->row || !t->col || !t->val ){
+    ZALLOCERROR();
+    zSpTripletFree( t );
+    return NULL;
+  }
+  return t;
+}
+
+/* add a triplet to a list. */
+bool zSpTripletAdd(zSpTriplet *t, int row, int col, double val)
+{
+  int *r, *c;
+  double *v;
+  int capacity;
+
+  if( row < 0 || col < 0 ){
+    ZRUNERROR( ZM_ERR_OUTOFRANGE );
+    return false;
+  }
+  if( t->size >= t->capacity ){
+    capacity = zMax( 2*t->capacity, 16 );
+    if( !( r = zRealloc( t->row, int, capacity ) ) ) goto FAILURE;
+    t->row = r;
+    if( !( c = zRealloc( t->col, int, capacity ) ) ) goto FAILURE;
+    t->col = c;
+    if( !( v = zRealloc( t->val, double, capacity ) ) ) goto FAILURE;
+    t->val = v;
+    t->capacity = capacity;
+  }
+  t->row[t->size] = row;
+  t->col[t->size] = col;
+  t->val[t->size++] = val;
+  return true;
+
+ FAILURE:
+  ZALLOCERROR();
+  return false;
+}
+
+/* free arrays of a triplet list. */
+void zSpTripletFree(zSpTriplet *t)
+{
+  zFree( t->row );
+  zFree( t->col );
+  zFree( t->val );
+  zSpTripletInit( t );
+}
+
+/* compress components given in arbitrary order into lines sorted by indices, where duplicates are summed up. */
+static zSpMat _zSpMatCompress(int rowsize, int colsize, int n, const int *row, const int *col, const double *val, zSpMatFormat format)
+{
+  zSpMat m = NULL;
+  const int *line, *key;
+  int *count = NULL, *order = NULL, *tmp = NULL;
+  int i, k, l, lines, keys, last;
+
+  if( format == ZM_SPMAT_CSR ){
+    line = row; key = col; lines = rowsize; keys = colsize;
+  } else{
+    line = col; key = row; lines = colsize; keys = rowsize;
+  }
+  count = zAlloc( int, zMax( lines, keys ) + 1 );
+  order = zAlloc( int, zMax( n, 1 ) );
+  tmp = zAlloc( int, zMax( n, 1 ) );
+  if( !count || !order || !tmp ||
+      !( m = zSpMatAlloc( rowsize, colsize, n, format ) ) ){
+    ZALLOCERROR();
+    goto TERMINATE;
+  }
+  /* stable counting sort by keys and then by lines */
+  for( k=0; k<n; k++ ) count[key[k]+1]++;
+  for( i=0; i<keys; i++ ) count[i+1] += count[i];
+  for( k=0; k<n; k++ ) tmp[count[key[k]]++] = k;
+  memset( count, 0, sizeof(int)*( zMax( lines, keys ) + 1 ) );
+  for( k=0; k<n; k++ ) count[line[k]+1]++;
+  for( l=0; l<lines; l++ ) count[l+1] += count[l];
+  for( k=0; k<n; k++ ) order[count[line[tmp[k]]]++] = tmp[k];
+  /* merge duplicates */
+  for( m->nnz=0, k=0, l=0; l<lines; l++ ){
+    m->ptr[l] = m->nnz;
+    for( last=-1; k<n && line[order[k]]==l; k++ ){
+      if( key[order[k]] == last ){
+        m->val[m->nnz-1] += val[order[k]];
+        continue;
+      }
+      m->ind[m->nnz] = last = key[order[k]];
+      m->val[m->nnz++] = val[order[k]];
+    }
+  }
+  m->ptr[lines] = m->nnz;
+ TERMINATE:
+  zFree( count );
+  zFree( order );
+  zFree( tmp );
+  return m;
+}
+
+/* create a sparse matrix from a triplet list. */
+zSpMat zSpMatFromTriplet(const zSpTriplet *t, int rowsize, int colsize, zSpMatFormat format)
+{
+  int k;
+
+  for( k=0; k<t->size; k++ )
+    if( t->row[k] >= rowsize || t->col[k] >= colsize ){
+      ZRUNERROR( ZM_ERR_OUTOFRANGE );
+      return NULL;
+    }
+  return _zSpMatCompress( rowsize, colsize, t->size, t->row, t->col, t->val, format );
+}
+
+/* create a sparse matrix from a dense matrix. */
+zSpMat zSpMatFromMat(const zMat m, double tol, zSpMatFormat format)
+{
+  zSpMat sp;
+  int i, j, nnz = 0;
+
+  for( i=0; i<zMatRowSizeNC(m); i++ )
+    for( j=0; j<zMatColSizeNC(m); j++ )
+      if( fabs( zMatElemNC(m,i,j) ) > tol ) nnz++;
+  if( !( sp = zSpMatAlloc( zMatRowSizeNC(m), zMatColSizeNC(m), nnz, format ) ) ) return NULL;
+  if( format == ZM_SPMAT_CSR ){
+    for( i=0; i<zMatRowSizeNC(m); i++ ){
+      sp->ptr[i] = sp->nnz;
+      for( j=0; j<zMatColSizeNC(m); j++ )
+        if( fabs( zMatElemNC(m,i,j) ) > tol ){
+          sp->ind[sp->nnz] = j;
+          sp->val[sp->nnz++] = zMatElemNC(m,i,j);
+        }
+    }
+  } else{
+    for( j=0; j<zMatColSizeNC(m); j++ ){
+      sp->ptr[j] = sp->nnz;
+      for( i=0; i<zMatRowSizeNC(m); i++ )
+        if( fabs( zMatElemNC(m,i,j) ) > tol ){
+          sp->ind[sp->nnz] = i;
+          sp->val[sp->nnz++] = zMatElemNC(m,i,j);
+        }
+    }
+  }
+  sp->ptr[zSpMatLineSize(sp)] = sp->nnz;
+  return sp;
+}
+
+/* copy a sparse matrix to a dense matrix. */
+zMat zSpMatToMat(const zSpMat sp, zMat m)
+{
+  int l, k;
+
+  if( zMatRowSizeNC(m) != sp->rowsize || zMatColSizeNC(m) != sp->colsize ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH );
+    return NULL;
+  }
+  zMatZero( m );
+  zSpMatForEach( sp, l, k )
+    zMatSetElemNC( m, zSpMatIterRow(sp,l,k), zSpMatIterCol(sp,l,k), sp->val[k] );
+  return m;
+}
+
+/* transpose compressed lines of a sparse matrix. */
+static zSpMat _zSpMatTransposeLines(const zSpMat sp, int rowsize, int colsize, zSpMatFormat format)
+{
+  zSpMat m;
+  int *count;
+  int l, k, keys, p;
+
+  keys = zSpMatIsCSR(sp) ? sp->colsize : sp->rowsize;
+  if( !( count = zAlloc( int, keys + 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  if( !( m = zSpMatAlloc( rowsize, colsize, sp->nnz, format ) ) ) goto TERMINATE;
+  for( k=0; k<sp->nnz; k++ ) count[sp->ind[k]+1]++;
+  for( l=0; l<keys; l++ ) count[l+1] += count[l];
+  memcpy( m->ptr, count, sizeof(int)*( keys + 1 ) );
+  zSpMatForEach( sp, l, k ){
+    p = count[sp->ind[k]]++;
+    m->ind[p] = l;
+    m->val[p] = sp->val[k];
+  }
+  m->nnz = sp->nnz;
+ TERMINATE:
+  free( count );
+  return m;
+}
+
+/* convert the storage format of a sparse matrix. */
+zSpMat zSpMatConvert(const zSpMat sp, zSpMatFormat format)
+{
+  if( sp->format == format ) return zSpMatClone( sp );
+  return _zSpMatTransposeLines( sp, sp->rowsize, sp->colsize, format );
+}
+
+/* transpose a sparse matrix. */
+zSpMat zSpMatT(const zSpMat sp)
+{
+  return _zSpMatTransposeLines( sp, sp->colsize, sp->rowsize, sp->format );
+}
+
+/* sparse matrix and vectors shared by threads of multiplication. */
+typedef struct{
+  const zSpMatStruct *m;
+  const double *v;
+  double *mv;
+} _zSpMatMulVecThreadData;
+
+/* inner products of compressed lines of a sparse matrix and a vector. */
+static void _zSpMatMulVecThreadTask(void *util, int from, int to)
+{
+  _zSpMatMulVecThreadData *data;
+  int l, k;
+  double s;
+
+  data = (_zSpMatMulVecThreadData *)util;
+  for( l=from; l<to; l++ ){
+    for( s=0, k=data->m->ptr[l]; k<data->m->ptr[l+1]; k++ )
+      s += data->m->val[k] * data->v[data->m->ind[k]];
+    data->mv[l] = s;
+  }
+}
+
+/* minimum number of stored components to run multiplication on multiple threads. */
+#define ZM_SPMAT_THREAD_THRESHOLD 0x8000
+
+/* inner products of compressed lines of a sparse matrix and a vector. */
+static void _zSpMatMulVecLine(const zSpMat m, const zVec v, zVec mv)
+{
+  _zSpMatMulVecThreadData data;
+  int num, lines;
+
+  data.m = m;
+  data.v = zVecBufNC(v);
+  data.mv = zVecBufNC(mv);
+  lines = zSpMatLineSize(m);
+  if( m->nnz < ZM_SPMAT_THREAD_THRESHOLD || ( num = zThreadNum() ) <= 1 )
+    _zSpMatMulVecThreadTask( &data, 0, lines );
+  else
+    zThreadFor( num, 0, lines, zThreadGrain( lines, num, 1 ), _zSpMatMulVecThreadTask, &data );
+}
+
+/* scatter products of compressed lines of a sparse matrix and a vector. */
+static void _zSpMatMulVecScatter(const zSpMat m, const zVec v, zVec mv)
+{
+  int l, k;
+  double vl;
+
+  zVecZero( mv );
+  for( l=0; l<zSpMatLineSize(m); l++ ){
+    if( ( vl = zVecElemNC(v,l) ) == 0 ) continue;
+    for( k=m->ptr[l]; k<m->ptr[l+1]; k++ )
+      zVecElemNC(mv,m->ind[k]) += m->val[k] * vl;
+  }
+}
+
+/* multiply a vector by a sparse matrix without checking size consistency. */
+zVec zSpMatMulVecNC(const zSpMat m, const zVec v, zVec mv)
+{
+  if( zSpMatIsCSR(m) )
+    _zSpMatMulVecLine( m, v, mv );
+  else
+    _zSpMatMulVecScatter( m, v, mv );
+  return mv;
+}
+
+/* multiply a vector by a sparse matrix. */
+zVec zSpMatMulVec(const zSpMat m, const zVec v, zVec mv)
+{
+  if( m->colsize != zVecSizeNC(v) || m->rowsize != zVecSizeNC(mv) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  return zSpMatMulVecNC( m, v, mv );
+}
+
+/* multiply a vector by transpose of a sparse matrix without checking size consistency. */
+zVec zSpMatTMulVecNC(const zSpMat m, const zVec v, zVec mv)
+{
+  if( zSpMatIsCSC(m) )
+    _zSpMatMulVecLine( m, v, mv );
+  else
+    _zSpMatMulVecScatter( m, v, mv );
+  return mv;
+}
+
+/* multiply a vector by transpose of a sparse matrix. */
+zVec zSpMatTMulVec(const zSpMat m, const zVec v, zVec mv)
+{
+  if( m->rowsize != zVecSizeNC(v) || m->colsize != zVecSizeNC(mv) ){
+    ZRUNERROR( ZM_ERR_MAT_SIZEMISMATCH_VEC );
+    return NULL;
+  }
+  return zSpMatTMulVecNC( m, v, mv );
+}
+
+/* print a sparse matrix. */
+void zSpMatFPrint(FILE *fp, const zSpMat m)
+{
+  int l, k;
+
+  if( !m ){
+    fprintf( fp, "(null sparse matrix)\n" );
+    return;
+  }
+  fprintf( fp, "%d x %d, %d components (%s)\n", m->rowsize, m->colsize, m->nnz, zSpMatIsCSR(m) ? "CSR" : "CSC" );
+  zSpMatForEach( m, l, k )
+    fprintf( fp, " (%d, %d) %.10g\n", zSpMatIterRow(m,l,k), zSpMatIterCol(m,l,k), m->val[k] );
+}
@@ -0,0 +1,457 @@
+/* ZM - Z's Mathematics Toolbox
+ * Copyright (C) 1998 Tomomichi Sugihara (Zhidao)
+ *
+ * zm_thread - thread pool for parallel computation.
+ */
+
+#include <zm/zm_thread.h>
+
+#if !defined(__ZM_NO_THREAD) && ( defined(__unix__) || defined(__APPLE__) )
+#define __ZM_USE_PTHREAD
+#include <pthread.h>
+#endif
+
+#ifdef __ZM_USE_PTHREAD
+/* remaining chunks of a thread. */
+typedef struct{
+  pthread_mutex_t mutex;
+  int head, tail;
+} _zThreadQueue;
+
+struct _zThreadPoolInternal{
+  _zThreadQueue **queue;
+  pthread_t *thread;
+  pthread_mutex_t mutex;
+  pthread_cond_t cond_start, cond_finish;
+  int generation; /* incremented every time a job starts */
+  int running;    /* number of worker threads still working on the current job */
+  bool busy, quit;
+  /* current job */
+  zThreadFunc func;
+  void *util;
+  int active; /* number of threads participating in the job */
+  int from, to, grain;
+};
+
+/* a worker thread with its identifier. */
+typedef struct{
+  zThreadPool *pool;
+  int id;
+} _zThreadWorkerArg;
+
+/* pop a chunk from the head of a queue. */
+static int _zThreadQueuePop(_zThreadQueue *queue)
+{
+  int c = -1;
+
+  pthread_mutex_lock( &queue->mutex );
+  if( queue->head < queue->tail ) c = queue->head++;
+  pthread_mutex_unlock( &queue->mutex );
+  return c;
+}
+
+/* steal a half of chunks from the tail of a queue to another empty queue. */
+static bool _zThreadQueueSteal(_zThreadQueue *victim, _zThreadQueue *thief)
+{
+  int head, tail;
+
+  pthread_mutex_lock( &victim->mutex );
+  tail = victim->tail;
+  head = victim->tail -= ( victim->tail - victim->head + 1 ) / 2;
+  pthread_mutex_unlock( &victim->mutex );
+  pthread_mutex_lock( &thief->mutex );
+  thief->head = head;
+  thief->tail = tail;
+  pthread_mutex_unlock( &thief->mutex );
+  return head < tail;
+}
+
+/* execute chunks of the current job on a thread. */
+static void _zThreadPoolWork(struct _zThreadPoolInternal *in, int id)
+{
+  int c, i, from;
+
+  do{
+    while( ( c = _zThreadQueuePop( in->queue[id] ) ) >= 0 ){
+      from = in->from + c * in->grain;
+      in->func( in->util, from, _zMin( from + in->grain, in->to ) );
+    }
+    for( i=1; i<in->active; i++ )
+      if( _zThreadQueueSteal( in->queue[(id+i)%in->active], in->queue[id] ) ) break;
+  } while( i < in->active );
+}
+
+/* distribute chunks of a job to threads. */
+static void _zThreadPoolAssign(struct _zThreadPoolInternal *in, int active, int from, int to, int grain, zThreadFunc func, void *util)
+{
+  int i, nchunk;
+
+  in->func = func;
+  in->util = util;
+  in->from = from;
+  in->to = to;
+  in->grain = grain;
+  nchunk = ( to - from + grain - 1 ) / grain;
+  in->active = _zMax( _zMin( active, nchunk ), 1 );
+  for( i=0; i<in->active; i++ ){
+    in->queue[i]->head = (int)( (double)nchunk * i / in->active );
+    in->queue[i]->tail = (int)( (double)nchunk * ( i + 1 ) / in->active );
+  }
+}
+
+/* main loop of a worker thread. */
+static void *_zThreadPoolWorker(void *arg)
+{
+  zThreadPool *pool;
+  struct _zThreadPoolInternal *in;
+  int id, generation = 0;
+
+  pool = ((_zThreadWorkerArg *)arg)->pool;
+  id = ((_zThreadWorkerArg *)arg)->id;
+  free( arg );
+  in = pool->_internal;
+  pthread_mutex_lock( &in->mutex );
+  while( 1 ){
+    while( !in->quit && generation == in->generation )
+      pthread_cond_wait( &in->cond_start, &in->mutex );
+    if( in->quit ) break;
+    generation = in->generation;
+    if( id >= in->active ) continue;
+    pthread_mutex_unlock( &in->mutex );
+    _zThreadPoolWork( in, id );
+    pthread_mutex_lock( &in->mutex );
+    if( --in->running == 0 )
+      pthread_cond_signal( &in->cond_finish );
+  }
+  pthread_mutex_unlock( &in->mutex );
+  return NULL;
+}
+
+/* spawn worker threads of a thread pool up to a specified number. */
+static void _zThreadPoolSpawn(zThreadPool *pool, int num)
+{
+  struct _zThreadPoolInternal *in;
+  _zThreadQueue **queue;
+  pthread_t *thread;
+  _zThreadWorkerArg *arg;
+
+  in = pool->_internal;
+  /* only the array of pointers is reallocated, so that initialized mutexes never move. */
+  if( !( queue = zRealloc( in->queue, _zThreadQueue*, num ) ) ||
+      !( thread = zRealloc( in->thread, pthread_t, num ) ) ){
+    ZALLOCERROR();
+    if( queue ) in->queue = queue;
+    return;
+  }
+  in->queue = queue;
+  in->thread = thread;
+  for( ; pool->num<num; pool->num++ ){
+    if( !( in->queue[pool->num] = zAlloc( _zThreadQueue, 1 ) ) ||
+        !( arg = zAlloc( _zThreadWorkerArg, 1 ) ) ){
+      ZALLOCERROR();
+      zFree( in->queue[pool->num] );
+      break;
+    }
+    pthread_mutex_init( &in->queue[pool->num]->mutex, NULL );
+    arg->pool = pool;
+    arg->id = pool->num;
+    if( pthread_create( &in->thread[pool->num], NULL, _zThreadPoolWorker, arg ) != 0 ){
+      ZRUNERROR( ZM_ERR_THREAD_CREATE );
+      free( arg );
+      pthread_mutex_destroy( &in->queue[pool->num]->mutex );
+      zFree( in->queue[pool->num] );
+      break;
+    }
+  }
+}
+
+/* create a thread pool. */
+zThreadPool *zThreadPoolCreate(zThreadPool *pool, int num)
+{
+  struct _zThreadPoolInternal *in;
+
+  pool->num = 1;
+  if( !( pool->_internal = in = zAlloc( struct _zThreadPoolInternal, 1 ) ) ||
+      !( in->queue = zAlloc( _zThreadQueue*, 1 ) ) ||
+      !( in->queue[0] = zAlloc( _zThreadQueue, 1 ) ) ||
+      !( in->thread = zAlloc( pthread_t, 1 ) ) ){
+    ZALLOCERROR();
+    if( in && in->queue ){
+      free( in->queue[0] );
+      free( in->queue );
+    }
+    zFree( pool->_internal );
+    return NULL;
+  }
+  pthread_mutex_init( &in->queue[0]->mutex, NULL );
+  pthread_mutex_init( &in->mutex, NULL );
+  pthread_cond_init( &in->cond_start, NULL );
+  pthread_cond_init( &in->cond_finish, NULL );
+  if( num > 1 ) _zThreadPoolSpawn( pool, num );
+  return pool;
+}
+
+/* destroy a thread pool. */
+void zThreadPoolDestroy(zThreadPool *pool)
+{
+  struct _zThreadPoolInternal *in;
+  int i;
+
+  if( !( in = pool->_internal ) ) return;
+  pthread_mutex_lock( &in->mutex );
+  in->quit = true;
+  pthread_cond_broadcast( &in->cond_start );
+  pthread_mutex_unlock( &in->mutex );
+  for( i=1; i<pool->num; i++ )
+    pthread_join( in->thread[i], NULL );
+  for( i=0; i<pool->num; i++ ){
+    pthread_mutex_destroy( &in->queue[i]->mutex );
+    free( in->queue[i] );
+  }
+  pthread_mutex_destroy( &in->mutex );
+  pthread_cond_destroy( &in->cond_start );
+  pthread_cond_destroy( &in->cond_finish );
+  free( in->thread );
+  free( in->queue );
+  zFree( pool->_internal );
+  pool->num = 0;
+}
+
+/* occupy a thread pool for a job. */
+static bool _zThreadPoolOccupy(zThreadPool *pool)
+{
+  struct _zThreadPoolInternal *in;
+  bool ret = false;
+
+  in = pool->_internal;
+  pthread_mutex_lock( &in->mutex );
+  if( !in->busy ) ret = in->busy = true;
+  pthread_mutex_unlock( &in->mutex );
+  return ret;
+}
+#else
+struct _zThreadPoolInternal{
+  int dummy;
+};
+
+/* create a thread pool (serial version). */
+zThreadPool *zThreadPoolCreate(zThreadPool *pool, int num)
+{
+  pool->num = 1;
+  if( !( pool->_internal = zAlloc( struct _zThreadPoolInternal, 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  return pool;
+}
+
+/* destroy a thread pool (serial version). */
+void zThreadPoolDestroy(zThreadPool *pool)
+{
+  zFree( pool->_internal );
+  pool->num = 0;
+}
+#endif /* __ZM_USE_PTHREAD */
+
+/* execute a job on a thread pool. */
+bool zThreadPoolFor(zThreadPool *pool, int num, int from, int to, int grain, zThreadFunc func, void *util)
+{
+#ifdef __ZM_USE_PTHREAD
+  struct _zThreadPoolInternal *in;
+#endif /* __ZM_USE_PTHREAD */
+
+  if( grain <= 0 ){
+    ZRUNERROR( ZM_ERR_THREAD_INVALIDGRAIN, grain );
+    return false;
+  }
+  if( from >= to ) return true;
+#ifdef __ZM_USE_PTHREAD
+  if( num != 1 && to - from > grain && _zThreadPoolOccupy( pool ) ){
+    if( num <= 0 || num > pool->num ) num = pool->num;
+    in = pool->_internal;
+    pthread_mutex_lock( &in->mutex );
+    _zThreadPoolAssign( in, num, from, to, grain, func, util );
+    in->running = in->active - 1;
+    in->generation++;
+    pthread_cond_broadcast( &in->cond_start );
+    pthread_mutex_unlock( &in->mutex );
+    _zThreadPoolWork( in, 0 );
+    pthread_mutex_lock( &in->mutex );
+    while( in->running > 0 )
+      pthread_cond_wait( &in->cond_finish, &in->mutex );
+    in->busy = false;
+    pthread_mutex_unlock( &in->mutex );
+    return true;
+  }
+#endif /* __ZM_USE_PTHREAD */
+  /* serial execution on the calling thread */
+  for( ; from<to; from+=grain )
+    func( util, from, _zMin( from + grain, to ) );
+  return true;
+}
+
+/* workspace for a reduction. */
+typedef struct{
+  zThreadReduceFunc func;
+  void *util;
+  int from, to, grain;
+  double *partial;
+} _zThreadReduceData;
+
+/* compute partial values of chunks for a reduction. */
+static void _zThreadReduceChunk(void *util, int from, int to)
+{
+  _zThreadReduceData *data;
+  int c, head;
+
+  data = (_zThreadReduceData *)util;
+  for( c=from; c<to; c++ ){
+    head = data->from + c * data->grain;
+    data->partial[c] = data->func( data->util, head, _zMin( head + data->grain, data->to ) );
+  }
+}
+
+/* deterministic reduction on a thread pool. */
+double zThreadPoolReduce(zThreadPool *pool, int num, int from, int to, int grain, zThreadReduceFunc func, void *util)
+{
+  _zThreadReduceData data;
+  double sum = 0;
+  int c, nchunk;
+
+  if( grain <= 0 ){
+    ZRUNERROR( ZM_ERR_THREAD_INVALIDGRAIN, grain );
+    return 0;
+  }
+  if( from >= to ) return 0;
+  nchunk = ( to - from + grain - 1 ) / grain;
+  data.func = func;
+  data.util = util;
+  data.from = from;
+  data.to = to;
+  data.grain = grain;
+  if( !( data.partial = zAlloc( double, nchunk ) ) ){
+    ZALLOCERROR();
+    return 0;
+  }
+  zThreadPoolFor( pool, num, 0, nchunk, 1, _zThreadReduceChunk, &data );
+  for( c=0; c<nchunk; c++ ) sum += data.partial[c];
+  free( data.partial );
+  return sum;
+}
+
+#ifdef __ZM_USE_PTHREAD
+struct _zThreadCounterInternal{
+  pthread_mutex_t mutex;
+  pthread_cond_t cond;
+};
+
+/* initialize a counter. */
+zThreadCounter *zThreadCounterInit(zThreadCounter *counter)
+{
+  counter->value = 0;
+  if( !( counter->_internal = zAlloc( struct _zThreadCounterInternal, 1 ) ) ){
+    ZALLOCERROR();
+    return NULL;
+  }
+  pthread_mutex_init( &counter->_internal->mutex, NULL );
+  pthread_cond_init( &counter->_internal->cond, NULL );
+  return counter;
+}
+
+/* destroy a counter. */
+void zThreadCounterDestroy(zThreadCounter *counter)
+{
+  if( !counter->_internal ) return;
+  pthread_mutex_destroy( &counter->_internal->mutex );
+  pthread_cond_destroy( &counter->_internal->cond );
+  zFree( counter->_internal );
+}
+
+/* set the value of a counter. */
+void zThreadCounterSet(zThreadCounter *counter, int value)
+{
+  pthread_mutex_lock( &counter->_internal->mutex );
+  counter->value = value;
+  pthread_cond_broadcast( &counter->_internal->cond );
+  pthread_mutex_unlock( &counter->_internal->mutex );
+}
+
+/* wait until the value of a counter reaches a specified value. */
+int zThreadCounterWait(zThreadCounter *counter, int value)
+{
+  pthread_mutex_lock( &counter->_internal->mutex );
+  while( counter->value < value )
+    pthread_cond_wait( &counter->_internal->cond, &counter->_internal->mutex );
+  value = counter->value;
+  pthread_mutex_unlock( &counter->_internal->mutex );
+  return value;
+}
+#else
+/* initialize a counter (serial version). */
+zThreadCounter *zThreadCounterInit(zThreadCounter *counter)
+{
+  counter->value = 0;
+  counter->_internal = NULL;
+  return counter;
+}
+
+/* destroy a counter (serial version). */
+void zThreadCounterDestroy(zThreadCounter *counter){}
+
+/* set the value of a counter (serial version). */
+void zThreadCounterSet(zThreadCounter *counter, int value)
+{
+  counter->value = value;
+}
+
+/* wait until the value of a counter reaches a specified value (serial version). */
+int zThreadCounterWait(zThreadCounter *counter, int value)
+{
+  return counter->value;
+}
+#endif /* __ZM_USE_PTHREAD */
+
+static int __zm_thread_num = 0;
+static zThreadPool __zm_thread_pool = { 0, NULL };
+#ifdef __ZM_USE_PTHREAD
+static pthread_mutex_t __zm_thread_pool_mutex = PTHREAD_MUTEX_INITIALIZER;
+#endif /* __ZM_USE_PTHREAD */
+
+/* set the default number of threads. */
+int zThreadSetNum(int num)
+{
+  char *env;
+
+  if( num <= 0 )
+    num = ( env = getenv( "ZM_THREAD_NUM" ) ) ? atoi( env ) : 1;
+  return ( __zm_thread_num = _zMax( num, 1 ) );
+}
+
+/* the default number of threads. */
+int zThreadNum(void)
+{
+  return __zm_thread_num > 0 ? __zm_thread_num : zThreadSetNum( 0 );
+}
+
+/* the default thread pool. */
+zThreadPool *zThreadPoolDefault(int num)
+{
+  num = _zMax( num, zThreadNum() );
+#ifdef __ZM_USE_PTHREAD
+  pthread_mutex_lock( &__zm_thread_pool_mutex );
+  if( !__zm_thread_pool._internal )
+    zThreadPoolCreate( &__zm_thread_pool, num );
+  else
+  if( __zm_thread_pool.num < num && _zThreadPoolOccupy( &__zm_thread_pool ) ){
+    /* worker threads are added only while no job is running */
+    _zThreadPoolSpawn( &__zm_thread_pool, num );
+    pthread_mutex_lock( &__zm_thread_pool._internal->mutex );
+    __zm_thread_pool._internal->busy = false;
+    pthread_mutex_unlock( &__zm_thread_pool._internal->mutex );
+  }
+  pthread_mutex_unlock( &__zm_thread_pool_mutex );
+#else
+  if( !__zm_thread_pool._internal ) zThreadPoolCreate( &__zm_thread_pool, num );
+#endif /* __ZM_USE_PTHREAD */
+  return &__zm_thread_pool;
+}
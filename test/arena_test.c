@@ -0,0 +1,191 @@
+#include <zm/zm.h>
+
+#define TOL (1.0e-10)
+
+void assert_arena_alloc(void)
+{
+  zArena arena;
+  zArenaMark mark;
+  zVec v;
+  zMat m;
+  zIndex idx;
+  static char buf[1024];
+  bool result1, result2, result3, result4, result5;
+
+  zArenaAlloc( &arena, zArenaVecSize(10) + zArenaMatSize(3,5) + zArenaIndexSize(7) );
+  v = zArenaVecAlloc( &arena, 10 );
+  m = zArenaMatAlloc( &arena, 3, 5 );
+  idx = zArenaIndexCreate( &arena, 7 );
+  result1 = v && zVecSizeNC(v) == 10 && zVecIsTiny(v) &&
+    m && zMatRowSizeNC(m) == 3 && zMatColSizeNC(m) == 5 && zMatIsTiny(m) &&
+    idx && zIndexSizeNC(idx) == 7 && zIndexElemNC(idx,6) == 6;
+  result2 = (size_t)zVecBufNC(v) % ZM_ARENA_ALIGN == 0 &&
+    (size_t)zMatBufNC(m) % ZM_ARENA_ALIGN == 0 &&
+    (size_t)zIndexBufNC(idx) % ZM_ARENA_ALIGN == 0 &&
+    zArenaRemain(&arena) == 0;
+  eprintf( "(the following error is expected.)\n" );
+  result3 = !zArenaVecAlloc( &arena, 1 );
+  zArenaRelease( &arena, zArenaVecSize(10) );
+  mark = zArenaMarkGet( &arena );
+  m = zArenaMatAlloc( &arena, 5, 3 );
+  result4 = m && (double *)m > zVecBufNC(v) && zArenaMarkGet(&arena) == mark + zArenaMatSize(5,3);
+  zArenaReset( &arena );
+  result4 = result4 && zArenaMarkGet(&arena) == 0 && arena.peak == arena.size;
+  zArenaFree( &arena );
+  /* a block prepared by the caller */
+  result5 = zArenaAssign( &arena, buf+1, sizeof(buf)-1 ) &&
+    (size_t)arena.buf % ZM_ARENA_ALIGN == 0 && arena.size <= sizeof(buf)-1 &&
+    ( v = zArenaVecAlloc( &arena, 20 ) ) && (char *)zVecBufNC(v) + sizeof(double)*20 <= buf + sizeof(buf);
+  zArenaFree( &arena );
+  zAssert( zArenaVecAlloc + zArenaMatAlloc + zArenaIndexCreate, result1 );
+  zAssert( zArenaCarve (alignment), result2 );
+  zAssert( zArenaCarve (shortage), result3 );
+  zAssert( zArenaRelease + zArenaReset, result4 );
+  zAssert( zArenaAssign, result5 );
+}
+
+void assert_arena_le(void)
+{
+  zArena arena;
+  zLEWorkspace workspace;
+  zMat a;
+  zVec b, x1, x2;
+  zArenaMark mark;
+  int i;
+  bool result = true;
+
+  a = zMatAlloc( 4, 7 );
+  b = zVecAlloc( 4 );
+  x1 = zVecAlloc( 7 );
+  x2 = zVecAlloc( 7 );
+  zArenaAlloc( &arena, zArenaMatSize(7,7) + zArenaVecSize(4) + zArenaVecSize(7)*2 + zArenaIndexSize(7) );
+  zLEWorkspaceAllocArena( &workspace, 4, 7, &arena );
+  mark = zArenaMarkGet( &arena );
+  for( i=0; i<10; i++ ){
+    zMatRandUniform( a, -10, 10 );
+    zVecRandUniform( b, -10, 10 );
+    zLESolveNormMin( a, b, NULL, x1 );
+    zVecCopy( b, workspace.b_copy );
+    zLESolveNormMinDST( a, workspace.b_copy, NULL, x2, &workspace );
+    if( !zVecEqual( x1, x2, TOL ) ) result = false;
+  }
+  zLEWorkspaceFree( &workspace );
+  result = result && zArenaMarkGet(&arena) == mark;
+  zArenaFree( &arena );
+  zMatFree( a );
+  zVecFreeAtOnce( 3, b, x1, x2 );
+  zAssert( zLEWorkspaceAllocArena, result );
+}
+
+zVec ode_test_f(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, zVecElemNC(x,1) );
+  zVecSetElemNC( dx, 1, -zVecElemNC(x,0) );
+  return dx;
+}
+
+void assert_arena_ode(void)
+{
+  zArena arena;
+  zODE ode1, ode2;
+  zVec x1, x2;
+  zArenaMark mark;
+  int i;
+  bool result = true;
+
+  zArenaAlloc( &arena, 4096 );
+  x1 = zVecCreateList( 2, 1.0, 0.0 );
+  x2 = zVecCreateList( 2, 1.0, 0.0 );
+  zODEAssign( &ode1, DP45, NULL, NULL );
+  zODECreate( &ode1, 2, 0, ode_test_f );
+  zODEAssign( &ode2, DP45, NULL, NULL );
+  zODESetArena( &ode2, &arena );
+  if( !zODECreate( &ode2, 2, 0, ode_test_f ) ) result = false;
+  mark = zArenaMarkGet( &arena );
+  for( i=0; i<100; i++ ){
+    zODEUpdate( &ode1, 0.01*i, x1, 0.01, NULL );
+    zODEUpdate( &ode2, 0.01*i, x2, 0.01, NULL );
+  }
+  result = result && mark > 0 && zArenaMarkGet(&arena) == mark && zVecEqual( x1, x2, 0 );
+  zODEDestroy( &ode1 );
+  zODEDestroy( &ode2 );
+  zArenaFree( &arena );
+  zVecFreeAtOnce( 2, x1, x2 );
+  zAssert( zODESetArena, result );
+}
+
+double opt_test_eval(const zVec x, void *util)
+{
+  return zSqr( 1 - zVecElemNC(x,0) ) + 10 * zSqr( zVecElemNC(x,1) - zSqr(zVecElemNC(x,0)) );
+}
+
+void assert_arena_opt(void)
+{
+  zArena arena;
+  zOptDM opt1, opt2;
+  zVec x1, x2;
+  zArenaMark mark;
+  bool result;
+
+  zArenaAlloc( &arena, 4096 );
+  x1 = zVecCreateList( 2, -1.0, 1.0 );
+  x2 = zVecCreateList( 2, -1.0, 1.0 );
+  zOptDMCreate( &opt1, 2, 0, opt_test_eval, NULL, NULL );
+  zOptDMCreateArena( &opt2, 2, 0, opt_test_eval, NULL, NULL, &arena );
+  zOptDMAssignLM( &opt1, NULL );
+  zOptDMAssignLM( &opt2, NULL );
+  mark = zArenaMarkGet( &arena );
+  zOptDMSolve( &opt1, x1, NULL, zTOL, 0, NULL );
+  zOptDMSolve( &opt2, x2, NULL, zTOL, 0, NULL );
+  result = zArenaMarkGet(&arena) == mark && arena.peak > mark && zVecEqual( x1, x2, 0 );
+  zOptDMDestroy( &opt1 );
+  zOptDMDestroy( &opt2 );
+  zArenaFree( &arena );
+  zVecFreeAtOnce( 2, x1, x2 );
+  zAssert( zOptDMCreateArena, result );
+}
+
+void assert_arena_lp(void)
+{
+  zArena arena;
+  zLPPDIP lp1, lp2;
+  zMat a;
+  zSpMat sa;
+  zVec b, c, q, x1, x2;
+  double cost1, cost2;
+  size_t used;
+  bool result;
+
+  zArenaAlloc( &arena, 8192 );
+  a = zMatCreateList( 2, 3, 1.0, 1.0, 1.0, 1.0, -1.0, 0.0 );
+  sa = zSpMatFromMat( a, 0, ZM_SPMAT_CSR );
+  b = zVecCreateList( 2, 4.0, 1.0 );
+  c = zVecCreateList( 3, 1.0, 2.0, 3.0 );
+  q = zVecCreateList( 3, 1.0, 1.0, 1.0 );
+  x1 = zVecAlloc( 3 );
+  x2 = zVecAlloc( 3 );
+  zLPPDIPCreate( &lp1, sa, b, c );
+  result = zLPPDIPCreateArena( &lp2, sa, b, c, &arena ) != NULL;
+  used = arena.used;
+  result = result && used > 0 && zLPPDIPSetQuad( &lp1, q ) && zLPPDIPSetQuad( &lp2, q ) && arena.used > used;
+  result = result && zLPPDIPSolve( &lp1, x1, &cost1 ) && zLPPDIPSolve( &lp2, x2, &cost2 ) &&
+    zVecEqual( x1, x2, 0 ) && cost1 == cost2;
+  zLPPDIPDestroy( &lp1 );
+  zLPPDIPDestroy( &lp2 );
+  zArenaFree( &arena );
+  zSpMatFree( sa );
+  zMatFree( a );
+  zVecFreeAtOnce( 5, b, c, q, x1, x2 );
+  zAssert( zLPPDIPCreateArena, result );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_arena_alloc();
+  assert_arena_le();
+  assert_arena_ode();
+  assert_arena_opt();
+  assert_arena_lp();
+  return 0;
+}
@@ -220,6 +220,90 @@ void assert_le_gauss_seidel(void)
   zAssert( zLESolveGaussSeidel, count_gs == n );
 }
 
+/* convection-diffusion equation on an n x n grid (symmetric if c = 0) */
+zSpMat le_krylov_gen(int n, double c)
+{
+  zSpTriplet t;
+  zSpMat a;
+  int i, j, k;
+
+  zSpTripletAlloc( &t, 5*n*n );
+  for( i=0; i<n; i++ )
+    for( j=0; j<n; j++ ){
+      k = i*n + j;
+      zSpTripletAdd( &t, k, k, 4 );
+      if( i > 0 )   zSpTripletAdd( &t, k, k-n, -1-c );
+      if( i < n-1 ) zSpTripletAdd( &t, k, k+n, -1+c );
+      if( j > 0 )   zSpTripletAdd( &t, k, k-1, -1-c );
+      if( j < n-1 ) zSpTripletAdd( &t, k, k+1, -1+c );
+    }
+  a = zSpMatFromTriplet( &t, n*n, n*n, ZM_SPMAT_CSR );
+  zSpTripletFree( &t );
+  return a;
+}
+
+bool assert_le_krylov_check(zLEKrylov *krylov, zSpMat a, zVec b, zVec x, zVec r, zVec (* solver)(zLEKrylov*,const zVec,zVec))
+{
+  zVecZero( x );
+  if( !solver( krylov, b, x ) ) return false;
+  zSpMatMulVec( a, x, r );
+  zVecSubDRC( r, b );
+  return zVecNorm( r ) < 1.0e-8 * zVecNorm( b );
+}
+
+void assert_le_krylov(void)
+{
+  const int n = 30;
+  zSpMat a;
+  zLEKrylov krylov;
+  zLEPrecond pc;
+  zVec b, x, r;
+  int iter_plain;
+  bool result_pcg = true, result_gmres = true, result_bicgstab = true, result_pc = true;
+
+  b = zVecRandUniform( zVecAlloc( n*n ), -1, 1 );
+  x = zVecAlloc( n*n );
+  r = zVecAlloc( n*n );
+  zLEKrylovAlloc( &krylov, n*n, 0 );
+  /* symmetric positive definite */
+  a = le_krylov_gen( n, 0 );
+  zLEKrylovSetOp( &krylov, zLEKrylovOpSpMat, a );
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovPCG ) ) result_pcg = false;
+  iter_plain = krylov.iter_num;
+  zLEPrecondIC( &pc, a );
+  zLEKrylovSetPrecond( &krylov, zLEPrecondApply, &pc );
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovPCG ) ) result_pcg = false;
+  if( krylov.iter_num >= iter_plain ) result_pc = false;
+  zLEPrecondFree( &pc );
+  zLEPrecondSSOR( &pc, a, 1.2 );
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovPCG ) ) result_pcg = false;
+  if( krylov.iter_num >= iter_plain ) result_pc = false;
+  zLEPrecondFree( &pc );
+  zSpMatFree( a );
+  /* nonsymmetric */
+  a = le_krylov_gen( n, 0.5 );
+  zLEKrylovSetOp( &krylov, zLEKrylovOpSpMat, a );
+  zLEKrylovSetPrecond( &krylov, NULL, NULL );
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovGMRES ) ) result_gmres = false;
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovBiCGSTAB ) ) result_bicgstab = false;
+  zLEPrecondJacobi( &pc, a );
+  zLEKrylovSetPrecond( &krylov, zLEPrecondApply, &pc );
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovGMRES ) ) result_gmres = false;
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovBiCGSTAB ) ) result_bicgstab = false;
+  zLEPrecondFree( &pc );
+  zLEPrecondSSOR( &pc, a, 1.0 );
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovGMRES ) ) result_gmres = false;
+  if( !assert_le_krylov_check( &krylov, a, b, x, r, zLEKrylovBiCGSTAB ) ) result_bicgstab = false;
+  zLEPrecondFree( &pc );
+  zSpMatFree( a );
+  zLEKrylovFree( &krylov );
+  zVecFreeAtOnce( 3, b, x, r );
+  zAssert( zLEKrylovPCG, result_pcg );
+  zAssert( zLEKrylovGMRES, result_gmres );
+  zAssert( zLEKrylovBiCGSTAB, result_bicgstab );
+  zAssert( zLEPrecondIC + zLEPrecondSSOR, result_pc );
+}
+
 /* generalized linear equation solver (benchmarking) */
 
 void generate_equation_general(zMat a, zVec b, zVec w, zVec w2, zVec x, zVec _b)
@@ -866,6 +950,39 @@ void assert_mat_det_adj(void)
   zAssert( zMatAdj + zMatDet (matrix), result );
 }
 
+void assert_le_large(void)
+{
+  zMat a, acp, ai, m;
+  zVec b, x, r;
+  zIndex idx;
+  const int size = 200;
+  double det1, det2;
+
+  a = zMatAllocSqr( size );
+  ai = zMatAllocSqr( size );
+  m = zMatAllocSqr( size );
+  b = zVecAlloc( size );
+  x = zVecAlloc( size );
+  r = zVecAlloc( size );
+  idx = zIndexCreate( size );
+  zMatRandUniform( a, -10, 10 );
+  zVecRandUniform( b, -10, 10 );
+  zLESolveGauss( a, b, x );
+  zLEResidual( a, b, x, r );
+  zAssert( zLESolveGauss (large matrix), zVecIsTol( r, 1.0e-11 * ( 1 + zVecElemAbsMax( x, NULL ) ) ) );
+  zMatInv( a, ai );
+  zMulMatMat( a, ai, m );
+  zAssert( zMatInv (large matrix), zMatIsIdent( m, 1.0e-9 ) );
+  zMatMulDRC( a, 0.1 );
+  det1 = zMatDet( a );
+  acp = zMatClone( a );
+  det2 = zMatDetDST( acp, idx );
+  zAssert( zMatDet (large matrix), fabs( det1 - det2 ) < 1.0e-9 * fabs( det2 ) );
+  zMatFreeAtOnce( 4, a, acp, ai, m );
+  zVecFreeAtOnce( 3, b, x, r );
+  zIndexFree( idx );
+}
+
 int main(void)
 {
   zRandInit();
@@ -874,6 +991,7 @@ int main(void)
   assert_le();
   assert_le_mat_capacity();
   assert_le_gauss_seidel();
+  assert_le_krylov();
   assert_le_gen();
   assert_le_gen_aux();
   assert_le_mpnull();
@@ -887,5 +1005,6 @@ int main(void)
   assert_mat_mpinv_rand();
   assert_mpnull();
   assert_mat_det_adj();
+  assert_le_large();
   return EXIT_SUCCESS;
 }
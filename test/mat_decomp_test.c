@@ -81,6 +81,127 @@ bool assert_mat_decomp_cholesky(int rowsize, int colsize, int n)
   return count_success == n;
 }
 
+bool assert_mat_decomp_cholesky_large(int size, int rank)
+{
+  zMat m, mc, l, s;
+  zIndex index;
+  bool result;
+
+  m = zMatAllocSqr( size );
+  mc = zMatAllocSqr( size );
+  l = zMatAllocSqr( size );
+  s = zMatAlloc( size, rank );
+  index = zIndexAlloc( size );
+  zMatRandUniform( s, -1, 1 );
+  zMulMatMatT( s, s, m );
+  result = zMatDecompCholesky( m, l, index ) == rank;
+  zMulMatMatT( l, l, mc );
+  result = result && zMatEqual( m, mc, 1.0e-10 );
+  eprintf( "(%d x %d) rank=%d ", size, size, rank );
+  zMatFreeAtOnce( 4, m, mc, l, s );
+  zIndexFree( index );
+  return result;
+}
+
+void generate_sym_mat(zMat m, bool definite)
+{
+  int i, j;
+
+  zMatRandUniform( m, -1, 1 );
+  for( i=0; i<zMatRowSizeNC(m); i++ ){
+    for( j=0; j<i; j++ )
+      zMatSetElemNC( m, j, i, zMatElemNC(m,i,j) );
+    if( definite )
+      zMatElemNC(m,i,i) += zMatRowSizeNC(m);
+    else
+    if( i % 3 == 0 )
+      zMatSetElemNC( m, i, i, 0 );
+  }
+}
+
+bool check_facto_solve(zLEFacto *f, zMat m, zMat b, zMat x)
+{
+  zMat bc;
+  zVec bv, xv, res;
+  bool result;
+
+  bc = zMatAlloc( zMatRowSizeNC(b), zMatColSizeNC(b) );
+  bv = zVecAlloc( zMatRowSizeNC(b) );
+  xv = zVecAlloc( zMatRowSizeNC(b) );
+  res = zVecAlloc( zMatRowSizeNC(b) );
+  zLEFactoSolveMat( f, b, x );
+  zMulMatMat( m, x, bc );
+  result = zMatEqual( b, bc, 1.0e-9 );
+  zMatGetCol( b, 0, bv );
+  zLEFactoSolve( f, bv, xv );
+  zLEResidual( m, bv, xv, res );
+  result = result && zVecIsTol( res, 1.0e-9 );
+  zMatFree( bc );
+  zVecFreeAtOnce( 3, bv, xv, res );
+  return result;
+}
+
+bool assert_le_facto(int size, bool definite)
+{
+  zLEFacto f;
+  zMat m, b, x;
+  zVec v;
+  bool result;
+
+  m = zMatAllocSqr( size );
+  b = zMatAlloc( size, 5 );
+  x = zMatAlloc( size, 5 );
+  v = zVecAlloc( size );
+  zLEFactoAlloc( &f, size );
+  generate_sym_mat( m, definite );
+  zMatRandUniform( b, -10, 10 );
+  zVecRandUniform( v, -1, 1 );
+  result = definite ? zLEFactoCholesky( &f, m ) : zLEFactoLDL( &f, m );
+  result = result && check_facto_solve( &f, m, b, x );
+  if( size <= 10 )
+    result = result && zIsTol( zLEFactoDet( &f ) - zMatDet( m ), 1.0e-9 * fabs( zMatDet( m ) ) );
+  if( definite ){ /* update and downdate */
+    result = result && zLEFactoUpdate( &f, v, 2.0 );
+    zMatAddDyad( m, v, v ); zMatAddDyad( m, v, v );
+    result = result && check_facto_solve( &f, m, b, x );
+    result = result && zLEFactoUpdate( &f, v, -1.0 );
+    zMatSubDyad( m, v, v );
+    result = result && check_facto_solve( &f, m, b, x );
+  }
+  zLEFactoFree( &f );
+  zMatFreeAtOnce( 3, m, b, x );
+  zVecFree( v );
+  return result;
+}
+
+bool assert_le_facto_update_ldl(int size)
+{
+  zLEFacto f;
+  zMat m;
+  zVec v, b, x, res;
+  bool result;
+
+  m = zMatAllocSqr( size );
+  v = zVecAlloc( size );
+  b = zVecAlloc( size );
+  x = zVecAlloc( size );
+  res = zVecAlloc( size );
+  zLEFactoAlloc( &f, size );
+  generate_sym_mat( m, true );
+  zMatElemNC(m,0,0) = -zMatElemNC(m,0,0); /* indefinite but with 1x1 pivots */
+  zVecRandUniform( v, -1, 1 );
+  zVecRandUniform( b, -10, 10 );
+  result = zLEFactoLDL( &f, m ) && zLEFactoUpdate( &f, v, -0.5 );
+  zMatCatDyad( m, -0.5, v, v );
+  zLEFactoSolve( &f, b, x );
+  zLEResidual( m, b, x, res );
+  result = result && zVecIsTol( res, 1.0e-9 );
+  zLEFactoFree( &f );
+  zMatFree( m );
+  zVecFreeAtOnce( 4, v, b, x, res );
+  return result;
+}
+
 bool assert_mat_decomp_lu(int rowsize, int colsize, int rank, int n)
 {
   zMat mat, l, u;
@@ -103,6 +224,50 @@ bool assert_mat_decomp_lu(int rowsize, int colsize, int rank, int n)
   return count_success == n;
 }
 
+bool assert_mat_decomp_lu_large(int rowsize, int colsize)
+{
+  zMat mat, l, u, mat_check;
+  zIndex index;
+  bool result;
+
+  mat = zMatAlloc( rowsize, colsize );
+  l = zMatAlloc( rowsize, rowsize );
+  u = zMatAlloc( rowsize, colsize );
+  mat_check = zMatAlloc( rowsize, colsize );
+  index = zIndexAlloc( rowsize );
+  zMatRandUniform( mat, -10, 10 );
+  result = zMatDecompLU( mat, l, u, index ) == zMatMinSize( mat );
+  zMulMatMat( l, u, mat_check );
+  result = result && zMatEqual( mat, mat_check, zTOL * zMatElemAbsMax( mat, NULL, NULL ) * zMax( rowsize, colsize ) );
+  eprintf( "(%d x %d) ", rowsize, colsize );
+  zMatFreeAtOnce( 4, mat, l, u, mat_check );
+  zIndexFree( index );
+  return result;
+}
+
+bool assert_mat_decomp_lu_block(int size, int (* decomp)(zMat,zIndex))
+{
+  zMat mat, lu, x, b, b_check;
+  zIndex index;
+  bool result;
+
+  mat = zMatAllocSqr( size );
+  x = zMatAlloc( size, 3 );
+  b = zMatAlloc( size, 3 );
+  b_check = zMatAlloc( size, 3 );
+  index = zIndexCreate( size );
+  zMatRandUniform( mat, -10, 10 );
+  zMatRandUniform( b, -10, 10 );
+  lu = zMatClone( mat );
+  result = decomp( lu, index ) == size;
+  zLESolveLUBlockMat( lu, index, b, x );
+  zMulMatMat( mat, x, b_check );
+  result = result && zMatEqual( b, b_check, 1.0e-8 );
+  zMatFreeAtOnce( 5, mat, lu, x, b, b_check );
+  zIndexFree( index );
+  return result;
+}
+
 bool assert_mat_decomp_lq_one(int rowsize, int colsize, int rank, int n)
 {
   zMat mat, l, q;
@@ -197,6 +362,82 @@ bool assert_mat_decomp_lq_nullspace(int rowsize, int colsize, int rank, int n)
   return count_success == n;
 }
 
+bool assert_lq_facto(int rowsize, int colsize, int rank, bool pivot)
+{
+  zLQFacto f;
+  zMat mat, pmat, l, q, qm, qtm, qtm_check;
+  zVec v, qv, qv_check, b, ans, ans_check;
+  int i, j;
+  const double tol = 1.0e-8;
+  bool result;
+
+  mat = zMatAlloc( rowsize, colsize );
+  pmat = zMatAlloc( rowsize, colsize );
+  l = zMatAlloc( rowsize, rank );
+  q = zMatAlloc( rank, colsize );
+  qm = zMatAlloc( colsize, 3 );
+  qtm = zMatAlloc( colsize, 3 );
+  qtm_check = zMatAlloc( colsize, 3 );
+  v = zVecAlloc( colsize );
+  qv = zVecAlloc( colsize );
+  qv_check = zVecAlloc( colsize );
+  b = zVecAlloc( rowsize );
+  ans = zVecAlloc( colsize );
+  ans_check = zVecAlloc( colsize );
+  zLQFactoAlloc( &f, rowsize, colsize );
+  generate_matrix_composition( mat, rank );
+  result = zLQFactoDecomp( &f, mat, pivot ) == rank;
+  if( !result ) eprintf( "assigned rank = %d / detected rank = %d\n", rank, f.rank );
+  /* P A = L Q */
+  for( i=0; i<rowsize; i++ )
+    zRawVecCopy( zMatRowBufNC(mat,zIndexElemNC(f.idx,i)), zMatRowBufNC(pmat,i), colsize );
+  result = result && zLQFactoGetL( &f, l ) && zLQFactoGetQ( &f, q ) &&
+    check_matrix_composition( pmat, l, q, tol ) && check_matrix_orthogonality( q, rank, tol );
+  /* Q^T Q v = v */
+  zVecRandUniform( v, -10, 10 );
+  zLQFactoMulQ( &f, v, qv );
+  zLQFactoMulQT( &f, qv, qv_check );
+  result = result && zVecEqual( v, qv_check, tol );
+  /* compact WY representation vs. reflectors one-by-one */
+  zMatRandUniform( qm, -10, 10 );
+  zLQFactoMulQTMat( &f, qm, qtm );
+  for( j=0; j<3; j++ ){
+    zMatGetCol( qm, j, v );
+    zLQFactoMulQT( &f, v, qv );
+    zMatPutCol( qtm_check, j, qv );
+  }
+  result = result && zMatEqual( qtm, qtm_check, tol );
+  zLQFactoMulQMat( &f, qtm, qtm_check );
+  result = result && zMatEqual( qm, qtm_check, tol );
+  /* Moore-Penrose inverse solution */
+  zVecRandUniform( b, -10, 10 );
+  zLQFactoSolveMP( &f, b, ans );
+  zLESolveMP_SVD( mat, b, ans_check );
+  result = result && zVecEqual( ans, ans_check, tol * ( 1 + zVecElemAbsMax( ans_check, NULL ) ) );
+  eprintf( "(%d x %d) rank=%d ", rowsize, colsize, rank );
+  zLQFactoFree( &f );
+  zMatFreeAtOnce( 7, mat, pmat, l, q, qm, qtm, qtm_check );
+  zVecFreeAtOnce( 6, v, qv, qv_check, b, ans, ans_check );
+  return result;
+}
+
+bool assert_mat_decomp_qr_householder(int rowsize, int colsize)
+{
+  zMat mat, q, r;
+  bool result;
+
+  mat = zMatAlloc( rowsize, colsize );
+  q = zMatAlloc( rowsize, colsize );
+  r = zMatAllocSqr( colsize );
+  zMatRandUniform( mat, -10, 10 );
+  result = zMatDecompQR_Householder( mat, q, r ) == colsize &&
+    check_matrix_composition( mat, q, r, 1.0e-8 );
+  zMatTDRC( q );
+  result = result && check_matrix_orthogonality( q, colsize, 1.0e-10 );
+  zMatFreeAtOnce( 3, mat, q, r );
+  return result;
+}
+
 int main(void)
 {
   const int size_large = 8;
@@ -207,9 +448,16 @@ int main(void)
   zRandInit();
   zAssert( zMatDecompCholesky (8x5), assert_mat_decomp_cholesky( size_large, size_small, n ) );
   zAssert( zMatDecompCholesky (8x8), assert_mat_decomp_cholesky( size_large, size_large, n ) );
+  zAssert( zMatDecompCholesky (blocked), assert_mat_decomp_cholesky_large( 200, 200 ) && assert_mat_decomp_cholesky_large( 200, 150 ) );
+  zAssert( zLEFactoCholesky + zLEFactoUpdate, assert_le_facto( 8, true ) && assert_le_facto( 200, true ) );
+  zAssert( zLEFactoLDL, assert_le_facto( 8, false ) && assert_le_facto( 200, false ) );
+  zAssert( zLEFactoLDL + zLEFactoUpdate, assert_le_facto_update_ldl( 100 ) );
   zAssert( zMatDecompLU (5x8), assert_mat_decomp_lu( size_small, size_large, rank, n ) );
   zAssert( zMatDecompLU (8x5), assert_mat_decomp_lu( size_large, size_small, rank, n ) );
   zAssert( zMatDecompLU (8x8), assert_mat_decomp_lu( size_large, size_large, rank, n ) );
+  zAssert( zMatDecompLU (blocked), assert_mat_decomp_lu_large( 200, 200 ) && assert_mat_decomp_lu_large( 300, 150 ) && assert_mat_decomp_lu_large( 150, 300 ) );
+  zAssert( zMatDecompLUBlockDST + zLESolveLUBlockMat, assert_mat_decomp_lu_block( 300, zMatDecompLUBlockDST ) );
+  zAssert( zMatDecompLURecursiveDST + zLESolveLUBlockMat, assert_mat_decomp_lu_block( 300, zMatDecompLURecursiveDST ) );
   zAssert( zMatDecompLQ (5x8), assert_mat_decomp_lq_one( size_small, size_large, rank, n ) );
   zAssert( zMatDecompLQ (8x5), assert_mat_decomp_lq_one( size_large, size_small, rank, n ) );
   zAssert( zMatDecompLQ (8x8), assert_mat_decomp_lq_one( size_large, size_large, rank, n ) );
@@ -218,5 +466,8 @@ int main(void)
   zAssert( zMatDecompLQ_Householder (8x8), assert_mat_decomp_lq_householder_one( size_large, size_large, size_small, n ) );
   zAssert( zMatDecompLQNull (5x8), assert_mat_decomp_lq_nullspace( size_small, size_large, rank, n ) );
   zAssert( zMatDecompLQNull (8x5), assert_mat_decomp_lq_nullspace( size_large, size_small, rank, n ) );
+  zAssert( zLQFactoDecomp (blocked), assert_lq_facto( 150, 200, 150, false ) && assert_lq_facto( 200, 100, 100, false ) );
+  zAssert( zLQFactoDecomp (pivoted), assert_lq_facto( 120, 150, 70, true ) && assert_lq_facto( 150, 80, 50, true ) && assert_lq_facto( 100, 100, 100, true ) );
+  zAssert( zMatDecompQR_Householder, assert_mat_decomp_qr_householder( 200, 120 ) );
   return 0;
 }
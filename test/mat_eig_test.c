@@ -349,6 +349,114 @@ void assert_mat_sym_eig_random(void)
   zAssert( zMatSymEigJacobi (random), result_jacobi );
 }
 
+void mat_sym_rand(zMat m)
+{
+  int i, j;
+
+  for( i=0; i<zMatRowSizeNC(m); i++ )
+    for( j=i; j<zMatColSizeNC(m); j++ ){
+      zMatSetElemNC( m, i, j, zRandF(-10,10) );
+      zMatSetElemNC( m, j, i, zMatElemNC(m,i,j) );
+    }
+}
+
+bool check_mat_sym_eig_tol(zMat m, zVec eigval, zMat eigbase, double tol)
+{
+  zMat mv, vd, vtv;
+  int i, j;
+  bool result;
+
+  mv = zMatAlloc( zMatRowSizeNC(eigbase), zMatColSizeNC(eigbase) );
+  vd = zMatAlloc( zMatRowSizeNC(eigbase), zMatColSizeNC(eigbase) );
+  vtv = zMatAllocSqr( zMatColSizeNC(eigbase) );
+  zMulMatMat( m, eigbase, mv );
+  for( i=0; i<zMatRowSizeNC(vd); i++ )
+    for( j=0; j<zMatColSizeNC(vd); j++ )
+      zMatSetElemNC( vd, i, j, zMatElemNC(eigbase,i,j) * zVecElemNC(eigval,j) );
+  zMulMatTMat( eigbase, eigbase, vtv );
+  result = zMatEqual( mv, vd, tol * ( 1 + zVecElemAbsMax( eigval, NULL ) ) ) && zMatIsIdent( vtv, tol );
+  zMatFreeAtOnce( 3, mv, vd, vtv );
+  return result;
+}
+
+void assert_mat_sym_eig_tridiag(void)
+{
+  zMat m, q, t, tmp, eigbase, eigbase_k;
+  zVec d, e, eigval, eigval2, eigval_k;
+  const int n = 200, k = 5;
+  const double tol = 1.0e-9;
+  int i;
+  bool result1, result2, result3, result4, result5;
+
+  m = zMatAllocSqr( n );
+  q = zMatAllocSqr( n );
+  t = zMatAllocSqr( n );
+  tmp = zMatAllocSqr( n );
+  eigbase = zMatAllocSqr( n );
+  eigbase_k = zMatAlloc( n, k );
+  d = zVecAlloc( n );
+  e = zVecAlloc( n );
+  eigval = zVecAlloc( n );
+  eigval2 = zVecAlloc( n );
+  eigval_k = zVecAlloc( k );
+  mat_sym_rand( m );
+  /* Q^T M Q = T */
+  zMatSymTridiag( m, d, e, q );
+  zMulMatMat( m, q, tmp );
+  zMulMatTMat( q, tmp, t );
+  for( i=0; i<n; i++ ){
+    zMatElemNC(t,i,i) -= zVecElemNC(d,i);
+    if( i < n-1 ){
+      zMatElemNC(t,i+1,i) -= zVecElemNC(e,i);
+      zMatElemNC(t,i,i+1) -= zVecElemNC(e,i);
+    }
+  }
+  result1 = zMatIsTol( t, tol * zMatNorm(m) );
+  /* all eigenpairs */
+  result2 = zMatSymEigTridiag( m, eigval, eigbase ) && check_mat_sym_eig_tol( m, eigval, eigbase, tol );
+  for( i=1; i<n; i++ )
+    if( zVecElemNC(eigval,i-1) > zVecElemNC(eigval,i) ) result2 = false;
+  /* eigenvalues only */
+  result3 = zMatSymEigTridiag( m, eigval2, NULL ) && zVecEqual( eigval, eigval2, tol * zVecElemAbsMax( eigval, NULL ) );
+  /* extreme eigenpairs */
+  result4 = zMatSymEigExtreme( m, true, eigval_k, eigbase_k ) && check_mat_sym_eig_tol( m, eigval_k, eigbase_k, tol );
+  for( i=0; i<k; i++ )
+    if( !zIsTol( zVecElemNC(eigval_k,i) - zVecElemNC(eigval,n-1-i), tol * zVecElemAbsMax( eigval, NULL ) ) ) result4 = false;
+  result5 = zMatSymEigExtreme( m, false, eigval_k, eigbase_k ) && check_mat_sym_eig_tol( m, eigval_k, eigbase_k, tol );
+  for( i=0; i<k; i++ )
+    if( !zIsTol( zVecElemNC(eigval_k,i) - zVecElemNC(eigval,i), tol * zVecElemAbsMax( eigval, NULL ) ) ) result5 = false;
+  zMatFreeAtOnce( 6, m, q, t, tmp, eigbase, eigbase_k );
+  zVecFreeAtOnce( 5, d, e, eigval, eigval2, eigval_k );
+  zAssert( zMatSymTridiag, result1 );
+  zAssert( zMatSymEigTridiag, result2 );
+  zAssert( zMatSymEigTridiag (eigenvalues only), result3 );
+  zAssert( zMatSymEigExtreme (largest), result4 );
+  zAssert( zMatSymEigExtreme (smallest), result5 );
+}
+
+void assert_mat_sym_eig_tridiag_degenerate(void)
+{
+  zMat m, eigbase, eigbase_k;
+  zVec eigval, eigval_k;
+  const int n = 30;
+  int i;
+  bool result;
+
+  /* diagonal and clustered eigenvalues */
+  m = zMatAllocSqr( n );
+  eigbase = zMatAllocSqr( n );
+  eigbase_k = zMatAlloc( n, 4 );
+  eigval = zVecAlloc( n );
+  eigval_k = zVecAlloc( 4 );
+  for( i=0; i<n; i++ ) zMatSetElemNC( m, i, i, i % 3 );
+  result = zMatSymEigTridiag( m, eigval, eigbase ) && check_mat_sym_eig_tol( m, eigval, eigbase, 1.0e-10 ) &&
+    zMatSymEigExtreme( m, true, eigval_k, eigbase_k ) && check_mat_sym_eig_tol( m, eigval_k, eigbase_k, 1.0e-10 ) &&
+    zVecElemNC(eigval_k,3) == 2;
+  zMatFreeAtOnce( 3, m, eigbase, eigbase_k );
+  zVecFreeAtOnce( 2, eigval, eigval_k );
+  zAssert( zMatSymEigTridiag (degenerate), result );
+}
+
 bool assert_mat_svd_one(double a[], int n, int m)
 {
   zMat ma, u, v, s, tmp1, tmp2;
@@ -472,6 +580,93 @@ void assert_mat_svd_random(void)
   zAssert( zMatSVD (random case), result );
 }
 
+bool check_mat_svd_thin(zMat a, zMat u, zVec sv, zMat v, int k, double tol)
+{
+  zMat usv, utu, vvt;
+  int i, j;
+  bool result;
+
+  usv = zMatAlloc( zMatRowSizeNC(a), zMatColSizeNC(a) );
+  utu = zMatAllocSqr( k );
+  vvt = zMatAllocSqr( k );
+  for( i=0; i<zMatRowSizeNC(a); i++ )
+    for( j=0; j<k; j++ ) zMatElemNC(u,i,j) *= zVecElemNC(sv,j);
+  zMulMatMat( u, v, usv );
+  for( i=0; i<zMatRowSizeNC(a); i++ )
+    for( j=0; j<k; j++ ) zMatElemNC(u,i,j) /= zVecElemNC(sv,j);
+  zMulMatTMat( u, u, utu );
+  zMulMatMatT( v, v, vvt );
+  result = zMatEqual( usv, a, tol * zVecElemNC(sv,0) ) && zMatIsIdent( utu, tol ) && zMatIsIdent( vvt, tol );
+  zMatFreeAtOnce( 3, usv, utu, vvt );
+  return result;
+}
+
+void assert_mat_svd_thin(void)
+{
+  zMat a, u, v;
+  zVec sv, sv2;
+  int i, k;
+  bool result1 = true, result2 = true;
+
+  for( i=0; i<N; i++ ){
+    a = zMatAlloc( zRandI(1,60), zRandI(1,60) );
+    k = zMatMinSizeNC( a );
+    zMatRandUniform( a, -10, 10 );
+    u = zMatAlloc( zMatRowSizeNC(a), k );
+    v = zMatAlloc( k, zMatColSizeNC(a) );
+    sv = zVecAlloc( k );
+    sv2 = zVecAlloc( k );
+    if( zMatSVD( a, u, sv, v ) != k || !check_mat_svd_thin( a, u, sv, v, k, 1.0e-12 ) ) result1 = false;
+    if( !zMatSingularValue( a, sv2 ) || !zVecEqual( sv, sv2, 1.0e-12 * zVecElemNC(sv,0) ) ) result2 = false;
+    zMatFreeAtOnce( 3, a, u, v );
+    zVecFreeAtOnce( 2, sv, sv2 );
+  }
+  zAssert( zMatSVD (thin), result1 );
+  zAssert( zMatSingularValue, result2 );
+}
+
+void assert_mat_svd_rand(void)
+{
+  zMat a, u, v, uk, vk, av, us, ktk;
+  zVec sv, svk;
+  const int rowsize = 500, colsize = 120, rank = 8, k = 5;
+  const double tol = 1.0e-10;
+  int i, j;
+  bool result;
+
+  a = zMatAlloc( rowsize, colsize );
+  u = zMatAlloc( rowsize, rank );
+  v = zMatAlloc( rank, colsize );
+  uk = zMatAlloc( rowsize, k );
+  vk = zMatAlloc( k, colsize );
+  av = zMatAlloc( rowsize, k );
+  us = zMatAlloc( rowsize, k );
+  ktk = zMatAllocSqr( k );
+  sv = zVecAlloc( colsize );
+  svk = zVecAlloc( k );
+  /* exactly low-rank matrix */
+  zMatRandUniform( u, -1, 1 );
+  zMatRandUniform( v, -1, 1 );
+  zMulMatMat( u, v, a );
+  zMatSingularValue( a, sv );
+  result = zMatSVDRand( a, -1, -1, uk, svk, vk ) == k;
+  for( i=0; i<k; i++ )
+    if( !zIsTol( zVecElemNC(sv,i) - zVecElemNC(svk,i), tol * zVecElemNC(sv,0) ) ) result = false;
+  /* A v_i^T = s_i u_i */
+  zMulMatMatT( a, vk, av );
+  for( i=0; i<rowsize; i++ )
+    for( j=0; j<k; j++ )
+      zMatSetElemNC( us, i, j, zMatElemNC(uk,i,j) * zVecElemNC(svk,j) );
+  result = result && zMatEqual( av, us, tol * zVecElemNC(sv,0) );
+  zMulMatTMat( uk, uk, ktk );
+  result = result && zMatIsIdent( ktk, tol );
+  zMulMatMatT( vk, vk, ktk );
+  result = result && zMatIsIdent( ktk, tol );
+  zMatFreeAtOnce( 8, a, u, v, uk, vk, av, us, ktk );
+  zVecFreeAtOnce( 2, sv, svk );
+  zAssert( zMatSVDRand, result );
+}
+
 void assert_mat_svd_minmax(void)
 {
   zMat m, u, v;
@@ -514,8 +709,12 @@ int main(int argc, char *argv[])
   assert_mat_sym_eig_power();
   assert_mat_sym_eig();
   assert_mat_sym_eig_random();
+  assert_mat_sym_eig_tridiag();
+  assert_mat_sym_eig_tridiag_degenerate();
   assert_mat_svd();
   assert_mat_svd_random();
   assert_mat_svd_minmax();
+  assert_mat_svd_thin();
+  assert_mat_svd_rand();
   return 0;
 }
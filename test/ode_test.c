@@ -0,0 +1,912 @@
+#include <zm/zm.h>
+
+/* harmonic oscillator */
+zVec ode_test_osc(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, zVecElemNC(x,1) );
+  zVecSetElemNC( dx, 1, -zVecElemNC(x,0) );
+  return dx;
+}
+
+/* exact solution from (1,0) */
+zVec ode_test_osc_exact(double t, zVec x)
+{
+  zVecSetElemNC( x, 0, cos(t) );
+  zVecSetElemNC( x, 1, -sin(t) );
+  return x;
+}
+
+#define ODE_TEST_T_END 20.0
+
+bool check_ode_adapt(zODE *ode, double tol, bool fsal)
+{
+  zODEAdaptCtrl ctrl;
+  zVec x, xe, xd;
+  double t, t0, ts;
+  int n0;
+  bool result = true;
+
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  xe = zVecAlloc( 2 );
+  xd = zVecAlloc( 2 );
+  zODEAdaptCtrlInit( &ctrl );
+  zODEAdaptCtrlSetTol( &ctrl, tol, tol );
+  for( t=0; t<ODE_TEST_T_END; ){
+    t0 = t;
+    n0 = ctrl.eval_num;
+    if( !zODEStepAdaptERK( ode, &ctrl, &t, x, ODE_TEST_T_END, NULL ) ){
+      result = false;
+      break;
+    }
+    /* FSAL: no extra evaluation for the first stage after the first step */
+    if( fsal && t0 > 0 && ctrl.eval_num - n0 > 6*( ctrl.step_num + ctrl.reject_num ) ) result = false;
+    /* dense output at the middle of the step */
+    ts = 0.5 * ( t0 + t );
+    zODEDenseAdaptERK( ode, ts, xd, NULL );
+    if( zVecDist( xd, ode_test_osc_exact( ts, xe ) ) > 1000*tol ) result = false;
+  }
+  /* far fewer steps than the fixed steps satisfying the same tolerance */
+  if( zVecDist( x, ode_test_osc_exact( ODE_TEST_T_END, xe ) ) > 1000*tol || ctrl.step_num > 1000 ) result = false;
+  /* a time out of the last step */
+  eprintf( "(the following error is expected.)\n" );
+  if( zODEDenseAdaptERK( ode, 0, xd, NULL ) ) result = false;
+  zVecFreeAtOnce( 3, x, xe, xd );
+  return result;
+}
+
+void assert_ode_adapt(void)
+{
+  zODE ode;
+  zODEAdaptCtrl ctrl;
+  zVec x, xe;
+  bool result1, result2, result3, result4;
+
+  zODEAssign( &ode, RKF45, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  result1 = check_ode_adapt( &ode, 1.0e-8, false );
+  zODEDestroy( &ode );
+  zODEAssign( &ode, CK45, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  result2 = check_ode_adapt( &ode, 1.0e-8, false );
+  zODEDestroy( &ode );
+  zODEAssign( &ode, DP45, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  result3 = check_ode_adapt( &ode, 1.0e-8, true );
+  /* backward integration */
+  x = zVecAlloc( 2 );
+  xe = zVecAlloc( 2 );
+  zODEAdaptCtrlInit( &ctrl );
+  zODEAdaptCtrlSetTol( &ctrl, 1.0e-10, 1.0e-10 );
+  ode_test_osc_exact( 5.0, x );
+  result4 = zODEIntegrateAdaptERK( &ode, &ctrl, 5.0, x, 1.0, NULL ) &&
+    zVecDist( x, ode_test_osc_exact( 1.0, xe ) ) < 1.0e-7;
+  zVecFreeAtOnce( 2, x, xe );
+  zODEDestroy( &ode );
+  zAssert( zODEStepAdaptERK + zODEDenseAdaptERK (RKF45), result1 );
+  zAssert( zODEStepAdaptERK + zODEDenseAdaptERK (CK45), result2 );
+  zAssert( zODEStepAdaptERK + zODEDenseAdaptERK (DP45), result3 );
+  zAssert( zODEIntegrateAdaptERK (backward), result4 );
+}
+
+/* stiff linear system: x0' = -1000 ( x0 - cos t ) - sin t, x1' = -x1 + x0 */
+zVec ode_test_stiff(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, -1000*( zVecElemNC(x,0) - cos(t) ) - sin(t) );
+  zVecSetElemNC( dx, 1, -zVecElemNC(x,1) + zVecElemNC(x,0) );
+  return dx;
+}
+
+int ode_test_jac_count;
+zMat ode_test_stiff_jac(double t, zVec x, void *util, zMat j)
+{
+  ode_test_jac_count++;
+  zMatSetElemNC( j, 0, 0, -1000 ); zMatSetElemNC( j, 0, 1, 0 );
+  zMatSetElemNC( j, 1, 0, 1 );     zMatSetElemNC( j, 1, 1, -1 );
+  return j;
+}
+
+/* exact solution from (1,0) */
+zVec ode_test_stiff_exact(double t, zVec x)
+{
+  zVecSetElemNC( x, 0, cos(t) );
+  zVecSetElemNC( x, 1, 0.5*( cos(t) + sin(t) - exp(-t) ) );
+  return x;
+}
+
+double ode_test_stiff_error(zODE *ode, double dt)
+{
+  zVec x, xe;
+  double t, err;
+
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  xe = zVecAlloc( 2 );
+  for( t=0; t<1.0-zTOL; t+=dt )
+    zODEUpdate( ode, t, x, dt, NULL );
+  err = zVecDist( x, ode_test_stiff_exact( 1.0, xe ) );
+  zVecFreeAtOnce( 2, x, xe );
+  return err;
+}
+
+/* a tridiagonal nonlinear system */
+#define ODE_TEST_TRI_DIM 10
+zVec ode_test_tri(double t, zVec x, void *util, zVec dx)
+{
+  int i, n;
+  double v;
+
+  n = zVecSizeNC(x);
+  for( i=0; i<n; i++ ){
+    v = zVecElemNC(x,i);
+    v = -2*v - 0.1*v*v*v;
+    if( i > 0 ) v += zVecElemNC(x,i-1);
+    if( i < n-1 ) v += zVecElemNC(x,i+1);
+    zVecSetElemNC( dx, i, v );
+  }
+  return dx;
+}
+
+void assert_ode_ros(void)
+{
+  zODE ode;
+  zSpMat pattern;
+  zMat m;
+  zVec x1, x2;
+  double err1, err2, t, dt;
+  int i, jac_num;
+  bool result1, result2, result3, result4;
+
+  zODEAssign( &ode, Ros34, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_stiff );
+  ode_test_jac_count = 0;
+  zODESetJacobianRos34( &ode, ode_test_stiff_jac );
+  /* stable with a step far beyond the explicit stability limit */
+  err1 = ode_test_stiff_error( &ode, 0.02 );
+  err2 = ode_test_stiff_error( &ode, 0.01 );
+  result1 = err1 < 1.0e-5 && err2 < err1;
+  /* the Jacobian matrix and the decomposition are reused */
+  jac_num = zODEJacobianNumRos34( &ode );
+  result3 = jac_num == ode_test_jac_count && jac_num < 5 && zODEDecompNumRos34( &ode ) < 10;
+  zODEDestroy( &ode );
+  /* third-order convergence for a non-stiff system */
+  x1 = zVecAlloc( 2 );
+  x2 = zVecAlloc( 2 );
+  zODEAssign( &ode, Ros34, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  for( err1=0, i=0; i<2; i++ ){
+    zVecSetElemList( x1, 1.0, 0.0 );
+    dt = 0.05 / ( i + 1 );
+    for( t=0; t<1.0-zTOL; t+=dt ) zODEUpdate( &ode, t, x1, dt, NULL );
+    err2 = zVecDist( x1, ode_test_osc_exact( 1.0, x2 ) );
+    if( i == 0 ) err1 = err2;
+  }
+  result2 = err1 / err2 > 7;
+  zODEDestroy( &ode );
+  zVecFreeAtOnce( 2, x1, x2 );
+  /* finite-difference Jacobian matrix with column coloring */
+  x1 = zVecAlloc( ODE_TEST_TRI_DIM );
+  x2 = zVecAlloc( ODE_TEST_TRI_DIM );
+  zVecRandUniform( x1, -1, 1 );
+  zVecCopy( x1, x2 );
+  zODEAssign( &ode, Ros34, NULL, NULL );
+  zODECreate( &ode, ODE_TEST_TRI_DIM, 0, ode_test_tri );
+  for( i=0; i<10; i++ ) zODEUpdate( &ode, 0.1*i, x1, 0.1, NULL );
+  zODEDestroy( &ode );
+  m = zMatAllocSqr( ODE_TEST_TRI_DIM );
+  for( i=0; i<ODE_TEST_TRI_DIM; i++ ){
+    if( i > 0 ) zMatSetElemNC( m, i, i-1, 1 );
+    zMatSetElemNC( m, i, i, 1 );
+    if( i < ODE_TEST_TRI_DIM-1 ) zMatSetElemNC( m, i, i+1, 1 );
+  }
+  pattern = zSpMatFromMat( m, zTOL, ZM_SPMAT_CSR );
+  zMatFree( m );
+  zODEAssign( &ode, Ros34, NULL, NULL );
+  zODECreate( &ode, ODE_TEST_TRI_DIM, 0, ode_test_tri );
+  zODESetJacobianPatternRos34( &ode, pattern );
+  for( i=0; i<10; i++ ) zODEUpdate( &ode, 0.1*i, x2, 0.1, NULL );
+  result4 = zODEColorNumRos34( &ode ) == 3 && zVecEqual( x1, x2, 1.0e-6 );
+  zODEDestroy( &ode );
+  zSpMatFree( pattern );
+  zVecFreeAtOnce( 2, x1, x2 );
+  zAssert( zODEUpdateRos34, result1 );
+  zAssert( zODEUpdateRos34 (convergence), result2 );
+  zAssert( zODESetJacobianRos34, result3 );
+  zAssert( zODESetJacobianPatternRos34, result4 );
+}
+
+/* ensemble of harmonic oscillators with member-wise angular frequencies */
+#define ODE_TEST_ENS_NUM 300
+zMat ode_test_ens(const zVec t, const zMat x, int from, int to, void *util, zMat dx)
+{
+  double *omega;
+  int j;
+
+  omega = (double *)util;
+  for( j=from; j<to; j++ ){
+    zMatSetElemNC( dx, 0, j, zMatElemNC(x,1,j) );
+    zMatSetElemNC( dx, 1, j, -zSqr(omega[j])*zMatElemNC(x,0,j) );
+  }
+  return dx;
+}
+
+zVec ode_test_ens_single(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, zVecElemNC(x,1) );
+  zVecSetElemNC( dx, 1, -zSqr(*(double *)util)*zVecElemNC(x,0) );
+  return dx;
+}
+
+void assert_ode_ens(void)
+{
+  zODEEns ens;
+  zODE ode;
+  zODEAdaptCtrl ctrl;
+  zMat x1, x2;
+  zVec x;
+  double omega[ODE_TEST_ENS_NUM], t;
+  int i, j, step_num, eval_num;
+  bool result1 = true, result2, result3 = true, result4;
+
+  x1 = zMatAlloc( 2, ODE_TEST_ENS_NUM );
+  x2 = zMatAlloc( 2, ODE_TEST_ENS_NUM );
+  x = zVecAlloc( 2 );
+  for( j=0; j<ODE_TEST_ENS_NUM; j++ ){
+    omega[j] = zRandF( 0.1, 10 );
+    zMatSetElemNC( x1, 0, j, 1 );
+    zMatSetElemNC( x1, 1, j, 0 );
+  }
+  zMatCopy( x1, x2 );
+  zODEEnsCreate( &ens, 2, ODE_TEST_ENS_NUM, ode_test_ens );
+  /* identical with separate solvers */
+  for( i=0; i<100; i++ ) zODEEnsUpdateRK4( &ens, 0.01*i, x1, 0.01, omega );
+  zODEAssign( &ode, RK4, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_ens_single );
+  for( j=0; j<ODE_TEST_ENS_NUM; j++ ){
+    zVecSetElemList( x, 1.0, 0.0 );
+    for( i=0; i<100; i++ ) zODEUpdate( &ode, 0.01*i, x, 0.01, &omega[j] );
+    if( fabs( zMatElemNC(x1,0,j) - zVecElemNC(x,0) ) > zTOL || fabs( zMatElemNC(x1,1,j) - zVecElemNC(x,1) ) > zTOL )
+      result1 = false;
+  }
+  zODEDestroy( &ode );
+  /* independent of the number of threads */
+  zODEEnsSetThreadNum( &ens, 4 );
+  for( i=0; i<100; i++ ) zODEEnsUpdateRK4( &ens, 0.01*i, x2, 0.01, omega );
+  result2 = zMatEqual( x1, x2, 0 );
+  /* member-wise adaptive steps */
+  for( j=0; j<ODE_TEST_ENS_NUM; j++ ){
+    zMatSetElemNC( x1, 0, j, 1 );
+    zMatSetElemNC( x1, 1, j, 0 );
+  }
+  zMatCopy( x1, x2 );
+  zODEAdaptCtrlInit( &ctrl );
+  zODEAdaptCtrlSetTol( &ctrl, 1.0e-9, 1.0e-9 );
+  zODEEnsSetThreadNum( &ens, 1 );
+  t = 2.0;
+  if( !zODEEnsIntegrateAdaptDP45( &ens, &ctrl, 0, x1, t, omega ) ) result3 = false;
+  for( j=0; j<ODE_TEST_ENS_NUM; j++ )
+    if( fabs( zMatElemNC(x1,0,j) - cos(omega[j]*t) ) > 1.0e-6 ||
+        fabs( zMatElemNC(x1,1,j) + omega[j]*sin(omega[j]*t) ) > 1.0e-6*omega[j] ) result3 = false;
+  /* a slow member takes fewer steps than a fast one */
+  for( i=0, j=1; j<ODE_TEST_ENS_NUM; j++ )
+    if( omega[j] < omega[i] ) i = j;
+  for( j=0; j<ODE_TEST_ENS_NUM; j++ )
+    if( omega[j] > 2*omega[i] && ens._step_num[j] <= ens._step_num[i] ) result3 = false;
+  /* evaluations and the next trial step size are reported */
+  if( ctrl.eval_num < ODE_TEST_ENS_NUM + 6*( ctrl.step_num + ctrl.reject_num ) || ctrl.dt <= 0 ) result3 = false;
+  step_num = ctrl.step_num;
+  eval_num = ctrl.eval_num;
+  zODEAdaptCtrlInit( &ctrl );
+  zODEAdaptCtrlSetTol( &ctrl, 1.0e-9, 1.0e-9 );
+  zODEEnsSetThreadNum( &ens, 4 );
+  result4 = zODEEnsIntegrateAdaptDP45( &ens, &ctrl, 0, x2, t, omega ) &&
+    zMatEqual( x1, x2, 0 ) && ctrl.step_num == step_num && ctrl.eval_num == eval_num;
+  zODEEnsDestroy( &ens );
+  zMatFreeAtOnce( 2, x1, x2 );
+  zVecFree( x );
+  zAssert( zODEEnsUpdateRK4, result1 );
+  zAssert( zODEEnsUpdateRK4 (multithread), result2 );
+  zAssert( zODEEnsIntegrateAdaptDP45, result3 );
+  zAssert( zODEEnsIntegrateAdaptDP45 (multithread), result4 );
+}
+
+/* maximum error of dense output at the middle of steps, or -1 if it does not coincide at the ends. */
+double check_ode_dense(zODE *ode, double dt)
+{
+  zVec x, xp, xd, xe;
+  double t, err = 0;
+
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  xp = zVecAlloc( 2 );
+  xd = zVecAlloc( 2 );
+  xe = zVecAlloc( 2 );
+  for( t=0; t<1.0-zTOL; t+=dt ){
+    zVecCopy( x, xp );
+    zODEUpdate( ode, t, x, dt, NULL );
+    if( !zODEDense( ode, t, xd, NULL ) || !zVecEqual( xd, xp, zTOL ) ||
+        !zODEDense( ode, t+dt, xd, NULL ) || !zVecEqual( xd, x, zTOL ) ){
+      err = -1;
+      break;
+    }
+    zODEDense( ode, t+0.5*dt, xd, NULL );
+    err = zMax( err, zVecDist( xd, ode_test_osc_exact( t+0.5*dt, xe ) ) );
+  }
+  zVecFreeAtOnce( 4, x, xp, xd, xe );
+  return err;
+}
+
+#define ODE_TEST_DENSE_CHECK(type,step,tol) do{\
+  zODEAssign( &ode, type, NULL, NULL );\
+  zODECreate( &ode, 2, step, ode_test_osc );\
+  err = check_ode_dense( &ode, 0.1 );\
+  if( err < 0 || err > tol ){\
+    eprintf( "dense output of " #type ": %g\n", err );\
+    result1 = false;\
+  }\
+  zODEDestroy( &ode );\
+} while(0)
+
+void assert_ode_dense(void)
+{
+  zODE ode;
+  zVec x;
+  double err;
+  bool result1 = true, result2;
+
+  ODE_TEST_DENSE_CHECK( Euler,  0, 1.0e-1 );
+  ODE_TEST_DENSE_CHECK( Heun,   0, 1.0e-4 );
+  ODE_TEST_DENSE_CHECK( RK4,    0, 1.0e-5 );
+  ODE_TEST_DENSE_CHECK( RKG,    0, 1.0e-5 );
+  ODE_TEST_DENSE_CHECK( RKF45,  0, 1.0e-6 );
+  ODE_TEST_DENSE_CHECK( CK45,   0, 1.0e-6 );
+  ODE_TEST_DENSE_CHECK( DP45,   0, 1.0e-8 );
+  ODE_TEST_DENSE_CHECK( Adams,  3, 2.0e-2 );
+  ODE_TEST_DENSE_CHECK( BEuler, 0, 1.0e-1 );
+  ODE_TEST_DENSE_CHECK( TR,     0, 2.0e-3 );
+  ODE_TEST_DENSE_CHECK( Gauss,  0, 1.0e-6 );
+  ODE_TEST_DENSE_CHECK( Radau,  0, 1.0e-4 );
+  ODE_TEST_DENSE_CHECK( Ros34,  0, 1.0e-4 );
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  zODEAssign( &ode, Gear, NULL, NULL );
+  zODECreate( &ode, 2, 3, ode_test_osc );
+  zODEInitHistoryGear( &ode, x );
+  err = check_ode_dense( &ode, 0.1 );
+  if( err < 0 || err > 1.0e-1 ) result1 = false;
+  /* out of the last step */
+  eprintf( "(the following error is expected.)\n" );
+  result2 = !zODEDense( &ode, 2.0, x, NULL );
+  zODEDestroy( &ode );
+  zVecFree( x );
+  zAssert( zODEDense, result1 );
+  zAssert( zODEDense (out of range), result2 );
+}
+
+/* falling ball: x = ( height, velocity ) */
+#define ODE_TEST_G 9.8
+zVec ode_test_ball(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, zVecElemNC(x,1) );
+  zVecSetElemNC( dx, 1, -ODE_TEST_G );
+  return dx;
+}
+
+zVec ode_test_ball2(double t, zVec x, zVec v, void *util, zVec a)
+{
+  zVecSetElemNC( a, 0, -ODE_TEST_G );
+  return a;
+}
+
+double ode_test_ball_ground(double t, zVec x, void *util){ return zVecElemNC(x,0); }
+double ode_test_ball_apex(double t, zVec x, void *util){ return zVecElemNC(x,1); }
+double ode_test_ball_half(double t, zVec x, void *util){ return zVecElemNC(x,0) - 0.2; }
+double ode_test_ball2_ground(double t, zVec x, zVec v, void *util){ return zVecElemNC(x,0); }
+
+/* a stiff oscillator x'' = -100 x, for which an embedded Runge-Kutta method splits a large step */
+zVec ode_test_osc100(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, zVecElemNC(x,1) );
+  zVecSetElemNC( dx, 1, -100*zVecElemNC(x,0) );
+  return dx;
+}
+
+void assert_ode_event(void)
+{
+  zODE ode;
+  zODE2 ode2;
+  zODEEventMonitor mon;
+  zVec x, v;
+  double t, t_impact, t_apex, t_up = 0;
+  int i, term, bounce = 0, apex = 0, up = 0;
+  bool result1 = true, result2, result3, result4, result5;
+
+  /* bouncing ball with the coefficient of restitution 0.5 */
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  zODEAssign( &ode, RK4, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_ball );
+  zODEEventMonitorAlloc( &mon, 3, 2 );
+  zODEEventAssign( zODEEventMonitorEvent(&mon,0), ode_test_ball_ground, -1, true );
+  zODEEventAssign( zODEEventMonitorEvent(&mon,1), ode_test_ball_apex, -1, false );
+  zODEEventAssign( zODEEventMonitorEvent(&mon,2), ode_test_ball_half, 1, false );
+  zODEEventSetSolver( zODEEventMonitorEvent(&mon,1), zNLE_RF );
+  t_impact = sqrt( 2/ODE_TEST_G );
+  t_apex = 0;
+  for( t=0; bounce<3; ){
+    term = zODEUpdateEvent( &ode, &mon, &t, x, 0.1, NULL );
+    if( mon.ev[1].fired ){ /* apex */
+      apex++;
+      if( fabs( mon.ev[1].t - t_apex ) > 1.0e-8 ) result1 = false;
+    }
+    if( mon.ev[2].fired ){ /* rising across the half height */
+      up++;
+      t_up = mon.ev[2].t;
+    }
+    if( term == 0 ){
+      bounce++;
+      if( fabs( t - t_impact ) > 1.0e-8 || zVecElemNC(x,0) > 0 || zVecElemNC(x,0) < -1.0e-8 ) result1 = false;
+      /* bounce and predict the next apex and impact */
+      zVecSetElemNC( x, 1, -0.5*zVecElemNC(x,1) );
+      t_apex = t + zVecElemNC(x,1) / ODE_TEST_G;
+      t_impact = t + 2 * zVecElemNC(x,1) / ODE_TEST_G;
+    }
+  }
+  /* non-terminal events with a direction filter */
+  result2 = apex == 2 && up == 1 &&
+    fabs( t_up - sqrt( 2/ODE_TEST_G ) - ( 0.5*sqrt( 2*ODE_TEST_G ) - sqrt( 0.5*ODE_TEST_G - 2*ODE_TEST_G*0.2 ) ) / ODE_TEST_G ) < 1.0e-8;
+  zODEDestroy( &ode );
+  zODEEventMonitorFree( &mon );
+  /* localization with Hermite interpolation in a step of zODE2 */
+  v = zVecAlloc( 1 );
+  zVecFree( x );
+  x = zVecAlloc( 1 );
+  zVecSetElemNC( x, 0, 1.0 );
+  zODE2Assign( &ode2, Regular, NULL, NULL, NULL, NULL );
+  zODE2AssignRegular( &ode2, RK4 );
+  zODE2Create( &ode2, 1, 0, ode_test_ball2 );
+  zODEEventMonitorAlloc( &mon, 1, 1 );
+  zODE2EventAssign( zODEEventMonitorEvent(&mon,0), ode_test_ball2_ground, -1, true );
+  for( t=0, i=0; i<100; i++ )
+    if( zODE2UpdateEvent( &ode2, &mon, &t, x, v, 0.1, NULL ) == 0 ) break;
+  result3 = i < 100 && fabs( t - sqrt( 2/ODE_TEST_G ) ) < 1.0e-8 &&
+    fabs( zVecElemNC(v,0) + sqrt( 2*ODE_TEST_G ) ) < 1.0e-6;
+  /* the state just beyond the surface does not trigger the same event again */
+  result4 = zODE2UpdateEvent( &ode2, &mon, &t, x, v, 0.1, NULL ) == -1 && !mon.ev[0].fired;
+  zODE2Destroy( &ode2 );
+  zODEEventMonitorFree( &mon );
+  /* localization in a step split by an embedded Runge-Kutta method, and backward integration */
+  zVecFree( x );
+  x = zVecAlloc( 2 );
+  zODEAssign( &ode, DP45, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc100 );
+  zODEEventMonitorAlloc( &mon, 1, 2 );
+  zODEEventAssign( zODEEventMonitorEvent(&mon,0), ode_test_ball_ground, -1, true );
+  zVecSetElemList( x, 1.0, 0.0 );
+  t = 0;
+  result5 = zODEUpdateEvent( &ode, &mon, &t, x, 0.3, NULL ) == 0 &&
+    fabs( t - zPI/20 ) < 1.0e-6 && fabs( zVecElemNC(x,0) ) < 1.0e-6 && fabs( zVecElemNC(x,1) + 10 ) < 1.0e-4;
+  zVecSetElemList( x, 1.0, 0.0 );
+  for( t=0, i=0; i<100; i++ )
+    if( zODEUpdateEvent( &ode, &mon, &t, x, -0.01, NULL ) == 0 ) break;
+  result5 = result5 && i < 100 && fabs( t + zPI/20 ) < 1.0e-6 &&
+    zVecElemNC(x,0) <= 0 && zVecElemNC(x,0) > -1.0e-6 && fabs( zVecElemNC(x,1) - 10 ) < 1.0e-4;
+  zODEDestroy( &ode );
+  zODEEventMonitorFree( &mon );
+  zVecFreeAtOnce( 2, x, v );
+  zAssert( zODEUpdateEvent (terminal), result1 );
+  zAssert( zODEUpdateEvent (non-terminal), result2 );
+  zAssert( zODE2UpdateEvent, result3 );
+  zAssert( zODE2UpdateEvent (restart), result4 );
+  zAssert( zODEUpdateEvent (split step), result5 );
+}
+
+/* oscillator with an optional damping: x'' = -x - c x' */
+zVec ode_test_osc2(double t, zVec x, zVec v, void *util, zVec a)
+{
+  zVecSetElemNC( a, 0, -zVecElemNC(x,0) - ( util ? *(double *)util : 0 ) * zVecElemNC(v,0) );
+  return a;
+}
+
+/* charged particle in a uniform magnetic field along z-axis: x'' = x' x e_z */
+zVec ode_test_lorentz(double t, zVec x, zVec v, void *util, zVec a)
+{
+  zVecSetElemNC( a, 0, zVecElemNC(v,1) );
+  zVecSetElemNC( a, 1,-zVecElemNC(v,0) );
+  return a;
+}
+
+double ode_test_osc2_err(zODE2 *ode, double dt, double c)
+{
+  zVec x, v;
+  double t, w, xe;
+  int i, n;
+
+  x = zVecCreateList( 1, 1.0 );
+  v = zVecCreateList( 1, 0.0 );
+  n = (int)( 10.0 / dt + 0.5 );
+  for( t=0, i=0; i<n; i++, t+=dt )
+    zODE2Update( ode, t, x, v, dt, c > 0 ? &c : NULL );
+  /* exact solution of the underdamped oscillator */
+  w = sqrt( 1 - 0.25*c*c );
+  xe = exp( -0.5*c*10 ) * ( cos(w*10) + 0.5*c/w*sin(w*10) );
+  xe = fabs( zVecElemNC(x,0) - xe );
+  zVecFreeAtOnce( 2, x, v );
+  return xe;
+}
+
+#define ODE2_TEST_SPLIT_CHECK(method,ratio,c,result) do{ \
+  zODE2Assign( &ode, method, NULL, NULL, NULL, NULL ); \
+  zODE2Create( &ode, 1, 0, ode_test_osc2 ); \
+  e1 = ode_test_osc2_err( &ode, 0.1, c ); \
+  e2 = ode_test_osc2_err( &ode, 0.05, c ); \
+  if( e1 / e2 < (ratio) ) result = false; \
+  zODE2Destroy( &ode ); \
+} while(0)
+
+void assert_ode2_split(void)
+{
+  zODE2 ode;
+  zVec x, v;
+  double e1, e2, c = 0.2, t, dt = 0.5, emax = 0;
+  int i;
+  bool result1 = true, result2 = true, result3, result4;
+
+  /* orders of accuracy */
+  ODE2_TEST_SPLIT_CHECK( Verlet,     3.5, 0, result1 );
+  ODE2_TEST_SPLIT_CHECK( Yoshida4,  14.0, 0, result1 );
+  ODE2_TEST_SPLIT_CHECK( ForestRuth,14.0, 0, result1 );
+  ODE2_TEST_SPLIT_CHECK( Yoshida6,  50.0, 0, result1 );
+  /* velocity-dependent force */
+  ODE2_TEST_SPLIT_CHECK( Verlet,     3.5, c, result2 );
+  ODE2_TEST_SPLIT_CHECK( Yoshida4,  14.0, c, result2 );
+  ODE2_TEST_SPLIT_CHECK( ForestRuth,14.0, c, result2 );
+  /* bounded energy error with a large step */
+  zODE2Assign( &ode, Yoshida4, NULL, NULL, NULL, NULL );
+  zODE2Create( &ode, 1, 0, ode_test_osc2 );
+  zODE2SetFixedPoint( &ode, 0, zTOL );
+  x = zVecCreateList( 1, 1.0 );
+  v = zVecCreateList( 1, 0.0 );
+  for( t=0, i=0; i<10000; i++, t+=dt ){
+    zODE2Update( &ode, t, x, v, dt, NULL );
+    emax = zMax( emax, fabs( zSqr(zVecElemNC(x,0)) + zSqr(zVecElemNC(v,0)) - 1 ) );
+  }
+  result3 = emax < 1.0e-2;
+  zVecFreeAtOnce( 2, x, v );
+  zODE2Destroy( &ode );
+  /* kinetic energy under the Lorentz force */
+  zODE2Assign( &ode, Verlet, NULL, NULL, NULL, NULL );
+  zODE2Create( &ode, 3, 0, ode_test_lorentz );
+  zODE2SetFixedPoint( &ode, 100, zTOL );
+  x = zVecCreateList( 3, 0.0, 0.0, 0.0 );
+  v = zVecCreateList( 3, 1.0, 0.0, 0.5 );
+  for( emax=0, t=0, i=0; i<10000; i++, t+=dt ){
+    zODE2Update( &ode, t, x, v, dt, NULL );
+    emax = zMax( emax, fabs( zVecSqrNorm(v) - 1.25 ) );
+  }
+  result4 = emax < 1.0e-2;
+  zVecFreeAtOnce( 2, x, v );
+  zODE2Destroy( &ode );
+  zAssert( zODE2UpdateVerlet + zODE2UpdateYoshida4 + zODE2UpdateYoshida6 + zODE2UpdateForestRuth (order), result1 );
+  zAssert( zODE2UpdateVerlet + zODE2UpdateYoshida4 + zODE2UpdateForestRuth (velocity-dependent), result2 );
+  zAssert( zODE2UpdateYoshida4 (energy), result3 );
+  zAssert( zODE2UpdateVerlet (Lorentz force), result4 );
+}
+
+/* harmonic oscillator on raw arrays */
+void ode_test_osc_raw(double t, const double *x, void *util, double *dx)
+{
+  dx[0] = x[1];
+  dx[1] = -x[0];
+  if( util ) (*(int *)util)++;
+}
+
+zODERawDefineRK4( ode_test_rk4_fixed, 2, ode_test_osc_raw )
+
+/* concatenation equivalent to the default one to go through the generic path */
+zVec ode_test_cat(zVec x, double dt, zVec dx, zVec xn, void *util)
+{
+  return zVecCatNC( x, dt, dx, xn );
+}
+
+#define ODE_TEST_RAW_N 200
+
+void assert_ode_raw(void)
+{
+  zODE ode, ode_gen;
+  zODERaw raw;
+  zVec x, x_gen;
+  double xr[2], xs[2], t, dt = 0.05;
+  int i, count = 0;
+  bool result1 = true, result2 = true, result3;
+
+  /* classical Runge-Kutta method */
+  zODEAssign( &ode, RK4, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  zODEAssign( &ode_gen, RK4, ode_test_cat, NULL );
+  zODECreate( &ode_gen, 2, 0, ode_test_osc );
+  zODERawCreate( &raw, 2, ode_test_osc_raw );
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  x_gen = zVecCreateList( 2, 1.0, 0.0 );
+  xr[0] = xs[0] = 1.0; xr[1] = xs[1] = 0.0;
+  for( t=0, i=0; i<ODE_TEST_RAW_N; i++, t+=dt ){
+    zODEUpdate( &ode, t, x, dt, NULL );
+    zODEUpdate( &ode_gen, t, x_gen, dt, NULL );
+    zODERawUpdateRK4( &raw, t, xr, dt, NULL );
+    ode_test_rk4_fixed( t, xs, dt, NULL );
+  }
+  for( i=0; i<2; i++ )
+    if( !zIsTiny( zVecElemNC(x,i) - zVecElemNC(x_gen,i) ) ||
+        !zIsTiny( zVecElemNC(x,i) - xr[i] ) || !zIsTiny( xr[i] - xs[i] ) ) result1 = false;
+  zODEDestroy( &ode );
+  zODEDestroy( &ode_gen );
+  /* Dormand-Prince method */
+  zODEAssign( &ode, DP45, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  zODEAssign( &ode_gen, DP45, ode_test_cat, NULL );
+  zODECreate( &ode_gen, 2, 0, ode_test_osc );
+  zVecSetElemList( x, 1.0, 0.0 );
+  zVecSetElemList( x_gen, 1.0, 0.0 );
+  xr[0] = 1.0; xr[1] = 0.0;
+  for( t=0, i=0; i<ODE_TEST_RAW_N; i++, t+=dt ){
+    zODEUpdate( &ode, t, x, dt, NULL );
+    zODEUpdate( &ode_gen, t, x_gen, dt, NULL );
+    zODERawUpdateDP45( &raw, t, xr, dt, &count );
+    if( raw.err > 1.0e-8 ) result2 = false;
+  }
+  for( i=0; i<2; i++ )
+    if( !zIsTiny( zVecElemNC(x,i) - zVecElemNC(x_gen,i) ) ||
+        !zIsTiny( zVecElemNC(x,i) - xr[i] ) ) result2 = false;
+  /* the first-same-as-last property */
+  result3 = count == 1 + 6*ODE_TEST_RAW_N;
+  zODERawDestroy( &raw );
+  zODEDestroy( &ode );
+  zODEDestroy( &ode_gen );
+  zVecFreeAtOnce( 2, x, x_gen );
+  zAssert( zODEUpdateRK4 + zODERawUpdateRK4 + zODERawDefineRK4, result1 );
+  zAssert( zODEUpdateDP45 + zODERawUpdateDP45, result2 );
+  zAssert( zODERawUpdateDP45 (FSAL), result3 );
+}
+
+#define ODE_TEST_PARAREAL_NUM 8
+
+void assert_ode_parareal(void)
+{
+  zODE coarse, fine, ode;
+  zODEParareal pr;
+  zVec x, xs;
+  double t, dt = 0.01, tend = ODE_TEST_T_END;
+  int i;
+  bool result1, result2;
+
+  zODEAssign( &coarse, RK4, NULL, NULL );
+  zODEAssign( &fine, RK4, ode_test_cat, NULL );
+  zODEPararealCreate( &pr, &coarse, &fine, 2, 0, ODE_TEST_PARAREAL_NUM, ode_test_osc );
+  zODEPararealSetThreadNum( &pr, 4 );
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  zODEPararealIntegrate( &pr, 0, x, tend, 0.5, dt, NULL );
+  /* sequential fine integration */
+  zODEAssign( &ode, RK4, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_osc );
+  xs = zVecCreateList( 2, 1.0, 0.0 );
+  for( t=0, i=0; i<(int)( tend/dt + 0.5 ); i++, t+=dt )
+    zODEUpdate( &ode, t, xs, dt, NULL );
+  result1 = zVecDist( x, xs ) < 1.0e-7;
+  /* convergence before the worst case, which is identical with the sequential integration */
+  result2 = pr.iter_num < ODE_TEST_PARAREAL_NUM;
+  zODEDestroy( &ode );
+  zODEPararealDestroy( &pr );
+  zVecFreeAtOnce( 2, x, xs );
+  zAssert( zODEPararealIntegrate, result1 );
+  zAssert( zODEPararealIntegrate (iteration), result2 );
+}
+
+double check_ode_ridc(zODERIDC *ridc, double dt, int thread_num, zVec x)
+{
+  double tend = 2.0;
+
+  zODERIDCSetThreadNum( ridc, thread_num );
+  zVecSetElemList( x, 1.0, 0.0 );
+  zODERIDCIntegrate( ridc, 0, x, tend, dt, NULL );
+  return sqrt( zSqr( zVecElemNC(x,0) - cos(tend) ) + zSqr( zVecElemNC(x,1) + sin(tend) ) );
+}
+
+void assert_ode_ridc(void)
+{
+  zODERIDC ridc;
+  zVec x, xs;
+  double e1, e2;
+  bool result1, result2, result3;
+
+  x = zVecAlloc( 2 );
+  xs = zVecAlloc( 2 );
+  /* predictor only */
+  zODERIDCCreate( &ridc, 2, 0, 0, ode_test_osc );
+  e1 = check_ode_ridc( &ridc, 0.02, 1, x );
+  e2 = check_ode_ridc( &ridc, 0.01, 1, x );
+  result1 = e1 / e2 > 1.8 && e1 / e2 < 2.2;
+  zODERIDCDestroy( &ridc );
+  /* fourth order with three sweeps over several blocks */
+  zODERIDCCreate( &ridc, 2, 3, 10, ode_test_osc );
+  e1 = check_ode_ridc( &ridc, 0.02, 1, x );
+  e2 = check_ode_ridc( &ridc, 0.01, 1, xs );
+  result2 = e1 / e2 > 12 && e2 < 1.0e-8;
+  /* independent of the number of threads */
+  check_ode_ridc( &ridc, 0.01, 4, x );
+  result3 = zVecEqual( x, xs, 0 );
+  zODERIDCDestroy( &ridc );
+  zVecFreeAtOnce( 2, x, xs );
+  zAssert( zODERIDCIntegrate (predictor), result1 );
+  zAssert( zODERIDCIntegrate (corrected), result2 );
+  zAssert( zODERIDCIntegrate (multithread), result3 );
+}
+
+/* damped oscillator split into the explicit spring and the implicit damper */
+#define ODE_TEST_DAMP 0.2
+zVec ode_test_spring(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, zVecElemNC(x,1) );
+  zVecSetElemNC( dx, 1,-zVecElemNC(x,0) );
+  return dx;
+}
+
+zVec ode_test_damper(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, 0 );
+  zVecSetElemNC( dx, 1,-ODE_TEST_DAMP*zVecElemNC(x,1) );
+  return dx;
+}
+
+/* Prothero-Robinson problem x' = lambda ( x - cos t ) - sin t */
+#define ODE_TEST_LAMBDA ( -1.0e6 )
+zVec ode_test_pr_stiff(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, ODE_TEST_LAMBDA*( zVecElemNC(x,0) - cos(t) ) );
+  return dx;
+}
+
+zVec ode_test_pr_nonstiff(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, -sin(t) );
+  return dx;
+}
+
+zMat ode_test_pr_jac(double t, zVec x, void *util, zMat j)
+{
+  zMatSetElemNC( j, 0, 0, ODE_TEST_LAMBDA );
+  return j;
+}
+
+double ode_test_imex_err(zODEIMEX *ode, zVec (* update)(zODEIMEX*,double,zVec,double,void*), double dt)
+{
+  zVec x;
+  double t, w, xe;
+  int i, n;
+
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  n = (int)( 10.0 / dt + 0.5 );
+  for( t=0, i=0; i<n; i++, t+=dt )
+    update( ode, t, x, dt, NULL );
+  w = sqrt( 1 - 0.25*zSqr(ODE_TEST_DAMP) );
+  xe = exp( -0.5*ODE_TEST_DAMP*10 ) * ( cos(w*10) + 0.5*ODE_TEST_DAMP/w*sin(w*10) );
+  xe = fabs( zVecElemNC(x,0) - xe );
+  zVecFree( x );
+  return xe;
+}
+
+void assert_ode_imex(void)
+{
+  zODEIMEX ode;
+  zVec x;
+  double t, dt = 0.1;
+  int i, n = 100;
+  bool result1, result2, result3, result4;
+
+  /* orders of accuracy */
+  zODEIMEXCreate( &ode, 2, ode_test_spring, ode_test_damper, NULL );
+  result1 = ode_test_imex_err( &ode, zODEIMEXUpdateARS222, 0.1 ) / ode_test_imex_err( &ode, zODEIMEXUpdateARS222, 0.05 ) > 3.5;
+  result2 = ode_test_imex_err( &ode, zODEIMEXUpdateARK324, 0.1 ) / ode_test_imex_err( &ode, zODEIMEXUpdateARK324, 0.05 ) > 7.0;
+  zODEIMEXDestroy( &ode );
+  /* a stiff linear part with a large step */
+  zODEIMEXCreate( &ode, 1, ode_test_pr_nonstiff, ode_test_pr_stiff, ode_test_pr_jac );
+  zODEIMEXSetLinear( &ode, true );
+  x = zVecCreateList( 1, 1.0 );
+  for( t=0, i=0; i<n; i++, t+=dt )
+    zODEIMEXUpdateARK324( &ode, t, x, dt, NULL );
+  /* stable with lambda dt = -1.0e5, with the stiff-limit error of the explicit part O(dt^2) */
+  result3 = fabs( zVecElemNC(x,0) - cos(n*dt) ) < 5.0e-3;
+  /* the linear part is factorized only once and solved by one Newton step a stage */
+  result4 = ode.decomp_num == 1 && ode.fi_num == 4*n && ode.fe_num == 4*n;
+  zVecFree( x );
+  zODEIMEXDestroy( &ode );
+  zAssert( zODEIMEXUpdateARS222 + zODEIMEXUpdateARK324 (order), result1 && result2 );
+  zAssert( zODEIMEXUpdateARK324 (stiff), result3 );
+  zAssert( zODEIMEXUpdateARK324 (linear), result4 );
+}
+
+/* a fast stiff part and a slow part */
+zVec ode_test_mr_fast(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, -50*( zVecElemNC(x,0) - zVecElemNC(x,1) ) );
+  zVecSetElemNC( dx, 1, 0 );
+  return dx;
+}
+
+zVec ode_test_mr_slow(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, 0 );
+  zVecSetElemNC( dx, 1, -sin( zVecElemNC(x,0) ) + cos(t) );
+  return dx;
+}
+
+zVec ode_test_mr_full(double t, zVec x, void *util, zVec dx)
+{
+  zVecSetElemNC( dx, 0, -50*( zVecElemNC(x,0) - zVecElemNC(x,1) ) );
+  zVecSetElemNC( dx, 1, -sin( zVecElemNC(x,0) ) + cos(t) );
+  return dx;
+}
+
+double ode_test_mr_err(zODEMR *ode, zVec (* update)(zODEMR*,double,zVec,double,void*), zVec xr, double dt)
+{
+  zVec x;
+  double t, e;
+  int i, n;
+
+  x = zVecCreateList( 2, 1.0, 0.0 );
+  n = (int)( 2.0 / dt + 0.5 );
+  for( t=0, i=0; i<n; i++, t+=dt )
+    update( ode, t, x, dt, NULL );
+  e = zVecDist( x, xr );
+  zVecFree( x );
+  return e;
+}
+
+void assert_ode_mr(void)
+{
+  zODE fast, ode;
+  zODEMR mr;
+  zVec xr;
+  double t, dt = 1.0e-4;
+  int i;
+  bool result1, result2, result3, result4;
+
+  /* reference solution */
+  zODEAssign( &ode, RK4, NULL, NULL );
+  zODECreate( &ode, 2, 0, ode_test_mr_full );
+  xr = zVecCreateList( 2, 1.0, 0.0 );
+  for( t=0, i=0; i<(int)( 2.0/dt + 0.5 ); i++, t+=dt )
+    zODEUpdate( &ode, t, xr, dt, NULL );
+  zODEDestroy( &ode );
+
+  zODEAssign( &fast, RK4, NULL, NULL );
+  zODEMRCreate( &mr, &fast, 2, 0, ode_test_mr_fast, ode_test_mr_slow, 100 );
+  result1 = ode_test_mr_err( &mr, zODEMRUpdateERK22a, xr, 0.05 ) / ode_test_mr_err( &mr, zODEMRUpdateERK22a, xr, 0.025 ) > 3.5;
+  result2 = ode_test_mr_err( &mr, zODEMRUpdateERK22b, xr, 0.05 ) / ode_test_mr_err( &mr, zODEMRUpdateERK22b, xr, 0.025 ) > 3.5;
+  /* the slow part is evaluated twice per step */
+  mr.fs_num = 0;
+  ode_test_mr_err( &mr, zODEMRUpdateERK22a, xr, 0.1 );
+  result3 = mr.fs_num == 2*20;
+  zODEMRDestroy( &mr );
+  /* a multistep solver of the fast part */
+  zODEAssign( &fast, Adams, NULL, NULL );
+  zODEMRCreate( &mr, &fast, 2, 3, ode_test_mr_fast, ode_test_mr_slow, 100 );
+  result4 = ode_test_mr_err( &mr, zODEMRUpdateERK22a, xr, 0.05 ) / ode_test_mr_err( &mr, zODEMRUpdateERK22a, xr, 0.025 ) > 3.5;
+  zODEMRDestroy( &mr );
+  zVecFree( xr );
+  zAssert( zODEMRUpdateERK22a, result1 );
+  zAssert( zODEMRUpdateERK22b, result2 );
+  zAssert( zODEMRUpdateERK22a (slow evaluation), result3 );
+  zAssert( zODEMRUpdateERK22a (multistep fast solver), result4 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_ode_adapt();
+  assert_ode_ros();
+  assert_ode_imex();
+  assert_ode_mr();
+  assert_ode_ens();
+  assert_ode_dense();
+  assert_ode_event();
+  assert_ode2_split();
+  assert_ode_raw();
+  assert_ode_parareal();
+  assert_ode_ridc();
+  return 0;
+}
@@ -78,9 +78,159 @@ void assert_lcp_lemke(void)
   zAssert( zLCPSolveLemke (regular case), result );
 }
 
+bool generate_lcp_spd(int n, zMat *m)
+{
+  zMat r;
+  int i;
+
+  *m = zMatAllocSqr( n );
+  r = zMatAllocSqr( n );
+  if( !*m || !r ){
+    zMatFreeAtOnce( 2, *m, r );
+    return false;
+  }
+  zMatRandUniform( r, -1, 1 );
+  zMulMatTMat( r, r, *m );
+  for( i=0; i<n; i++ )
+    zMatElemNC(*m,i,i) += n;
+  zMatFree( r );
+  return true;
+}
+
+bool generate_lcp_pgs(int n, zMat *m, zVec *p, zVec *w_ans, zVec *z_ans)
+{
+  zVec mz;
+  int i;
+
+  if( !generate_lcp_spd( n, m ) ) return false;
+  *p = zVecAlloc( n );
+  *w_ans = zVecAlloc( n );
+  *z_ans = zVecAlloc( n );
+  mz = zVecAlloc( n );
+  if( !*p || !*w_ans || !*z_ans || !mz ){
+    zMatFree( *m );
+    zVecFreeAtOnce( 4, *p, *w_ans, *z_ans, mz );
+    return false;
+  }
+  for( i=0; i<n; i++ ){
+    if( zRandI(0,1) == 0 )
+      zVecSetElemNC( *z_ans, i, zRandF( 0, 10 ) );
+    else
+      zVecSetElemNC( *w_ans, i, zRandF( 0, 10 ) );
+  }
+  zMulMatVec( *m, *z_ans, mz );
+  zVecSub( *w_ans, mz, *p );
+  zVecFree( mz );
+  return true;
+}
+
+bool generate_lcp_friction(int n, zMat *m, zVec *p, zVec *mu, zVec *w_ans, zVec *z_ans)
+{
+  zVec mz;
+  double mu_k, s, d[2], dn;
+  int k, b;
+
+  if( !generate_lcp_spd( 3*n, m ) ) return false;
+  *p = zVecAlloc( 3*n );
+  *mu = zVecAlloc( n );
+  *w_ans = zVecAlloc( 3*n );
+  *z_ans = zVecAlloc( 3*n );
+  mz = zVecAlloc( 3*n );
+  if( !*p || !*mu || !*w_ans || !*z_ans || !mz ){
+    zMatFree( *m );
+    zVecFreeAtOnce( 5, *p, *mu, *w_ans, *z_ans, mz );
+    return false;
+  }
+  for( k=0; k<n; k++ ){
+    b = 3 * k;
+    zVecSetElemNC( *mu, k, ( mu_k = zRandF( 0.1, 1.0 ) ) );
+    d[0] = zRandF( -1, 1 );
+    d[1] = zRandF( -1, 1 );
+    dn = sqrt( zSqr(d[0]) + zSqr(d[1]) ) + zTOL;
+    d[0] /= dn;
+    d[1] /= dn;
+    switch( zRandI(0,2) ){
+    case 0: /* separated */
+      s = zRandF( 0, 10 );
+      zVecSetElemNC( *w_ans, b+1, s*d[0] );
+      zVecSetElemNC( *w_ans, b+2, s*d[1] );
+      zVecSetElemNC( *w_ans, b, mu_k*s + zRandF( 0.1, 10 ) );
+      break;
+    case 1: /* sticking */
+      s = zRandF( 1, 10 );
+      zVecSetElemNC( *z_ans, b, s );
+      zVecSetElemNC( *z_ans, b+1, zRandF( 0, 0.9 ) * mu_k * s * d[0] );
+      zVecSetElemNC( *z_ans, b+2, zRandF( 0, 0.9 ) * mu_k * s * d[1] );
+      break;
+    default: /* sliding */
+      s = zRandF( 1, 10 );
+      zVecSetElemNC( *z_ans, b, s );
+      zVecSetElemNC( *z_ans, b+1, mu_k * s * d[0] );
+      zVecSetElemNC( *z_ans, b+2, mu_k * s * d[1] );
+      s = zRandF( 0.1, 10 );
+      zVecSetElemNC( *w_ans, b, mu_k * s );
+      zVecSetElemNC( *w_ans, b+1, -s * d[0] );
+      zVecSetElemNC( *w_ans, b+2, -s * d[1] );
+    }
+  }
+  zMulMatVec( *m, *z_ans, mz );
+  zVecSub( *w_ans, mz, *p );
+  zVecFree( mz );
+  return true;
+}
+
+void assert_lcp_pgs(void)
+{
+  zLCPPGS pgs;
+  zMat m;
+  zVec p, mu, w, z, w_ans, z_ans;
+  const int n = 50;
+  const double tol = 1.0e-6;
+  int num_trial = 10, iter_cold, iter_warm;
+  bool result = true, result_warm = true, result_rt = true, result_friction = true;
+
+  zLCPPGSInit( &pgs );
+  for( ; num_trial>0; num_trial-- ){
+    if( !generate_lcp_pgs( n, &m, &p, &w_ans, &z_ans ) ) return;
+    w = zVecAlloc( n );
+    z = zVecAlloc( n );
+    if( !zLCPSolvePGS( m, p, w, z ) ) result = false;
+    check_answer( w, z, w_ans, z_ans, tol, &result );
+    /* warm start for a perturbed problem */
+    zVecZero( z );
+    zLCPPGSSolve( &pgs, m, p, w, z );
+    iter_cold = pgs.iter_num;
+    zVecSetElemNC( p, 0, zVecElemNC(p,0) + 1.0e-3 );
+    zLCPPGSSolve( &pgs, m, p, w, z );
+    iter_warm = pgs.iter_num;
+    if( iter_warm >= iter_cold ) result_warm = false;
+    /* real-time mode */
+    pgs.tol = 0;
+    pgs.iter_max = 5;
+    zVecZero( z );
+    if( !zLCPPGSSolve( &pgs, m, p, w, z ) || pgs.iter_num != 5 || !( pgs.residual > 0 ) ) result_rt = false;
+    zLCPPGSInit( &pgs );
+    zMatFree( m );
+    zVecFreeAtOnce( 5, p, w, z, w_ans, z_ans );
+
+    if( !generate_lcp_friction( n/5, &m, &p, &mu, &w_ans, &z_ans ) ) return;
+    w = zVecAlloc( n/5*3 );
+    z = zVecAlloc( n/5*3 );
+    if( !zLCPPGSSolveFriction( &pgs, m, p, mu, w, z ) ) result_friction = false;
+    check_answer( w, z, w_ans, z_ans, tol, &result_friction );
+    zMatFree( m );
+    zVecFreeAtOnce( 6, p, mu, w, z, w_ans, z_ans );
+  }
+  zAssert( zLCPSolvePGS (regular case), result );
+  zAssert( zLCPPGSSolve (warm start), result_warm );
+  zAssert( zLCPPGSSolve (real-time mode), result_rt );
+  zAssert( zLCPPGSSolveFriction, result_friction );
+}
+
 int main(void)
 {
   zRandInit();
   assert_lcp_lemke();
+  assert_lcp_pgs();
   return 0;
 }
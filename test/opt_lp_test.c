@@ -82,6 +82,132 @@ void assert_lp_simplex(void)
   zAssert( zLPSolveSimplex (regular case), result );
 }
 
+/* sparse problem with a known optimum x0, and a cost vector c2 perturbed from c keeping x0 feasible */
+zSpMat generate_lp_sparse(int n, int m, int nnz, zVec *c, zVec *c2, zVec *b, zVec *ans)
+{
+  zSpTriplet t;
+  zSpMat a;
+  zIndex index;
+  zVec l, z;
+  int i, j, k;
+
+  zSpTripletAlloc( &t, n*nnz+m );
+  for( j=0; j<n; j++ )
+    for( k=0; k<nnz; k++ )
+      zSpTripletAdd( &t, zRandI(0,m-1), j, zRandI(0,1) ? zRandF(1,10) : -zRandF(1,10) );
+  for( i=0; i<m; i++ )
+    zSpTripletAdd( &t, i, i, zRandF(1,10) );
+  a = zSpMatFromTriplet( &t, m, n, ZM_SPMAT_CSC );
+  zSpTripletFree( &t );
+  index = zIndexCreate( n );
+  zIndexShuffle( index, 0 );
+  *ans = zVecAlloc( n );
+  z = zVecAlloc( n );
+  l = zVecAlloc( m );
+  for( i=0; i<m; i++ )
+    zVecSetElemNC( *ans, zIndexElemNC(index,i), zRandF(1,10) );
+  for( ; i<n; i++ )
+    zVecSetElemNC( z, zIndexElemNC(index,i), zRandF(0.1,10) );
+  *b = zVecAlloc( m );
+  zSpMatMulVec( a, *ans, *b );
+  zVecRandUniform( l, -5, 5 );
+  *c = zVecAlloc( n );
+  zSpMatTMulVec( a, l, *c );
+  zVecAddDRC( *c, z );
+  zVecRandUniform( l, -1, 1 );
+  *c2 = zVecAlloc( n );
+  zSpMatTMulVec( a, l, *c2 );
+  zVecAddDRC( *c2, *c );
+  for( j=0; j<n; j++ )
+    zVecElemNC(*c2,j) += zRandF(0,0.5);
+  zVecFreeAtOnce( 2, l, z );
+  zIndexFree( index );
+  return a;
+}
+
+void assert_lp_revised(void)
+{
+  zMat a;
+  zSpMat sa;
+  zVec c, c2, b, ans, x;
+  zLPRevised lp;
+  double cost, cost_cold;
+  const int n = 10, m = 6;
+  const double tol = 1.0e-8;
+  int num_trial = 100, iter_warm;
+  bool result = true;
+
+  for( ; num_trial>0; num_trial-- ){
+    if( !generate_lp( n, m, &c, &a, &b, &ans ) ) return;
+    x = zVecAlloc( n );
+    zLPSolveSimplexRevised( a, b, c, x, &cost );
+    check_answer( x, ans, tol, &result );
+    zMatFree( a );
+    zVecFreeAtOnce( 4, c, b, x, ans );
+  }
+  zAssert( zLPSolveSimplexRevised (regular case), result );
+
+  sa = generate_lp_sparse( 900, 300, 3, &c, &c2, &b, &ans );
+  x = zVecAlloc( 900 );
+  zLPRevisedCreate( &lp, sa, b, c );
+  result = zLPRevisedSolve( &lp, x, &cost ) && zIsTol( cost - zVecInnerProd( c, ans ), tol*fabs(cost) );
+  zAssert( zLPRevisedSolve (sparse case), result );
+  zLPRevisedSetCost( &lp, c2 );
+  result = zLPRevisedSolve( &lp, x, &cost );
+  iter_warm = lp.iter_num;
+  zLPRevisedReset( &lp );
+  result = zLPRevisedSolve( &lp, x, &cost_cold ) && result;
+  zAssert( zLPRevisedSolve (warm start), result && zIsTol( cost - cost_cold, tol*fabs(cost) ) && iter_warm < lp.iter_num );
+  zLPRevisedDestroy( &lp );
+  zSpMatFree( sa );
+  zVecFreeAtOnce( 5, c, c2, b, ans, x );
+}
+
+void assert_lp_pdip(void)
+{
+  zMat a;
+  zSpMat sa;
+  zVec c, c2, b, ans, x;
+  zLPPDIP lp;
+  double cost, cost_cold;
+  const int n = 10, m = 6;
+  const double tol = 1.0e-5;
+  int num_trial = 100, iter_warm, i;
+  bool result = true;
+
+  for( ; num_trial>0; num_trial-- ){
+    if( !generate_lp( n, m, &c, &a, &b, &ans ) ) return;
+    x = zVecAlloc( n );
+    zLPSolvePDIP_Cholesky( a, b, c, x, &cost );
+    check_answer( x, ans, tol, &result );
+    zMatFree( a );
+    zVecFreeAtOnce( 4, c, b, x, ans );
+  }
+  zAssert( zLPSolvePDIP_Cholesky (regular case), result );
+
+  sa = generate_lp_sparse( 900, 300, 3, &c, &c2, &b, &ans );
+  x = zVecAlloc( 900 );
+  zLPPDIPCreate( &lp, sa, b, c );
+  result = zLPPDIPSolve( &lp, x, &cost ) && zIsTol( cost - zVecInnerProd( c, ans ), tol*fabs(cost) );
+  zAssert( zLPPDIPSolve (sparse case), result );
+  /* perturbations which keep the problem primal and dual feasible */
+  for( i=0; i<zVecSizeNC(ans); i++ )
+    zVecSetElemNC( x, i, zVecElemNC(ans,i) * ( 1 + zRandF(-1.0e-4,1.0e-4) ) );
+  zSpMatMulVec( sa, x, b );
+  for( i=0; i<zVecSizeNC(c); i++ )
+    zVecElemNC(c,i) += zRandF(0,1.0e-4) * fabs( zVecElemNC(c,i) );
+  zLPPDIPSetRHS( &lp, b );
+  zLPPDIPSetCost( &lp, c );
+  result = zLPPDIPSolve( &lp, x, &cost );
+  iter_warm = lp.iter_num;
+  zLPPDIPReset( &lp );
+  result = zLPPDIPSolve( &lp, x, &cost_cold ) && result;
+  zAssert( zLPPDIPSolve (warm start), result && zIsTol( cost - cost_cold, tol*fabs(cost) ) && iter_warm < lp.iter_num );
+  zLPPDIPDestroy( &lp );
+  zSpMatFree( sa );
+  zVecFreeAtOnce( 5, c, c2, b, ans, x );
+}
+
 bool test_lp_megiddo_dyer(int num_test, int num_constraint)
 {
   zLPMegiddoDyer lp;
@@ -125,6 +251,8 @@ int main(void)
 {
   zRandInit();
   assert_lp_simplex();
+  assert_lp_revised();
+  assert_lp_pdip();
   assert_lp_megiddo_dyer();
   return 0;
 }
@@ -100,10 +100,211 @@ void assert_qp_lemke(void)
   zAssert( zQPSolveLemke (regular case), result );
 }
 
+void assert_qp_dual_asm(void)
+{
+  zMat q, a;
+  zVec c, b, ans, x, xc;
+  zQPDualASM qp;
+  double cost, cost_cold;
+  const int n = 30, m = 60;
+  const double tol = 1.0e-8;
+  int i, num_trial = 10, iter_warm = 0, iter_cold = 0;
+  bool result = true, result_warm = true, result_budget = true;
+
+  for( i=0; i<num_trial; i++ ){
+    if( !generate_qp( 10, 10, -10, 10, &q, &c, &a, &b, &ans ) ) return;
+    x = zVecAlloc( 10 );
+    zQPSolveDualASM( q, c, a, b, x, &cost );
+    check_answer( x, ans, tol, &result );
+    zMatFreeAtOnce( 2, q, a );
+    zVecFreeAtOnce( 4, c, b, x, ans );
+  }
+  zAssert( zQPSolveDualASM (regular case), result );
+
+  for( ; num_trial>0; num_trial-- ){
+    if( !generate_qp( n, m, -10, 10, &q, &c, &a, &b, &ans ) ) return;
+    x = zVecAlloc( n );
+    xc = zVecAlloc( n );
+    if( !zQPDualASMCreate( &qp, q, a ) ) goto TERMINATE;
+    if( !zQPDualASMSolve( &qp, c, b, x, &cost ) ) result_warm = false;
+    check_answer( x, ans, tol, &result_warm );
+    /* slightly perturbed problem */
+    for( i=0; i<n; i++ ) zVecElemNC(c,i) += zRandF( -1.0e-2, 1.0e-2 );
+    for( i=0; i<m; i++ ) zVecElemNC(b,i) += zRandF( -1.0e-2, 1.0e-2 );
+    if( !zQPDualASMSolve( &qp, c, b, x, &cost ) ) result_warm = false;
+    iter_warm += qp.iter_num;
+    zQPDualASMReset( &qp );
+    if( !zQPDualASMSolve( &qp, c, b, xc, &cost_cold ) ) result_warm = false;
+    iter_cold += qp.iter_num;
+    check_answer( x, xc, tol, &result_warm );
+    if( !zIsTol( cost - cost_cold, tol*(1+fabs(cost_cold)) ) ) result_warm = false;
+    /* budget */
+    zQPDualASMReset( &qp );
+    qp.iter_max = 1;
+    if( zQPDualASMSolve( &qp, c, b, x, NULL ) || !qp.truncated ) result_budget = false;
+    zQPDualASMDestroy( &qp );
+   TERMINATE:
+    zMatFreeAtOnce( 2, q, a );
+    zVecFreeAtOnce( 5, c, b, x, xc, ans );
+  }
+  zAssert( zQPDualASMSolve (warm start), result_warm && iter_warm < iter_cold );
+  zAssert( zQPDualASMSolve (budget), result_budget );
+}
+
+bool generate_qp_sparse(int n, int m, zSpMat *p, zSpMat *a, zVec *q, zVec *b, zVec *xl, zVec *ans)
+{
+  zSpTriplet t;
+  zVec l, d;
+  int i, j, k;
+  bool ret = false;
+
+  *p = *a = NULL;
+  *q = zVecAlloc( n );
+  *b = zVecAlloc( m );
+  *xl = zVecAlloc( n );
+  *ans = zVecAlloc( n );
+  l = zVecAlloc( m );
+  d = zVecAlloc( n );
+  if( !*q || !*b || !*xl || !*ans || !l || !d ) goto TERMINATE;
+  /* tridiagonal positive definite P */
+  zSpTripletInit( &t );
+  for( i=0; i<n; i++ ){
+    zSpTripletAdd( &t, i, i, zRandF( 3.0, 5.0 ) );
+    if( i > 0 ) zSpTripletAdd( &t, i-1, i, zRandF( -1.0, 1.0 ) );
+  }
+  *p = zSpMatFromTriplet( &t, n, n, ZM_SPMAT_CSC );
+  zSpTripletFree( &t );
+  /* A with four nonzero components on each row */
+  zSpTripletInit( &t );
+  for( i=0; i<m; i++ )
+    for( k=0; k<4; k++ ) zSpTripletAdd( &t, i, zRandI(0,n-1), zRandF( -10.0, 10.0 ) );
+  *a = zSpMatFromTriplet( &t, m, n, ZM_SPMAT_CSC );
+  zSpTripletFree( &t );
+  if( !*p || !*a ) goto TERMINATE;
+  /* optimum answer, a part of which is on the lower bounds of box constraints */
+  zVecRandUniform( *ans, 1.0, 10.0 );
+  zVecZero( *xl );
+  zVecZero( d );
+  for( j=0; j<n; j++ )
+    if( zRandI(0,3) == 0 ){
+      zVecSetElemNC( *ans, j, 0 );
+      zVecSetElemNC( d, j, zRandF( 1.0, 5.0 ) );
+    }
+  for( i=0; i<m; i++ ) /* lambda vector */
+    zVecSetElemNC( l, i, zRandI(0,1) == 0 ? zRandF( 1.0, 5.0 ) : 0 );
+  /* q = A^T l + d - P x */
+  zSpMatTMulVecNC( *a, l, *q );
+  zVecAddDRC( *q, d );
+  for( j=0; j<n; j++ )
+    for( k=(*p)->ptr[j]; k<(*p)->ptr[j+1]; k++ ){
+      i = (*p)->ind[k];
+      zVecElemNC(*q,i) -= (*p)->val[k] * zVecElemNC(*ans,j);
+      if( i != j ) zVecElemNC(*q,j) -= (*p)->val[k] * zVecElemNC(*ans,i);
+    }
+  zSpMatMulVecNC( *a, *ans, *b ); /* b vector */
+  for( i=0; i<m; i++ )
+    if( zVecElemNC(l,i) == 0 ) zVecElemNC(*b,i) -= zRandF( 1.0, 10.0 );
+  ret = true;
+
+ TERMINATE:
+  zVecFreeAtOnce( 2, l, d );
+  if( !ret ){
+    zSpMatFree( *p );
+    zSpMatFree( *a );
+    zVecFreeAtOnce( 4, *q, *b, *xl, *ans );
+  }
+  return ret;
+}
+
+double sp_quadratic_value(zSpMat p, zVec q, zVec x)
+{
+  double v;
+  int i, j, k;
+
+  v = zVecInnerProd( q, x );
+  for( j=0; j<zSpMatColSize(p); j++ )
+    for( k=p->ptr[j]; k<p->ptr[j+1]; k++ ){
+      i = p->ind[k];
+      v += ( i == j ? 0.5 : 1.0 ) * p->val[k] * zVecElemNC(x,i) * zVecElemNC(x,j);
+    }
+  return v;
+}
+
+bool check_feasibility(zSpMat a, zVec b, zVec xl, zVec x, double tol)
+{
+  zVec ax;
+  int i;
+  bool ret = true;
+
+  if( !( ax = zVecAlloc( zSpMatRowSize(a) ) ) ) return false;
+  zSpMatMulVec( a, x, ax );
+  for( i=0; i<zVecSizeNC(ax); i++ )
+    if( zVecElemNC(ax,i) < zVecElemNC(b,i) - tol ) ret = false;
+  for( i=0; i<zVecSizeNC(x); i++ )
+    if( zVecElemNC(x,i) < zVecElemNC(xl,i) - tol ) ret = false;
+  zVecFree( ax );
+  return ret;
+}
+
+void assert_qp_admm(void)
+{
+  zMat q, a;
+  zSpMat ps, as;
+  zVec c, b, xl, ans, x;
+  zQPADMM qp;
+  double cost, cost_opt;
+  const int n = 500, m = 250;
+  const double tol = 1.0e-4;
+  int i, j, num_trial = 10, iter_warm;
+  bool result = true, result_sparse = true, result_warm = true;
+
+  for( i=0; i<num_trial; i++ ){
+    if( !generate_qp( 10, 10, -10, 10, &q, &c, &a, &b, &ans ) ) return;
+    x = zVecAlloc( 10 );
+    zQPSolveADMM( q, c, a, b, x, &cost );
+    check_answer( x, ans, 10*tol, &result );
+    zMatFreeAtOnce( 2, q, a );
+    zVecFreeAtOnce( 4, c, b, x, ans );
+  }
+  zAssert( zQPSolveADMM (regular case), result );
+
+  for( i=0; i<num_trial; i++ ){
+    if( !generate_qp_sparse( n, m, &ps, &as, &c, &b, &xl, &ans ) ) return;
+    x = zVecAlloc( n );
+    if( zQPADMMCreate( &qp, ps, as ) ){
+      qp.iter_max = 100000;
+      zQPADMMSetCost( &qp, c );
+      zQPADMMSetBound( &qp, b, NULL );
+      zQPADMMSetBox( &qp, xl, NULL );
+      if( !zQPADMMSolve( &qp, x, &cost ) ) result_sparse = false;
+      cost_opt = sp_quadratic_value( ps, c, ans );
+      if( !zIsTol( cost - cost_opt, tol*(1+fabs(cost_opt)) ) ||
+          !check_feasibility( as, b, xl, x, 10*tol ) ) result_sparse = false;
+      /* slightly perturbed problem */
+      for( j=0; j<n; j++ ) zVecElemNC(c,j) += zRandF( -1.0e-3, 1.0e-3 );
+      zQPADMMSetCost( &qp, c );
+      if( !zQPADMMSolve( &qp, x, &cost ) ) result_warm = false;
+      iter_warm = qp.iter_num;
+      zQPADMMReset( &qp );
+      if( !zQPADMMSolve( &qp, ans, &cost_opt ) || qp.iter_num <= iter_warm ) result_warm = false;
+      if( !zIsTol( cost - cost_opt, tol*(1+fabs(cost_opt)) ) ) result_warm = false;
+      zQPADMMDestroy( &qp );
+    } else
+      result_sparse = false;
+    zSpMatFree( ps );
+    zSpMatFree( as );
+    zVecFreeAtOnce( 5, c, b, xl, ans, x );
+  }
+  zAssert( zQPADMMSolve (sparse case), result_sparse );
+  zAssert( zQPADMMSolve (warm start), result_warm );
+}
+
 int main(void)
 {
   zRandInit();
   assert_qp_asm();
+  assert_qp_dual_asm();
+  assert_qp_admm();
   assert_qp_lemke();
   return 0;
 }
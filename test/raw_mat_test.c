@@ -645,6 +645,68 @@ void assert_raw_mul_mat_mat(void)
   zAssert( zRawMulMatTMat, zRawMatEqual( m, 5, mtm_ans, 3, 3, 3, zTOL ) );
 }
 
+void assert_raw_gemm(void)
+{
+  double *m1, *m2, *m2t, *m, *ans;
+  const int rowsize = 137, colsize = 75, innersize = 290;
+  const int colcapacity1 = 300, colcapacity2 = 150, colcapacity2t = 310, colcapacity3 = 80;
+  const double alpha = 1.5, beta = -0.5;
+  const double tol = 1.0e-9;
+  zRawGEMMKernelType type;
+  int i, j, k;
+  bool result_nn = true, result_nt = true, result_tn = true, result_ab = true;
+
+  m1 = zAlloc( double, innersize * colcapacity1 );
+  m2 = zAlloc( double, innersize * colcapacity2 );
+  m2t = zAlloc( double, colsize * colcapacity2t );
+  m = zAlloc( double, rowsize * colcapacity3 );
+  ans = zAlloc( double, rowsize * colsize );
+  zRawMatRandUniform( m1, colcapacity1, -5, 5, innersize, colcapacity1 );
+  zRawMatRandUniform( m2, colcapacity2, -5, 5, innersize, colcapacity2 );
+  zRawMatRandUniform( m2t, colcapacity2t, -5, 5, colsize, colcapacity2t );
+  for( type=ZM_RAW_GEMM_KERNEL_SCALAR; type<=ZM_RAW_GEMM_KERNEL_AVX2; type++ ){
+    if( zRawGEMMSelectKernel( type ) != type ) continue;
+    /* m1 (rowsize x innersize) m2 (innersize x colsize) */
+    for( i=0; i<rowsize; i++ )
+      for( j=0; j<colsize; j++ )
+        for( ans[i*colsize+j]=0, k=0; k<innersize; k++ )
+          ans[i*colsize+j] += m1[i*colcapacity1+k] * m2[k*colcapacity2+j];
+    zRawGEMM( false, false, rowsize, colsize, innersize, 1.0, m1, colcapacity1, m2, colcapacity2, 0.0, m, colcapacity3 );
+    if( !zRawMatEqual( m, colcapacity3, ans, colsize, rowsize, colsize, tol ) ) result_nn = false;
+    /* m = alpha m1 m2 + beta m */
+    zRawMatRandUniform( m, colcapacity3, -5, 5, rowsize, colsize );
+    for( i=0; i<rowsize; i++ )
+      for( j=0; j<colsize; j++ )
+        ans[i*colsize+j] = alpha * ans[i*colsize+j] + beta * m[i*colcapacity3+j];
+    zRawGEMM( false, false, rowsize, colsize, innersize, alpha, m1, colcapacity1, m2, colcapacity2, beta, m, colcapacity3 );
+    if( !zRawMatEqual( m, colcapacity3, ans, colsize, rowsize, colsize, tol ) ) result_ab = false;
+    /* m1 (rowsize x innersize) m2^T (colsize x innersize) */
+    for( i=0; i<rowsize; i++ )
+      for( j=0; j<colsize; j++ )
+        for( ans[i*colsize+j]=0, k=0; k<innersize; k++ )
+          ans[i*colsize+j] += m1[i*colcapacity1+k] * m2t[j*colcapacity2t+k];
+    zRawGEMM( false, true, rowsize, colsize, innersize, 1.0, m1, colcapacity1, m2t, colcapacity2t, 0.0, m, colcapacity3 );
+    if( !zRawMatEqual( m, colcapacity3, ans, colsize, rowsize, colsize, tol ) ) result_nt = false;
+    /* m1^T (innersize x rowsize) m2 (innersize x colsize) */
+    for( i=0; i<rowsize; i++ )
+      for( j=0; j<colsize; j++ )
+        for( ans[i*colsize+j]=0, k=0; k<innersize; k++ )
+          ans[i*colsize+j] += m1[k*colcapacity1+i] * m2[k*colcapacity2+j];
+    zRawGEMM( true, false, rowsize, colsize, innersize, 1.0, m1, colcapacity1, m2, colcapacity2, 0.0, m, colcapacity3 );
+    if( !zRawMatEqual( m, colcapacity3, ans, colsize, rowsize, colsize, tol ) ) result_tn = false;
+  }
+  zRawGEMMSelectKernel( ZM_RAW_GEMM_KERNEL_AUTO );
+  free( m1 );
+  free( m2 );
+  free( m2t );
+  free( m );
+  free( ans );
+  zAssert( zRawGEMM (m1 m2), result_nn );
+  zAssert( zRawGEMM (alpha m1 m2 + beta m), result_ab );
+  zAssert( zRawGEMM (m1 m2^T), result_nt );
+  zAssert( zRawGEMM (m1^T m2), result_tn );
+}
+
 void assert_raw_mat_dyad(void)
 {
   double v1[] = { 1.0, 2.0, 3.0 };
@@ -699,6 +761,7 @@ int main(void)
   assert_raw_mat_transpose();
   assert_raw_mul_mat_vec();
   assert_raw_mul_mat_mat();
+  assert_raw_gemm();
   assert_raw_mat_dyad();
   return 0;
 }
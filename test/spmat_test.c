@@ -0,0 +1,244 @@
+#include <zm/zm.h>
+
+#define TOL (1.0e-10)
+
+zMat mat_sparse_rand(zMat m, double rate)
+{
+  int i, j;
+
+  for( i=0; i<zMatRowSizeNC(m); i++ )
+    for( j=0; j<zMatColSizeNC(m); j++ )
+      zMatSetElemNC( m, i, j, zRandF(0,1) < rate ? zRandF(-10,10) : 0 );
+  return m;
+}
+
+/* 2D Laplacian on an n x n grid */
+zSpMat spmat_laplacian(int n, zSpMatFormat format)
+{
+  zSpTriplet t;
+  zSpMat m;
+  int i, j, k;
+
+  zSpTripletAlloc( &t, 0 );
+  for( i=0; i<n; i++ )
+    for( j=0; j<n; j++ ){
+      k = i*n + j;
+      zSpTripletAdd( &t, k, k, 4 );
+      if( i > 0 )   zSpTripletAdd( &t, k, k-n, -1 );
+      if( i < n-1 ) zSpTripletAdd( &t, k, k+n, -1 );
+      if( j > 0 )   zSpTripletAdd( &t, k, k-1, -1 );
+      if( j < n-1 ) zSpTripletAdd( &t, k, k+1, -1 );
+    }
+  m = zSpMatFromTriplet( &t, n*n, n*n, format );
+  zSpTripletFree( &t );
+  return m;
+}
+
+void assert_spmat_conv(void)
+{
+  zMat m, m2;
+  zSpMat csr, csc, sp, spt;
+  bool result1, result2, result3, result4;
+
+  m = mat_sparse_rand( zMatAlloc( 37, 23 ), 0.2 );
+  m2 = zMatAlloc( 37, 23 );
+  csr = zSpMatFromMat( m, 0, ZM_SPMAT_CSR );
+  csc = zSpMatFromMat( m, 0, ZM_SPMAT_CSC );
+  result1 = zMatEqual( zSpMatToMat( csr, m2 ), m, 0 ) && zMatEqual( zSpMatToMat( csc, m2 ), m, 0 );
+  result2 = zSpMatElem( csr, 3, 5 ) == zMatElemNC(m,3,5) && zSpMatElem( csc, 36, 22 ) == zMatElemNC(m,36,22);
+  sp = zSpMatConvert( csr, ZM_SPMAT_CSC );
+  result3 = sp->nnz == csc->nnz &&
+    memcmp( sp->ptr, csc->ptr, sizeof(int)*24 ) == 0 &&
+    memcmp( sp->ind, csc->ind, sizeof(int)*csc->nnz ) == 0 &&
+    zMatEqual( zSpMatToMat( sp, m2 ), m, 0 );
+  zSpMatFree( sp );
+  spt = zSpMatT( csc );
+  zMatFree( m2 );
+  m2 = zMatAlloc( 23, 37 );
+  zSpMatToMat( spt, m2 );
+  zMatTDRC( m2 );
+  result4 = zSpMatIsCSC(spt) && zMatEqual( m2, m, 0 );
+  zSpMatFree( spt );
+  zSpMatFree( csr );
+  zSpMatFree( csc );
+  zMatFreeAtOnce( 2, m, m2 );
+  zAssert( zSpMatFromMat + zSpMatToMat, result1 );
+  zAssert( zSpMatElem, result2 );
+  zAssert( zSpMatConvert, result3 );
+  zAssert( zSpMatT, result4 );
+}
+
+void assert_spmat_triplet(void)
+{
+  zSpTriplet t;
+  zSpMat sp;
+  bool result;
+
+  zSpTripletAlloc( &t, 1 );
+  zSpTripletAdd( &t, 2, 1, 1.0 );
+  zSpTripletAdd( &t, 0, 0, 2.0 );
+  zSpTripletAdd( &t, 2, 1, 3.0 );
+  zSpTripletAdd( &t, 1, 2, 5.0 );
+  zSpTripletAdd( &t, 2, 0, 7.0 );
+  zSpTripletAdd( &t, 0, 0, -2.0 );
+  sp = zSpMatFromTriplet( &t, 3, 3, ZM_SPMAT_CSR );
+  result = sp->nnz == 4 &&
+    zSpMatElem( sp, 0, 0 ) == 0 && zSpMatElem( sp, 2, 1 ) == 4.0 &&
+    zSpMatElem( sp, 1, 2 ) == 5.0 && zSpMatElem( sp, 2, 0 ) == 7.0 &&
+    sp->ind[2] == 0 && sp->ind[3] == 1;
+  zSpMatFree( sp );
+  eprintf( "(the following error is expected.)\n" );
+  result = result && !zSpMatFromTriplet( &t, 2, 3, ZM_SPMAT_CSR );
+  zSpTripletFree( &t );
+  zAssert( zSpMatFromTriplet, result );
+}
+
+void assert_spmat_mulvec(void)
+{
+  zMat m;
+  zSpMat csr, csc;
+  zVec v, vt, mv0, mvt0, mv, mvt;
+  int num;
+  bool result1 = true, result2 = true;
+
+  m = mat_sparse_rand( zMatAlloc( 300, 400 ), 0.3 );
+  v = zVecRandUniform( zVecAlloc( 400 ), -10, 10 );
+  vt = zVecRandUniform( zVecAlloc( 300 ), -10, 10 );
+  mv0 = zVecAlloc( 300 ); mv = zVecAlloc( 300 );
+  mvt0 = zVecAlloc( 400 ); mvt = zVecAlloc( 400 );
+  zMulMatVec( m, v, mv0 );
+  zMulMatTVec( m, vt, mvt0 );
+  csr = zSpMatFromMat( m, 0, ZM_SPMAT_CSR );
+  csc = zSpMatFromMat( m, 0, ZM_SPMAT_CSC );
+  for( num=1; num<=4; num++ ){
+    zThreadSetNum( num );
+    zSpMatMulVec( csr, v, mv );
+    if( !zVecIsTol( zVecSubDRC( mv, mv0 ), TOL ) ) result1 = false;
+    zSpMatMulVec( csc, v, mv );
+    if( !zVecIsTol( zVecSubDRC( mv, mv0 ), TOL ) ) result1 = false;
+    zSpMatTMulVec( csr, vt, mvt );
+    if( !zVecIsTol( zVecSubDRC( mvt, mvt0 ), TOL ) ) result2 = false;
+    zSpMatTMulVec( csc, vt, mvt );
+    if( !zVecIsTol( zVecSubDRC( mvt, mvt0 ), TOL ) ) result2 = false;
+  }
+  zThreadSetNum( 1 );
+  zSpMatFree( csr );
+  zSpMatFree( csc );
+  zMatFree( m );
+  zVecFreeAtOnce( 6, v, vt, mv0, mvt0, mv, mvt );
+  zAssert( zSpMatMulVec, result1 );
+  zAssert( zSpMatTMulVec, result2 );
+}
+
+void assert_spmat_amd(void)
+{
+  zSpMat a;
+  int *perm, *flag;
+  int i, n = 400;
+  bool result = true;
+
+  a = spmat_laplacian( 20, ZM_SPMAT_CSR );
+  perm = zAlloc( int, n );
+  flag = zAlloc( int, n );
+  if( !zSpMatOrderAMD( a, perm ) ) result = false;
+  for( i=0; i<n; i++ ){
+    if( perm[i] < 0 || perm[i] >= n || flag[perm[i]] ){
+      result = false;
+      break;
+    }
+    flag[perm[i]] = 1;
+  }
+  free( perm );
+  free( flag );
+  zSpMatFree( a );
+  zAssert( zSpMatOrderAMD, result );
+}
+
+/* number of nonzero components of the Cholesky factor of a symmetric CSC matrix without reordering */
+int spmat_cholesky_nnz_natural(const zSpMat a)
+{
+  char *pattern;
+  int n, i, j, k, p, nnz = 0;
+
+  n = zSpMatColSize( a );
+  if( !( pattern = zAlloc( char, n*n ) ) ) return 0;
+  for( j=0; j<n; j++ )
+    for( p=a->ptr[j]; p<a->ptr[j+1]; p++ )
+      pattern[a->ind[p]*n+j] = pattern[j*n+a->ind[p]] = 1;
+  /* symbolic elimination, which does not suffer from numerical cancellation */
+  for( k=0; k<n; k++ )
+    for( i=k+1; i<n; i++ ){
+      if( !pattern[i*n+k] ) continue;
+      for( j=k+1; j<=i; j++ )
+        if( pattern[j*n+k] ) pattern[i*n+j] = 1;
+    }
+  for( i=0; i<n; i++ )
+    for( j=0; j<=i; j++ )
+      if( pattern[i*n+j] ) nnz++;
+  free( pattern );
+  return nnz;
+}
+
+void assert_spmat_cholesky(void)
+{
+  zSpMat a;
+  zSpCholesky chol;
+  zMat m, mtm;
+  zVec b, x, x0, r;
+  int n = 30, k;
+  bool result1, result2, result3, result4, result5;
+
+  a = spmat_laplacian( n, ZM_SPMAT_CSC );
+  b = zVecRandUniform( zVecAlloc( n*n ), -1, 1 );
+  x = zVecAlloc( n*n );
+  r = zVecAlloc( n*n );
+  zSpCholeskyInit( &chol );
+  zSpCholeskyAnalyze( &chol, a );
+  result1 = zSpCholeskyFactorize( &chol, a ) && zSpCholeskySolve( &chol, b, x );
+  zSpMatMulVec( a, x, r );
+  result1 = result1 && zVecIsTol( zVecSubDRC( r, b ), TOL );
+  /* the fill-reducing ordering has to reduce fill-in of the factor in the natural ordering */
+  result2 = chol.l->nnz < spmat_cholesky_nnz_natural( a ) / 2;
+  /* refactorization with the same pattern */
+  for( k=0; k<a->nnz; k++ ) a->val[k] *= 2;
+  result3 = zSpCholeskyFactorize( &chol, a ) && zSpCholeskySolve( &chol, b, x );
+  zSpMatMulVec( a, x, r );
+  result3 = result3 && zVecIsTol( zVecSubDRC( r, b ), TOL );
+  /* a different pattern with the same number of components */
+  a->ind[a->ptr[1]-1]++;
+  eprintf( "(the following error is expected.)\n" );
+  result5 = !zSpCholeskyFactorize( &chol, a ) && !chol.factorized;
+  zSpCholeskyFree( &chol );
+  zSpMatFree( a );
+  zVecFreeAtOnce( 3, b, x, r );
+  /* a random positive definite matrix */
+  m = mat_sparse_rand( zMatAllocSqr( 50 ), 0.1 );
+  mtm = zMatAllocSqr( 50 );
+  zMulMatTMat( m, m, mtm );
+  for( k=0; k<50; k++ ) zMatElemNC(mtm,k,k) += 1;
+  a = zSpMatFromMat( mtm, 0, ZM_SPMAT_CSR );
+  x0 = zVecRandUniform( zVecAlloc( 50 ), -1, 1 );
+  b = zVecAlloc( 50 );
+  x = zVecAlloc( 50 );
+  zMulMatVec( mtm, x0, b );
+  result4 = zLESolveSpCholesky( a, b, x ) && zVecIsTol( zVecSubDRC( x, x0 ), 1e-8 );
+  zSpMatFree( a );
+  zMatFreeAtOnce( 2, m, mtm );
+  zVecFreeAtOnce( 3, x0, b, x );
+  zAssert( zSpCholeskyFactorize + zSpCholeskySolve, result1 );
+  zAssert( zSpCholeskyAnalyze (fill-in), result2 );
+  zAssert( zSpCholeskyFactorize (refactorization), result3 );
+  zAssert( zLESolveSpCholesky, result4 );
+  zAssert( zSpCholeskyFactorize (pattern mismatch), result5 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_spmat_conv();
+  assert_spmat_triplet();
+  assert_spmat_mulvec();
+  assert_spmat_amd();
+  assert_spmat_cholesky();
+  return 0;
+}
@@ -0,0 +1,159 @@
+#include <zm/zm.h>
+
+#define N 1000
+
+typedef struct{
+  int count[N];
+  double val[N];
+} thread_test_t;
+
+void thread_test_count(void *util, int from, int to)
+{
+  int i;
+
+  for( i=from; i<to; i++ )
+    ((thread_test_t *)util)->count[i]++;
+}
+
+double thread_test_sum(void *util, int from, int to)
+{
+  double s = 0;
+  int i;
+
+  for( i=from; i<to; i++ )
+    s += ((thread_test_t *)util)->val[i];
+  return s;
+}
+
+void assert_thread_pool(void)
+{
+  thread_test_t data;
+  zThreadPool pool;
+  double s0, s;
+  int i, num;
+  bool result_for = true, result_reduce = true;
+
+  for( i=0; i<N; i++ ) data.val[i] = zRandF(-1e5,1e5);
+  zThreadPoolCreate( &pool, 1 );
+  s0 = zThreadPoolReduce( &pool, 0, 0, N, 7, thread_test_sum, &data );
+  zThreadPoolDestroy( &pool );
+  for( num=1; num<=4; num++ ){
+    zThreadPoolCreate( &pool, num );
+    for( i=0; i<N; i++ ) data.count[i] = 0;
+    zThreadPoolFor( &pool, 0, 0, N, 7, thread_test_count, &data );
+    for( i=0; i<N; i++ )
+      if( data.count[i] != 1 ) result_for = false;
+    s = zThreadPoolReduce( &pool, 0, 0, N, 7, thread_test_sum, &data );
+    if( s != s0 ) result_reduce = false;
+    zThreadPoolDestroy( &pool );
+  }
+  zAssert( zThreadPoolFor, result_for );
+  zAssert( zThreadPoolReduce, result_reduce );
+}
+
+/* pipeline of stages, each of which accumulates the values of the preceding stage */
+#define THREAD_TEST_STAGE 6
+typedef struct{
+  zThreadCounter count[THREAD_TEST_STAGE];
+  double val[THREAD_TEST_STAGE][N];
+} thread_test_pipe_t;
+
+void thread_test_pipe(void *util, int from, int to)
+{
+  thread_test_pipe_t *data;
+  int i;
+
+  data = (thread_test_pipe_t *)util;
+  for( ; from<to; from++ )
+    for( i=0; i<N; i++ ){
+      if( from > 0 ){
+        zThreadCounterWait( &data->count[from-1], i+1 );
+        data->val[from][i] = ( i > 0 ? data->val[from][i-1] : 0 ) + data->val[from-1][i];
+      } else
+        data->val[from][i] = 1;
+      zThreadCounterSet( &data->count[from], i+1 );
+    }
+}
+
+void assert_thread_counter(void)
+{
+  thread_test_pipe_t data;
+  int i, num;
+  bool result = true;
+
+  for( i=0; i<THREAD_TEST_STAGE; i++ ) zThreadCounterInit( &data.count[i] );
+  for( num=1; num<=4; num++ ){
+    for( i=0; i<THREAD_TEST_STAGE; i++ ) zThreadCounterSet( &data.count[i], 0 );
+    zThreadFor( num, 0, THREAD_TEST_STAGE, 1, thread_test_pipe, &data );
+    /* the (k+1)-th stage at i is the binomial coefficient (i+k, k) */
+    if( data.val[1][N-1] != N || data.val[2][N-1] != (double)N*(N+1)/2 ) result = false;
+  }
+  for( i=0; i<THREAD_TEST_STAGE; i++ ) zThreadCounterDestroy( &data.count[i] );
+  zAssert( zThreadCounterWait, result );
+}
+
+void assert_thread_mul_mat_mat(void)
+{
+  const int r = 131, c = 97, k = 113;
+  zMat m1, m2, m1t, m2t, m0, m;
+  int num;
+  bool result1 = true, result2 = true, result3 = true;
+
+  m1 = zMatAlloc( r, k ); zMatRandUniform( m1, -10, 10 );
+  m2 = zMatAlloc( k, c ); zMatRandUniform( m2, -10, 10 );
+  m1t = zMatAlloc( k, r ); zMatT( m1, m1t );
+  m2t = zMatAlloc( c, k ); zMatT( m2, m2t );
+  m0 = zMatAlloc( r, c );
+  m = zMatAlloc( r, c );
+  zMulMatMatThreadNC( m1, m2, m0, 1 );
+  for( num=1; num<=4; num++ ){
+    zMulMatMatThreadNC( m1, m2, m, num );
+    if( !zMatMatch( m0, m ) || !zMatEqual( m0, m, 0 ) ) result1 = false;
+    zMulMatMatTThreadNC( m1, m2t, m, num );
+    if( !zMatIsTol( zMatSubDRC( m, m0 ), 1e-9 ) ) result2 = false;
+    zMulMatTMatThreadNC( m1t, m2, m, num );
+    if( !zMatIsTol( zMatSubDRC( m, m0 ), 1e-9 ) ) result3 = false;
+  }
+  zMatFreeAtOnce( 6, m1, m2, m1t, m2t, m0, m );
+  zAssert( zMulMatMatThreadNC, result1 );
+  zAssert( zMulMatMatTThreadNC, result2 );
+  zAssert( zMulMatTMatThreadNC, result3 );
+}
+
+void assert_thread_mat_quad(void)
+{
+  const int r = 80, c = 70;
+  zMat a, q, q0, m, m0;
+  zVec w;
+  int num;
+  bool result1 = true, result2 = true;
+
+  a = zMatAlloc( r, c ); zMatRandUniform( a, -10, 10 );
+  w = zVecAlloc( c ); zVecRandUniform( w, 0, 10 );
+  q = zMatAllocSqr( c ); zMatRandUniform( q, -10, 10 );
+  q0 = zMatAllocSqr( r );
+  m0 = zMatAllocSqr( r );
+  m = zMatAllocSqr( r );
+  zMatQuadThreadNC( a, w, q0, 1 );
+  zMulMatMatMatTThreadNC( a, q, m0, 1 );
+  for( num=2; num<=4; num++ ){
+    zMatQuadThreadNC( a, w, m, num );
+    if( !zMatEqual( q0, m, 0 ) ) result1 = false;
+    zMulMatMatMatTThreadNC( a, q, m, num );
+    if( !zMatEqual( m0, m, 0 ) ) result2 = false;
+  }
+  zMatFreeAtOnce( 5, a, q, q0, m, m0 );
+  zVecFree( w );
+  zAssert( zMatQuadThreadNC, result1 );
+  zAssert( zMulMatMatMatTThreadNC, result2 );
+}
+
+int main(void)
+{
+  zRandInit();
+  assert_thread_pool();
+  assert_thread_counter();
+  assert_thread_mul_mat_mat();
+  assert_thread_mat_quad();
+  return 0;
+}